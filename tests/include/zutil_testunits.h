@@ -43,7 +43,13 @@ typedef struct {
 
 
 extern Void TestUnit_Module_ZBase64(int _argc, char** _argv);
+extern Void TestUnit_Module_ZIconV(int _argc, char** _argv);
 extern Void TestUnit_Module_ZLog(int _argc, char** _argv);
+extern Void TestUnit_Module_ZMathArray(int _argc, char** _argv);
+extern Void TestUnit_Module_ZRectPack(int _argc, char** _argv);
+extern Void TestUnit_Module_ZSpatial(int _argc, char** _argv);
+extern Void TestUnit_Module_ZStr(int _argc, char** _argv);
+extern Void TestUnit_Module_ZSweep(int _argc, char** _argv);
 extern Void TestUnit_Module_ZSystem(int _argc, char** _argv);
 extern Void TestUnit_Module_ZThreads(int _argc, char** _argv); 
 	
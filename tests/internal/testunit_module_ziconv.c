@@ -0,0 +1,145 @@
+/******************************************************************************
+* zutil - C Utility Library
+* Copyright (C) 2017-2021 Zachary T Harris. All Rights Reserved.  
+* Zlib license.
+* 
+* File: testunit_module_ziconv.c
+* Desc: streaming conversion tests
+*******************************************************************************
+
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+******************************************************************************/ 
+#include "zutil/ziconv.h"
+#include "zutil_testunits.h" 
+
+
+
+#define ZICONV_TEST_OUTPUT 64
+
+
+
+typedef struct {
+	Lpcstr      name;
+	Lpcstr      tocode;
+	Lpcstr      fromcode;
+	const Byte* input;
+	SizeT       inputlen;
+	const Byte* expect;
+	SizeT       expectlen;
+} ZICONVCASE;
+
+
+/*
+A, e acute, euro sign, and U+1F600 (a surrogate pair in UTF-16)*/
+static const Byte s_utf8[] = {
+	0x41, 0xC3, 0xA9, 0xE2, 0x82, 0xAC, 0xF0, 0x9F, 0x98, 0x80 };
+static const Byte s_utf16bom[] = {
+	0xFF, 0xFE, 0x41, 0x00, 0xE9, 0x00, 0xAC, 0x20, 0x3D, 0xD8, 0x00, 0xDE };
+static const Byte s_utf16be[] = {
+	0x00, 0x41, 0x00, 0xE9, 0x20, 0xAC, 0xD8, 0x3D, 0xDE, 0x00 };
+static const Byte s_utf32bom[] = {
+	0x00, 0x00, 0xFE, 0xFF, 0x00, 0x00, 0x00, 0x41, 0x00, 0x00, 0x00, 0xE9 };
+static const Uint32 s_utf32native[] = { 0x41, 0xE9 };
+
+static const ZICONVCASE s_cases[] = {
+	{ "UTF-16 marker -> UTF-8", "UTF-8", "UTF-16", 
+	   s_utf16bom, sizeof(s_utf16bom), s_utf8, sizeof(s_utf8) },
+	{ "UTF-32 marker -> UTF-8", "UTF-8", "UTF-32",
+	   s_utf32bom, sizeof(s_utf32bom), s_utf8, 3 },
+	{ "UTF-32 no marker -> UTF-8", "UTF-8", "UTF-32",
+	   (const Byte*)s_utf32native, sizeof(s_utf32native), s_utf8, 3 },
+	{ "UTF-8 -> UTF-16BE", "UTF-16BE", "UTF-8",
+	   s_utf8, sizeof(s_utf8), s_utf16be, sizeof(s_utf16be) },
+	{ "UTF-16 marker -> UTF-16BE", "UTF-16BE", "UTF-16",
+	   s_utf16bom, sizeof(s_utf16bom), s_utf16be, sizeof(s_utf16be) },
+	{ "UTF-32 no marker -> UTF-16BE", "UTF-16BE", "UTF-32",
+	   (const Byte*)s_utf32native, sizeof(s_utf32native), s_utf16be, 4 },
+};
+
+
+/*
+Feeds the input in pieces of _piece bytes, splitting sequences, into
+an output window of _room bytes. A call that ends with Z_EICONVTOOBIG
+is resumed with the same descriptor, and the window is only widened
+when not even one character fits.*/
+static Bool ConvertInPieces(const ZICONVCASE* _case, SizeT _piece, SizeT _room) {
+	ZIconV iconv;
+	Char   out[ZICONV_TEST_OUTPUT];
+	Lpcstr src;
+	Char*  dst;
+	SizeT  srclen, dstlen, size, pos, offset, result;
+	Bool   bOk;
+
+	iconv = ZIconV_Open(_case->tocode, _case->fromcode);
+	if (iconv == (ZIconV)-1)
+		return Z_FALSE;
+	bOk    = Z_TRUE;
+	pos    = 0;
+	offset = 0;
+	while (bOk && offset < _case->inputlen) {
+		src    = (Lpcstr)_case->input + offset;
+		srclen = Z_Min(_piece, _case->inputlen - offset);
+		size   = _room;
+		for (;;) {
+			dst    = out + pos;
+			dstlen = size;
+			result = ZIconV_Init(iconv, &src, &srclen, &dst, &dstlen);
+			pos    = (SizeT)(dst - out);
+			if (result != (SizeT)Z_EICONVTOOBIG)
+				break;
+			size = (dstlen == size) ? size + 1 : _room;
+			if (size > 4 || pos + size > ZICONV_TEST_OUTPUT) {
+				bOk = Z_FALSE;
+				break;
+			}
+		}
+		if (srclen != 0)
+			bOk = Z_FALSE;
+		offset = (SizeT)(src - (Lpcstr)_case->input);
+	}
+	ZIconV_Close(iconv);
+	return bOk && 
+		pos == _case->expectlen && memcmp(out, _case->expect, pos) == 0;
+}
+
+
+
+Void TestUnit_Module_ZIconV(int argc, char** argv) { 
+	SizeT it, piece, room, failed;
+	Z_Unused(argc);
+	Z_Unused(argv);
+
+	for (it = 0; it < Z_ArraySize(s_cases); ++it) {
+		/*
+		every split of the input against 1 to 3 byte output windows:*/
+		failed = 0;
+		for (piece = 1; piece <= s_cases[it].inputlen; ++piece) {
+			for (room = 1; room <= 3; ++room) {
+				if (!ConvertInPieces(&s_cases[it], piece, room)) {
+					printf("  failed: %zu byte pieces, %zu byte output\n",
+						(size_t)piece, (size_t)room);
+					++failed;
+				}
+			}
+		}
+		printf("%-30s %s\n", s_cases[it].name, failed ? "FAILED" : "ok");
+	}
+} 
+/*****************************************************************************/  
+//EOF
+/*****************************************************************************/  
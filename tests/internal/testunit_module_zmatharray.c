@@ -0,0 +1,192 @@
+/******************************************************************************
+* zutil - C Utility Library
+* Copyright (C) 2017-2021 Zachary T Harris. All Rights Reserved.  
+* Zlib license.
+* 
+* File: testunit_module_zmatharray.c
+* Desc: batch math function tests
+*******************************************************************************
+
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+******************************************************************************/ 
+#include <float.h>
+#include <math.h>
+#include "zutil/zmatharray.h"
+#include "zutil_testunits.h" 
+
+
+
+#define ZMATHARRAY_TEST_COUNT 100003 //not a multiple of the vector width
+
+
+
+static Float RandomFloat(Float _min, Float _max) {
+	return _min + (Float)rand() / (Float)RAND_MAX * (_max - _min);
+}
+
+
+/*
+@return: the error of _value in units in the last place of the float
+nearest to _exact*/
+static Real64 Ulps(Float _value, Real64 _exact) {
+	Float  f;
+	Real64 ulp;
+	f = fabsf((Float)_exact);
+	ulp = (f == 0.0f) ? (Real64)FLT_TRUE_MIN : 
+		(Real64)nextafterf(f, INFINITY) - (Real64)f;
+	return fabs((Real64)_value - _exact) / ulp;
+}
+
+
+/*
+@return: Z_TRUE if _value matches the C library's _expected: both NaN,
+or the same sign bit and at most 1 ULP apart*/
+static Bool Same(Float _value, Float _expected) {
+	if (isnan(_expected) || isnan(_value))
+		return isnan(_expected) && isnan(_value);
+	if (signbit(_value) != signbit(_expected))
+		return Z_FALSE;
+	if (isinf(_expected) || isinf(_value))
+		return _value == _expected;
+	return Ulps(_value, (Real64)_expected) <= 1.0;
+}
+
+
+Void TestUnit_Module_ZMathArray(int argc, char** argv) {
+	static const Float specials[] = {
+		0.0f, -0.0f, 1.0f, -1.0f, 1.6e8f, -2.6e9f, 1e30f, -FLT_MAX, 
+		INFINITY, -INFINITY, NAN
+	};
+	Float *x, *y, *r1, *r2;
+	Real64 sinulp, cosulp, atanulp, expulp, logulp;
+	SizeT it, jt, count, bad, outside;
+	Z_Unused(argc);
+	Z_Unused(argv);
+
+	srand(1);
+	x  = (Float*)malloc(ZMATHARRAY_TEST_COUNT * sizeof(Float));
+	y  = (Float*)malloc(ZMATHARRAY_TEST_COUNT * sizeof(Float));
+	r1 = (Float*)malloc(ZMATHARRAY_TEST_COUNT * sizeof(Float));
+	r2 = (Float*)malloc(ZMATHARRAY_TEST_COUNT * sizeof(Float));
+	/*
+	accurate tier against the C library in double precision, within the
+	bounds of the precision table:*/
+	for (it = 0; it < ZMATHARRAY_TEST_COUNT; ++it) {
+		x[it] = RandomFloat(-ZMATH_PI, ZMATH_PI);
+		y[it] = RandomFloat(-100.0f, 100.0f);
+	}
+	ZMathArray_SinCos(x, r1, r2, ZMATHARRAY_TEST_COUNT, ZMATHARRAY_ACCURATE);
+	sinulp = cosulp = 0.0;
+	for (it = 0; it < ZMATHARRAY_TEST_COUNT; ++it) {
+		sinulp = Z_Max(sinulp, Ulps(r1[it], sin((Real64)x[it])));
+		cosulp = Z_Max(cosulp, Ulps(r2[it], cos((Real64)x[it])));
+	}
+	printf("sin, |x| <= pi: %.2f ULP %s\n", sinulp, 
+		sinulp <= 1.5 ? "ok" : "FAILED");
+	printf("cos, |x| <= pi: %.2f ULP %s\n", cosulp, 
+		cosulp <= 1.5 ? "ok" : "FAILED");
+	for (it = 0; it < ZMATHARRAY_TEST_COUNT; ++it)
+		x[it] = RandomFloat(-100.0f, 100.0f);
+	ZMathArray_Atan2(y, x, r1, ZMATHARRAY_TEST_COUNT, ZMATHARRAY_ACCURATE);
+	atanulp = 0.0;
+	for (it = 0; it < ZMATHARRAY_TEST_COUNT; ++it) {
+		atanulp = Z_Max(atanulp, 
+			Ulps(r1[it], atan2((Real64)y[it], (Real64)x[it])));
+	}
+	printf("atan2: %.2f ULP %s\n", atanulp, atanulp <= 3.1 ? "ok" : "FAILED");
+	for (it = 0; it < ZMATHARRAY_TEST_COUNT; ++it)
+		x[it] = RandomFloat(-87.0f, 88.0f);
+	ZMathArray_Exp(x, r1, ZMATHARRAY_TEST_COUNT, ZMATHARRAY_ACCURATE);
+	expulp = 0.0;
+	for (it = 0; it < ZMATHARRAY_TEST_COUNT; ++it)
+		expulp = Z_Max(expulp, Ulps(r1[it], exp((Real64)x[it])));
+	printf("exp: %.2f ULP %s\n", expulp, expulp <= 1.3 ? "ok" : "FAILED");
+	for (it = 0; it < ZMATHARRAY_TEST_COUNT; ++it)
+		x[it] = ldexpf(RandomFloat(1.0f, 2.0f), rand() % 250 - 125);
+	ZMathArray_Log(x, r1, ZMATHARRAY_TEST_COUNT, ZMATHARRAY_ACCURATE);
+	logulp = 0.0;
+	for (it = 0; it < ZMATHARRAY_TEST_COUNT; ++it)
+		logulp = Z_Max(logulp, Ulps(r1[it], log((Real64)x[it])));
+	printf("log: %.2f ULP %s\n", logulp, logulp <= 0.9 ? "ok" : "FAILED");
+	/*
+	large arguments: sine and cosine stay within [-1, 1] in both tiers
+	and match the C library in the accurate one:*/
+	for (it = 0; it < ZMATHARRAY_TEST_COUNT; ++it) {
+		x[it] = ldexpf(RandomFloat(1.0f, 2.0f), rand() % 128);
+		x[it] = (rand() & 1) ? -x[it] : x[it];
+	}
+	outside = bad = 0;
+	for (jt = 0; jt < 2; ++jt) {
+		ZMathArray_SinCos(x, r1, r2, ZMATHARRAY_TEST_COUNT, 
+			jt ? ZMATHARRAY_FAST : ZMATHARRAY_ACCURATE);
+		for (it = 0; it < ZMATHARRAY_TEST_COUNT; ++it) {
+			if (!(fabsf(r1[it]) <= 1.0f && fabsf(r2[it]) <= 1.0f))
+				outside++;
+			if (jt == 0 && fabsf(x[it]) > 8192.0f && 
+				(r1[it] != sinf(x[it]) || r2[it] != cosf(x[it])))
+				bad++;
+		}
+	}
+	printf("sin, cos, |x| < 2^129: %zu outside [-1, 1] %s\n", 
+		(size_t)outside, outside ? "FAILED" : "ok");
+	printf("sin, cos, |x| > 8192: %zu unlike sinf, cosf %s\n", 
+		(size_t)bad, bad ? "FAILED" : "ok");
+	/*
+	special values against the C library, signed zeros included; atan2 
+	takes every pair of them, the fast tier only the finite ones with a
+	zero:*/
+	count = Z_ArraySize(specials);
+	bad = 0;
+	ZMathArray_SinCos(specials, r1, r2, count, ZMATHARRAY_ACCURATE);
+	for (it = 0; it < count; ++it) {
+		bad += !Same(r1[it], sinf(specials[it]));
+		bad += !Same(r2[it], cosf(specials[it]));
+	}
+	ZMathArray_Exp(specials, r1, count, ZMATHARRAY_ACCURATE);
+	for (it = 0; it < count; ++it)
+		bad += !Same(r1[it], expf(specials[it]));
+	ZMathArray_Log(specials, r1, count, ZMATHARRAY_ACCURATE);
+	for (it = 0; it < count; ++it)
+		bad += !Same(r1[it], logf(specials[it]));
+	for (it = 0; it < count; ++it) {
+		for (jt = 0; jt < count; ++jt) {
+			x[it * count + jt] = specials[jt];
+			y[it * count + jt] = specials[it];
+		}
+	}
+	ZMathArray_Atan2(y, x, r1, count * count, ZMATHARRAY_ACCURATE);
+	for (it = 0; it < count * count; ++it)
+		bad += !Same(r1[it], atan2f(y[it], x[it]));
+	ZMathArray_Atan2(y, x, r1, count * count, ZMATHARRAY_FAST);
+	for (it = 0; it < count * count; ++it) {
+		if ((y[it] == 0.0f || x[it] == 0.0f) && 
+			isfinite(y[it]) && isfinite(x[it]))
+			bad += !Same(r1[it], atan2f(y[it], x[it]));
+	}
+	printf("special values: %zu unlike the C library %s\n", 
+		(size_t)bad, bad ? "FAILED" : "ok");
+	/*
+	cleanup:*/
+	free(r2);
+	free(r1);
+	free(y);
+	free(x);
+} 
+/*****************************************************************************/  
+//EOF
+/*****************************************************************************/  
@@ -0,0 +1,170 @@
+/******************************************************************************
+* zutil - C Utility Library
+* Copyright (C) 2017-2021 Zachary T Harris. All Rights Reserved.  
+* Zlib license.
+* 
+* File: testunit_module_zrectpack.c
+* Desc: rectangle packing benchmarks
+*******************************************************************************
+
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+******************************************************************************/ 
+#include <time.h>
+#include "zutil/zrectpack.h"
+#include "zutil_testunits.h" 
+
+
+
+#define ZRECTPACK_TEST_COUNT 30000
+#define ZRECTPACK_TEST_SIZE  2048
+
+
+
+static Float RandomFloat(Float _max) {
+	return (Float)rand() / (Float)RAND_MAX * _max;
+}
+
+
+static Real64 ElapsedMs(clock_t _start) {
+	return (Real64)(clock() - _start) * 1000.0 / CLOCKS_PER_SEC;
+}
+
+
+/*
+Mean occupancy of the pages closed so far in percent, or of the current
+page when it is the only one.*/
+static Real64 GetOccupancy(ZRectPack* _lpPack, Real64 _filled, SizeT _pages) {
+	if (_pages < 2)
+		return 100.0 * ZRectPack_GetOccupancy(_lpPack);
+	return 100.0 * _filled / (Real64)(_pages - 1);
+}
+
+
+/*
+Packs every rect into as many pages as it takes, a whole batch per page;
+the rects left over are carried to the next page. The occupancy printed
+is that of the full pages, as the last one is partly empty.*/
+static Void PackBatch(
+	ZRectPack* _lpPack, const ZRECT* _sizes, ZRECT* _rects, Lpcstr _name) {
+
+	clock_t start;
+	SizeT   it, left, kept, placed, pages;
+	Real64  filled;
+
+	memcpy(_rects, _sizes, ZRECTPACK_TEST_COUNT * sizeof(ZRECT));
+	left   = ZRECTPACK_TEST_COUNT;
+	pages  = 0;
+	filled = 0.0;
+	start  = clock();
+	while (left > 0) {
+		if (pages > 0)
+			filled += ZRectPack_GetOccupancy(_lpPack);
+		ZRectPack_Reset(_lpPack);
+		ZRectPack_InsertBatch(_lpPack, _rects, left, &placed);
+		pages++;
+		if (placed == 0)
+			break;
+		for (it = 0, kept = 0; it < left; ++it) {
+			if (_rects[it].x < 0)
+				_rects[kept++] = _rects[it];
+		}
+		left = kept;
+	}
+	printf("%s batch:       %zu pages, %.1f%% full, %.2f ms\n", _name,
+		(size_t)pages, GetOccupancy(_lpPack, filled, pages), ElapsedMs(start));
+}
+
+
+/*
+Packs the rects one at a time, in their original order, starting a new 
+page whenever one does not fit.*/
+static Void PackIncremental(
+	ZRectPack* _lpPack, const ZRECT* _sizes, ZRECT* _rects, Lpcstr _name) {
+
+	clock_t start;
+	SizeT   it, pages;
+	Real64  filled;
+
+	memcpy(_rects, _sizes, ZRECTPACK_TEST_COUNT * sizeof(ZRECT));
+	ZRectPack_Reset(_lpPack);
+	pages  = 1;
+	filled = 0.0;
+	start  = clock();
+	for (it = 0; it < ZRECTPACK_TEST_COUNT; ++it) {
+		if (ZRectPack_Insert(_lpPack, &_rects[it]) != Z_ERANGE)
+			continue;
+		filled += ZRectPack_GetOccupancy(_lpPack);
+		pages++;
+		ZRectPack_Reset(_lpPack);
+		ZRectPack_Insert(_lpPack, &_rects[it]);
+	}
+	printf("%s incremental: %zu pages, %.1f%% full, %.2f ms\n", _name,
+		(size_t)pages, GetOccupancy(_lpPack, filled, pages), ElapsedMs(start));
+}
+
+
+
+Void TestUnit_Module_ZRectPack(int argc, char** argv) { 
+	ZRECT*     sizes;
+	ZRECT*     rects;
+	ZRectPack* skyline;
+	ZRectPack* maxrects;
+	SizeT      it;
+	Z_Unused(argc);
+	Z_Unused(argv);
+
+	sizes    = (ZRECT*)malloc(ZRECTPACK_TEST_COUNT * sizeof(ZRECT));
+	rects    = (ZRECT*)malloc(ZRECTPACK_TEST_COUNT * sizeof(ZRECT));
+	skyline  = ZRectPack_Create(ZRECTPACK_TEST_SIZE, ZRECTPACK_TEST_SIZE, 
+		ZRECTPACK_SKYLINE_BL, NULL);
+	maxrects = ZRectPack_Create(ZRECTPACK_TEST_SIZE, ZRECTPACK_TEST_SIZE,
+		ZRECTPACK_MAXRECTS_BSSF, NULL);
+	/*
+	glyphs 4 to 40 units wide and 8 to 48 units tall, 
+	with one sprite in a hundred up to 256 units on a side:*/
+	srand(1);
+	for (it = 0; it < ZRECTPACK_TEST_COUNT; ++it) {
+		sizes[it].x = 0.0f;
+		sizes[it].y = 0.0f;
+		if (it % 100 == 0) {
+			sizes[it].w = 32.0f + RandomFloat(224.0f);
+			sizes[it].h = 32.0f + RandomFloat(224.0f);
+		}
+		else {
+			sizes[it].w = 4.0f + RandomFloat(36.0f);
+			sizes[it].h = 8.0f + RandomFloat(40.0f);
+		}
+	}
+	printf("rects: %d, pages: %dx%d\n", 
+		ZRECTPACK_TEST_COUNT, ZRECTPACK_TEST_SIZE, ZRECTPACK_TEST_SIZE);
+	/*
+	sorted batches, then one rect at a time:*/
+	PackBatch(skyline, sizes, rects, "skyline ");
+	PackBatch(maxrects, sizes, rects, "maxrects");
+	PackIncremental(skyline, sizes, rects, "skyline ");
+	PackIncremental(maxrects, sizes, rects, "maxrects");
+	/*
+	cleanup:*/
+	ZRectPack_Release(maxrects);
+	ZRectPack_Release(skyline);
+	free(rects);
+	free(sizes);
+} 
+/*****************************************************************************/  
+//EOF
+/*****************************************************************************/  
@@ -0,0 +1,148 @@
+/******************************************************************************
+* zutil - C Utility Library
+* Copyright (C) 2017-2021 Zachary T Harris. All Rights Reserved.  
+* Zlib license.
+*
+* File: testunit_module_zspatial.c
+* Desc: spatial index benchmarks
+*******************************************************************************
+
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+******************************************************************************/ 
+#include <time.h>
+#include "zutil/zspatial.h"
+#include "zutil_testunits.h" 
+
+
+
+#define ZSPATIAL_TEST_COUNT 10000
+
+
+
+/*
+Counts a pair if it keeps the callback contract, _idA < _idB with the 
+NULL data given on insertion, so that a broken pair shows up as a 
+count unlike brute force*/
+static Bool CountPair(
+	Int32 _idA, Handle _hDataA, Int32 _idB, Handle _hDataB, Handle _hContext) {
+
+	if (_idA >= 0 && _idA < _idB && _hDataA == NULL && _hDataB == NULL)
+		++*(SizeT*)_hContext;
+	return Z_TRUE;
+}
+
+
+static Float RandomFloat(Float _max) {
+	return (Float)rand() / (Float)RAND_MAX * _max;
+}
+
+
+static Real64 ElapsedMs(clock_t _start) {
+	return (Real64)(clock() - _start) * 1000.0 / CLOCKS_PER_SEC;
+}
+
+
+
+Void TestUnit_Module_ZSpatial(int argc, char** argv) { 
+	ZRECT*        rects;
+	Int32*        gridIds;
+	Int32*        treeIds;
+	ZSpatialGrid* grid;
+	ZSpatialTree* tree;
+	clock_t       start;
+	SizeT         it, jt, brute, pairs;
+	Z_Unused(argc);
+	Z_Unused(argv);
+
+	rects   = (ZRECT*)malloc(ZSPATIAL_TEST_COUNT * sizeof(ZRECT));
+	gridIds = (Int32*)malloc(ZSPATIAL_TEST_COUNT * sizeof(Int32));
+	treeIds = (Int32*)malloc(ZSPATIAL_TEST_COUNT * sizeof(Int32));
+	grid  = ZSpatialGrid_Create(16.0f, ZSPATIAL_TEST_COUNT, NULL);
+	tree  = ZSpatialTree_Create(2.0f, ZSPATIAL_TEST_COUNT, NULL);
+	/*
+	a 2000x2000 world of objects 2 to 12 units wide, 
+	with one object in a hundred up to 100 units wide:*/
+	srand(1);
+	for (it = 0; it < ZSPATIAL_TEST_COUNT; ++it) {
+		Float size = (it % 100 == 0) ? 100.0f : 12.0f;
+		rects[it].x = RandomFloat(2000.0f);
+		rects[it].y = RandomFloat(2000.0f);
+		rects[it].w = 2.0f + RandomFloat(size - 2.0f);
+		rects[it].h = 2.0f + RandomFloat(size - 2.0f);
+	}
+	printf("objects:   %d\n", ZSPATIAL_TEST_COUNT);
+	/*
+	brute force, every pair tested once:*/
+	brute = 0;
+	start = clock();
+	for (it = 0; it < ZSPATIAL_TEST_COUNT; ++it) {
+		for (jt = it + 1; jt < ZSPATIAL_TEST_COUNT; ++jt)
+			brute += ZRect_GetIntersection(&rects[it], &rects[jt], NULL);
+	}
+	printf("brute:     %zu pairs, %.2f ms\n", 
+		(size_t)brute, ElapsedMs(start));
+	/*
+	uniform grid, build and query:*/
+	pairs = 0;
+	start = clock();
+	for (it = 0; it < ZSPATIAL_TEST_COUNT; ++it)
+		gridIds[it] = ZSpatialGrid_Insert(grid, &rects[it], NULL);
+	ZSpatialGrid_QueryPairs(grid, CountPair, &pairs);
+	printf("grid:      %zu pairs, %.2f ms\n", 
+		(size_t)pairs, ElapsedMs(start));
+	/*
+	AABB tree, build and query:*/
+	pairs = 0;
+	start = clock();
+	for (it = 0; it < ZSPATIAL_TEST_COUNT; ++it)
+		treeIds[it] = ZSpatialTree_Insert(tree, &rects[it], NULL);
+	ZSpatialTree_QueryPairs(tree, CountPair, &pairs);
+	printf("tree:      %zu pairs, %.2f ms (height %d)\n", 
+		(size_t)pairs, ElapsedMs(start),
+		ZSpatialTree_GetHeight(tree));
+	/*
+	move every object a little, then query again:*/
+	for (it = 0; it < ZSPATIAL_TEST_COUNT; ++it) {
+		rects[it].x += RandomFloat(2.0f) - 1.0f;
+		rects[it].y += RandomFloat(2.0f) - 1.0f;
+	}
+	pairs = 0;
+	start = clock();
+	for (it = 0; it < ZSPATIAL_TEST_COUNT; ++it)
+		ZSpatialGrid_Update(grid, gridIds[it], &rects[it]);
+	ZSpatialGrid_QueryPairs(grid, CountPair, &pairs);
+	printf("grid move: %zu pairs, %.2f ms\n", 
+		(size_t)pairs, ElapsedMs(start));
+	pairs = 0;
+	start = clock();
+	for (it = 0; it < ZSPATIAL_TEST_COUNT; ++it)
+		ZSpatialTree_Update(tree, treeIds[it], &rects[it]);
+	ZSpatialTree_QueryPairs(tree, CountPair, &pairs);
+	printf("tree move: %zu pairs, %.2f ms\n", 
+		(size_t)pairs, ElapsedMs(start));
+	/*
+	cleanup:*/
+	ZSpatialTree_Release(tree);
+	ZSpatialGrid_Release(grid);
+	free(treeIds);
+	free(gridIds);
+	free(rects);
+} 
+/*****************************************************************************/  
+//EOF
+/*****************************************************************************/  
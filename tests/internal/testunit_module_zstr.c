@@ -0,0 +1,96 @@
+/******************************************************************************
+* zutil - C Utility Library
+* Copyright (C) 2017-2021 Zachary T Harris. All Rights Reserved.  
+* Zlib license.
+* 
+* File: testunit_module_zstr.c
+* Desc: length-tracked string tests
+*******************************************************************************
+
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+******************************************************************************/ 
+#include "zutil/zstr.h"
+#include "zutil_testunits.h" 
+
+
+
+#define ZSTR_TEST_ROUNDS 16
+
+
+
+/*
+@return: Z_TRUE if _str holds exactly the _len characters of _expected*/
+static Bool Equals(const ZSTR* _str, Lpcstr _expected, SizeT _len) {
+	return ZStr_Length(_str) == _len && 
+		!memcmp(ZStr_CStr(_str), _expected, _len) &&
+		ZStr_CStr(_str)[_len] == '\0';
+}
+
+
+Void TestUnit_Module_ZStr(int argc, char** argv) {
+	ZSTR     str;
+	ZSTRVIEW view;
+	Char*    expected;
+	SizeT    it, len, failed;
+	Z_Unused(argc);
+	Z_Unused(argv);
+
+	expected = (Char*)malloc((SizeT)3 << ZSTR_TEST_ROUNDS);
+	/*
+	append a string to itself until it doubles from inline storage 
+	well into the heap, each round moving the characters it reads:*/
+	failed = 0;
+	ZStr_InitN(&str, "abc", 3);
+	memcpy(expected, "abc", 3);
+	for (it = 0, len = 3; it < ZSTR_TEST_ROUNDS; ++it, len *= 2) {
+		memcpy(expected + len, expected, len);
+		ZStr_Append(&str, ZStr_CStr(&str), ZStr_Length(&str));
+		failed += !Equals(&str, expected, len * 2);
+	}
+	printf("self append, %d rounds: %zu failed %s\n", ZSTR_TEST_ROUNDS,
+		(size_t)failed, failed ? "FAILED" : "ok");
+	ZStr_Free(&str);
+	/*
+	append views and slices of the string to itself, across the move
+	from inline storage:*/
+	failed = 0;
+	ZStr_InitN(&str, "0123456789", 10);
+	view = ZStr_View(&str);
+	ZStr_Append(&str, view.lpData, view.iLength);
+	failed += !Equals(&str, "01234567890123456789", 20);
+	view = ZStr_Slice(&str, 2, 7);
+	ZStr_Append(&str, view.lpData, view.iLength);
+	failed += !Equals(&str, "0123456789012345678923456", 25);
+	view = ZStr_Slice(&str, 20, 25);
+	ZStr_Append(&str, view.lpData, view.iLength);
+	failed += !Equals(&str, "012345678901234567892345623456", 30);
+	/*
+	and assign a slice of the string to itself:*/
+	view = ZStr_Slice(&str, 5, 15);
+	ZStr_Assign(&str, view.lpData, view.iLength);
+	failed += !Equals(&str, "5678901234", 10);
+	printf("self view and slice: %zu failed %s\n", 
+		(size_t)failed, failed ? "FAILED" : "ok");
+	/*
+	cleanup:*/
+	ZStr_Free(&str);
+	free(expected);
+} 
+/*****************************************************************************/  
+//EOF
+/*****************************************************************************/  
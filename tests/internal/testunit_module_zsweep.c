@@ -0,0 +1,132 @@
+/******************************************************************************
+* zutil - C Utility Library
+* Copyright (C) 2017-2021 Zachary T Harris. All Rights Reserved.  
+* Zlib license.
+* 
+* File: testunit_module_zsweep.c
+* Desc: sort-and-sweep broadphase tests
+*******************************************************************************
+
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+******************************************************************************/ 
+#include "zutil/zsweep.h"
+#include "zutil_testunits.h" 
+
+
+
+#define ZSWEEP_TEST_COUNT  300
+#define ZSWEEP_TEST_FRAMES 200
+
+
+
+static Float RandomFloat(Float _max) {
+	return (Float)rand() / (Float)RAND_MAX * _max;
+}
+
+
+/*
+Checks the pairs of the broadphase, and the pairs followed through the
+added and removed lists in _tracked, against brute force.
+@return: the number of pairs that disagree*/
+static SizeT CheckPairs(
+	const ZSweep* _lpSweep, const ZRECT* _rects, Byte* _tracked) {
+
+	const ZSWEEPPAIR* pairs;
+	SizeT it, jt, count, brute, errors;
+	Bool  overlap;
+
+	errors = 0;
+	pairs  = ZSweep_GetRemoved(_lpSweep, &count);
+	for (it = 0; it < count; ++it)
+		_tracked[pairs[it].a * ZSWEEP_TEST_COUNT + pairs[it].b] = 0;
+	pairs = ZSweep_GetAdded(_lpSweep, &count);
+	for (it = 0; it < count; ++it)
+		_tracked[pairs[it].a * ZSWEEP_TEST_COUNT + pairs[it].b] = 1;
+	brute = 0;
+	for (it = 0; it < ZSWEEP_TEST_COUNT; ++it) {
+		for (jt = it + 1; jt < ZSWEEP_TEST_COUNT; ++jt) {
+			overlap = ZRect_GetIntersection(&_rects[it], &_rects[jt], NULL);
+			brute  += overlap;
+			if (ZSweep_IsOverlapping(_lpSweep, (Int32)it, (Int32)jt) != overlap ||
+				_tracked[it * ZSWEEP_TEST_COUNT + jt] != overlap)
+				++errors;
+		}
+	}
+	if (brute != ZSweep_GetPairCount(_lpSweep))
+		++errors;
+	return errors;
+}
+
+
+
+Void TestUnit_Module_ZSweep(int argc, char** argv) { 
+	ZRECT*  rects;
+	Byte*   tracked;
+	ZSweep* sweep;
+	SizeT   it, frame, errors;
+	Z_Unused(argc);
+	Z_Unused(argv);
+
+	rects   = (ZRECT*)malloc(ZSWEEP_TEST_COUNT * sizeof(ZRECT));
+	tracked = (Byte*)calloc(ZSWEEP_TEST_COUNT * ZSWEEP_TEST_COUNT, 1);
+	sweep   = ZSweep_Create(NULL);
+	/*
+	a 200x200 world of objects up to 20 units wide,
+	one in ten starting empty:*/
+	srand(1);
+	for (it = 0; it < ZSWEEP_TEST_COUNT; ++it) {
+		rects[it].x = RandomFloat(200.0f);
+		rects[it].y = RandomFloat(200.0f);
+		rects[it].w = (it % 10 == 0) ? 0.0f : 1.0f + RandomFloat(19.0f);
+		rects[it].h = 1.0f + RandomFloat(19.0f);
+	}
+	errors = 0;
+	for (frame = 0; frame < ZSWEEP_TEST_FRAMES; ++frame) {
+		ZSweep_Update(sweep, rects, ZSWEEP_TEST_COUNT);
+		errors += CheckPairs(sweep, rects, tracked);
+		/*
+		move every object a little, and shrink a few to zero width or
+		height in place or grow them back; once in a while toggle too 
+		many to follow one by one:*/
+		for (it = 0; it < ZSWEEP_TEST_COUNT; ++it) {
+			rects[it].x += RandomFloat(2.0f) - 1.0f;
+			rects[it].y += RandomFloat(2.0f) - 1.0f;
+			if (rand() % ((frame % 50 == 49) ? 2 : 100) != 0)
+				continue;
+			if (rects[it].w == 0.0f)
+				rects[it].w = 1.0f + RandomFloat(19.0f);
+			else if (rects[it].h == 0.0f)
+				rects[it].h = 1.0f + RandomFloat(19.0f);
+			else if (rand() & 1)
+				rects[it].w = 0.0f;
+			else
+				rects[it].h = 0.0f;
+		}
+	}
+	printf("objects: %d, frames: %d, mismatched pairs: %zu %s\n",
+		ZSWEEP_TEST_COUNT, ZSWEEP_TEST_FRAMES, (size_t)errors, 
+		errors ? "FAILED" : "ok");
+	/*
+	cleanup:*/
+	ZSweep_Release(sweep);
+	free(tracked);
+	free(rects);
+} 
+/*****************************************************************************/  
+//EOF
+/*****************************************************************************/  
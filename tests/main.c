@@ -33,6 +33,12 @@ const TESTUNIT s_module[] = {
 	{ "TestUnit Module: ZBase64",  TestUnit_Module_ZBase64  },
 	{ "TestUnit Module: ZLog",     TestUnit_Module_ZLog     }, 
 	{ "TestUnit Module: ZThreads", TestUnit_Module_ZThreads }, 
+	{ "TestUnit Module: ZSpatial", TestUnit_Module_ZSpatial },
+	{ "TestUnit Module: ZRectPack", TestUnit_Module_ZRectPack },
+	{ "TestUnit Module: ZIconV",   TestUnit_Module_ZIconV   },
+	{ "TestUnit Module: ZSweep",   TestUnit_Module_ZSweep   },
+	{ "TestUnit Module: ZMathArray", TestUnit_Module_ZMathArray },
+	{ "TestUnit Module: ZStr",     TestUnit_Module_ZStr     },
     { NULL,                                                 }
 }; 
 
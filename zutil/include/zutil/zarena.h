@@ -0,0 +1,155 @@
+/******************************************************************************
+* zutil - C Utility Library
+* Copyright (C) 2017-2021 Zachary T Harris. All Rights Reserved.  
+* Zlib license.
+* 
+* File: zarena.h
+* Desc: bump-pointer arena allocator with savepoints
+*******************************************************************************
+
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+******************************************************************************/ 
+#ifndef __ZARENA_H__
+#define __ZARENA_H__
+
+#include "zcore.h"
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+
+
+#define ZARENA_ALIGN      16         //default alignment of allocations
+#define ZARENA_CHUNK_SIZE 0x10000    //default chunk size and commit step
+#define ZARENA_RESERVE    0x10000000 //default address space reserved
+
+/*
+flags used to specify where an arena takes its memory from*/
+typedef enum {
+	ZARENA_DEFAULT = 0x00, //chunks chained from the heap
+	ZARENA_VIRTUAL = 0x01, //one reserved range, committed as it fills
+} ZARENAFLAGS;
+
+/*
+A bump-pointer allocator. Each allocation advances a cursor through 
+the current block of memory, and nothing is freed on its own: the 
+memory is given back all at once by ZArena_Reset, or back to a 
+savepoint by ZArena_Rewind, both in constant time. This suits the
+temporaries of a request or a frame, which share one lifetime.
+
+A default arena chains heap chunks. The chunks are kept on reset and 
+reused by later allocations, so a reused arena stops calling malloc
+once it has grown to its working size. A ZARENA_VIRTUAL arena reserves
+a range of address space up front and commits pages as it fills, so its
+memory is contiguous and never moves, but it cannot outgrow the range.
+
+An arena is not thread-safe, use one per thread.*/
+typedef struct _ZArena ZArena;
+
+/*
+A savepoint of an arena, taken by ZArena_Mark*/
+typedef struct _ZARENAMARK {
+	Void* lpChunk; //chunk being filled
+	SizeT iUsed;   //bytes used in that chunk
+	SizeT iFilled; //bytes used in the chunks before it
+} ZARENAMARK;
+
+/*
+Allocates an object of the given type from an arena*/
+#define ZArena_New(lpArena, type)\
+  ((type*)ZArena_Alloc(lpArena, sizeof(type), ALIGNOF(type)))
+
+
+
+
+
+/*
+Create an empty arena.
+@_eFlags  : ZARENA_DEFAULT or ZARENA_VIRTUAL
+@_size    : the chunk size of a default arena, or the bytes of address
+            space a virtual arena reserves; 0 picks ZARENA_CHUNK_SIZE
+            or ZARENA_RESERVE
+@_lpResult: Z_OK on success, non-zero on failure (optional, can be NULL)
+@return   : an allocated arena, or NULL on failure
+            !must call ZArena_Release when finished using it!*/
+extern ZArena* ZAPI
+ZArena_Create(
+	_In_        ZARENAFLAGS _eFlags,
+	_In_        SizeT       _size,
+	_Inout_opt_ ZRESULT*    _lpResult);
+
+/*
+Destroy an arena, invalidating every allocation made from it.
+@_lpArena: the arena to destroy*/
+extern Void ZAPI
+ZArena_Release(
+	_Inout_ ZArena* _lpArena);
+
+/*
+Allocates uninitialized memory from an arena.
+@_lpArena: the arena
+@_size   : number of bytes, may be 0
+@_align  : alignment in bytes, a power of two, or 0 for ZARENA_ALIGN
+@return  : the memory, or NULL if it could not be allocated or 
+           _align is not a power of two*/
+extern Void* ZAPI
+ZArena_Alloc(
+	_Inout_ ZArena* _lpArena,
+	_In_    SizeT   _size,
+	_In_    SizeT   _align);
+
+/*
+Takes a savepoint of an arena.
+@_lpArena: the arena
+@return  : the savepoint, to pass to ZArena_Rewind*/
+extern ZARENAMARK ZAPI
+ZArena_Mark(
+	_In_ const ZArena* _lpArena);
+
+/*
+Frees everything allocated since a savepoint, in constant time.
+Savepoints taken after _lpMark are invalidated.
+@_lpArena: the arena
+@_lpMark : a savepoint taken from this arena*/
+extern Void ZAPI
+ZArena_Rewind(
+	_Inout_ ZArena*           _lpArena,
+	_In_    const ZARENAMARK* _lpMark);
+
+/*
+Frees everything allocated from an arena, in constant time. 
+The memory is kept for the allocations that follow.
+@_lpArena: the arena to reset*/
+extern Void ZAPI
+ZArena_Reset(
+	_Inout_ ZArena* _lpArena);
+
+/*
+Returns the bytes allocated since the last reset, alignment included*/
+extern SizeT ZAPI
+ZArena_GetUsed(
+	_In_ const ZArena* _lpArena);
+
+
+
+#if defined(__cplusplus)
+}
+#endif
+/*****************************************************************************/  
+#endif //EOF
+/*****************************************************************************/  
@@ -0,0 +1,132 @@
+/******************************************************************************
+* zutil - C Utility Library
+* Copyright (C) 2017-2021 Zachary T Harris. All Rights Reserved.  
+* Zlib license.
+* 
+* File: zbezier.h
+* Desc: adaptive flattening of quadratic and cubic Bezier curves
+*******************************************************************************
+
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+******************************************************************************/ 
+#ifndef __ZBEZIER_H__
+#define __ZBEZIER_H__
+
+#include "zvec2.h"
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+
+
+#define ZBEZIER_MAXSEGMENTS 65536 //segments a curve is flattened into at most
+
+/*
+A quadratic or cubic Bezier curve. As with ZVec2_BezierCurve3/4 the
+order is the number of control points.*/
+typedef struct _ZBEZIER {
+	ZVEC2 p[4];   //control points, p[3] is unused by quadratics
+	Int32 iOrder; //3 for a quadratic, 4 for a cubic
+} ZBEZIER;
+
+
+
+/*
+Flattening:
+******************************************************************************/
+/*
+Flattening replaces a curve by a polyline whose points lie on the 
+curve, starting at its first control point and ending at its last,
+such that no point of the curve is farther than the tolerance from 
+the polyline. The number of segments over a stretch of the curve 
+comes from the largest second derivative over it, the bound behind 
+Wang's formula. Quadratics have a constant second derivative and are
+split evenly; cubics are split evenly within each quarter of their 
+parameter range, so flat stretches take fewer segments than bends.
+No curve is cut into more than ZBEZIER_MAXSEGMENTS segments, even if
+a huge curve then misses the tolerance.
+
+The functions return the number of points of the polyline, and write
+as many of them as fit in _capacity; pass a NULL buffer and a zero
+capacity to size the buffer first. The tolerance is in the units of 
+the control points and must be positive, otherwise nothing is written
+and 0 is returned.*/
+
+/*
+Flattens a quadratic curve.
+@_v0, _v1, _v2: the control points
+@_tolerance   : the largest distance allowed from the curve
+@_out         : receives the points, may be NULL if _capacity is 0
+@_capacity    : number of points _out can hold
+@return       : number of points in the polyline, at least 2*/
+extern SizeT ZAPI
+ZBezier_Flatten3(
+	_In_        const ZVEC2* _v0,
+	_In_        const ZVEC2* _v1,
+	_In_        const ZVEC2* _v2,
+	_In_        Float        _tolerance,
+	_Inout_opt_ ZVEC2*       _out,
+	_In_        SizeT        _capacity);
+
+/*
+Flattens a cubic curve.
+@_v0.._v3 : the control points
+@_tolerance: the largest distance allowed from the curve
+@_out      : receives the points, may be NULL if _capacity is 0
+@_capacity : number of points _out can hold
+@return    : number of points in the polyline, at least 2*/
+extern SizeT ZAPI
+ZBezier_Flatten4(
+	_In_        const ZVEC2* _v0,
+	_In_        const ZVEC2* _v1,
+	_In_        const ZVEC2* _v2,
+	_In_        const ZVEC2* _v3,
+	_In_        Float        _tolerance,
+	_Inout_opt_ ZVEC2*       _out,
+	_In_        SizeT        _capacity);
+
+/*
+Flattens an array of curves into one buffer, one polyline after the
+other: the polyline of curve i is _out[_offsets[i]] up to 
+_out[_offsets[i + 1] - 1]. Curves joined end to start, as along a 
+path, each keep their own copy of the shared point. Curves of an 
+order other than 3 or 4 produce no points.
+@_curves   : the curves to flatten
+@_count    : number of curves
+@_tolerance: the largest distance allowed from each curve
+@_out      : receives the points, may be NULL if _capacity is 0
+@_capacity : number of points _out can hold
+@_offsets  : optional, receives _count + 1 point indices
+@return    : number of points written to a large enough buffer*/
+extern SizeT ZAPI
+ZBezier_FlattenArray(
+	_In_        const ZBEZIER* _curves,
+	_In_        SizeT          _count,
+	_In_        Float          _tolerance,
+	_Inout_opt_ ZVEC2*         _out,
+	_In_        SizeT          _capacity,
+	_Inout_opt_ SizeT*         _offsets);
+
+
+
+#if defined(__cplusplus)
+}
+#endif
+/*****************************************************************************/  
+#endif //EOF
+/*****************************************************************************/  
@@ -0,0 +1,299 @@
+/******************************************************************************
+* zutil - C Utility Library
+* Copyright (C) 2017-2021 Zachary T Harris. All Rights Reserved.  
+* Zlib license.
+* 
+* File: zbitset.h
+* Desc: bitsets with vectorized set operations, iteration and rank/select
+*******************************************************************************
+
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+******************************************************************************/ 
+#ifndef __ZBITSET_H__
+#define __ZBITSET_H__
+
+#include "zcore.h"
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+
+
+#define ZBITSET_NONE        ((SizeT)-1) //returned when no bit is found
+#define ZBITSET_WORDS(bits) (((bits) + 63) / 64)
+
+/*
+A set of bits, stored as 64-bit words: bit i is bit (i % 64) of word
+(i / 64). The bits past the count in the last word are always clear,
+so counts and searches never see them. A bitset either owns its words
+or runs on caller storage (see ZBitset_InitFixed), and grows into an
+allocation of its own only when resized past that storage. A zero 
+filled ZBITSET is a valid empty set.
+
+Operations over whole sets handle 128 or 256 bits per instruction 
+where SSE2, AVX2 or NEON is available.*/
+typedef struct _ZBITSET {
+	Uint64* lpWords;   //the bits
+	SizeT   iCount;    //number of bits
+	SizeT   iCapacity; //bits that fit without reallocating
+	Void*   lpBlock;   //allocation holding the words, NULL on caller storage
+} ZBITSET;
+
+/*
+A rank directory over a bitset: the number of set bits before each 
+block of ZBITSETRANK_BLOCK bits. It makes ZBitsetRank_Rank a constant 
+time lookup and ZBitsetRank_Select a binary search, where the 
+ZBitset versions scan the set. The directory describes the set as it
+was when built and must be rebuilt after the set changes.*/
+typedef struct _ZBITSETRANK {
+	SizeT* lpCounts; //iBlocks + 1 running counts
+	SizeT  iBlocks;  //number of blocks
+} ZBITSETRANK;
+
+#define ZBITSETRANK_BLOCK 512
+
+
+
+/*
+Element access:
+******************************************************************************/
+static FORCEINLINE Bool
+ZBitset_Test(
+	_In_ const ZBITSET* _set,
+	_In_ SizeT          _index) {
+
+	return (Bool)((_set->lpWords[_index / 64] >> (_index % 64)) & 1);
+}
+
+static FORCEINLINE Void
+ZBitset_Set(
+	_Inout_ ZBITSET* _set,
+	_In_    SizeT    _index) {
+
+	_set->lpWords[_index / 64] |= 1ull << (_index % 64);
+}
+
+static FORCEINLINE Void
+ZBitset_Clear(
+	_Inout_ ZBITSET* _set,
+	_In_    SizeT    _index) {
+
+	_set->lpWords[_index / 64] &= ~(1ull << (_index % 64));
+}
+
+
+
+/*
+Lifetime:
+******************************************************************************/
+/*
+Initializes a set of _count clear bits.
+@_set  : the set to initialize
+@_count: number of bits, may be 0
+@return: Z_OK, or Z_EOUTOFMEMORY (_set is then left empty)*/
+extern ZRESULT ZAPI
+ZBitset_Init(
+	_Out_ ZBITSET* _set,
+	_In_  SizeT    _count);
+
+/*
+Initializes a set of _count clear bits over caller storage, for sets
+of a fixed size that should not allocate. The storage is cleared and
+must outlive the set, or until a resize moves the set off it.
+@_set  : the set to initialize
+@_words: ZBITSET_WORDS(_count) words of storage
+@_count: number of bits*/
+extern Void ZAPI
+ZBitset_InitFixed(
+	_Out_   ZBITSET* _set,
+	_Inout_ Uint64*  _words,
+	_In_    SizeT    _count);
+
+/*
+Releases the memory owned by a set and leaves it empty.
+@_set: the set to release*/
+extern Void ZAPI
+ZBitset_Free(
+	_Inout_ ZBITSET* _set);
+
+/*
+Sets the number of bits, keeping the existing ones. 
+Bits added at the end are clear.
+@_set  : the set to resize
+@_count: the new number of bits
+@return: Z_OK, or Z_EOUTOFMEMORY (the set is left unchanged)*/
+extern ZRESULT ZAPI
+ZBitset_Resize(
+	_Inout_ ZBITSET* _set,
+	_In_    SizeT    _count);
+
+/*
+Sets or clears a range of bits.
+@_set   : the set
+@_first : the first bit of the range
+@_count : number of bits, the range must lie within the set
+@_value : true to set the bits, false to clear them*/
+extern Void ZAPI
+ZBitset_SetRange(
+	_Inout_ ZBITSET* _set,
+	_In_    SizeT    _first,
+	_In_    SizeT    _count,
+	_In_    Bool     _value);
+
+
+
+/*
+Set operations:
+******************************************************************************/
+/*
+Combine two sets of the same count bit by bit. _dst may be _a or _b,
+otherwise it is resized to the count of the sources.
+@return: Z_OK, Z_EINVALIDARG if the counts differ, or Z_EOUTOFMEMORY*/
+extern ZRESULT ZAPI
+ZBitset_And(
+	_Inout_ ZBITSET*       _dst,
+	_In_    const ZBITSET* _a,
+	_In_    const ZBITSET* _b);
+
+extern ZRESULT ZAPI
+ZBitset_Or(
+	_Inout_ ZBITSET*       _dst,
+	_In_    const ZBITSET* _a,
+	_In_    const ZBITSET* _b);
+
+extern ZRESULT ZAPI
+ZBitset_Xor(
+	_Inout_ ZBITSET*       _dst,
+	_In_    const ZBITSET* _a,
+	_In_    const ZBITSET* _b);
+
+/*
+_a and not _b: the bits of _a that are clear in _b*/
+extern ZRESULT ZAPI
+ZBitset_AndNot(
+	_Inout_ ZBITSET*       _dst,
+	_In_    const ZBITSET* _a,
+	_In_    const ZBITSET* _b);
+
+/*
+Inverts every bit of a set. _dst may be _a.
+@return: Z_OK, or Z_EOUTOFMEMORY*/
+extern ZRESULT ZAPI
+ZBitset_Not(
+	_Inout_ ZBITSET*       _dst,
+	_In_    const ZBITSET* _a);
+
+
+
+/*
+Counting and searching:
+******************************************************************************/
+/*
+Counts the set bits*/
+extern SizeT ZAPI
+ZBitset_Count(
+	_In_ const ZBITSET* _set);
+
+/*
+Finds the first set bit at or after a position. The set bits are 
+visited in order by
+	for (i = ZBitset_FindNext(s, 0); i != ZBITSET_NONE; 
+		i = ZBitset_FindNext(s, i + 1))
+@_set  : the set to search
+@_from : the first bit to look at, may be past the end
+@return: the index of the bit, or ZBITSET_NONE*/
+extern SizeT ZAPI
+ZBitset_FindNext(
+	_In_ const ZBITSET* _set,
+	_In_ SizeT          _from);
+
+/*
+Finds the first clear bit at or after a position, 
+such as a free slot in an allocation map.
+@return: the index of the bit, or ZBITSET_NONE*/
+extern SizeT ZAPI
+ZBitset_FindNextClear(
+	_In_ const ZBITSET* _set,
+	_In_ SizeT          _from);
+
+/*
+Counts the set bits below a position.
+@_set  : the set
+@_index: the position, at most the count of the set
+@return: number of set bits before _index*/
+extern SizeT ZAPI
+ZBitset_Rank(
+	_In_ const ZBITSET* _set,
+	_In_ SizeT          _index);
+
+/*
+Finds the set bit of a given rank, the inverse of ZBitset_Rank.
+@_set  : the set
+@_nth  : the rank of the bit, 0 for the first set bit
+@return: the index of the bit, or ZBITSET_NONE if there are not 
+         enough set bits*/
+extern SizeT ZAPI
+ZBitset_Select(
+	_In_ const ZBITSET* _set,
+	_In_ SizeT          _nth);
+
+
+
+/*
+Rank directory:
+******************************************************************************/
+/*
+Builds the rank directory of a set.
+@_rank : the directory to initialize
+@_set  : the set to index
+@return: Z_OK, or Z_EOUTOFMEMORY (_rank is then left empty)*/
+extern ZRESULT ZAPI
+ZBitsetRank_Init(
+	_Out_ ZBITSETRANK*   _rank,
+	_In_  const ZBITSET* _set);
+
+/*
+Releases a rank directory and leaves it empty*/
+extern Void ZAPI
+ZBitsetRank_Free(
+	_Inout_ ZBITSETRANK* _rank);
+
+/*
+As ZBitset_Rank, for the set the directory was built from*/
+extern SizeT ZAPI
+ZBitsetRank_Rank(
+	_In_ const ZBITSETRANK* _rank,
+	_In_ const ZBITSET*     _set,
+	_In_ SizeT              _index);
+
+/*
+As ZBitset_Select, for the set the directory was built from*/
+extern SizeT ZAPI
+ZBitsetRank_Select(
+	_In_ const ZBITSETRANK* _rank,
+	_In_ const ZBITSET*     _set,
+	_In_ SizeT              _nth);
+
+
+
+#if defined(__cplusplus)
+}
+#endif
+/*****************************************************************************/  
+#endif //EOF
+/*****************************************************************************/  
@@ -65,6 +65,22 @@ declaration specification helpers
 #define NOINLINEWEAK  __attribute__ ((noinline)) __attribute__((weak))
 #define NORETURN      __attribute__((__noreturn__)) 
  
+/*
+Bit scanning and counting. Z_CTZ and Z_CLZ are undefined for zero
+******************************************************************************/
+#define Z_POPCOUNT32(x) __builtin_popcount(x)
+#define Z_POPCOUNT64(x) __builtin_popcountll(x)
+#define Z_CTZ32(x)      __builtin_ctz(x)
+#define Z_CTZ64(x)      __builtin_ctzll(x)
+#define Z_CLZ32(x)      __builtin_clz(x)
+#define Z_CLZ64(x)      __builtin_clzll(x)
+#define Z_BSWAP32(x)    __builtin_bswap32(x)
+#define Z_BSWAP64(x)    __builtin_bswap64(x)
+#if defined(__clang__)
+#  define Z_BITREVERSE32(x) __builtin_bitreverse32(x)
+#  define Z_BITREVERSE64(x) __builtin_bitreverse64(x)
+#endif
+
 /*
 Disable/Enable specific compiler warnings. 
 ******************************************************************************/
@@ -65,6 +65,92 @@ declaration specification helpers
 #define NOINLINEWEAK  __declspec(noinline) inline
 #define NORETURN      __declspec(noreturn)
 
+/*
+Bit scanning and counting. Z_CTZ and Z_CLZ are undefined for zero.
+popcnt is only assumed where AVX2 is, all other x86 builds count in 
+registers.
+******************************************************************************/
+#include <intrin.h>
+
+static __forceinline int
+Z_MsvcCtz32(unsigned long x) {
+	unsigned long index;
+	_BitScanForward(&index, x);
+	return (int)index;
+}
+
+static __forceinline int
+Z_MsvcClz32(unsigned long x) {
+	unsigned long index;
+	_BitScanReverse(&index, x);
+	return 31 - (int)index;
+}
+
+static __forceinline int
+Z_MsvcCtz64(unsigned __int64 x) {
+	unsigned long index;
+#if (Z_ARCHITECTURE_X86_64 || Z_ARCHITECTURE_ARM_64)
+	_BitScanForward64(&index, x);
+#else
+	if (!_BitScanForward(&index, (unsigned long)x)) {
+		_BitScanForward(&index, (unsigned long)(x >> 32));
+		index += 32;
+	}
+#endif
+	return (int)index;
+}
+
+static __forceinline int
+Z_MsvcClz64(unsigned __int64 x) {
+	unsigned long index;
+#if (Z_ARCHITECTURE_X86_64 || Z_ARCHITECTURE_ARM_64)
+	_BitScanReverse64(&index, x);
+#else
+	if (_BitScanReverse(&index, (unsigned long)(x >> 32)))
+		index += 32;
+	else _BitScanReverse(&index, (unsigned long)x);
+#endif
+	return 63 - (int)index;
+}
+
+static __forceinline int
+Z_MsvcPopCount64(unsigned __int64 x) {
+#if (Z_ARCHITECTURE_ARM_64)
+	return (int)_CountOneBits64(x);
+#elif (Z_ARCHITECTURE_AVX2 && Z_ARCHITECTURE_X86_64)
+	return (int)__popcnt64(x);
+#elif (Z_ARCHITECTURE_AVX2)
+	return (int)(__popcnt((unsigned int)x) + __popcnt((unsigned int)(x >> 32)));
+#else
+	x = x - ((x >> 1) & 0x5555555555555555ull);
+	x = (x & 0x3333333333333333ull) + ((x >> 2) & 0x3333333333333333ull);
+	x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+	return (int)((x * 0x0101010101010101ull) >> 56);
+#endif
+}
+
+static __forceinline int
+Z_MsvcPopCount32(unsigned int x) {
+#if (Z_ARCHITECTURE_ARM_64)
+	return (int)_CountOneBits(x);
+#elif (Z_ARCHITECTURE_AVX2)
+	return (int)__popcnt(x);
+#else
+	x = x - ((x >> 1) & 0x55555555);
+	x = (x & 0x33333333) + ((x >> 2) & 0x33333333);
+	return (int)((((x + (x >> 4)) & 0x0F0F0F0F) * 0x01010101) >> 24);
+#endif
+}
+
+#define Z_POPCOUNT32(x) Z_MsvcPopCount32(x)
+#define Z_POPCOUNT64(x) Z_MsvcPopCount64(x)
+#define Z_CTZ32(x)      Z_MsvcCtz32(x)
+#define Z_CTZ64(x)      Z_MsvcCtz64(x)
+#define Z_CLZ32(x)      Z_MsvcClz32(x)
+#define Z_CLZ64(x)      Z_MsvcClz64(x)
+#define Z_BSWAP32(x)    _byteswap_ulong(x)
+#define Z_BSWAP64(x)    _byteswap_uint64(x)
+
 /*
 Disable/Enable specific compiler warnings. 
 ******************************************************************************/
@@ -0,0 +1,126 @@
+/******************************************************************************
+* zutil - C Utility Library
+* Copyright (C) 2017-2021 Zachary T Harris. All Rights Reserved.  
+* Zlib license.
+* 
+* File: zeasing.h
+* Desc: Batch evaluation of the ZMath easing curves
+*******************************************************************************
+
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+******************************************************************************/ 
+#ifndef __ZEASING_H__
+#define __ZEASING_H__
+
+#include "zmath.h"
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+
+
+/*
+A lookup table for one easing curve over [0, 1], sampled at iSize + 1
+evenly spaced points and read back by linear interpolation. Reads
+clamp their input to [0, 1]. A zero filled ZEASINGLUT is an empty 
+table that must be initialized before use.*/
+typedef struct _ZEASINGLUT {
+	ZMATH_EASING eEasing;   //the curve sampled
+	SizeT        iSize;     //number of intervals
+	Float        fMaxError; //largest measured difference from ZMath_Easing
+	Float*       lpTable;   //iSize + 1 samples
+} ZEASINGLUT;
+
+
+
+
+
+/*
+Evaluates one easing curve for an array of progress values, as
+ZMath_Easing without the per call switch. Each curve is computed 
+without branches, a vector at a time, with polynomial sine and 2^x 
+in place of sinf, cosf and powf; results stay within 1e-6 of 
+ZMath_Easing for progress values in [0, 1].
+@_eEasing: the easing curve
+@_src    : progress values, normally in [0, 1]
+@_dst    : receives the eased values, may be _src
+@_count  : number of values*/
+extern Void ZAPI
+ZEasing_Evaluate(
+	_In_  ZMATH_EASING _eEasing,
+	_In_  const Float* _src,
+	_Out_ Float*       _dst,
+	_In_  SizeT        _count);
+
+/*
+Builds a lookup table for an easing curve and measures its error 
+against ZMath_Easing at 64 points inside every interval. The error 
+falls with the square of the size on smooth curves, where 256 
+intervals keep it near 1e-4 or below. The circ curves (square root
+ends), the bounce curves (sharp bounces) and the elastic in-out curve
+(steps at 0.45 and 0.55) converge slowly and stay near 1e-2.
+@_lpLut  : the table to initialize
+@_eEasing: the easing curve
+@_size   : number of intervals, from 1 to 2^31 - 1
+@return  : Z_OK, Z_EINVALIDARG, or Z_EOUTOFMEMORY 
+           (_lpLut is then left empty)*/
+extern ZRESULT ZAPI
+ZEasingLut_Init(
+	_Out_ ZEASINGLUT*  _lpLut,
+	_In_  ZMATH_EASING _eEasing,
+	_In_  SizeT        _size);
+
+/*
+Releases the table of a lookup table, leaving it empty.
+@_lpLut: the table to free*/
+extern Void ZAPI
+ZEasingLut_Free(
+	_Inout_ ZEASINGLUT* _lpLut);
+
+/*
+Reads a lookup table at one progress value.
+@_lpLut: the table
+@_t    : progress value, clamped to [0, 1]
+@return: the interpolated eased value*/
+extern Float ZAPI
+ZEasingLut_Sample(
+	_In_ const ZEASINGLUT* _lpLut,
+	_In_ Float             _t);
+
+/*
+Reads a lookup table at an array of progress values, gathering 
+eight samples at a time with AVX2.
+@_lpLut: the table
+@_src  : progress values, clamped to [0, 1]
+@_dst  : receives the interpolated eased values, may be _src
+@_count: number of values*/
+extern Void ZAPI
+ZEasingLut_Evaluate(
+	_In_  const ZEASINGLUT* _lpLut,
+	_In_  const Float*      _src,
+	_Out_ Float*            _dst,
+	_In_  SizeT             _count);
+
+
+
+#if defined(__cplusplus)
+}
+#endif
+/*****************************************************************************/  
+#endif //EOF
+/*****************************************************************************/  
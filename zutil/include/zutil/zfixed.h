@@ -0,0 +1,770 @@
+/******************************************************************************
+* zutil - C Utility Library
+* Copyright (C) 2017-2021 Zachary T Harris. All Rights Reserved.  
+* Zlib license.
+* 
+* File: zfixed.h
+* Desc: deterministic Q16.16 and Q32.32 fixed-point vectors and rects
+*******************************************************************************
+
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+******************************************************************************/ 
+#ifndef __ZFIXED_H__
+#define __ZFIXED_H__
+
+#include "zrect.h"
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+
+
+/*
+Fixed-point counterparts of ZVEC2 and ZRECT for simulations that must
+give bit-identical results on every machine, such as lockstep games.
+Everything here is computed with integer arithmetic only, so results
+depend neither on the compiler, the floating-point mode, nor libm; the
+vector paths of the batch kernels give the same bits as the scalar code.
+
+ZFIXED is a signed Q16.16 number (16 integer and 16 fraction bits) and 
+ZFIXED64 a signed Q32.32 number. Products, quotients and square roots 
+are rounded to the nearest representable value, with ties rounded 
+toward positive infinity. Sums and products that leave the range of the
+format wrap around, as integers do; quotients, square roots and lengths
+saturate instead. The conversions from floating-point are the only 
+functions that touch the FPU, and are exact for values that fit.
+
+Angles are binary angles (ZANGLE): an unsigned 32-bit fraction of a 
+full turn, so that 2^32 is one turn and angle arithmetic wraps around 
+the circle for free.
+
+The code assumes two's complement integers and an arithmetic right 
+shift of negative values, as every supported compiler provides.*/
+typedef Int32  ZFIXED;   //Q16.16 fixed-point number
+typedef Int64  ZFIXED64; //Q32.32 fixed-point number
+typedef Uint32 ZANGLE;   //binary angle, 2^32 units per turn
+
+#define ZFIXED_SHIFT   16
+#define ZFIXED_ONE     ((ZFIXED)0x00010000)
+#define ZFIXED_HALF    ((ZFIXED)0x00008000)
+#define ZFIXED_MAX     ((ZFIXED)0x7FFFFFFF)
+#define ZFIXED_MIN     ((ZFIXED)(-ZFIXED_MAX - 1))
+
+#define ZFIXED64_SHIFT 32
+#define ZFIXED64_ONE   ((ZFIXED64)0x0000000100000000ll)
+#define ZFIXED64_HALF  ((ZFIXED64)0x0000000080000000ll)
+#define ZFIXED64_MAX   ((ZFIXED64)0x7FFFFFFFFFFFFFFFll)
+#define ZFIXED64_MIN   ((ZFIXED64)(-ZFIXED64_MAX - 1))
+
+#define ZANGLE_QUARTER ((ZANGLE)0x40000000u) //90 degrees
+#define ZANGLE_HALF    ((ZANGLE)0x80000000u) //180 degrees
+
+/*
+A Q16.16 vector, as ZVEC2*/
+typedef struct _ZFixedVector2D {
+	union {
+		struct {
+			ZFIXED x;
+			ZFIXED y;
+		};
+		ZFIXED v[2];
+	};
+} ZFVEC2;
+
+/*
+A Q16.16 rectangle, as ZRECT*/
+typedef struct _ZFixedRect {
+	union {
+		struct {
+			ZFIXED x;
+			ZFIXED y;
+			ZFIXED w;
+			ZFIXED h;
+		};
+		ZFIXED v[4];
+	};
+} ZFRECT;
+
+/*
+A Q32.32 vector, for coordinates beyond the +-32768 range of ZFVEC2*/
+typedef struct _ZLongFixedVector2D {
+	union {
+		struct {
+			ZFIXED64 x;
+			ZFIXED64 y;
+		};
+		ZFIXED64 v[2];
+	};
+} ZLVEC2;
+
+/*
+A Q32.32 rectangle*/
+typedef struct _ZLongFixedRect {
+	union {
+		struct {
+			ZFIXED64 x;
+			ZFIXED64 y;
+			ZFIXED64 w;
+			ZFIXED64 h;
+		};
+		ZFIXED64 v[4];
+	};
+} ZLRECT;
+
+
+
+/*
+Scalar arithmetic:
+******************************************************************************/
+static FORCEINLINE ZFIXED
+ZFixed_FromInt(
+	_In_ Int32 _value) {
+
+	return (ZFIXED)((Uint32)_value << ZFIXED_SHIFT);
+}
+
+/*
+Rounds toward negative infinity, as floor*/
+static FORCEINLINE Int32
+ZFixed_ToInt(
+	_In_ ZFIXED _value) {
+
+	return _value >> ZFIXED_SHIFT;
+}
+
+/*
+Rounds to the nearest integer, ties toward positive infinity*/
+static FORCEINLINE Int32
+ZFixed_Round(
+	_In_ ZFIXED _value) {
+
+	return (Int32)(((Int64)_value + ZFIXED_HALF) >> ZFIXED_SHIFT);
+}
+
+static FORCEINLINE ZFIXED
+ZFixed_Mul(
+	_In_ ZFIXED _a,
+	_In_ ZFIXED _b) {
+
+	return (ZFIXED)(((Int64)_a * _b + ZFIXED_HALF) >> ZFIXED_SHIFT);
+}
+
+static FORCEINLINE ZFIXED64
+ZFixed64_FromInt(
+	_In_ Int32 _value) {
+
+	return (ZFIXED64)((Uint64)(Int64)_value << ZFIXED64_SHIFT);
+}
+
+static FORCEINLINE Int64
+ZFixed64_ToInt(
+	_In_ ZFIXED64 _value) {
+
+	return _value >> ZFIXED64_SHIFT;
+}
+
+static FORCEINLINE ZFIXED64
+ZFixed64_FromFixed(
+	_In_ ZFIXED _value) {
+
+	return (ZFIXED64)((Uint64)(Int64)_value << 16);
+}
+
+/*
+Narrows to Q16.16, rounding to nearest; the integer part wraps*/
+static FORCEINLINE ZFIXED
+ZFixed64_ToFixed(
+	_In_ ZFIXED64 _value) {
+
+	return (ZFIXED)(Int64)(((Uint64)_value + 0x8000u) >> 16);
+}
+
+/*
+Converts a float, rounding to nearest and saturating at the range
+of the format. NaN converts to 0.*/
+extern ZFIXED ZAPI
+ZFixed_FromFloat(
+	_In_ Float _value);
+
+/*
+Converts to a float, rounding to the nearest float*/
+extern Float ZAPI
+ZFixed_ToFloat(
+	_In_ ZFIXED _value);
+
+/*
+Divides two numbers.
+@return: the rounded quotient, saturated at ZFIXED_MAX or ZFIXED_MIN 
+         when it is out of range or _b is 0 (0 / 0 gives 0)*/
+extern ZFIXED ZAPI
+ZFixed_Div(
+	_In_ ZFIXED _a,
+	_In_ ZFIXED _b);
+
+/*
+Computes a square root, rounded to nearest.
+@return: the root, or 0 if _value is negative*/
+extern ZFIXED ZAPI
+ZFixed_Sqrt(
+	_In_ ZFIXED _value);
+
+/*
+Converts a double, rounding to nearest and saturating at the range
+of the format. NaN converts to 0.*/
+extern ZFIXED64 ZAPI
+ZFixed64_FromReal64(
+	_In_ Real64 _value);
+
+/*
+Converts to a double, rounding to the nearest double*/
+extern Real64 ZAPI
+ZFixed64_ToReal64(
+	_In_ ZFIXED64 _value);
+
+/*
+Multiplies two Q32.32 numbers through a 128-bit product*/
+extern ZFIXED64 ZAPI
+ZFixed64_Mul(
+	_In_ ZFIXED64 _a,
+	_In_ ZFIXED64 _b);
+
+/*
+Divides two Q32.32 numbers, as ZFixed_Div*/
+extern ZFIXED64 ZAPI
+ZFixed64_Div(
+	_In_ ZFIXED64 _a,
+	_In_ ZFIXED64 _b);
+
+/*
+Computes a Q32.32 square root, as ZFixed_Sqrt*/
+extern ZFIXED64 ZAPI
+ZFixed64_Sqrt(
+	_In_ ZFIXED64 _value);
+
+
+
+/*
+Angles and trigonometry:
+******************************************************************************/
+/*
+Converts Q16.16 degrees to a binary angle, exactly rounded*/
+extern ZANGLE ZAPI
+ZAngle_FromDegrees(
+	_In_ ZFIXED _degrees);
+
+/*
+Converts Q16.16 radians to a binary angle*/
+extern ZANGLE ZAPI
+ZAngle_FromRadians(
+	_In_ ZFIXED _radians);
+
+/*
+Converts a binary angle to Q16.16 degrees in [-180, 180)*/
+extern ZFIXED ZAPI
+ZAngle_ToDegrees(
+	_In_ ZANGLE _angle);
+
+/*
+Converts a binary angle to Q16.16 radians in [-pi, pi)*/
+extern ZFIXED ZAPI
+ZAngle_ToRadians(
+	_In_ ZANGLE _angle);
+
+/*
+Computes a sine from a quarter-wave table with a third-order 
+correction. The error is within half a unit in the last place (2^-16),
+so the result is the nearest value but for rare near ties.*/
+extern ZFIXED ZAPI
+ZFixed_Sin(
+	_In_ ZANGLE _angle);
+
+/*
+Computes a cosine, as ZFixed_Sin*/
+extern ZFIXED ZAPI
+ZFixed_Cos(
+	_In_ ZANGLE _angle);
+
+/*
+Computes the direction of the vector (_x, _y), as atan2.
+The Q16.16 and Q32.32 versions share a 36-step CORDIC, and are 
+accurate to a few binary angle units (about 1e-9 radians).
+@return: the angle, or 0 for the zero vector*/
+extern ZANGLE ZAPI
+ZFixed_Atan2(
+	_In_ ZFIXED _y,
+	_In_ ZFIXED _x);
+
+/*
+Computes a Q32.32 sine and cosine together with a 36-step CORDIC.
+The error is within a few units in the last place (2^-32).
+@_angle: the angle
+@_sin  : receives the sine (optional, can be NULL)
+@_cos  : receives the cosine (optional, can be NULL)*/
+extern Void ZAPI
+ZFixed64_SinCos(
+	_In_        ZANGLE    _angle,
+	_Inout_opt_ ZFIXED64* _sin,
+	_Inout_opt_ ZFIXED64* _cos);
+
+/*
+Computes the direction of the vector (_x, _y), as ZFixed_Atan2*/
+extern ZANGLE ZAPI
+ZFixed64_Atan2(
+	_In_ ZFIXED64 _y,
+	_In_ ZFIXED64 _x);
+
+
+
+/*
+Q16.16 vectors:
+******************************************************************************/
+/*
+Converts a ZVEC2, as ZFixed_FromFloat*/
+extern ZFVEC2 ZAPI
+ZFVec2_FromVec2(
+	_In_ const ZVEC2* _v0);
+
+/*
+Converts to a ZVEC2, as ZFixed_ToFloat*/
+extern ZVEC2 ZAPI
+ZFVec2_ToVec2(
+	_In_ const ZFVEC2* _v0);
+
+extern ZFVEC2 ZAPI
+ZFVec2_Add(
+	_In_ const ZFVEC2* _v0,
+	_In_ const ZFVEC2* _v1);
+
+extern ZFVEC2 ZAPI
+ZFVec2_Sub(
+	_In_ const ZFVEC2* _v0,
+	_In_ const ZFVEC2* _v1);
+
+extern ZFVEC2 ZAPI
+ZFVec2_Scale(
+	_In_ const ZFVEC2* _v0,
+	_In_ ZFIXED        _scale);
+
+/*
+Computes the dot product with a single rounding*/
+extern ZFIXED ZAPI
+ZFVec2_DotProduct(
+	_In_ const ZFVEC2* _v0,
+	_In_ const ZFVEC2* _v1);
+
+/*
+Computes the z component of the cross product (_v0.x * _v1.y -
+_v0.y * _v1.x) with a single rounding. It is positive when _v1 is 
+clockwise from _v0 in y-down coordinates.*/
+extern ZFIXED ZAPI
+ZFVec2_CrossProduct(
+	_In_ const ZFVEC2* _v0,
+	_In_ const ZFVEC2* _v1);
+
+/*
+Computes the length from the exact sum of squares.
+@return: the rounded length, saturated at ZFIXED_MAX*/
+extern ZFIXED ZAPI
+ZFVec2_Length(
+	_In_ const ZFVEC2* _v0);
+
+/*
+Computes the distance between two points, as ZFVec2_Length*/
+extern ZFIXED ZAPI
+ZFVec2_Distance(
+	_In_ const ZFVEC2* _v0,
+	_In_ const ZFVEC2* _v1);
+
+/*
+Scales a vector to unit length.
+@return: the unit vector, or the zero vector for the zero vector*/
+extern ZFVEC2 ZAPI
+ZFVec2_Unit(
+	_In_ const ZFVEC2* _v0);
+
+/*
+Computes the direction of a vector, as ZFixed_Atan2*/
+extern ZANGLE ZAPI
+ZFVec2_Angle(
+	_In_ const ZFVEC2* _v0);
+
+/*
+Builds the vector of a given length and direction*/
+extern ZFVEC2 ZAPI
+ZFVec2_Rectangular(
+	_In_ ZFIXED _length,
+	_In_ ZANGLE _angle);
+
+/*
+Rotates a vector about the origin, with a single rounding per 
+component*/
+extern ZFVEC2 ZAPI
+ZFVec2_Rotation(
+	_In_ const ZFVEC2* _v0,
+	_In_ ZANGLE        _angle);
+
+/*
+Interpolates between two vectors, _t = 0 giving _v0 and 
+_t = ZFIXED_ONE giving _v1*/
+extern ZFVEC2 ZAPI
+ZFVec2_Lerp(
+	_In_ const ZFVEC2* _v0,
+	_In_ const ZFVEC2* _v1,
+	_In_ ZFIXED        _t);
+
+extern ZFVEC2 ZAPI
+ZFVec2_Min(
+	_In_ const ZFVEC2* _v0,
+	_In_ const ZFVEC2* _v1);
+
+extern ZFVEC2 ZAPI
+ZFVec2_Max(
+	_In_ const ZFVEC2* _v0,
+	_In_ const ZFVEC2* _v1);
+
+extern ZFVEC2 ZAPI
+ZFVec2_Floor(
+	_In_ const ZFVEC2* _v0);
+
+extern ZFVEC2 ZAPI
+ZFVec2_Ceil(
+	_In_ const ZFVEC2* _v0);
+
+/*
+Projects _v0 onto _v1.
+@return: the projection, or the zero vector if _v1 is zero*/
+extern ZFVEC2 ZAPI
+ZFVec2_Projection(
+	_In_ const ZFVEC2* _v0,
+	_In_ const ZFVEC2* _v1);
+
+/*
+Reflects _v0 about the line along the unit vector _normal, as 
+ZVec2_Reflection*/
+extern ZFVEC2 ZAPI
+ZFVec2_Reflection(
+	_In_ const ZFVEC2* _v0,
+	_In_ const ZFVEC2* _normal);
+
+/*
+Removes the component of _v0 along the unit vector _normal*/
+extern ZFVEC2 ZAPI
+ZFVec2_Slide(
+	_In_ const ZFVEC2* _v0,
+	_In_ const ZFVEC2* _normal);
+
+/*
+Returns the vector turned a quarter turn, as ZVec2_Tangent*/
+extern ZFVEC2 ZAPI
+ZFVec2_Tangent(
+	_In_ const ZFVEC2* _v0);
+
+
+
+/*
+Q16.16 rectangles:
+******************************************************************************/
+/*
+The rect functions follow their ZRect counterparts: rects may have a 
+negative width or height, rects overlap when their intersection has a 
+positive area, and rects contain the points on their left and top edges
+but not those on their right and bottom edges.*/
+extern ZFRECT ZAPI
+ZFRect_FromRect(
+	_In_ const ZRECT* _r0);
+
+extern ZRECT ZAPI
+ZFRect_ToRect(
+	_In_ const ZFRECT* _r0);
+
+extern Bool ZAPI
+ZFRect_IsEqual(
+	_In_ const ZFRECT* _r0,
+	_In_ const ZFRECT* _r1);
+
+extern ZFVEC2 ZAPI
+ZFRect_GetCenter(
+	_In_ const ZFRECT* _r0);
+
+extern ZFIXED ZAPI
+ZFRect_GetArea(
+	_In_ const ZFRECT* _r0);
+
+extern ZFIXED ZAPI
+ZFRect_GetRight(
+	_In_ const ZFRECT* _r0);
+
+extern ZFIXED ZAPI
+ZFRect_GetBottom(
+	_In_ const ZFRECT* _r0);
+
+extern Bool ZAPI
+ZFRect_ContainsPoint(
+	_In_ const ZFRECT* _r0,
+	_In_ ZFIXED        _x,
+	_In_ ZFIXED        _y);
+
+/*
+Tests whether _r1 lies inside _r0, edges included*/
+extern Bool ZAPI
+ZFRect_ContainsRect(
+	_In_ const ZFRECT* _r0,
+	_In_ const ZFRECT* _r1);
+
+/*
+Intersects two rects.
+@_out  : receives the intersection, or an empty rect at the origin
+         (optional, can be NULL)
+@return: true if the rects overlap*/
+extern Bool ZAPI
+ZFRect_GetIntersection(
+	_In_        const ZFRECT* _r0,
+	_In_        const ZFRECT* _r1,
+	_Inout_opt_ ZFRECT*       _out);
+
+/*
+Computes the bounding rect of two normalized rects*/
+extern ZFRECT ZAPI
+ZFRect_Merge(
+	_In_ const ZFRECT* _r0,
+	_In_ const ZFRECT* _r1);
+
+/*
+Flips a rect so that its width and height are not negative*/
+extern Void ZAPI
+ZFRect_Normalize(
+	_Inout_ ZFRECT* _r0);
+
+
+
+/*
+Q32.32 vectors and rectangles:
+******************************************************************************/
+/*
+These behave as their Q16.16 counterparts. Dot and cross products,
+lengths and distances are computed from exact 128-bit products.*/
+extern ZLVEC2 ZAPI
+ZLVec2_FromVec2(
+	_In_ const ZVEC2* _v0);
+
+extern ZVEC2 ZAPI
+ZLVec2_ToVec2(
+	_In_ const ZLVEC2* _v0);
+
+extern ZLVEC2 ZAPI
+ZLVec2_Add(
+	_In_ const ZLVEC2* _v0,
+	_In_ const ZLVEC2* _v1);
+
+extern ZLVEC2 ZAPI
+ZLVec2_Sub(
+	_In_ const ZLVEC2* _v0,
+	_In_ const ZLVEC2* _v1);
+
+extern ZLVEC2 ZAPI
+ZLVec2_Scale(
+	_In_ const ZLVEC2* _v0,
+	_In_ ZFIXED64      _scale);
+
+extern ZFIXED64 ZAPI
+ZLVec2_DotProduct(
+	_In_ const ZLVEC2* _v0,
+	_In_ const ZLVEC2* _v1);
+
+extern ZFIXED64 ZAPI
+ZLVec2_CrossProduct(
+	_In_ const ZLVEC2* _v0,
+	_In_ const ZLVEC2* _v1);
+
+extern ZFIXED64 ZAPI
+ZLVec2_Length(
+	_In_ const ZLVEC2* _v0);
+
+extern ZFIXED64 ZAPI
+ZLVec2_Distance(
+	_In_ const ZLVEC2* _v0,
+	_In_ const ZLVEC2* _v1);
+
+extern ZLVEC2 ZAPI
+ZLVec2_Unit(
+	_In_ const ZLVEC2* _v0);
+
+extern ZANGLE ZAPI
+ZLVec2_Angle(
+	_In_ const ZLVEC2* _v0);
+
+extern ZLVEC2 ZAPI
+ZLVec2_Rectangular(
+	_In_ ZFIXED64 _length,
+	_In_ ZANGLE   _angle);
+
+extern ZLVEC2 ZAPI
+ZLVec2_Rotation(
+	_In_ const ZLVEC2* _v0,
+	_In_ ZANGLE        _angle);
+
+extern ZLVEC2 ZAPI
+ZLVec2_Lerp(
+	_In_ const ZLVEC2* _v0,
+	_In_ const ZLVEC2* _v1,
+	_In_ ZFIXED64      _t);
+
+extern ZLVEC2 ZAPI
+ZLVec2_Min(
+	_In_ const ZLVEC2* _v0,
+	_In_ const ZLVEC2* _v1);
+
+extern ZLVEC2 ZAPI
+ZLVec2_Max(
+	_In_ const ZLVEC2* _v0,
+	_In_ const ZLVEC2* _v1);
+
+extern ZLVEC2 ZAPI
+ZLVec2_Floor(
+	_In_ const ZLVEC2* _v0);
+
+extern ZLVEC2 ZAPI
+ZLVec2_Ceil(
+	_In_ const ZLVEC2* _v0);
+
+extern ZLVEC2 ZAPI
+ZLVec2_Projection(
+	_In_ const ZLVEC2* _v0,
+	_In_ const ZLVEC2* _v1);
+
+extern ZLVEC2 ZAPI
+ZLVec2_Reflection(
+	_In_ const ZLVEC2* _v0,
+	_In_ const ZLVEC2* _normal);
+
+extern ZLVEC2 ZAPI
+ZLVec2_Slide(
+	_In_ const ZLVEC2* _v0,
+	_In_ const ZLVEC2* _normal);
+
+extern ZLVEC2 ZAPI
+ZLVec2_Tangent(
+	_In_ const ZLVEC2* _v0);
+
+extern ZLRECT ZAPI
+ZLRect_FromRect(
+	_In_ const ZRECT* _r0);
+
+extern ZRECT ZAPI
+ZLRect_ToRect(
+	_In_ const ZLRECT* _r0);
+
+extern Bool ZAPI
+ZLRect_IsEqual(
+	_In_ const ZLRECT* _r0,
+	_In_ const ZLRECT* _r1);
+
+extern ZLVEC2 ZAPI
+ZLRect_GetCenter(
+	_In_ const ZLRECT* _r0);
+
+extern ZFIXED64 ZAPI
+ZLRect_GetArea(
+	_In_ const ZLRECT* _r0);
+
+extern ZFIXED64 ZAPI
+ZLRect_GetRight(
+	_In_ const ZLRECT* _r0);
+
+extern ZFIXED64 ZAPI
+ZLRect_GetBottom(
+	_In_ const ZLRECT* _r0);
+
+extern Bool ZAPI
+ZLRect_ContainsPoint(
+	_In_ const ZLRECT* _r0,
+	_In_ ZFIXED64      _x,
+	_In_ ZFIXED64      _y);
+
+extern Bool ZAPI
+ZLRect_ContainsRect(
+	_In_ const ZLRECT* _r0,
+	_In_ const ZLRECT* _r1);
+
+extern Bool ZAPI
+ZLRect_GetIntersection(
+	_In_        const ZLRECT* _r0,
+	_In_        const ZLRECT* _r1,
+	_Inout_opt_ ZLRECT*       _out);
+
+extern ZLRECT ZAPI
+ZLRect_Merge(
+	_In_ const ZLRECT* _r0,
+	_In_ const ZLRECT* _r1);
+
+extern Void ZAPI
+ZLRect_Normalize(
+	_Inout_ ZLRECT* _r0);
+
+
+
+/*
+Batch kernels:
+******************************************************************************/
+/*
+Computes _dst[i] = _a[i] + _b[i] * _scale, as ZFVec2_Scale followed by
+ZFVec2_Add, eight components per instruction on AVX2 and four on NEON.
+This is the integration step of positions from velocities. _dst may be
+_a or _b.
+@_a    : the vectors to add to
+@_b    : the vectors to scale
+@_scale: the scale, e.g. the time step
+@_dst  : receives the results
+@_count: number of vectors*/
+extern Void ZAPI
+ZFVec2_MulAddArray(
+	_In_    const ZFVEC2* _a,
+	_In_    const ZFVEC2* _b,
+	_In_    ZFIXED        _scale,
+	_Inout_ ZFVEC2*       _dst,
+	_In_    SizeT         _count);
+
+/*
+Rotates an array of vectors about the origin, as ZFVec2_Rotation.
+_dst may be the same array as _src.*/
+extern Void ZAPI
+ZFVec2_RotateArray(
+	_In_    const ZFVEC2* _src,
+	_In_    ZANGLE        _angle,
+	_Inout_ ZFVEC2*       _dst,
+	_In_    SizeT         _count);
+
+/*
+Intersects each pair of rects, as ZFRect_GetIntersection.
+_dst may be _a or _b.
+@return: the number of pairs that overlap*/
+extern SizeT ZAPI
+ZFRect_IntersectArray(
+	_In_    const ZFRECT* _a,
+	_In_    const ZFRECT* _b,
+	_Inout_ ZFRECT*       _dst,
+	_In_    SizeT         _count);
+
+
+
+#if defined(__cplusplus)
+}
+#endif
+/*****************************************************************************/  
+#endif //EOF
+/*****************************************************************************/  
@@ -0,0 +1,125 @@
+/******************************************************************************
+* zutil - C Utility Library
+* Copyright (C) 2017-2021 Zachary T Harris. All Rights Reserved.  
+* Zlib license.
+* 
+* File: zformat.h
+* Desc: locale-independent number to text conversion
+*******************************************************************************
+
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+******************************************************************************/ 
+#ifndef __ZFORMAT_H__
+#define __ZFORMAT_H__
+
+#include "zcore.h"
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+
+
+#define ZFORMAT_INT_SIZE    21  //buffer size for any Int64/Uint64
+#define ZFORMAT_FLOAT_SIZE  32  //buffer size for shortest Float/Real64
+#define ZFORMAT_FIXED_SIZE  330 //buffer size for any fixed-decimal value
+#define ZFORMAT_MAX_DECIMAL 17  //largest number of fixed decimal places
+
+/*
+All functions write a null-terminated string into a caller provided
+buffer and return its length, excluding the terminator. The output does
+not depend on the current locale: the decimal point is always '.'.
+Non-finite values are written as "nan", "inf" and "-inf".*/
+
+
+
+/*
+Writes a signed integer in decimal.
+Digits are produced two at a time from a lookup table.
+@_value: the value to write
+@_dst  : the destination, at least ZFORMAT_INT_SIZE bytes
+@return: number of characters written*/
+extern SizeT ZAPI
+ZFormat_Int(
+	_In_    Int64 _value,
+	_Inout_ Char* _dst);
+
+/*
+Writes an unsigned integer in decimal.
+@_value: the value to write
+@_dst  : the destination, at least ZFORMAT_INT_SIZE bytes
+@return: number of characters written*/
+extern SizeT ZAPI
+ZFormat_Uint(
+	_In_    Uint64 _value,
+	_Inout_ Char*  _dst);
+
+/*
+Writes the shortest decimal string that reads back as exactly the same 
+double, choosing the closest such string when several have that length
+(the Ryu algorithm). Values whose decimal exponent lies in [-6, 21) are
+written in plain notation ("0.001", "1500"), others in exponent 
+notation ("1e+21", "2.5e-7").
+@_value: the value to write
+@_dst  : the destination, at least ZFORMAT_FLOAT_SIZE bytes
+@return: number of characters written*/
+extern SizeT ZAPI
+ZFormat_Double(
+	_In_    Real64 _value,
+	_Inout_ Char*  _dst);
+
+/*
+Writes the shortest decimal string that reads back as exactly the same 
+float, laid out as for ZFormat_Double.
+@_value: the value to write
+@_dst  : the destination, at least ZFORMAT_FLOAT_SIZE bytes
+@return: number of characters written*/
+extern SizeT ZAPI
+ZFormat_Float(
+	_In_    Float _value,
+	_Inout_ Char* _dst);
+
+/*
+Writes a double in plain notation with a fixed number of decimal places.
+The exact binary value is rounded half to even, as printf("%.*f") does.
+@_value    : the value to write
+@_decPlaces: number of decimal places (clamped to 0-ZFORMAT_MAX_DECIMAL)
+@_dst      : the destination, at least ZFORMAT_FIXED_SIZE bytes
+@return    : number of characters written*/
+extern SizeT ZAPI
+ZFormat_DoubleFixed(
+	_In_    Real64 _value,
+	_In_    Int32  _decPlaces,
+	_Inout_ Char*  _dst);
+
+/*
+Writes a float in plain notation with a fixed number of decimal places.
+@_value    : the value to write
+@_decPlaces: number of decimal places (clamped to 0-ZFORMAT_MAX_DECIMAL)
+@_dst      : the destination, at least ZFORMAT_FIXED_SIZE bytes
+@return    : number of characters written*/
+#define ZFormat_FloatFixed(value, decPlaces, dst)\
+  ZFormat_DoubleFixed((Real64)(value), decPlaces, dst)
+
+
+
+#if defined(__cplusplus)
+}
+#endif
+/*****************************************************************************/  
+#endif //EOF
+/*****************************************************************************/  
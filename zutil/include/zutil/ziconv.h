@@ -27,7 +27,7 @@ freely, subject to the following restrictions:
 #ifndef __ZICONV_H__
 #define __ZICONV_H__
 
-#include "zcore.h"
+#include "zarena.h"
 #if defined(__cplusplus)
 extern "C" {
 #endif
@@ -47,6 +47,16 @@ extern Int32 ZAPI
 ZIconV_Close(
 	_Inout_ ZIconV _lpIconV);
 
+/*
+Converts as much of the input buffer as fits into the output buffer,
+advancing both buffers and their byte counts past the converted data.
+The descriptor is stateful, so input may be fed in arbitrary pieces:
+a sequence cut off at the end of the input is held by the descriptor and
+completed on the next call, and the byte order of UTF-16/UTF-32 input is
+detected once from the leading marker and kept for later calls.
+Pass a NULL _inbuffer to reset the descriptor for a new stream.
+@return: number of characters converted, or Z_EICONVTOOBIG if
+         the output buffer is full*/
 extern SizeT ZAPI
 ZIconV_Init(
 	_Inout_ ZIconV  _lpIconV, 
@@ -56,8 +66,43 @@ ZIconV_Init(
     _In_    SizeT*  _outbytesleft);
 
 
+/*
+Computes the exact number of bytes ZIconV_ConvertBuffer writes for the
+given input, so callers can size their own buffers up front.
+@_lpSize: receives the converted size in bytes, excluding any terminator
+@return: Z_OK, or Z_EUNSUPPORTED if the encodings are unknown*/
+extern ZRESULT ZAPI
+ZIconV_GetConvertedSize(
+	_In_    Lpcstr _tocode,
+	_In_    Lpcstr _fromcode,
+	_In_    Lpcstr _inbuffer,
+	_In_    SizeT  _inbytesleft,
+	_Inout_ SizeT* _lpSize);
+
+/*
+Converts a string between encodings into a caller provided buffer
+without allocating. Descriptors are taken from a small per-thread cache
+keyed by the encoding names, so repeated conversions between the same
+encodings skip the lookup; the locale encoding ("") is resolved once
+per thread.
+@_lpWritten: optional, receives the number of bytes written
+@return: Z_OK, Z_EICONVTOOBIG if the output buffer is too small
+         (the buffer then holds the converted prefix),
+         or Z_EUNSUPPORTED if the encodings are unknown*/
+extern ZRESULT ZAPI
+ZIconV_ConvertBuffer(
+	_In_        Lpcstr _tocode,
+	_In_        Lpcstr _fromcode,
+	_In_        Lpcstr _inbuffer,
+	_In_        SizeT  _inbytesleft,
+	_Inout_     Char*  _outbuffer,
+	_In_        SizeT  _outbytesleft,
+	_Inout_opt_ SizeT* _lpWritten);
+
 /* 
 Converts a string between encodings, 
+the result is allocated once at its exact size and is followed
+by a zeroed terminator wide enough for any destination encoding.
 !WARNING! - This function returns a string allocated with malloc. 
             Caller is responsible for deallocating it with free.*/
 extern Char* ZAPI
@@ -67,6 +112,19 @@ ZIconV_ConvertString(
     _In_ Lpcstr _inbuffer,
     _In_ SizeT  _inbytesleft);
 
+/* 
+Converts a string between encodings as ZIconV_ConvertString, 
+into memory taken from an arena. Nothing is left allocated on failure.
+@_lpArena: the arena to allocate from
+@return  : the converted string, or NULL on failure*/
+extern Char* ZAPI
+ZIconV_ConvertStringArena(
+	_Inout_ ZArena* _lpArena,
+	_In_    Lpcstr  _tocode,
+	_In_    Lpcstr  _fromcode,
+	_In_    Lpcstr  _inbuffer,
+	_In_    SizeT   _inbytesleft);
+
 
 #define ZIconV_UTF8_Locale(x)\
   ZIconV_ConvertString(\
@@ -79,6 +137,37 @@ ZIconV_ConvertString(
 #define ZIconV_UTF8_UCS4(x) \
   (Uint32*)ZIconV_ConvertString(\
   "UCS-4-INTERNAL", "UTF-8", x, strlen(x) + 1)
+
+/*
+The conversions above without the heap: the Arena forms allocate from 
+an arena as ZIconV_ConvertStringArena, the Buffer forms write into a
+caller provided buffer of outlen bytes as ZIconV_ConvertBuffer and 
+return its result. Both convert the terminator of x too.*/
+#define ZIconV_UTF8_LocaleArena(arena, x)\
+  ZIconV_ConvertStringArena(\
+  arena, "", "UTF-8", x, strlen(x) + 1)
+
+#define ZIconV_UTF8_UCS2Arena(arena, x)\
+  (Uint16*)ZIconV_ConvertStringArena(\
+  arena, "UCS-2-INTERNAL", "UTF-8", x, strlen(x) + 1)
+
+#define ZIconV_UTF8_UCS4Arena(arena, x)\
+  (Uint32*)ZIconV_ConvertStringArena(\
+  arena, "UCS-4-INTERNAL", "UTF-8", x, strlen(x) + 1)
+
+#define ZIconV_UTF8_LocaleBuffer(x, out, outlen, lpWritten)\
+  ZIconV_ConvertBuffer(\
+  "", "UTF-8", x, strlen(x) + 1, (Char*)(out), outlen, lpWritten)
+
+#define ZIconV_UTF8_UCS2Buffer(x, out, outlen, lpWritten)\
+  ZIconV_ConvertBuffer(\
+  "UCS-2-INTERNAL", "UTF-8", x, strlen(x) + 1, (Char*)(out), outlen, \
+  lpWritten)
+
+#define ZIconV_UTF8_UCS4Buffer(x, out, outlen, lpWritten)\
+  ZIconV_ConvertBuffer(\
+  "UCS-4-INTERNAL", "UTF-8", x, strlen(x) + 1, (Char*)(out), outlen, \
+  lpWritten)
  
 
 
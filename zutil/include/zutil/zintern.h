@@ -0,0 +1,131 @@
+/******************************************************************************
+* zutil - C Utility Library
+* Copyright (C) 2017-2021 Zachary T Harris. All Rights Reserved.  
+* Zlib license.
+* 
+* File: zintern.h
+* Desc: concurrent string interning table
+*******************************************************************************
+
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+******************************************************************************/ 
+#ifndef __ZINTERN_H__
+#define __ZINTERN_H__
+
+#include "zcore.h"
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+
+
+/*
+flags used to specify how strings are matched*/
+typedef enum {
+	ZINTERN_DEFAULT         = 0x00, //strings match byte for byte
+	ZINTERN_CASEINSENSITIVE = 0x01, //strings match ignoring ASCII case
+} ZINTERNFLAGS;
+
+/*
+A table that stores one copy of each distinct string it is given.
+Interned strings are returned as stable handles: a null-terminated 
+string that lives as long as the table, so that two handles from the 
+same table are equal if and only if the pointers are equal.
+Strings are packed into large chunks rather than allocated one by one.
+The table is split into independently locked shards, so it can be
+used from several threads at once.*/
+typedef struct _ZIntern ZIntern;
+
+
+
+
+
+/*
+Create an empty interning table.
+@_eFlags  : ZINTERN_DEFAULT or ZINTERN_CASEINSENSITIVE
+            (the first spelling interned is the one stored)
+@_lpResult: Z_OK on success, non-zero on failure (optional, can be NULL)
+@return   : an allocated table,
+            !must call ZIntern_Release when finished using it!*/
+extern ZIntern* ZAPI
+ZIntern_Create(
+	_In_        ZINTERNFLAGS _eFlags,
+	_Inout_opt_ ZRESULT*     _lpResult);
+
+/*
+Destroy an interning table, invalidating every handle it returned.
+@_lpIntern: the table to destroy
+@return   : Z_OK on success, non-zero on failure*/
+extern ZRESULT ZAPI
+ZIntern_Release(
+	_Inout_ ZIntern* _lpIntern);
+
+/*
+Returns the handle of a string, adding it to the table if necessary.
+@_lpIntern: the table
+@_str     : the characters to intern (need not be null-terminated)
+@_len     : number of bytes in _str
+@return   : the stable handle, or NULL if memory could not be allocated*/
+extern Lpcstr ZAPI
+ZIntern_InternN(
+	_Inout_ ZIntern* _lpIntern,
+	_In_    Lpcstr   _str,
+	_In_    SizeT    _len);
+
+/*
+Returns the handle of a null-terminated string, 
+adding it to the table if necessary.*/
+#define ZIntern_Intern(lpIntern, str)\
+  ZIntern_InternN(lpIntern, str, strlen(str))
+
+/*
+Returns the handle of a string only if it was interned before.
+@_lpIntern: the table
+@_str     : the characters to look up (need not be null-terminated)
+@_len     : number of bytes in _str
+@return   : the stable handle, or NULL if the string is not in the table*/
+extern Lpcstr ZAPI
+ZIntern_FindN(
+	_Inout_ ZIntern* _lpIntern,
+	_In_    Lpcstr   _str,
+	_In_    SizeT    _len);
+
+/*
+Returns the length of an interned string without scanning it.
+@_handle: a handle returned by ZIntern_InternN or ZIntern_FindN
+@return : length in bytes, excluding the terminator*/
+extern SizeT ZAPI
+ZIntern_Length(
+	_In_ Lpcstr _handle);
+
+/*
+Returns the number of distinct strings held by a table.
+@_lpIntern: the table
+@return   : the number of strings*/
+extern SizeT ZAPI
+ZIntern_Count(
+	_Inout_ ZIntern* _lpIntern);
+
+
+
+#if defined(__cplusplus)
+}
+#endif
+/*****************************************************************************/  
+#endif //EOF
+/*****************************************************************************/  
@@ -0,0 +1,178 @@
+/******************************************************************************
+* zutil - C Utility Library
+* Copyright (C) 2017-2021 Zachary T Harris. All Rights Reserved.  
+* Zlib license.
+* 
+* File: zmat23.h
+* Desc: 2D affine transforms with batched point and rect transformation
+*******************************************************************************
+
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+******************************************************************************/ 
+#ifndef __ZMAT23_H__
+#define __ZMAT23_H__
+
+#include "zrect.h"
+#include "zvec2array.h"
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+
+
+/*
+A 2D affine transform, the upper two rows of a 3x3 matrix.
+A point is transformed as 
+	x' = a * x + c * y + tx
+	y' = b * x + d * y + ty
+which is the layout of the CSS/SVG matrix(a, b, c, d, tx, ty).*/
+typedef struct _ZMatrix23 {
+	union {
+		struct {
+			Float a, b;   //first column: image of the x axis
+			Float c, d;   //second column: image of the y axis
+			Float tx, ty; //translation
+		};
+		Float m[6];
+	};
+} ZMAT23;
+
+
+
+/*
+Construction:
+******************************************************************************/
+/*
+Returns the identity transform*/
+extern ZMAT23 ZAPI
+ZMat23_Identity(Void);
+
+/*
+Returns a translation by (_tx, _ty)*/
+extern ZMAT23 ZAPI
+ZMat23_Translation(
+	_In_ Float _tx,
+	_In_ Float _ty);
+
+/*
+Returns a rotation about the origin by _radians*/
+extern ZMAT23 ZAPI
+ZMat23_Rotation(
+	_In_ Float _radians);
+
+/*
+Returns a scale about the origin by per-axis factors*/
+extern ZMAT23 ZAPI
+ZMat23_Scaling(
+	_In_ Float _sx,
+	_In_ Float _sy);
+
+/*
+Returns the transform that scales, then rotates, then translates,
+evaluating the sine and cosine once. This is the usual local transform
+of a scene node.
+@_position: translation applied last
+@_radians : rotation about the origin
+@_scale   : per-axis scale applied first
+@return   : the composed transform*/
+extern ZMAT23 ZAPI
+ZMat23_Compose(
+	_In_ const ZVEC2* _position,
+	_In_ Float        _radians,
+	_In_ const ZVEC2* _scale);
+
+/*
+Concatenates two transforms.
+@_first : the transform applied first (e.g. a child's local transform)
+@_second: the transform applied second (e.g. its parent's world transform)
+@return : a transform equivalent to applying _first, then _second*/
+extern ZMAT23 ZAPI
+ZMat23_Concat(
+	_In_ const ZMAT23* _first,
+	_In_ const ZMAT23* _second);
+
+/*
+Computes the inverse of a transform.
+@_mat  : the transform to invert
+@_out  : receives the inverse, left unchanged if there is none
+@return: false if the transform is singular (determinant is zero)*/
+extern Bool ZAPI
+ZMat23_Invert(
+	_In_    const ZMAT23* _mat,
+	_Inout_ ZMAT23*       _out);
+
+
+
+/*
+Application:
+******************************************************************************/
+/*
+Transforms a single point*/
+extern ZVEC2 ZAPI
+ZMat23_Apply(
+	_In_ const ZMAT23* _mat,
+	_In_ const ZVEC2*  _point);
+
+/*
+Transforms an array of interleaved points, two to four per vector
+instruction. _dst may be the same array as _src.
+@_mat  : the transform
+@_src  : the points to transform
+@_dst  : receives the transformed points
+@_count: number of points*/
+extern Void ZAPI
+ZMat23_ApplyArray(
+	_In_    const ZMAT23* _mat,
+	_In_    const ZVEC2*  _src,
+	_Inout_ ZVEC2*        _dst,
+	_In_    SizeT         _count);
+
+/*
+Transforms a structure-of-arrays batch of points. _dst may be _src,
+otherwise it is resized to the source count.
+@return: Z_OK, or Z_EOUTOFMEMORY*/
+extern ZRESULT ZAPI
+ZMat23_ApplySoA(
+	_In_    const ZMAT23*     _mat,
+	_In_    const ZVEC2ARRAY* _src,
+	_Inout_ ZVEC2ARRAY*       _dst);
+
+/*
+Computes the axis-aligned bounding box of each transformed rect from
+its position and extents, without transforming the four corners.
+Rects with a negative width or height are accepted, and the results are
+normalized. _dst may be the same array as _src.
+@_mat  : the transform
+@_src  : the rects to transform
+@_dst  : receives the bounding boxes
+@_count: number of rects*/
+extern Void ZAPI
+ZMat23_TransformRects(
+	_In_    const ZMAT23* _mat,
+	_In_    const ZRECT*  _src,
+	_Inout_ ZRECT*        _dst,
+	_In_    SizeT         _count);
+
+
+
+#if defined(__cplusplus)
+}
+#endif
+/*****************************************************************************/  
+#endif //EOF
+/*****************************************************************************/  
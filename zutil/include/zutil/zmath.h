@@ -195,16 +195,30 @@ ZMath_AngleSubtract(
 	_In_ Float _a2);
 
 
+/*
+Counts the set bits of a value; a single instruction where the 
+target has one (see Z_POPCOUNT32 in the zcompiler headers)*/
 extern Int32 ZAPI
 ZMath_BitCount(
 	_In_ Int32 x);
 
 
+extern Int32 ZAPI
+ZMath_BitCountU64(
+	_In_ Uint64 x);
+
+/*
+Reverses the order of the bits of a value*/
 extern Int32 ZAPI
 ZMath_BitReverse(
 	_In_ Int32 x);
 
 
+extern Uint64 ZAPI
+ZMath_BitReverseU64(
+	_In_ Uint64 x);
+
+
 extern Int32 ZAPI
 ZMath_BitsForFloat(
 	_In_ Float x);
@@ -215,21 +229,37 @@ ZMath_BitsForInteger(
 	_In_ Int32 x);
 
 
+/*
+Returns the smallest power of 2 not below a value, 
+0 if the value is not positive or the power does not fit*/
 extern Int32 ZAPI
 ZMath_CeilPowerOf2(
 	_In_ Int32 x);
 
 
+extern Uint64 ZAPI
+ZMath_CeilPowerOf2U64(
+	_In_ Uint64 x);
+
+
 extern Float ZAPI 
 ZMath_Fabs(
 	_In_ Float x);
 
 
+/*
+Returns the largest power of 2 not above a value, 
+0 if the value is not positive*/
 extern Int32 ZAPI
 ZMath_FloorPowerOf2(
 	_In_ Int32 x);
 
 
+extern Uint64 ZAPI
+ZMath_FloorPowerOf2U64(
+	_In_ Uint64 x);
+
+
 extern Float ZAPI
 ZMath_Fraction(
 	_In_ Float x);
@@ -253,8 +283,8 @@ ZMath_Easing(
 	_In_ Float          _norm);
 
 /*
-Returns the value of seed being used for randomization
-@return: the randomizer seed*/
+Returns the seed last passed to ZMath_SetRandSeed on the calling thread
+@return: the randomizer seed, 0 if the thread never set one*/
 extern Dword ZAPI
 ZMath_GetRandSeed(Void);
 
@@ -269,11 +299,19 @@ ZMath_Log2f(
 	_In_ Float x);
 
 
+/*
+Returns the base 2 logarithm of a value rounded down, which is the 
+index of its highest set bit, or -1 if the value is not positive*/
 extern Int32 ZAPI
 ZMath_Log2i(
 	_In_ Int32 x);
 
 
+extern Int32 ZAPI
+ZMath_Log2U64(
+	_In_ Uint64 x);
+
+
 extern Int32 ZAPI 
 ZMath_MaskForFloatSign(
 	_In_ Float x);
@@ -284,7 +322,8 @@ ZMath_MaskForIntegerSign(
 	_In_ Int32 x);
 
 /* 
-Returns a random Byte from a lookup table*/
+Returns a random Byte from the calling thread's default generator
+(see ZRng_GetDefault in zrng.h)*/
 extern Byte ZAPI
 ZMath_RandByte(Void); 
 
@@ -299,9 +338,10 @@ ZMath_RandFloat(
     _In_ Bool _signed); 
 
 /* 
-Returns a random Int32 within the range of (0 and _iMax)
-@_iMax : the max range value that can be returned
-@return: a random integer*/
+Returns an unbiased random Int32 within the range of [0, _iMax),
+from the calling thread's default generator
+@_iMax : the number of values that can be returned
+@return: a random integer, 0 if _iMax is not positive*/
 extern Int32 ZAPI
 ZMath_RandInt( 
 	_In_ Int32 _iMax);
@@ -317,7 +357,8 @@ ZMath_Rsqrt(
 	_In_ Float x);
 
 /*
-Reset the randomizer seed.
+Reset the randomizer seed of the calling thread, reseeding its
+default generator. Other threads are not affected.
 @_dwSeed: the new seed*/
 extern Void ZAPI
 ZMath_SetRandSeed(
@@ -0,0 +1,192 @@
+/******************************************************************************
+* zutil - C Utility Library
+* Copyright (C) 2017-2021 Zachary T Harris. All Rights Reserved.  
+* Zlib license.
+* 
+* File: zmatharray.h
+* Desc: Batch transcendental and reciprocal functions over Float arrays
+*******************************************************************************
+
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+******************************************************************************/ 
+#ifndef __ZMATHARRAY_H__
+#define __ZMATHARRAY_H__
+
+#include "zmath.h"
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+
+
+/*
+Precision tiers for the array functions. Errors are the largest 
+measured, in units in the last place of the correctly rounded result
+(ULP), or as an absolute error where the result can be near zero:
+
+function  accurate                     fast
+--------  ---------------------------  -------------------------------
+sin, cos  1.5 ULP for |x| <= pi,       absolute 1.3e-5 for |x| <= pi,
+          absolute 8.2e-8 to 8192      4.7e-4 at |x| = 8192
+atan2     3.1 ULP                      absolute 1.2e-5
+exp       1.3 ULP                      relative 7.5e-6 (100 ULP)
+log       0.9 ULP                      absolute 1.8e-5
+rsqrt     1.5 ULP                      relative 1.5 * 2^-12 (x86), 2^-11
+rcp       0.5 ULP                      relative 1.5 * 2^-12 (x86), 2^-11
+
+The accurate tier follows Cephes and handles the special values as 
+the C library does: infinities, signed zeros, NaN, negative logarithms
+and the overflow and underflow ends of exp. Sine and cosine are valid
+for every finite x and stay within [-1, 1]: arguments up to |x| = 8192
+are reduced in vectors, larger ones (in both tiers) by the C library's
+sinf and cosf, a slow path for those elements only.
+The fast tier uses shorter polynomials and the hardware estimates of
+1/x and 1/sqrt(x), which treat denormal inputs as zero; it is meant 
+for finite arguments in the usual ranges. Builds without vector 
+instructions compute rsqrt and rcp exactly in both tiers.*/
+typedef enum _ZMATHARRAY_PRECISION {
+	ZMATHARRAY_ACCURATE, //Cephes polynomials, a few ULP
+	ZMATHARRAY_FAST      //short polynomials and estimates
+} ZMATHARRAY_PRECISION;
+
+
+
+
+
+/*
+Each function reads _count values from its source arrays and writes
+_count results; the destination may be the same array as a source.
+Arrays need no particular alignment.*/
+
+/*
+Computes the sine of each value.
+@_src      : angles in radians
+@_dst      : receives the sines
+@_count    : number of values
+@_precision: the precision tier*/
+extern Void ZAPI
+ZMathArray_Sin(
+	_In_  const Float*         _src,
+	_Out_ Float*               _dst,
+	_In_  SizeT                _count,
+	_In_  ZMATHARRAY_PRECISION _precision);
+
+/*
+Computes the cosine of each value.
+@_src      : angles in radians
+@_dst      : receives the cosines
+@_count    : number of values
+@_precision: the precision tier*/
+extern Void ZAPI
+ZMathArray_Cos(
+	_In_  const Float*         _src,
+	_Out_ Float*               _dst,
+	_In_  SizeT                _count,
+	_In_  ZMATHARRAY_PRECISION _precision);
+
+/*
+Computes the sine and cosine of each value, sharing the argument
+reduction; about the cost of either one alone.
+@_src      : angles in radians
+@_sin      : receives the sines
+@_cos      : receives the cosines
+@_count    : number of values
+@_precision: the precision tier*/
+extern Void ZAPI
+ZMathArray_SinCos(
+	_In_  const Float*         _src,
+	_Out_ Float*               _sin,
+	_Out_ Float*               _cos,
+	_In_  SizeT                _count,
+	_In_  ZMATHARRAY_PRECISION _precision);
+
+/*
+Computes the angle of each point (_x[i], _y[i]), as atan2f.
+@_y        : y coordinates
+@_x        : x coordinates
+@_dst      : receives the angles, in [-pi, pi]
+@_count    : number of points
+@_precision: the precision tier*/
+extern Void ZAPI
+ZMathArray_Atan2(
+	_In_  const Float*         _y,
+	_In_  const Float*         _x,
+	_Out_ Float*               _dst,
+	_In_  SizeT                _count,
+	_In_  ZMATHARRAY_PRECISION _precision);
+
+/*
+Computes e raised to each value.
+@_src      : exponents
+@_dst      : receives the powers, 0 below -103.9, inf above 88.8
+@_count    : number of values
+@_precision: the precision tier*/
+extern Void ZAPI
+ZMathArray_Exp(
+	_In_  const Float*         _src,
+	_Out_ Float*               _dst,
+	_In_  SizeT                _count,
+	_In_  ZMATHARRAY_PRECISION _precision);
+
+/*
+Computes the natural logarithm of each value.
+@_src      : values
+@_dst      : receives the logarithms
+@_count    : number of values
+@_precision: the precision tier*/
+extern Void ZAPI
+ZMathArray_Log(
+	_In_  const Float*         _src,
+	_Out_ Float*               _dst,
+	_In_  SizeT                _count,
+	_In_  ZMATHARRAY_PRECISION _precision);
+
+/*
+Computes 1 / sqrt(x) for each value.
+@_src      : values
+@_dst      : receives the reciprocal square roots
+@_count    : number of values
+@_precision: the precision tier*/
+extern Void ZAPI
+ZMathArray_Rsqrt(
+	_In_  const Float*         _src,
+	_Out_ Float*               _dst,
+	_In_  SizeT                _count,
+	_In_  ZMATHARRAY_PRECISION _precision);
+
+/*
+Computes 1 / x for each value.
+@_src      : values
+@_dst      : receives the reciprocals
+@_count    : number of values
+@_precision: the precision tier*/
+extern Void ZAPI
+ZMathArray_Rcp(
+	_In_  const Float*         _src,
+	_Out_ Float*               _dst,
+	_In_  SizeT                _count,
+	_In_  ZMATHARRAY_PRECISION _precision);
+
+
+
+#if defined(__cplusplus)
+}
+#endif
+/*****************************************************************************/  
+#endif //EOF
+/*****************************************************************************/  
@@ -0,0 +1,123 @@
+/******************************************************************************
+* zutil - C Utility Library
+* Copyright (C) 2017-2021 Zachary T Harris. All Rights Reserved.  
+* Zlib license.
+* 
+* File: zparse.h
+* Desc: locale independent string to number parsing
+*******************************************************************************
+
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+******************************************************************************/ 
+#ifndef __ZPARSE_H__
+#define __ZPARSE_H__
+
+#include "zcore.h"
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+
+
+/*
+All parsers read at most _len characters from _str, which need not be
+null-terminated, and never allocate. Leading whitespace is not skipped.
+On return *_lpEnd (optional) points just past the last character that 
+belongs to the number, so callers can continue scanning from there;
+when nothing could be parsed it is set to _str. The accepted syntax does
+not depend on the current locale: the decimal point is always '.'.*/
+
+
+
+/*
+Parses an optional '+' followed by decimal digits.
+Eight digits are validated and combined at a time with 64-bit
+arithmetic (SWAR) when enough input is available.
+@_str    : the characters to parse
+@_len    : number of characters available
+@_lpValue: receives the value, or UINT64_MAX on overflow
+@_lpEnd  : optional, receives the end of the parsed characters
+@return  : Z_OK, Z_EINVALIDARG if no digits were found,
+           or Z_ERANGE if the value does not fit*/
+extern ZRESULT ZAPI
+ZParse_Uint64(
+	_In_        Lpcstr  _str,
+	_In_        SizeT   _len,
+	_Inout_     Uint64* _lpValue,
+	_Inout_opt_ Lpcstr* _lpEnd);
+
+/*
+Parses an optional sign followed by decimal digits.
+@_str    : the characters to parse
+@_len    : number of characters available
+@_lpValue: receives the value, clamped to INT64_MIN/INT64_MAX on overflow
+@_lpEnd  : optional, receives the end of the parsed characters
+@return  : Z_OK, Z_EINVALIDARG if no digits were found,
+           or Z_ERANGE if the value does not fit*/
+extern ZRESULT ZAPI
+ZParse_Int64(
+	_In_        Lpcstr  _str,
+	_In_        SizeT   _len,
+	_Inout_     Int64*  _lpValue,
+	_Inout_opt_ Lpcstr* _lpEnd);
+
+/*
+Parses a decimal floating point number, "inf", "infinity" or "nan"
+(case-insensitive, with an optional sign) and rounds it correctly to
+the nearest double, ties to even. Numbers with up to 19 significant
+digits are converted with the Eisel-Lemire algorithm using a table of
+128-bit powers of five; longer inputs are resolved exactly with a 
+big integer comparison when the truncated digits could change the 
+result. Hexadecimal floats are not accepted.
+@_str    : the characters to parse
+@_len    : number of characters available
+@_lpValue: receives the value, or a signed infinity on overflow
+@_lpEnd  : optional, receives the end of the parsed characters
+@return  : Z_OK, Z_EINVALIDARG if no number was found,
+           or Z_ERANGE if a finite number overflows to infinity*/
+extern ZRESULT ZAPI
+ZParse_Double(
+	_In_        Lpcstr  _str,
+	_In_        SizeT   _len,
+	_Inout_     Real64* _lpValue,
+	_Inout_opt_ Lpcstr* _lpEnd);
+
+/*
+Parses a boolean keyword, ignoring case: "1", "true", "on", "enable" are
+true and "0", "false", "off", "disable" are false. A keyword must not be
+followed by another letter or digit ("onward" is not accepted).
+@_str    : the characters to parse
+@_len    : number of characters available
+@_lpValue: receives Z_TRUE or Z_FALSE
+@_lpEnd  : optional, receives the end of the parsed characters
+@return  : Z_OK, or Z_EINVALIDARG if no keyword was found*/
+extern ZRESULT ZAPI
+ZParse_Bool(
+	_In_        Lpcstr  _str,
+	_In_        SizeT   _len,
+	_Inout_     Bool*   _lpValue,
+	_Inout_opt_ Lpcstr* _lpEnd);
+
+
+
+#if defined(__cplusplus)
+}
+#endif
+/*****************************************************************************/  
+#endif //EOF
+/*****************************************************************************/  
@@ -47,6 +47,7 @@ Architecture identification*/
 #define Z_ARCHITECTURE_ARM8      0
 #define Z_ARCHITECTURE_ARM_64    0
 #define Z_ARCHITECTURE_ARM8_64   0
+#define Z_ARCHITECTURE_AVX2      0
 #define Z_ARCHITECTURE_ENDIANBIG 0
 #define Z_ARCHITECTURE_ENDIANLIL 0
 #define Z_ARCHITECTURE_GENERIC   0 
@@ -58,6 +59,7 @@ Architecture identification*/
 #define Z_ARCHITECTURE_PPC_64    0
 #define Z_ARCHITECTURE_SSE2      0
 #define Z_ARCHITECTURE_SSE3      0
+#define Z_ARCHITECTURE_SSSE3     0
 #define Z_ARCHITECTURE_SSE4      0
 #define Z_ARCHITECTURE_SSE4_FMA3 0
 #define Z_ARCHITECTURE_THUMB     0 
@@ -440,11 +442,23 @@ User configurable Options*/
 #  undef  Z_ARCHITECTURE_SSE3
 #  define Z_ARCHITECTURE_SSE3 1
 #endif 
+#if defined(__SSSE3__) || defined(__SSE4_1__)
+#  undef  Z_ARCHITECTURE_SSSE3
+#  define Z_ARCHITECTURE_SSSE3 1
+#endif 
 #if defined(__SSE4_1__)
 #  undef  Z_ARCHITECTURE_SSE4
 #  define Z_ARCHITECTURE_SSE4 1
 #endif 
-#if defined(__ARM_NEON__)
+#if defined(__AVX2__)
+#  undef  Z_ARCHITECTURE_AVX2
+#  define Z_ARCHITECTURE_AVX2 1
+#endif 
+#if defined(__FMA__)
+#  undef  Z_ARCHITECTURE_SSE4_FMA3
+#  define Z_ARCHITECTURE_SSE4_FMA3 1
+#endif 
+#if defined(__ARM_NEON__) || defined(__ARM_NEON)
 #  undef  Z_ARCHITECTURE_NEON
 #  define Z_ARCHITECTURE_NEON 1
 #endif 
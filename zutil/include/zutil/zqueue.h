@@ -27,7 +27,7 @@ freely, subject to the following restrictions:
 #ifndef __ZQUEUE_H__
 #define __ZQUEUE_H__
 
-#include "zcore.h"
+#include "zarena.h"
 #if defined(__cplusplus)
 extern "C" {
 #endif
@@ -46,6 +46,19 @@ extern ZQueue* ZAPI
 ZQueue_Create(
 	_In_ SizeT _nElements);
 
+/*
+Allocate and return an empty queue structure whose elements, and the
+queue itself, are taken from an arena. Popping an element does not
+free it: the memory is given back when the arena is reset, and 
+ZQueue_Release only empties the queue.
+@_lpArena  : the arena to allocate from
+@_nElements: the size of the queue
+@return    : the queue, or NULL if the arena is exhausted*/
+extern ZQueue* ZAPI
+ZQueue_CreateArena(
+	_Inout_ ZArena* _lpArena,
+	_In_    SizeT   _nElements);
+
 /*
 Insert data into the back of the queue.
 @_lpQueue: the queue to insert data into
@@ -0,0 +1,249 @@
+/******************************************************************************
+* zutil - C Utility Library
+* Copyright (C) 2017-2021 Zachary T Harris. All Rights Reserved.  
+* Zlib license.
+* 
+* File: zrectarray.h
+* Desc: batched queries over rectangles in structure-of-arrays layout
+*******************************************************************************
+
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+******************************************************************************/ 
+#ifndef __ZRECTARRAY_H__
+#define __ZRECTARRAY_H__
+
+#include "zrect.h"
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+
+
+#define ZRECTARRAY_ALIGN 32 //alignment of the edge arrays in bytes
+#define ZRECTARRAY_PAD   8  //capacities are rounded up to this many rects
+
+/*
+An array of rectangles in structure-of-arrays layout. Each rect is kept
+as its four edges, normalized so that left <= right and top <= bottom;
+the edge arrays share a single aligned allocation. A zero filled 
+ZRECTARRAY is a valid empty array.
+
+Queries test one rect or point against the whole array and write the 
+result as a bitmask: bit (i % 32) of word (i / 32) is set when rect i 
+matches, and bits past the count are cleared, so the mask needs 
+ZRECTARRAY_MASKWORDS(count) words. They follow the pairwise ZRect 
+functions: rects overlap when their intersection has a positive area,
+so empty rects overlap nothing, and rects contain the points on their 
+left and top edges but not those on their right and bottom edges.*/
+typedef struct _ZRECTARRAY {
+	Float* left;      //left edges, aligned to ZRECTARRAY_ALIGN
+	Float* top;       //top edges
+	Float* right;     //right edges
+	Float* bottom;    //bottom edges
+	SizeT  iCount;    //number of rects
+	SizeT  iCapacity; //rects that fit without reallocating
+	Void*  lpBlock;   //allocation holding the four edge arrays
+} ZRECTARRAY;
+
+#define ZRECTARRAY_MASKWORDS(count) (((count) + 31) / 32)
+
+
+
+/*
+Element access:
+******************************************************************************/
+static FORCEINLINE ZRECT
+ZRectArray_Get(
+	_In_ const ZRECTARRAY* _array,
+	_In_ SizeT             _index) {
+
+	ZRECT rect;
+	rect.x = _array->left[_index];
+	rect.y = _array->top[_index];
+	rect.w = _array->right[_index] - rect.x;
+	rect.h = _array->bottom[_index] - rect.y;
+	return rect;
+}
+
+static FORCEINLINE Void
+ZRectArray_Set(
+	_Inout_ ZRECTARRAY*  _array,
+	_In_    SizeT        _index,
+	_In_    const ZRECT* _rect) {
+
+	Float r = _rect->x + _rect->w, b = _rect->y + _rect->h;
+	_array->left[_index]   = Z_Min(_rect->x, r);
+	_array->top[_index]    = Z_Min(_rect->y, b);
+	_array->right[_index]  = Z_Max(_rect->x, r);
+	_array->bottom[_index] = Z_Max(_rect->y, b);
+}
+
+
+
+/*
+Lifetime and conversion:
+******************************************************************************/
+/*
+Initializes an empty array with room for _capacity rects.
+@_array   : the array to initialize
+@_capacity: number of rects to reserve, may be 0
+@return   : Z_OK, or Z_EOUTOFMEMORY (_array is then left empty)*/
+extern ZRESULT ZAPI
+ZRectArray_Init(
+	_Out_ ZRECTARRAY* _array,
+	_In_  SizeT       _capacity);
+
+/*
+Releases the memory owned by an array and leaves it empty.
+@_array: the array to release*/
+extern Void ZAPI
+ZRectArray_Free(
+	_Inout_ ZRECTARRAY* _array);
+
+/*
+Sets the number of rects, keeping the existing ones. 
+Rects added at the end are uninitialized.
+@_array: the array to resize
+@_count: the new number of rects
+@return: Z_OK, or Z_EOUTOFMEMORY (the array is left unchanged)*/
+extern ZRESULT ZAPI
+ZRectArray_Resize(
+	_Inout_ ZRECTARRAY* _array,
+	_In_    SizeT       _count);
+
+/*
+Fills an array from ZRECT values, normalizing them.
+@_array: the array to fill, resized to _count
+@_src  : the rects to copy
+@_count: number of rects
+@return: Z_OK, or Z_EOUTOFMEMORY*/
+extern ZRESULT ZAPI
+ZRectArray_FromAoS(
+	_Inout_ ZRECTARRAY*  _array,
+	_In_    const ZRECT* _src,
+	_In_    SizeT        _count);
+
+/*
+Copies an array out to ZRECT values.
+@_array: the array to copy
+@_dst  : receives _array->iCount rects*/
+extern Void ZAPI
+ZRectArray_ToAoS(
+	_In_    const ZRECTARRAY* _array,
+	_Inout_ ZRECT*            _dst);
+
+
+
+/*
+Queries:
+******************************************************************************/
+/*
+Finds the rects that overlap a rect, as ZRect_GetIntersection.
+@_array: the rects to test
+@_rect : the rect to test against, need not be normalized
+@_mask : receives ZRECTARRAY_MASKWORDS(_array->iCount) words
+@return: number of overlapping rects*/
+extern SizeT ZAPI
+ZRectArray_QueryOverlap(
+	_In_    const ZRECTARRAY* _array,
+	_In_    const ZRECT*      _rect,
+	_Inout_ Uint32*           _mask);
+
+/*
+Finds the rects that lie entirely inside a rect, edges included.
+@_array: the rects to test
+@_rect : the enclosing rect, need not be normalized
+@_mask : receives ZRECTARRAY_MASKWORDS(_array->iCount) words
+@return: number of enclosed rects*/
+extern SizeT ZAPI
+ZRectArray_QueryInside(
+	_In_    const ZRECTARRAY* _array,
+	_In_    const ZRECT*      _rect,
+	_Inout_ Uint32*           _mask);
+
+/*
+Finds the rects that contain a point, as ZRect_ContainsPoint.
+@_array: the rects to test
+@_mask : receives ZRECTARRAY_MASKWORDS(_array->iCount) words
+@return: number of rects containing the point*/
+extern SizeT ZAPI
+ZRectArray_QueryPoint(
+	_In_    const ZRECTARRAY* _array,
+	_In_    Float             _x,
+	_In_    Float             _y,
+	_Inout_ Uint32*           _mask);
+
+/*
+Lists the set bits of a query mask in ascending order.
+@_mask   : the mask written by a query
+@_count  : number of rects the mask covers
+@_indices: receives one index per set bit
+@return  : number of indices written*/
+extern SizeT ZAPI
+ZRectArray_MaskToIndices(
+	_In_    const Uint32* _mask,
+	_In_    SizeT         _count,
+	_Inout_ SizeT*        _indices);
+
+
+
+/*
+Batch kernels:
+******************************************************************************/
+/*
+Intersects each pair of rects, as ZRect_GetIntersection: pairs that do 
+not overlap produce an empty rect at the origin.
+@_dst  : receives the intersections, may be _a or _b
+@_mask : optional, receives ZRECTARRAY_MASKWORDS(_a->iCount) words
+         marking the pairs that overlap
+@return: Z_OK, Z_EINVALIDARG if the counts differ, or Z_EOUTOFMEMORY*/
+extern ZRESULT ZAPI
+ZRectArray_Intersect(
+	_Inout_     ZRECTARRAY*       _dst,
+	_In_        const ZRECTARRAY* _a,
+	_In_        const ZRECTARRAY* _b,
+	_Inout_opt_ Uint32*           _mask);
+
+/*
+Computes the bounding rect of each pair of rects, as ZRect_Merge.
+@_dst  : receives the merged rects, may be _a or _b
+@return: Z_OK, Z_EINVALIDARG if the counts differ, or Z_EOUTOFMEMORY*/
+extern ZRESULT ZAPI
+ZRectArray_Merge(
+	_Inout_ ZRECTARRAY*       _dst,
+	_In_    const ZRECTARRAY* _a,
+	_In_    const ZRECTARRAY* _b);
+
+/*
+Computes the bounding rect of all rects in an array.
+@_array: the rects to bound
+@_out  : receives the bounds, or an empty rect at the origin
+@return: false if the array is empty*/
+extern Bool ZAPI
+ZRectArray_GetBounds(
+	_In_    const ZRECTARRAY* _array,
+	_Inout_ ZRECT*            _out);
+
+
+
+#if defined(__cplusplus)
+}
+#endif
+/*****************************************************************************/  
+#endif //EOF
+/*****************************************************************************/  
@@ -0,0 +1,143 @@
+/******************************************************************************
+* zutil - C Utility Library
+* Copyright (C) 2017-2021 Zachary T Harris. All Rights Reserved.  
+* Zlib license.
+* 
+* File: zrectpack.h
+* Desc: rectangle packing for texture atlases
+*******************************************************************************
+
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+******************************************************************************/ 
+#ifndef __ZRECTPACK_H__
+#define __ZRECTPACK_H__
+
+#include "zrect.h"
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+
+
+/*
+Packs rectangles into a fixed size bin, such as glyphs and sprites into
+a texture atlas. Positions and sizes are whole units (pixels): sizes
+are rounded up to integers, and the rects are placed without rotation
+at integer positions in [0, width) x [0, height).
+
+ZRECTPACK_SKYLINE_BL tracks only the upper outline of the packed rects
+and places each rect where its bottom edge ends up lowest. It is the 
+faster heuristic, and packs rects of similar height well.
+
+ZRECTPACK_MAXRECTS_BSSF tracks every maximal free rectangle and places 
+each rect in the free rect that leaves the shortest leftover side. It 
+fills holes the skyline cannot reach and gives the higher occupancy on
+mixed sizes, at a higher cost per rect.
+
+Rects may be inserted one at a time as they are needed at runtime, or
+in batches that are sorted, largest first, before packing for a better
+fill.*/
+typedef struct _ZRectPack ZRectPack;
+
+typedef enum _ZRECTPACK_HEURISTIC {
+	ZRECTPACK_SKYLINE_BL    = 0, //skyline, bottom-left
+	ZRECTPACK_MAXRECTS_BSSF = 1  //maximal rectangles, best short side fit
+} ZRECTPACK_HEURISTIC;
+
+
+
+/*
+Creates an empty bin.
+@_width    : width of the bin, 1 or more
+@_height   : height of the bin, 1 or more
+@_heuristic: the packing heuristic
+@_lpResult : Z_OK on success, non-zero on failure (optional, can be NULL)
+@return    : an allocated packer, or NULL on failure
+             !must call ZRectPack_Release when finished using it!*/
+extern ZRectPack* ZAPI
+ZRectPack_Create(
+	_In_        Int32               _width,
+	_In_        Int32               _height,
+	_In_        ZRECTPACK_HEURISTIC _heuristic,
+	_Inout_opt_ ZRESULT*            _lpResult);
+
+/*
+Destroys a packer.
+@_lpPack: the packer to destroy*/
+extern Void ZAPI
+ZRectPack_Release(
+	_Inout_ ZRectPack* _lpPack);
+
+/*
+Empties the bin, keeping its size and heuristic*/
+extern Void ZAPI
+ZRectPack_Reset(
+	_Inout_ ZRectPack* _lpPack);
+
+/*
+Places one rect.
+@_lpPack: the packer
+@_rect  : the size to place in w and h, receives the position in x and
+          y. An empty rect is placed at the origin without using space
+@return : Z_OK, Z_ERANGE if the rect does not fit (it is left 
+          unchanged), Z_EINVALIDARG for a negative size, or 
+          Z_EOUTOFMEMORY*/
+extern ZRESULT ZAPI
+ZRectPack_Insert(
+	_Inout_ ZRectPack* _lpPack,
+	_Inout_ ZRECT*     _rect);
+
+/*
+Places a batch of rects, largest first: by height for the skyline and
+by longest side for the maximal rectangles.
+@_lpPack  : the packer
+@_rects   : the sizes to place in w and h, receive the positions in x 
+            and y; rects that do not fit get x = y = -1
+@_count   : number of rects
+@_lpPlaced: receives the number of rects placed (optional, can be NULL)
+@return   : Z_OK if every rect was placed, Z_ERANGE if some did not fit,
+            Z_EINVALIDARG for a negative size (nothing is placed), or 
+            Z_EOUTOFMEMORY (the rects placed so far stay in the bin)*/
+extern ZRESULT ZAPI
+ZRectPack_InsertBatch(
+	_Inout_     ZRectPack* _lpPack,
+	_Inout_     ZRECT*     _rects,
+	_In_        SizeT      _count,
+	_Inout_opt_ SizeT*     _lpPlaced);
+
+/*
+Returns the fraction of the bin covered by the rects placed, 0 to 1*/
+extern Float ZAPI
+ZRectPack_GetOccupancy(
+	_In_ const ZRectPack* _lpPack);
+
+/*
+Returns the largest bottom edge (y + h) of the rects placed. Cropping 
+the bin to this height keeps every rect.*/
+extern Int32 ZAPI
+ZRectPack_GetUsedHeight(
+	_In_ const ZRectPack* _lpPack);
+
+
+
+#if defined(__cplusplus)
+}
+#endif
+/*****************************************************************************/  
+#endif //EOF
+/*****************************************************************************/  
@@ -70,6 +70,7 @@ enum {
     Z_EREGISTERED  = -0x1A, //specified file is not registered
     Z_ETIMEDOUT    = -0x1B, //mutex or connection timed out
     Z_EUNSUPPORTED = -0x1C, //unsupported operation or feature 	 
+    Z_ERANGE       = -0x1D, //result is out of range for its type
 };
 #define Z_FAILURE(r) (((ZRESULT)(r)) < 0)  /**< Did operation fail?*/
 #define Z_SUCCESS(r) (((ZRESULT)(r)) >= 0) /**< Did operation succeed?*/ 
@@ -0,0 +1,251 @@
+/******************************************************************************
+* zutil - C Utility Library
+* Copyright (C) 2017-2021 Zachary T Harris. All Rights Reserved.  
+* Zlib license.
+* 
+* File: zrng.h
+* Desc: Seedable pseudo random number generators
+*******************************************************************************
+
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+******************************************************************************/ 
+#ifndef __ZRNG_H__
+#define __ZRNG_H__
+
+#include "zcore.h"
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+
+
+/*
+Fast pseudo random number generators held in a small state object.
+A state belongs to one thread at a time; threads that share work
+should each own a state, either their default state from 
+ZRng_GetDefault or streams split from a common seed with ZRng_Jump.
+None of these generators are suitable for cryptography.*/
+typedef enum {
+	ZRNG_XOSHIRO256PP, //xoshiro256++: period 2^256 - 1, 64-bit output
+	ZRNG_PCG32         //PCG-XSH-RR: period 2^64, 32-bit output
+} ZRNG_TYPE;
+
+/*
+Generator state*/
+typedef struct _ZRNG {
+	ZRNG_TYPE eType;
+	union {
+		Uint64 s[4];     //xoshiro256++ state, never all zero
+		struct {
+			Uint64 state;
+			Uint64 inc;  //odd increment selecting the stream
+		} pcg;
+	};
+} ZRNG;
+
+
+
+
+
+/*
+Seeds a generator. The seed is expanded with SplitMix64, so nearby
+seeds give unrelated sequences, and the same seed always gives the 
+same sequence on every platform.
+@_lpRng: the generator
+@_type : the algorithm to use
+@_seed : any value*/
+extern Void ZAPI
+ZRng_Init(
+	_Out_ ZRNG*     _lpRng,
+	_In_  ZRNG_TYPE _type,
+	_In_  Uint64    _seed);
+
+/*
+Returns the calling thread's default generator, a xoshiro256++ state 
+created on first use. Each thread's default is seeded from the order 
+in which threads first ask for it, so the first thread always sees 
+the same sequence unless it reseeds the generator.
+@return: the default generator of the calling thread*/
+extern ZRNG* ZAPI
+ZRng_GetDefault(Void);
+
+/*
+Advances a generator as if by a very large number of calls, to split
+one seed into non-overlapping streams for parallel work: copy the 
+state, give the copy to a worker and jump the original. For 
+xoshiro256++ this skips 2^128 outputs; for PCG32, 2^48.
+@_lpRng: the generator*/
+extern Void ZAPI
+ZRng_Jump(
+	_Inout_ ZRNG* _lpRng);
+
+/*
+As ZRng_Jump, but skips 2^192 outputs for xoshiro256++ and 2^56 for
+PCG32, to split streams between machines or processes that each 
+use ZRng_Jump to split further.
+@_lpRng: the generator*/
+extern Void ZAPI
+ZRng_LongJump(
+	_Inout_ ZRNG* _lpRng);
+
+/*
+Returns 32 random bits*/
+extern Uint32 ZAPI
+ZRng_NextU32(
+	_Inout_ ZRNG* _lpRng);
+
+/*
+Returns 64 random bits*/
+extern Uint64 ZAPI
+ZRng_NextU64(
+	_Inout_ ZRNG* _lpRng);
+
+/*
+Returns a uniform Float in [0, 1) with 24 bits of precision*/
+extern Float ZAPI
+ZRng_NextFloat(
+	_Inout_ ZRNG* _lpRng);
+
+/*
+Returns a uniform Real64 in [0, 1) with 53 bits of precision*/
+extern Real64 ZAPI
+ZRng_NextReal64(
+	_Inout_ ZRNG* _lpRng);
+
+/*
+Returns a normally distributed Float with mean 0 and standard 
+deviation 1, by the ziggurat method*/
+extern Float ZAPI
+ZRng_NextNormal(
+	_Inout_ ZRNG* _lpRng);
+
+/*
+Returns an exponentially distributed Float with rate 1 (mean 1),
+by the ziggurat method*/
+extern Float ZAPI
+ZRng_NextExponential(
+	_Inout_ ZRNG* _lpRng);
+
+/*
+Returns an unbiased integer in [0, _range) using Lemire's 
+multiply-shift method, which rejects a draw only with probability 
+below _range / 2^32 and needs no division in the common case.
+@_lpRng: the generator
+@_range: the number of possible values, 0 returns 0
+@return: a random integer below _range*/
+extern Uint32 ZAPI
+ZRng_Bounded(
+	_Inout_ ZRNG*  _lpRng,
+	_In_    Uint32 _range);
+
+/*
+Fills an array with random 32-bit integers. Large xoshiro256++ fills 
+run eight interleaved generators, seeded from this one, in vector 
+registers; the results depend only on the state and the count, never
+on the instruction set, but they differ from calling ZRng_NextU32 
+_count times. PCG32 fills are serial, as vector units lack the 
+64-bit multiply it needs.
+@_lpRng: the generator
+@_dst  : receives the values
+@_count: the number of values*/
+extern Void ZAPI
+ZRng_FillU32(
+	_Inout_ ZRNG*   _lpRng,
+	_Out_   Uint32* _dst,
+	_In_    SizeT   _count);
+
+/*
+Fills an array with uniform Floats in [0, 1), as ZRng_FillU32.
+@_lpRng: the generator
+@_dst  : receives the values
+@_count: the number of values*/
+extern Void ZAPI
+ZRng_FillFloat(
+	_Inout_ ZRNG*  _lpRng,
+	_Out_   Float* _dst,
+	_In_    SizeT  _count);
+
+
+/*
+Distributions:
+******************************************************************************/
+/*
+The fills below draw their random integers from eight interleaved
+generators, as ZRng_FillU32, and transform them in blocks; the normal 
+and exponential fills use the ziggurat tables, gathered eight at a 
+time with AVX2. A fill depends only on the generator state and the 
+count, so a fixed seed reproduces a run. Unit normal, unit 
+exponential and [0, 1) uniform values are the same on every 
+instruction set, except for the rare draws outside the ziggurat 
+(about 1%) that go through logf and expf. Other ranges take one 
+multiply-add, which rounds differently where the compiler fuses it.
+A fill gives different values than the same number of ZRng_Next* 
+calls.*/
+
+
+/*
+Fills an array with uniform Floats between _min and _max.
+@_lpRng: the generator
+@_dst  : receives the values
+@_count: the number of values
+@_min  : the lower bound, inclusive
+@_max  : the upper bound*/
+extern Void ZAPI
+ZRng_FillUniform(
+	_Inout_ ZRNG*  _lpRng,
+	_Out_   Float* _dst,
+	_In_    SizeT  _count,
+	_In_    Float  _min,
+	_In_    Float  _max);
+
+/*
+Fills an array with normally distributed Floats.
+@_lpRng : the generator
+@_dst   : receives the values
+@_count : the number of values
+@_mean  : the mean of the distribution
+@_stddev: the standard deviation of the distribution*/
+extern Void ZAPI
+ZRng_FillNormal(
+	_Inout_ ZRNG*  _lpRng,
+	_Out_   Float* _dst,
+	_In_    SizeT  _count,
+	_In_    Float  _mean,
+	_In_    Float  _stddev);
+
+/*
+Fills an array with exponentially distributed Floats.
+@_lpRng: the generator
+@_dst  : receives the values
+@_count: the number of values
+@_rate : the rate of the distribution (1 / mean), positive*/
+extern Void ZAPI
+ZRng_FillExponential(
+	_Inout_ ZRNG*  _lpRng,
+	_Out_   Float* _dst,
+	_In_    SizeT  _count,
+	_In_    Float  _rate);
+
+
+
+#if defined(__cplusplus)
+}
+#endif
+/*****************************************************************************/  
+#endif //EOF
+/*****************************************************************************/  
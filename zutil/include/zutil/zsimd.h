@@ -0,0 +1,752 @@
+/******************************************************************************
+* zutil - C Utility Library
+* Copyright (C) 2017-2021 Zachary T Harris. All Rights Reserved.  
+* Zlib license.
+* 
+* File: zsimd.h
+* Desc: portable single precision vector operations
+*******************************************************************************
+
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+******************************************************************************/ 
+#ifndef __ZSIMD_H__
+#define __ZSIMD_H__
+
+#include "zcore.h"
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+
+
+/*
+A thin layer over the widest single precision vector unit the build
+targets, shared by the batch kernels: AVX2 (8 lanes), SSE2 (4 lanes),
+AArch64 NEON (4 lanes), or plain scalars (1 lane). All loads and stores
+are unaligned. Comparisons return lane masks for ZSimd_And (keeps the
+selected lanes, clears the others) and ZSimd_Select. ZSimd_Floor
+needs |a| < 2^31, and ZSimd_Pow2i builds 2^n from whole numbers n in
+[-126, 127]. ZSimd_Exponent and ZSimd_Mantissa split a positive normal
+a into 2^e * m with m in [1, 2). ZSimd_RcpEst and ZSimd_RsqrtEst have
+a relative error below 2^-11 (they are exact in scalar builds) and 
+treat denormal inputs as zero. ZSimd_CopySign gives the magnitude of
+a with the sign bit of b, which tells -0 from +0 where the comparisons
+cannot.*/
+#if (Z_ARCHITECTURE_AVX2)
+#  include <immintrin.h>
+#  define ZSIMD_AVX2  1
+#  define ZSIMD_LANES 8
+typedef __m256 ZSIMDF;
+#elif (Z_ARCHITECTURE_SSE2)
+#  include <emmintrin.h>
+#  define ZSIMD_SSE2  1
+#  define ZSIMD_LANES 4
+typedef __m128 ZSIMDF;
+#elif (Z_ARCHITECTURE_NEON && Z_ARCHITECTURE_ARM_64)
+#  include <arm_neon.h>
+#  define ZSIMD_NEON  1
+#  define ZSIMD_LANES 4
+typedef float32x4_t ZSIMDF;
+#else
+#  include <math.h>
+#  define ZSIMD_SCALAR 1
+#  define ZSIMD_LANES  1
+typedef Float ZSIMDF;
+#endif
+
+#define ZSIMD_ALIGN 32 //alignment that suits every vector width above
+
+
+
+#if (ZSIMD_AVX2)
+static FORCEINLINE ZSIMDF
+ZSimd_Load(
+	_In_ const Float* _p) {
+	return _mm256_loadu_ps(_p);
+}
+
+static FORCEINLINE Void
+ZSimd_Store(
+	_Out_ Float* _p,
+	_In_  ZSIMDF _a) {
+	_mm256_storeu_ps(_p, _a);
+}
+
+static FORCEINLINE ZSIMDF
+ZSimd_Set1(
+	_In_ Float _a) {
+	return _mm256_set1_ps(_a);
+}
+
+static FORCEINLINE ZSIMDF
+ZSimd_Add(
+	_In_ ZSIMDF _a,
+	_In_ ZSIMDF _b) {
+	return _mm256_add_ps(_a, _b);
+}
+
+static FORCEINLINE ZSIMDF
+ZSimd_Sub(
+	_In_ ZSIMDF _a,
+	_In_ ZSIMDF _b) {
+	return _mm256_sub_ps(_a, _b);
+}
+
+static FORCEINLINE ZSIMDF
+ZSimd_Mul(
+	_In_ ZSIMDF _a,
+	_In_ ZSIMDF _b) {
+	return _mm256_mul_ps(_a, _b);
+}
+
+static FORCEINLINE ZSIMDF
+ZSimd_Div(
+	_In_ ZSIMDF _a,
+	_In_ ZSIMDF _b) {
+	return _mm256_div_ps(_a, _b);
+}
+
+static FORCEINLINE ZSIMDF
+ZSimd_Min(
+	_In_ ZSIMDF _a,
+	_In_ ZSIMDF _b) {
+	return _mm256_min_ps(_a, _b);
+}
+
+static FORCEINLINE ZSIMDF
+ZSimd_Max(
+	_In_ ZSIMDF _a,
+	_In_ ZSIMDF _b) {
+	return _mm256_max_ps(_a, _b);
+}
+
+static FORCEINLINE ZSIMDF
+ZSimd_Sqrt(
+	_In_ ZSIMDF _a) {
+	return _mm256_sqrt_ps(_a);
+}
+
+static FORCEINLINE ZSIMDF
+ZSimd_CmpGt(
+	_In_ ZSIMDF _a,
+	_In_ ZSIMDF _b) {
+	return _mm256_cmp_ps(_a, _b, _CMP_GT_OQ);
+}
+
+static FORCEINLINE ZSIMDF
+ZSimd_CmpLe(
+	_In_ ZSIMDF _a,
+	_In_ ZSIMDF _b) {
+	return _mm256_cmp_ps(_a, _b, _CMP_LE_OQ);
+}
+
+static FORCEINLINE ZSIMDF
+ZSimd_And(
+	_In_ ZSIMDF _mask,
+	_In_ ZSIMDF _a) {
+	return _mm256_and_ps(_mask, _a);
+}
+
+static FORCEINLINE ZSIMDF
+ZSimd_Select(
+	_In_ ZSIMDF _mask,
+	_In_ ZSIMDF _a,
+	_In_ ZSIMDF _b) {
+	return _mm256_blendv_ps(_b, _a, _mask);
+}
+
+static FORCEINLINE Uint32
+ZSimd_MoveMask(
+	_In_ ZSIMDF _mask) {
+	return (Uint32)_mm256_movemask_ps(_mask);
+}
+#  if (Z_ARCHITECTURE_SSE4_FMA3)
+static FORCEINLINE ZSIMDF
+ZSimd_MulAdd(
+	_In_ ZSIMDF _a,
+	_In_ ZSIMDF _b,
+	_In_ ZSIMDF _c) {
+	return _mm256_fmadd_ps(_a, _b, _c);
+}
+#  else
+static FORCEINLINE ZSIMDF
+ZSimd_MulAdd(
+	_In_ ZSIMDF _a,
+	_In_ ZSIMDF _b,
+	_In_ ZSIMDF _c) {
+	return _mm256_add_ps(_mm256_mul_ps(_a, _b), _c);
+}
+#  endif
+static FORCEINLINE ZSIMDF
+ZSimd_Floor(
+	_In_ ZSIMDF _a) {
+	return _mm256_floor_ps(_a);
+}
+
+static FORCEINLINE ZSIMDF
+ZSimd_Abs(
+	_In_ ZSIMDF _a) {
+	return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), _a);
+}
+
+static FORCEINLINE ZSIMDF
+ZSimd_CopySign(
+	_In_ ZSIMDF _a,
+	_In_ ZSIMDF _b) {
+	ZSIMDF s = _mm256_set1_ps(-0.0f);
+	return _mm256_or_ps(_mm256_andnot_ps(s, _a), _mm256_and_ps(s, _b));
+}
+
+static FORCEINLINE ZSIMDF
+ZSimd_Pow2i(
+	_In_ ZSIMDF _n) {
+	return _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_add_epi32(
+		_mm256_cvtps_epi32(_n), _mm256_set1_epi32(127)), 23));
+}
+
+static FORCEINLINE ZSIMDF
+ZSimd_Exponent(
+	_In_ ZSIMDF _a) {
+	return _mm256_cvtepi32_ps(_mm256_sub_epi32(_mm256_srli_epi32(
+		_mm256_castps_si256(_a), 23), _mm256_set1_epi32(127)));
+}
+
+static FORCEINLINE ZSIMDF
+ZSimd_Mantissa(
+	_In_ ZSIMDF _a) {
+	__m256i m = _mm256_and_si256(
+		_mm256_castps_si256(_a), _mm256_set1_epi32(0x007FFFFF));
+	return _mm256_castsi256_ps(
+		_mm256_or_si256(m, _mm256_set1_epi32(0x3F800000)));
+}
+
+static FORCEINLINE ZSIMDF
+ZSimd_RcpEst(
+	_In_ ZSIMDF _a) {
+	return _mm256_rcp_ps(_a);
+}
+
+static FORCEINLINE ZSIMDF
+ZSimd_RsqrtEst(
+	_In_ ZSIMDF _a) {
+	return _mm256_rsqrt_ps(_a);
+}
+#elif (ZSIMD_SSE2)
+static FORCEINLINE ZSIMDF
+ZSimd_Load(
+	_In_ const Float* _p) {
+	return _mm_loadu_ps(_p);
+}
+
+static FORCEINLINE Void
+ZSimd_Store(
+	_Out_ Float* _p,
+	_In_  ZSIMDF _a) {
+	_mm_storeu_ps(_p, _a);
+}
+
+static FORCEINLINE ZSIMDF
+ZSimd_Set1(
+	_In_ Float _a) {
+	return _mm_set1_ps(_a);
+}
+
+static FORCEINLINE ZSIMDF
+ZSimd_Add(
+	_In_ ZSIMDF _a,
+	_In_ ZSIMDF _b) {
+	return _mm_add_ps(_a, _b);
+}
+
+static FORCEINLINE ZSIMDF
+ZSimd_Sub(
+	_In_ ZSIMDF _a,
+	_In_ ZSIMDF _b) {
+	return _mm_sub_ps(_a, _b);
+}
+
+static FORCEINLINE ZSIMDF
+ZSimd_Mul(
+	_In_ ZSIMDF _a,
+	_In_ ZSIMDF _b) {
+	return _mm_mul_ps(_a, _b);
+}
+
+static FORCEINLINE ZSIMDF
+ZSimd_Div(
+	_In_ ZSIMDF _a,
+	_In_ ZSIMDF _b) {
+	return _mm_div_ps(_a, _b);
+}
+
+static FORCEINLINE ZSIMDF
+ZSimd_Min(
+	_In_ ZSIMDF _a,
+	_In_ ZSIMDF _b) {
+	return _mm_min_ps(_a, _b);
+}
+
+static FORCEINLINE ZSIMDF
+ZSimd_Max(
+	_In_ ZSIMDF _a,
+	_In_ ZSIMDF _b) {
+	return _mm_max_ps(_a, _b);
+}
+
+static FORCEINLINE ZSIMDF
+ZSimd_Sqrt(
+	_In_ ZSIMDF _a) {
+	return _mm_sqrt_ps(_a);
+}
+
+static FORCEINLINE ZSIMDF
+ZSimd_CmpGt(
+	_In_ ZSIMDF _a,
+	_In_ ZSIMDF _b) {
+	return _mm_cmpgt_ps(_a, _b);
+}
+
+static FORCEINLINE ZSIMDF
+ZSimd_CmpLe(
+	_In_ ZSIMDF _a,
+	_In_ ZSIMDF _b) {
+	return _mm_cmple_ps(_a, _b);
+}
+
+static FORCEINLINE ZSIMDF
+ZSimd_And(
+	_In_ ZSIMDF _mask,
+	_In_ ZSIMDF _a) {
+	return _mm_and_ps(_mask, _a);
+}
+
+static FORCEINLINE ZSIMDF
+ZSimd_Select(
+	_In_ ZSIMDF _mask,
+	_In_ ZSIMDF _a,
+	_In_ ZSIMDF _b) {
+	return _mm_or_ps(_mm_and_ps(_mask, _a), _mm_andnot_ps(_mask, _b));
+}
+
+static FORCEINLINE Uint32
+ZSimd_MoveMask(
+	_In_ ZSIMDF _mask) {
+	return (Uint32)_mm_movemask_ps(_mask);
+}
+
+static FORCEINLINE ZSIMDF
+ZSimd_MulAdd(
+	_In_ ZSIMDF _a,
+	_In_ ZSIMDF _b,
+	_In_ ZSIMDF _c) {
+	return _mm_add_ps(_mm_mul_ps(_a, _b), _c);
+}
+
+static FORCEINLINE ZSIMDF
+ZSimd_Floor(
+	_In_ ZSIMDF _a) {
+	ZSIMDF t = _mm_cvtepi32_ps(_mm_cvttps_epi32(_a));
+	return _mm_sub_ps(t, _mm_and_ps(_mm_cmpgt_ps(t, _a), _mm_set1_ps(1.0f)));
+}
+
+static FORCEINLINE ZSIMDF
+ZSimd_Abs(
+	_In_ ZSIMDF _a) {
+	return _mm_andnot_ps(_mm_set1_ps(-0.0f), _a);
+}
+
+static FORCEINLINE ZSIMDF
+ZSimd_CopySign(
+	_In_ ZSIMDF _a,
+	_In_ ZSIMDF _b) {
+	ZSIMDF s = _mm_set1_ps(-0.0f);
+	return _mm_or_ps(_mm_andnot_ps(s, _a), _mm_and_ps(s, _b));
+}
+
+static FORCEINLINE ZSIMDF
+ZSimd_Pow2i(
+	_In_ ZSIMDF _n) {
+	return _mm_castsi128_ps(_mm_slli_epi32(_mm_add_epi32(_mm_cvtps_epi32(_n),
+		_mm_set1_epi32(127)), 23));
+}
+
+static FORCEINLINE ZSIMDF
+ZSimd_Exponent(
+	_In_ ZSIMDF _a) {
+	return _mm_cvtepi32_ps(_mm_sub_epi32(_mm_srli_epi32(_mm_castps_si128(_a),
+		23), _mm_set1_epi32(127)));
+}
+
+static FORCEINLINE ZSIMDF
+ZSimd_Mantissa(
+	_In_ ZSIMDF _a) {
+	return _mm_castsi128_ps(_mm_or_si128(_mm_and_si128(_mm_castps_si128(_a),
+		_mm_set1_epi32(0x007FFFFF)), _mm_set1_epi32(0x3F800000)));
+}
+
+static FORCEINLINE ZSIMDF
+ZSimd_RcpEst(
+	_In_ ZSIMDF _a) {
+	return _mm_rcp_ps(_a);
+}
+
+static FORCEINLINE ZSIMDF
+ZSimd_RsqrtEst(
+	_In_ ZSIMDF _a) {
+	return _mm_rsqrt_ps(_a);
+}
+#elif (ZSIMD_NEON)
+static FORCEINLINE ZSIMDF
+ZSimd_Load(
+	_In_ const Float* _p) {
+	return vld1q_f32(_p);
+}
+
+static FORCEINLINE Void
+ZSimd_Store(
+	_Out_ Float* _p,
+	_In_  ZSIMDF _a) {
+	vst1q_f32(_p, _a);
+}
+
+static FORCEINLINE ZSIMDF
+ZSimd_Set1(
+	_In_ Float _a) {
+	return vdupq_n_f32(_a);
+}
+
+static FORCEINLINE ZSIMDF
+ZSimd_Add(
+	_In_ ZSIMDF _a,
+	_In_ ZSIMDF _b) {
+	return vaddq_f32(_a, _b);
+}
+
+static FORCEINLINE ZSIMDF
+ZSimd_Sub(
+	_In_ ZSIMDF _a,
+	_In_ ZSIMDF _b) {
+	return vsubq_f32(_a, _b);
+}
+
+static FORCEINLINE ZSIMDF
+ZSimd_Mul(
+	_In_ ZSIMDF _a,
+	_In_ ZSIMDF _b) {
+	return vmulq_f32(_a, _b);
+}
+
+static FORCEINLINE ZSIMDF
+ZSimd_Div(
+	_In_ ZSIMDF _a,
+	_In_ ZSIMDF _b) {
+	return vdivq_f32(_a, _b);
+}
+
+static FORCEINLINE ZSIMDF
+ZSimd_Min(
+	_In_ ZSIMDF _a,
+	_In_ ZSIMDF _b) {
+	return vminq_f32(_a, _b);
+}
+
+static FORCEINLINE ZSIMDF
+ZSimd_Max(
+	_In_ ZSIMDF _a,
+	_In_ ZSIMDF _b) {
+	return vmaxq_f32(_a, _b);
+}
+
+static FORCEINLINE ZSIMDF
+ZSimd_Sqrt(
+	_In_ ZSIMDF _a) {
+	return vsqrtq_f32(_a);
+}
+
+static FORCEINLINE ZSIMDF
+ZSimd_CmpGt(
+	_In_ ZSIMDF _a,
+	_In_ ZSIMDF _b) {
+	return vreinterpretq_f32_u32(vcgtq_f32(_a, _b));
+}
+
+static FORCEINLINE ZSIMDF
+ZSimd_CmpLe(
+	_In_ ZSIMDF _a,
+	_In_ ZSIMDF _b) {
+	return vreinterpretq_f32_u32(vcleq_f32(_a, _b));
+}
+
+static FORCEINLINE ZSIMDF
+ZSimd_And(
+	_In_ ZSIMDF _mask,
+	_In_ ZSIMDF _a) {
+	return vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(_mask),
+		vreinterpretq_u32_f32(_a)));
+}
+
+static FORCEINLINE ZSIMDF
+ZSimd_Select(
+	_In_ ZSIMDF _mask,
+	_In_ ZSIMDF _a,
+	_In_ ZSIMDF _b) {
+	return vbslq_f32(vreinterpretq_u32_f32(_mask), _a, _b);
+}
+
+static FORCEINLINE Uint32
+ZSimd_MoveMask(
+	_In_ ZSIMDF _mask) {
+	static const int32_t shifts[4] = { 0, 1, 2, 3 };
+	uint32x4_t bits = vshlq_u32(
+		vshrq_n_u32(vreinterpretq_u32_f32(_mask), 31), vld1q_s32(shifts));
+	return vaddvq_u32(bits);
+}
+
+static FORCEINLINE ZSIMDF
+ZSimd_MulAdd(
+	_In_ ZSIMDF _a,
+	_In_ ZSIMDF _b,
+	_In_ ZSIMDF _c) {
+	return vfmaq_f32(_c, _a, _b);
+}
+
+static FORCEINLINE ZSIMDF
+ZSimd_Floor(
+	_In_ ZSIMDF _a) {
+	return vrndmq_f32(_a);
+}
+
+static FORCEINLINE ZSIMDF
+ZSimd_Abs(
+	_In_ ZSIMDF _a) {
+	return vabsq_f32(_a);
+}
+
+static FORCEINLINE ZSIMDF
+ZSimd_CopySign(
+	_In_ ZSIMDF _a,
+	_In_ ZSIMDF _b) {
+	return vbslq_f32(vdupq_n_u32(0x80000000), _b, _a);
+}
+
+static FORCEINLINE ZSIMDF
+ZSimd_Pow2i(
+	_In_ ZSIMDF _n) {
+	return vreinterpretq_f32_s32(vshlq_n_s32(vaddq_s32(vcvtq_s32_f32(_n),
+		vdupq_n_s32(127)), 23));
+}
+
+static FORCEINLINE ZSIMDF
+ZSimd_Exponent(
+	_In_ ZSIMDF _a) {
+	return vcvtq_f32_s32(vsubq_s32(vreinterpretq_s32_u32(vshrq_n_u32(
+		vreinterpretq_u32_f32(_a), 23)), vdupq_n_s32(127)));
+}
+
+static FORCEINLINE ZSIMDF
+ZSimd_Mantissa(
+	_In_ ZSIMDF _a) {
+	return vreinterpretq_f32_u32(vorrq_u32(vandq_u32(vreinterpretq_u32_f32(_a),
+		vdupq_n_u32(0x007FFFFF)), vdupq_n_u32(0x3F800000)));
+}
+
+static FORCEINLINE ZSIMDF
+ZSimd_RcpEst(
+	_In_ ZSIMDF _a) {
+	ZSIMDF e = vrecpeq_f32(_a);
+	return vmulq_f32(e, vrecpsq_f32(_a, e));
+}
+
+static FORCEINLINE ZSIMDF
+ZSimd_RsqrtEst(
+	_In_ ZSIMDF _a) {
+	ZSIMDF e = vrsqrteq_f32(_a);
+	return vmulq_f32(e, vrsqrtsq_f32(vmulq_f32(e, e), _a));
+}
+#else
+static FORCEINLINE ZSIMDF
+ZSimd_Load(
+	_In_ const Float* _p) {
+	return *_p;
+}
+
+static FORCEINLINE Void
+ZSimd_Store(
+	_Out_ Float* _p,
+	_In_  ZSIMDF _a) {
+	*_p = _a;
+}
+
+static FORCEINLINE ZSIMDF
+ZSimd_Set1(
+	_In_ Float _a) {
+	return _a;
+}
+
+static FORCEINLINE ZSIMDF
+ZSimd_Add(
+	_In_ ZSIMDF _a,
+	_In_ ZSIMDF _b) {
+	return _a + _b;
+}
+
+static FORCEINLINE ZSIMDF
+ZSimd_Sub(
+	_In_ ZSIMDF _a,
+	_In_ ZSIMDF _b) {
+	return _a - _b;
+}
+
+static FORCEINLINE ZSIMDF
+ZSimd_Mul(
+	_In_ ZSIMDF _a,
+	_In_ ZSIMDF _b) {
+	return _a * _b;
+}
+
+static FORCEINLINE ZSIMDF
+ZSimd_Div(
+	_In_ ZSIMDF _a,
+	_In_ ZSIMDF _b) {
+	return _a / _b;
+}
+
+static FORCEINLINE ZSIMDF
+ZSimd_Min(
+	_In_ ZSIMDF _a,
+	_In_ ZSIMDF _b) {
+	return _a < _b ? _a : _b;
+}
+
+static FORCEINLINE ZSIMDF
+ZSimd_Max(
+	_In_ ZSIMDF _a,
+	_In_ ZSIMDF _b) {
+	return _a > _b ? _a : _b;
+}
+
+static FORCEINLINE ZSIMDF
+ZSimd_Sqrt(
+	_In_ ZSIMDF _a) {
+	return sqrtf(_a);
+}
+
+static FORCEINLINE ZSIMDF
+ZSimd_CmpGt(
+	_In_ ZSIMDF _a,
+	_In_ ZSIMDF _b) {
+	return (Float)(_a > _b);
+}
+
+static FORCEINLINE ZSIMDF
+ZSimd_CmpLe(
+	_In_ ZSIMDF _a,
+	_In_ ZSIMDF _b) {
+	return (Float)(_a <= _b);
+}
+
+static FORCEINLINE ZSIMDF
+ZSimd_And(
+	_In_ ZSIMDF _mask,
+	_In_ ZSIMDF _a) {
+	return _mask != 0 ? _a : 0.0f;
+}
+
+static FORCEINLINE ZSIMDF
+ZSimd_Select(
+	_In_ ZSIMDF _mask,
+	_In_ ZSIMDF _a,
+	_In_ ZSIMDF _b) {
+	return _mask != 0 ? _a : _b;
+}
+
+static FORCEINLINE Uint32
+ZSimd_MoveMask(
+	_In_ ZSIMDF _mask) {
+	return _mask != 0;
+}
+
+static FORCEINLINE ZSIMDF
+ZSimd_MulAdd(
+	_In_ ZSIMDF _a,
+	_In_ ZSIMDF _b,
+	_In_ ZSIMDF _c) {
+	return _a * _b + _c;
+}
+
+static FORCEINLINE ZSIMDF
+ZSimd_Floor(
+	_In_ ZSIMDF _a) {
+	return floorf(_a);
+}
+
+static FORCEINLINE ZSIMDF
+ZSimd_Abs(
+	_In_ ZSIMDF _a) {
+	return fabsf(_a);
+}
+
+static FORCEINLINE ZSIMDF
+ZSimd_CopySign(
+	_In_ ZSIMDF _a,
+	_In_ ZSIMDF _b) {
+	return copysignf(_a, _b);
+}
+
+static FORCEINLINE ZSIMDF
+ZSimd_Pow2i(
+	_In_ ZSIMDF _n) {
+	return ldexpf(1.0f, (int)_n);
+}
+
+static FORCEINLINE ZSIMDF
+ZSimd_Exponent(
+	_In_ ZSIMDF _a) {
+	int e;
+	frexpf(_a, &e);
+	return (Float)(e - 1);
+}
+
+static FORCEINLINE ZSIMDF
+ZSimd_Mantissa(
+	_In_ ZSIMDF _a) {
+	int e;
+	return 2.0f * frexpf(_a, &e);
+}
+
+static FORCEINLINE ZSIMDF
+ZSimd_RcpEst(
+	_In_ ZSIMDF _a) {
+	return 1.0f / _a;
+}
+
+static FORCEINLINE ZSIMDF
+ZSimd_RsqrtEst(
+	_In_ ZSIMDF _a) {
+	return 1.0f / sqrtf(_a);
+}
+#endif
+
+
+
+#if defined(__cplusplus)
+}
+#endif
+/*****************************************************************************/  
+#endif //EOF
+/*****************************************************************************/  
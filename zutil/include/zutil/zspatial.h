@@ -0,0 +1,314 @@
+/******************************************************************************
+* zutil - C Utility Library
+* Copyright (C) 2017-2021 Zachary T Harris. All Rights Reserved.  
+* Zlib license.
+* 
+* File: zspatial.h
+* Desc: spatial indexes over rectangles: uniform hash grid and dynamic AABB tree
+*******************************************************************************
+
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+******************************************************************************/ 
+#ifndef __ZSPATIAL_H__
+#define __ZSPATIAL_H__
+
+#include "zrect.h"
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+
+
+/*
+Both indexes store rects under integer proxy ids returned on insertion,
+each with a user data handle. The ids of removed proxies are reused.
+Queries follow the pairwise ZRect functions: a rect is reported when
+its intersection with the query rect has a positive area, and a point
+is reported inside a rect on its left and top edges but not on its 
+right and bottom edges. Rects may have negative width or height.
+
+Queries report each match once, in no particular order, and may be run
+from several threads at once while the index is not being modified.*/
+
+/*
+Receives a proxy matching a query.
+@_id      : the proxy id
+@_hData   : the data handle given on insertion
+@_hContext: the context handle given to the query
+@return   : true to continue the query, false to stop it*/
+typedef Bool(*ZSpatialQueryFn)(
+	Int32  _id, 
+	Handle _hData, 
+	Handle _hContext);
+
+/*
+Receives a pair of overlapping proxies, _idA < _idB.
+@return: true to continue, false to stop*/
+typedef Bool(*ZSpatialPairFn)(
+	Int32  _idA, 
+	Handle _hDataA, 
+	Int32  _idB, 
+	Handle _hDataB, 
+	Handle _hContext);
+
+/*
+A uniform grid of square cells, hashed into a table of buckets so that
+only occupied cells cost memory. Each proxy is entered in every cell it
+touches, so the grid suits many objects of similar size with a cell 
+a little larger than a typical object; a proxy spanning k cells costs
+k entries to insert, move and remove.*/
+typedef struct _ZSpatialGrid ZSpatialGrid;
+
+/*
+A dynamic bounding volume tree. Leaves hold each proxy's rect enlarged
+by a margin, so that a proxy moving inside its enlarged rect only needs
+its stored rect updated. The tree is kept balanced by rotations and 
+suits objects of mixed sizes.*/
+typedef struct _ZSpatialTree ZSpatialTree;
+
+
+
+
+
+/*
+Uniform grid:
+******************************************************************************/
+/*
+Create an empty grid.
+@_cellSize: width and height of a cell, must be positive
+@_capacity: number of proxies to reserve room for, may be 0
+@_lpResult: Z_OK on success, non-zero on failure (optional, can be NULL)
+@return   : an allocated grid, or NULL on failure
+            !must call ZSpatialGrid_Release when finished using it!*/
+extern ZSpatialGrid* ZAPI
+ZSpatialGrid_Create(
+	_In_        Float    _cellSize,
+	_In_        SizeT    _capacity,
+	_Inout_opt_ ZRESULT* _lpResult);
+
+/*
+Destroy a grid.
+@_lpGrid: the grid to destroy*/
+extern Void ZAPI
+ZSpatialGrid_Release(
+	_Inout_ ZSpatialGrid* _lpGrid);
+
+/*
+Add a rect to a grid.
+@_lpGrid: the grid
+@_rect  : the bounds of the new proxy
+@_hData : a handle passed back by queries
+@return : the proxy id, or Z_UNDEFINED if memory could not be allocated*/
+extern Int32 ZAPI
+ZSpatialGrid_Insert(
+	_Inout_ ZSpatialGrid* _lpGrid,
+	_In_    const ZRECT*  _rect,
+	_In_    Handle        _hData);
+
+/*
+Move a proxy. Only the cells it enters or leaves are touched.
+@_lpGrid: the grid
+@_id    : the proxy to move
+@_rect  : its new bounds
+@return : Z_OK, or Z_EOUTOFMEMORY (the proxy is left unchanged)*/
+extern ZRESULT ZAPI
+ZSpatialGrid_Update(
+	_Inout_ ZSpatialGrid* _lpGrid,
+	_In_    Int32         _id,
+	_In_    const ZRECT*  _rect);
+
+/*
+Remove a proxy from a grid, its id may be reused by a later insertion.
+@_lpGrid: the grid
+@_id    : the proxy to remove*/
+extern Void ZAPI
+ZSpatialGrid_Remove(
+	_Inout_ ZSpatialGrid* _lpGrid,
+	_In_    Int32         _id);
+
+/*
+Returns the data handle of a proxy*/
+extern Handle ZAPI
+ZSpatialGrid_GetData(
+	_In_ const ZSpatialGrid* _lpGrid,
+	_In_ Int32               _id);
+
+/*
+Returns the number of proxies in a grid*/
+extern SizeT ZAPI
+ZSpatialGrid_GetCount(
+	_In_ const ZSpatialGrid* _lpGrid);
+
+/*
+Reports the proxies overlapping a rect. Queries spanning more cells 
+than there are proxies test every proxy instead.
+@_lpGrid  : the grid
+@_rect    : the rect to test
+@_fn      : receives each match
+@_hContext: passed to _fn
+@return   : number of matches reported*/
+extern SizeT ZAPI
+ZSpatialGrid_QueryRect(
+	_In_ const ZSpatialGrid* _lpGrid,
+	_In_ const ZRECT*        _rect,
+	_In_ ZSpatialQueryFn     _fn,
+	_In_ Handle              _hContext);
+
+/*
+Reports the proxies containing a point.
+@return: number of matches reported*/
+extern SizeT ZAPI
+ZSpatialGrid_QueryPoint(
+	_In_ const ZSpatialGrid* _lpGrid,
+	_In_ Float               _x,
+	_In_ Float               _y,
+	_In_ ZSpatialQueryFn     _fn,
+	_In_ Handle              _hContext);
+
+/*
+Reports every pair of overlapping proxies once.
+@return: number of pairs reported*/
+extern SizeT ZAPI
+ZSpatialGrid_QueryPairs(
+	_In_ const ZSpatialGrid* _lpGrid,
+	_In_ ZSpatialPairFn      _fn,
+	_In_ Handle              _hContext);
+
+
+
+
+
+/*
+Dynamic AABB tree:
+******************************************************************************/
+/*
+Create an empty tree.
+@_margin  : distance by which stored rects are enlarged on every side,
+            0 refits the tree on every update
+@_capacity: number of proxies to reserve room for, may be 0
+@_lpResult: Z_OK on success, non-zero on failure (optional, can be NULL)
+@return   : an allocated tree, or NULL on failure
+            !must call ZSpatialTree_Release when finished using it!*/
+extern ZSpatialTree* ZAPI
+ZSpatialTree_Create(
+	_In_        Float    _margin,
+	_In_        SizeT    _capacity,
+	_Inout_opt_ ZRESULT* _lpResult);
+
+/*
+Destroy a tree.
+@_lpTree: the tree to destroy*/
+extern Void ZAPI
+ZSpatialTree_Release(
+	_Inout_ ZSpatialTree* _lpTree);
+
+/*
+Add a rect to a tree.
+@_lpTree: the tree
+@_rect  : the bounds of the new proxy
+@_hData : a handle passed back by queries
+@return : the proxy id, or Z_UNDEFINED if memory could not be allocated*/
+extern Int32 ZAPI
+ZSpatialTree_Insert(
+	_Inout_ ZSpatialTree* _lpTree,
+	_In_    const ZRECT*  _rect,
+	_In_    Handle        _hData);
+
+/*
+Move a proxy. The tree is only restructured when the new rect leaves 
+the enlarged rect stored for the proxy.
+@_lpTree: the tree
+@_id    : the proxy to move
+@_rect  : its new bounds
+@return : true if the proxy was reinserted*/
+extern Bool ZAPI
+ZSpatialTree_Update(
+	_Inout_ ZSpatialTree* _lpTree,
+	_In_    Int32         _id,
+	_In_    const ZRECT*  _rect);
+
+/*
+Remove a proxy from a tree, its id may be reused by a later insertion.
+@_lpTree: the tree
+@_id    : the proxy to remove*/
+extern Void ZAPI
+ZSpatialTree_Remove(
+	_Inout_ ZSpatialTree* _lpTree,
+	_In_    Int32         _id);
+
+/*
+Returns the data handle of a proxy*/
+extern Handle ZAPI
+ZSpatialTree_GetData(
+	_In_ const ZSpatialTree* _lpTree,
+	_In_ Int32               _id);
+
+/*
+Returns the number of proxies in a tree*/
+extern SizeT ZAPI
+ZSpatialTree_GetCount(
+	_In_ const ZSpatialTree* _lpTree);
+
+/*
+Returns the height of a tree, 0 when it is empty or holds one proxy*/
+extern Int32 ZAPI
+ZSpatialTree_GetHeight(
+	_In_ const ZSpatialTree* _lpTree);
+
+/*
+Reports the proxies overlapping a rect.
+@_lpTree  : the tree
+@_rect    : the rect to test
+@_fn      : receives each match
+@_hContext: passed to _fn
+@return   : number of matches reported*/
+extern SizeT ZAPI
+ZSpatialTree_QueryRect(
+	_In_ const ZSpatialTree* _lpTree,
+	_In_ const ZRECT*        _rect,
+	_In_ ZSpatialQueryFn     _fn,
+	_In_ Handle              _hContext);
+
+/*
+Reports the proxies containing a point.
+@return: number of matches reported*/
+extern SizeT ZAPI
+ZSpatialTree_QueryPoint(
+	_In_ const ZSpatialTree* _lpTree,
+	_In_ Float               _x,
+	_In_ Float               _y,
+	_In_ ZSpatialQueryFn     _fn,
+	_In_ Handle              _hContext);
+
+/*
+Reports every pair of overlapping proxies once.
+@return: number of pairs reported*/
+extern SizeT ZAPI
+ZSpatialTree_QueryPairs(
+	_In_ const ZSpatialTree* _lpTree,
+	_In_ ZSpatialPairFn      _fn,
+	_In_ Handle              _hContext);
+
+
+
+#if defined(__cplusplus)
+}
+#endif
+/*****************************************************************************/  
+#endif //EOF
+/*****************************************************************************/  
@@ -0,0 +1,270 @@
+/******************************************************************************
+* zutil - C Utility Library
+* Copyright (C) 2017-2021 Zachary T Harris. All Rights Reserved.  
+* Zlib license.
+* 
+* File: zstr.h
+* Desc: length-tracked string with small-string optimization
+*******************************************************************************
+
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+******************************************************************************/ 
+#ifndef __ZSTR_H__
+#define __ZSTR_H__
+
+#include "zcore.h"
+#include "zstrview.h"
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+
+
+#define ZSTR_INLINE_CAPACITY 22   //longest string held without allocating
+#define ZSTR_TAG_HEAP        0xFF //tag value of a heap allocated string
+
+/*
+A string that tracks its own length and capacity.
+Strings of up to ZSTR_INLINE_CAPACITY bytes are stored inline, 
+longer strings are moved to the heap and grow geometrically.
+The last inline byte is a tag holding the inline length, 
+or ZSTR_TAG_HEAP once the characters live on the heap.
+The characters are always followed by a null terminator, 
+but may themselves contain null characters.
+A zero filled ZSTR (Z_INITZERO) is a valid empty string.*/
+typedef union _ZSTR {
+	struct {
+		Char*  lpData;    //heap allocated characters
+		SizeT  iLength;   //length in bytes, excluding the terminator
+		Uint32 iCapacity; //usable bytes, excluding the terminator
+	} heap;
+	Char sso[ZSTR_INLINE_CAPACITY + 2]; //inline characters, terminator, tag
+} ZSTR;
+
+
+
+/*
+Accessors:
+******************************************************************************/
+static FORCEINLINE Bool
+ZStr_IsInline(_In_ const ZSTR* _str) {
+	return (Byte)_str->sso[ZSTR_INLINE_CAPACITY + 1] != ZSTR_TAG_HEAP;
+}
+
+static FORCEINLINE SizeT
+ZStr_Length(_In_ const ZSTR* _str) {
+	return ZStr_IsInline(_str) ?
+		(SizeT)(Byte)_str->sso[ZSTR_INLINE_CAPACITY + 1] :
+		_str->heap.iLength;
+}
+
+static FORCEINLINE SizeT
+ZStr_Capacity(_In_ const ZSTR* _str) {
+	return ZStr_IsInline(_str) ?
+		ZSTR_INLINE_CAPACITY : (SizeT)_str->heap.iCapacity;
+}
+
+static FORCEINLINE Char*
+ZStr_Data(_Inout_ ZSTR* _str) {
+	return ZStr_IsInline(_str) ? _str->sso : _str->heap.lpData;
+}
+
+static FORCEINLINE Lpcstr
+ZStr_CStr(_In_ const ZSTR* _str) {
+	return ZStr_IsInline(_str) ? _str->sso : _str->heap.lpData;
+}
+
+
+
+/*
+Lifetime:
+******************************************************************************/
+/*
+Initializes an empty string, no memory is allocated.
+@_str: the string to initialize*/
+extern Void ZAPI
+ZStr_Init(
+	_Out_ ZSTR* _str);
+
+/*
+Initializes a string with a copy of the given characters.
+@_str  : the string to initialize
+@_src  : the characters to copy (need not be null-terminated)
+@_len  : number of bytes to copy
+@return: Z_OK, or Z_EOUTOFMEMORY (_str is then left empty)*/
+extern ZRESULT ZAPI
+ZStr_InitN(
+	_Out_ ZSTR*  _str,
+	_In_  Lpcstr _src,
+	_In_  SizeT  _len);
+
+/*
+Releases the memory owned by a string and leaves it empty.
+@_str: the string to release*/
+extern Void ZAPI
+ZStr_Free(
+	_Inout_ ZSTR* _str);
+
+/*
+Ensures the string can hold at least _capacity bytes without reallocating.
+@_str     : the string to grow
+@_capacity: required capacity in bytes, excluding the terminator
+@return   : Z_OK, or Z_EOUTOFMEMORY (the string is left unchanged)*/
+extern ZRESULT ZAPI
+ZStr_Reserve(
+	_Inout_ ZSTR* _str,
+	_In_    SizeT _capacity);
+
+/*
+Empties a string while keeping its capacity, so it can be refilled 
+without allocating.
+@_str: the string to clear*/
+extern Void ZAPI
+ZStr_Clear(
+	_Inout_ ZSTR* _str);
+
+/*
+Shortens a string to the given length, longer lengths are ignored.
+@_str: the string to truncate
+@_len: the new length in bytes*/
+extern Void ZAPI
+ZStr_Truncate(
+	_Inout_ ZSTR* _str,
+	_In_    SizeT _len);
+
+
+
+/*
+Modifiers:
+******************************************************************************/
+/*
+Appends characters to the end of a string.
+Growth is geometric, so repeated appends run in amortized constant time.
+@_str  : the string to append to
+@_src  : the characters to append (may point into _str)
+@_len  : number of bytes to append
+@return: Z_OK, or Z_EOUTOFMEMORY (the string is left unchanged)*/
+extern ZRESULT ZAPI
+ZStr_Append(
+	_Inout_ ZSTR*  _str,
+	_In_    Lpcstr _src,
+	_In_    SizeT  _len);
+
+/*
+Appends a single character to the end of a string.
+@_str  : the string to append to
+@_char : the character to append
+@return: Z_OK, or Z_EOUTOFMEMORY (the string is left unchanged)*/
+extern ZRESULT ZAPI
+ZStr_AppendChar(
+	_Inout_ ZSTR* _str,
+	_In_    Char  _char);
+
+/*
+Replaces the contents of a string with a copy of the given characters.
+@_str  : the string to assign to
+@_src  : the characters to copy (may point into _str)
+@_len  : number of bytes to copy
+@return: Z_OK, or Z_EOUTOFMEMORY (the string is left empty)*/
+extern ZRESULT ZAPI
+ZStr_Assign(
+	_Inout_ ZSTR*  _str,
+	_In_    Lpcstr _src,
+	_In_    SizeT  _len);
+
+/*
+Transforms a string to all lowercase.
+@_str: the string to transform*/
+extern Void ZAPI
+ZStr_ToLower(
+	_Inout_ ZSTR* _str);
+
+/*
+Transforms a string to all uppercase.
+@_str: the string to transform*/
+extern Void ZAPI
+ZStr_ToUpper(
+	_Inout_ ZSTR* _str);
+
+
+
+/*
+Views and queries:
+******************************************************************************/
+/*
+Returns a view of the whole string.
+@_str  : the string to view
+@return: a view, valid until the string is next modified*/
+extern ZSTRVIEW ZAPI
+ZStr_View(
+	_In_ const ZSTR* _str);
+
+/*
+Returns a view of the characters between two indexes, without copying.
+Indexes past the end of the string are clamped to its length.
+@_str  : the string to slice
+@_begin: index of the first character
+@_end  : index one past the last character
+@return: a view, valid until the string is next modified*/
+extern ZSTRVIEW ZAPI
+ZStr_Slice(
+	_In_ const ZSTR* _str,
+	_In_ SizeT       _begin,
+	_In_ SizeT       _end);
+
+/*
+Compares two strings while ignoring differences in case.
+@return: (< 0), (= 0) or (> 0) as for ZString_CaseCmpEx*/
+extern Int32 ZAPI
+ZStr_CaseCmp(
+	_In_ const ZSTR* _str1,
+	_In_ const ZSTR* _str2);
+
+/*
+Compares two strings byte by byte.
+@return: (< 0), (= 0) or (> 0), a string that is
+         a prefix of the other compares less*/
+extern Int32 ZAPI
+ZStr_Compare(
+	_In_ const ZSTR* _str1,
+	_In_ const ZSTR* _str2);
+
+/*
+Returns the first index of a character within a string.
+@return: index of char in the string, or -1 if not present*/
+extern Intptr ZAPI
+ZStr_Find(
+	_In_ const ZSTR* _str,
+	_In_ Char        _char);
+
+/*
+Returns the last index of a character within a string.
+@return: index of char in the string, or -1 if not present*/
+extern Intptr ZAPI
+ZStr_FindLast(
+	_In_ const ZSTR* _str,
+	_In_ Char        _char);
+
+
+
+#if defined(__cplusplus)
+}
+#endif
+/*****************************************************************************/  
+#endif //EOF
+/*****************************************************************************/  
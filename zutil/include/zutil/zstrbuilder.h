@@ -0,0 +1,189 @@
+/******************************************************************************
+* zutil - C Utility Library
+* Copyright (C) 2017-2021 Zachary T Harris. All Rights Reserved.  
+* Zlib license.
+* 
+* File: zstrbuilder.h
+* Desc: incremental string assembly without rescanning
+*******************************************************************************
+
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+******************************************************************************/ 
+#ifndef __ZSTRBUILDER_H__
+#define __ZSTRBUILDER_H__
+
+#include "zcore.h"
+#include "zstr.h"
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+
+
+/*
+Assembles a string from pieces, tracking the length so that no append 
+rescans what was already written. The buffer is either owned by the 
+builder and grows as needed, or provided by the caller with a fixed size.
+Appends never fail individually: the first error is recorded in zresult,
+the output is truncated to what fit and later appends are ignored until 
+the builder is reset. The characters are always null-terminated.*/
+typedef struct _ZSTRBUILDER {
+	Char*   lpData;    //characters written so far
+	SizeT   iLength;   //length in bytes, excluding the terminator
+	SizeT   iCapacity; //usable bytes, excluding the terminator
+	Bool    bGrowable; //buffer is owned by the builder and may be reallocated
+	ZRESULT zresult;   //first error since the last reset
+} ZSTRBUILDER;
+
+
+
+/*
+Accessors:
+******************************************************************************/
+static FORCEINLINE Lpcstr
+ZStrBuilder_CStr(_In_ const ZSTRBUILDER* _sb) {
+	return _sb->lpData;
+}
+
+static FORCEINLINE SizeT
+ZStrBuilder_Length(_In_ const ZSTRBUILDER* _sb) {
+	return _sb->iLength;
+}
+
+static FORCEINLINE ZRESULT
+ZStrBuilder_GetResult(_In_ const ZSTRBUILDER* _sb) {
+	return _sb->zresult;
+}
+
+
+
+/*
+Lifetime:
+******************************************************************************/
+/*
+Initializes a builder that owns a growable heap buffer.
+@_sb      : the builder to initialize
+@_capacity: initial capacity in bytes, excluding the terminator
+@return   : Z_OK, or Z_EOUTOFMEMORY*/
+extern ZRESULT ZAPI
+ZStrBuilder_Init(
+	_Out_ ZSTRBUILDER* _sb,
+	_In_  SizeT        _capacity);
+
+/*
+Initializes a builder over a caller provided buffer (stack, arena, ...).
+The buffer is never reallocated, appends that do not fit are truncated 
+and raise Z_EOUTOFMEMORY.
+@_sb    : the builder to initialize
+@_buffer: the buffer to write into
+@_size  : size of _buffer in bytes, including room for the terminator*/
+extern Void ZAPI
+ZStrBuilder_InitBuffer(
+	_Out_   ZSTRBUILDER* _sb,
+	_Inout_ Char*        _buffer,
+	_In_    SizeT        _size);
+
+/*
+Releases the buffer of a growable builder. 
+Caller provided buffers are left to the caller.
+@_sb: the builder to release*/
+extern Void ZAPI
+ZStrBuilder_Free(
+	_Inout_ ZSTRBUILDER* _sb);
+
+/*
+Empties the builder and clears its error while keeping the buffer,
+so steady-state building does not allocate.
+@_sb: the builder to reset*/
+extern Void ZAPI
+ZStrBuilder_Reset(
+	_Inout_ ZSTRBUILDER* _sb);
+
+
+
+/*
+Appenders:
+******************************************************************************/
+/*
+Appends a single character.*/
+extern Void ZAPI
+ZStrBuilder_AppendChar(
+	_Inout_ ZSTRBUILDER* _sb,
+	_In_    Char         _char);
+
+/*
+Appends _len characters, which need not be null-terminated.*/
+extern Void ZAPI
+ZStrBuilder_AppendN(
+	_Inout_ ZSTRBUILDER* _sb,
+	_In_    Lpcstr       _src,
+	_In_    SizeT        _len);
+
+/*
+Appends a null-terminated string.*/
+extern Void ZAPI
+ZStrBuilder_AppendStr(
+	_Inout_ ZSTRBUILDER* _sb,
+	_In_    Lpcstr       _src);
+
+/*
+Appends the characters referred to by a view.*/
+extern Void ZAPI
+ZStrBuilder_AppendView(
+	_Inout_ ZSTRBUILDER* _sb,
+	_In_    ZSTRVIEW     _view);
+
+/*
+Appends a signed integer in decimal.*/
+extern Void ZAPI
+ZStrBuilder_AppendInt(
+	_Inout_ ZSTRBUILDER* _sb,
+	_In_    Int64        _value);
+
+/*
+Appends an unsigned integer in decimal.*/
+extern Void ZAPI
+ZStrBuilder_AppendUint(
+	_Inout_ ZSTRBUILDER* _sb,
+	_In_    Uint64       _value);
+
+/*
+Appends a floating-point value in fixed notation (see ZFormat_DoubleFixed).
+@_decPlaces: number of decimal places to print (clamped to 0-17)*/
+extern Void ZAPI
+ZStrBuilder_AppendFloat(
+	_Inout_ ZSTRBUILDER* _sb,
+	_In_    Real64       _value,
+	_In_    Int32        _decPlaces);
+
+/*
+Appends the shortest text that reads back as the same double
+(see ZFormat_Double).*/
+extern Void ZAPI
+ZStrBuilder_AppendDouble(
+	_Inout_ ZSTRBUILDER* _sb,
+	_In_    Real64       _value);
+
+
+
+#if defined(__cplusplus)
+}
+#endif
+/*****************************************************************************/  
+#endif //EOF
+/*****************************************************************************/  
@@ -27,13 +27,36 @@ freely, subject to the following restrictions:
 #ifndef __ZSTRING_H__
 #define __ZSTRING_H__  
 
-#include "zcore.h" 
+#include "zarena.h" 
 #if defined(__cplusplus)
 extern "C" {
 #endif
 
 	 
 
+#define ZSTRING_FTOA_SIZE 64 //buffer size for ZString_Ftoa with any float
+
+
+
+/*
+A set of byte values for ZString_FindAny, built with ZString_CharSetInit.
+Besides the membership bitmap it keeps two nibble-indexed tables so that
+vector units can classify a block of bytes with two table lookups.*/
+typedef struct _ZCHARSET {
+	Uint32 bits[8];   //membership bitmap, one bit per byte value
+	Byte   lower[16]; //by low nibble, bit h: byte (h << 4 | lo) for h < 8
+	Byte   upper[16]; //by low nibble, bit h: byte ((h + 8) << 4 | lo)
+}ZCHARSET;
+
+static FORCEINLINE Bool
+ZString_CharSetHas(
+	_In_ const ZCHARSET* _set,
+	_In_ Char            _char) {
+
+	return (_set->bits[(Byte)_char >> 5] >> ((Byte)_char & 31)) & 1;
+}
+
+
 /*(C) 
 Append a char to the end of a string.
 @_str : the string to append to
@@ -65,6 +88,17 @@ extern Char* ZAPI
 ZString_Copy(
 	_In_ Lpcstr _src);
 
+/*(C) 
+Duplicate the given source string into memory taken from an arena,
+it is freed with the arena rather than on its own.
+@_lpArena: the arena to allocate from
+@_src    : the source string to duplicate
+@return  : the copy, or NULL if _src is NULL or the arena is exhausted*/
+extern Char* ZAPI 
+ZString_CopyArena(
+	_Inout_ ZArena* _lpArena,
+	_In_    Lpcstr  _src);
+
 /*(C) 
 Returns the last index of a character if it is present
 within the given string, otherwise returns -1
@@ -77,10 +111,12 @@ ZString_FindLastOf(
 	_In_ Char   _char); 
 
 /*(C) 
-Convert a float value to equivalent string. 
+Convert a float value to equivalent string (see ZFormat_DoubleFixed). 
+Values below 2^31 in magnitude take at most 12 + _decPlaces characters
+and the terminator; any float fits in ZSTRING_FTOA_SIZE bytes.
 @_fValue   : the float value to convert
-@_dst      : the destination string (preallocated)
-@_decPlaces: number of decimal places to print*/
+@_dst      : the destination string (preallocated, see above)
+@_decPlaces: number of decimal places to print (clamped to 0-17)*/
 extern Void ZAPI
 ZString_Ftoa(
 	_In_    Float _fValue,
@@ -109,19 +145,33 @@ ZString_Strlcpy(
 	_In_    Uint32 _dstlen);
 
 /*(C) 
-Get a substring between the given start and end indexes.
+Get a substring between the given start and end indexes, 
+indexes past the end of the source are clamped to its length.
+ZStrView_Sub returns the same range without copying.
 !WARNING! - This function returns a string allocated with malloc. 
             Caller is responsible for deallocating it with free.
 @_src  : source string
 @_begin: first index
-@_end  : last index
-@return: the resulting string (must be freed)*/
+@_end  : index one past the last character
+@return: the resulting null-terminated string (must be freed)*/
 extern Char* ZAPI
 ZString_SubStr(
 	_In_ Lpcstr _src,
 	_In_ Uint32 _begin,
 	_In_ Uint32 _end);
 
+/*(C) 
+Get a substring as ZString_SubStr, in memory taken from an arena.
+@_lpArena: the arena to allocate from
+@return  : the resulting null-terminated string, or NULL if _end is 
+           before _begin or the arena is exhausted*/
+extern Char* ZAPI
+ZString_SubStrArena(
+	_Inout_ ZArena* _lpArena,
+	_In_    Lpcstr  _src,
+	_In_    Uint32  _begin,
+	_In_    Uint32  _end);
+
 /*(C)
 Converts the given string to a boolean value (integer).  
 @_str  : the string to convert to boolean value
@@ -170,6 +220,135 @@ ZString_StrCaseCmpN(
 	_In_ Lpcstr _cStr2, 
 	_In_ Int32  _iEndPoint); 
 
+/*(C)
+Compares two strings of explicit length while ignoring differences in case.
+The strings need not be null-terminated and may contain null characters.
+@_str1 : a string to compare with _str2
+@_len1 : length of _str1 in bytes
+@_str2 : a string to compare with _str1
+@_len2 : length of _str2 in bytes
+@return: (< 0), (= 0) or (> 0) as for ZString_CaseCmp, 
+         a string that is a prefix of the other compares less*/
+extern Int32 ZAPI
+ZString_CaseCmpEx(
+	_In_ Lpcstr _str1,
+	_In_ SizeT  _len1,
+	_In_ Lpcstr _str2,
+	_In_ SizeT  _len2);
+
+/*(C)
+Determines whether two strings of the same explicit length are equal 
+while ignoring differences in case.
+@_str1 : a string to compare with _str2
+@_str2 : a string to compare with _str1
+@_len  : length of both strings in bytes
+@return: true if the strings are equal, else false*/
+extern Bool ZAPI
+ZString_CaseEqualEx(
+	_In_ Lpcstr _str1,
+	_In_ Lpcstr _str2,
+	_In_ SizeT  _len);
+
+/*(C) 
+Returns the first index of a character within a string of explicit length.
+@_str  : the string to search
+@_len  : length of _str in bytes
+@_char : the char to search for
+@return: index of char in the string, or -1 if not present*/
+extern Intptr ZAPI
+ZString_FindOfEx(
+	_In_ Lpcstr _str,
+	_In_ SizeT  _len,
+	_In_ Char   _char);
+
+/*(C) 
+Returns the last index of a character within a string of explicit length.
+@_str  : the string to search
+@_len  : length of _str in bytes
+@_char : the char to search for
+@return: index of char in the string, or -1 if not present*/
+extern Intptr ZAPI
+ZString_FindLastOfEx(
+	_In_ Lpcstr _str,
+	_In_ SizeT  _len,
+	_In_ Char   _char);
+
+/*(C) 
+Returns the first index of a substring within a string of explicit length.
+Candidates are found a vector block at a time by matching the first and 
+last byte of _sub; inputs that produce many false candidates switch to 
+the Two-Way algorithm, so the search is linear in the worst case.
+@_str   : the string to search
+@_len   : length of _str in bytes
+@_sub   : the substring to search for, need not be null-terminated
+@_sublen: length of _sub in bytes
+@return : index of _sub in the string, 0 if _sub is empty, 
+          or -1 if not present*/
+extern Intptr ZAPI
+ZString_Find(
+	_In_ Lpcstr _str,
+	_In_ SizeT  _len,
+	_In_ Lpcstr _sub,
+	_In_ SizeT  _sublen);
+
+/*(C) 
+Returns the last index of a substring within a string of explicit length,
+searching backwards with the same guarantees as ZString_Find.
+@_str   : the string to search
+@_len   : length of _str in bytes
+@_sub   : the substring to search for, need not be null-terminated
+@_sublen: length of _sub in bytes
+@return : index of _sub in the string, _len if _sub is empty, 
+          or -1 if not present*/
+extern Intptr ZAPI
+ZString_FindLast(
+	_In_ Lpcstr _str,
+	_In_ SizeT  _len,
+	_In_ Lpcstr _sub,
+	_In_ SizeT  _sublen);
+
+/*(C) 
+Builds a character set from a list of bytes.
+@_set  : the set to initialize
+@_chars: the member bytes, need not be null-terminated
+@_len  : number of bytes in _chars*/
+extern Void ZAPI
+ZString_CharSetInit(
+	_Inout_ ZCHARSET* _set,
+	_In_    Lpcstr    _chars,
+	_In_    SizeT     _len);
+
+/*(C) 
+Returns the first index of any member of a character set within a string
+of explicit length, the counterpart of strpbrk. 
+@_str  : the string to search
+@_len  : length of _str in bytes
+@_set  : the characters to search for
+@return: index of the first member in the string, or -1 if not present*/
+extern Intptr ZAPI
+ZString_FindAny(
+	_In_ Lpcstr          _str,
+	_In_ SizeT           _len,
+	_In_ const ZCHARSET* _set);
+
+/*(C)
+Transforms the first _len bytes of a string to lowercase.
+@_str: the string to be transformed
+@_len: number of bytes to transform*/
+extern Void ZAPI
+ZString_ToLowerEx(
+	_Inout_ Char* _str,
+	_In_    SizeT _len);
+
+/*(C)
+Transforms the first _len bytes of a string to uppercase.
+@_str: the string to be transformed
+@_len: number of bytes to transform*/
+extern Void ZAPI
+ZString_ToUpperEx(
+	_Inout_ Char* _str,
+	_In_    SizeT _len);
+
 
 
 #if defined(__cplusplus)
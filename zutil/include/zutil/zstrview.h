@@ -0,0 +1,267 @@
+/******************************************************************************
+* zutil - C Utility Library
+* Copyright (C) 2017-2021 Zachary T Harris. All Rights Reserved.  
+* Zlib license.
+* 
+* File: zstrview.h
+* Desc: non-owning string views, splitting and tokenizing
+*******************************************************************************
+
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+******************************************************************************/ 
+#ifndef __ZSTRVIEW_H__
+#define __ZSTRVIEW_H__
+
+#include "zcore.h"
+#include "zstring.h"
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+
+
+/*
+A non-owning reference to a range of characters.
+A view is not null-terminated, and is only valid
+for as long as the characters it refers to.*/
+typedef struct _ZSTRVIEW {
+	Lpcstr lpData;  //first character
+	SizeT  iLength; //length in bytes
+} ZSTRVIEW;
+
+/*
+Iterates over the fields of a view separated by a delimiter string.
+Every delimiter ends a field, so empty fields are reported and a view
+holding n delimiters yields n + 1 fields.*/
+typedef struct _ZSTRSPLIT {
+	ZSTRVIEW rest;         //characters not yet visited
+	Lpcstr   lpDelim;      //the delimiter
+	SizeT    iDelimLength; //length of the delimiter in bytes
+	Bool     bDone;        //the last field has been returned
+} ZSTRSPLIT;
+
+/*
+Iterates over the tokens of a view separated by runs of delimiter 
+characters, like strtok but without modifying the characters.
+Empty tokens are never reported.*/
+typedef struct _ZSTRTOKEN {
+	ZSTRVIEW rest;   //characters not yet visited
+	ZCHARSET delims; //the delimiter characters
+} ZSTRTOKEN;
+
+
+
+/*
+Construction:
+******************************************************************************/
+static FORCEINLINE ZSTRVIEW
+ZStrView_Make(
+	_In_ Lpcstr _str,
+	_In_ SizeT  _len) {
+
+	ZSTRVIEW view;
+	view.lpData  = _str;
+	view.iLength = _len;
+	return view;
+}
+
+static FORCEINLINE ZSTRVIEW
+ZStrView_FromCStr(
+	_In_ Lpcstr _str) {
+
+	return ZStrView_Make(_str, strlen(_str));
+}
+
+/*
+Returns the part of a view starting at _begin with at most _count bytes.
+Both values are clamped to the view, so the result is always valid.*/
+static FORCEINLINE ZSTRVIEW
+ZStrView_Sub(
+	_In_ ZSTRVIEW _view,
+	_In_ SizeT    _begin,
+	_In_ SizeT    _count) {
+
+	_begin = Z_Min(_begin, _view.iLength);
+	_count = Z_Min(_count, _view.iLength - _begin);
+	return ZStrView_Make(_view.lpData + _begin, _count);
+}
+
+
+
+/*
+Comparison and search:
+******************************************************************************/
+/*
+Checks two views for equal contents.
+@return: true if both views hold the same bytes*/
+extern Bool ZAPI
+ZStrView_Equal(
+	_In_ ZSTRVIEW _view1,
+	_In_ ZSTRVIEW _view2);
+
+/*
+Checks two views for equal contents, ignoring case.
+@return: true if both views hold the same bytes, ignoring case*/
+extern Bool ZAPI
+ZStrView_CaseEqual(
+	_In_ ZSTRVIEW _view1,
+	_In_ ZSTRVIEW _view2);
+
+/*
+Compares two views byte by byte.
+@return: (< 0), (= 0) or (> 0), a view that is
+         a prefix of the other compares less*/
+extern Int32 ZAPI
+ZStrView_Compare(
+	_In_ ZSTRVIEW _view1,
+	_In_ ZSTRVIEW _view2);
+
+/*
+Checks whether a view begins with the given prefix.
+@return: true if _view starts with _prefix*/
+extern Bool ZAPI
+ZStrView_StartsWith(
+	_In_ ZSTRVIEW _view,
+	_In_ ZSTRVIEW _prefix);
+
+/*
+Checks whether a view ends with the given suffix.
+@return: true if _view ends with _suffix*/
+extern Bool ZAPI
+ZStrView_EndsWith(
+	_In_ ZSTRVIEW _view,
+	_In_ ZSTRVIEW _suffix);
+
+/*
+Returns the first index of a substring within a view (see ZString_Find).
+@return: index of _sub in the view, or -1 if not present*/
+extern Intptr ZAPI
+ZStrView_Find(
+	_In_ ZSTRVIEW _view,
+	_In_ ZSTRVIEW _sub);
+
+
+
+/*
+Trimming and splitting:
+******************************************************************************/
+/*
+Removes leading and trailing ASCII whitespace (" \t\n\v\f\r").
+@return: the trimmed view, referring to the same characters*/
+extern ZSTRVIEW ZAPI
+ZStrView_Trim(
+	_In_ ZSTRVIEW _view);
+
+/*
+Removes leading ASCII whitespace.
+@return: the trimmed view, referring to the same characters*/
+extern ZSTRVIEW ZAPI
+ZStrView_TrimLeft(
+	_In_ ZSTRVIEW _view);
+
+/*
+Removes trailing ASCII whitespace.
+@return: the trimmed view, referring to the same characters*/
+extern ZSTRVIEW ZAPI
+ZStrView_TrimRight(
+	_In_ ZSTRVIEW _view);
+
+/*
+Splits a view at the first occurrence of a character, such as the '='
+of a key=value pair. The separator belongs to neither part.
+@_view   : the view to split
+@_sep    : the separating character
+@_lpLeft : receives the characters before the separator
+@_lpRight: receives the characters after the separator
+@return  : true if the separator was found, otherwise _lpLeft 
+           receives the whole view and _lpRight an empty view*/
+extern Bool ZAPI
+ZStrView_SplitOnce(
+	_In_    ZSTRVIEW  _view,
+	_In_    Char      _sep,
+	_Inout_ ZSTRVIEW* _lpLeft,
+	_Inout_ ZSTRVIEW* _lpRight);
+
+/*
+Prepares an iterator over the fields of a view.
+@_iter    : the iterator to initialize
+@_view    : the characters to split, which must outlive the iterator
+@_delim   : the delimiter, which must outlive the iterator
+@_delimlen: length of the delimiter in bytes (at least one)*/
+extern Void ZAPI
+ZStrView_SplitInit(
+	_Out_ ZSTRSPLIT* _iter,
+	_In_  ZSTRVIEW   _view,
+	_In_  Lpcstr     _delim,
+	_In_  SizeT      _delimlen);
+
+/*
+Advances to the next field.
+@_iter   : the iterator
+@_lpField: receives the field
+@return  : true if a field was returned, false once all were visited*/
+extern Bool ZAPI
+ZStrView_SplitNext(
+	_Inout_ ZSTRSPLIT* _iter,
+	_Inout_ ZSTRVIEW*  _lpField);
+
+/*
+Prepares an iterator over the tokens of a view.
+@_iter  : the iterator to initialize
+@_view  : the characters to tokenize, which must outlive the iterator
+@_delims: the delimiter characters (copied into the iterator)
+@_len   : number of delimiter characters*/
+extern Void ZAPI
+ZStrView_TokenInit(
+	_Out_ ZSTRTOKEN* _iter,
+	_In_  ZSTRVIEW   _view,
+	_In_  Lpcstr     _delims,
+	_In_  SizeT      _len);
+
+/*
+Advances to the next token.
+@_iter   : the iterator
+@_lpToken: receives the token
+@return  : true if a token was returned, false once all were visited*/
+extern Bool ZAPI
+ZStrView_TokenNext(
+	_Inout_ ZSTRTOKEN* _iter,
+	_Inout_ ZSTRVIEW*  _lpToken);
+
+/*
+Copies a view into a buffer as a null-terminated string, truncating it
+to fit like ZString_Strlcpy.
+@_view   : the characters to copy
+@_dst    : the destination buffer
+@_dstsize: size of the destination buffer in bytes
+@return  : length of the view, a result of _dstsize or more 
+           means the copy was truncated*/
+extern SizeT ZAPI
+ZStrView_Copy(
+	_In_    ZSTRVIEW _view,
+	_Inout_ Char*    _dst,
+	_In_    SizeT    _dstsize);
+
+
+
+#if defined(__cplusplus)
+}
+#endif
+/*****************************************************************************/  
+#endif //EOF
+/*****************************************************************************/  
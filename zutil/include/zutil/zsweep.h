@@ -0,0 +1,142 @@
+/******************************************************************************
+* zutil - C Utility Library
+* Copyright (C) 2017-2021 Zachary T Harris. All Rights Reserved.  
+* Zlib license.
+* 
+* File: zsweep.h
+* Desc: sort-and-sweep broadphase over rectangle arrays
+*******************************************************************************
+
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+******************************************************************************/ 
+#ifndef __ZSWEEP_H__
+#define __ZSWEEP_H__
+
+#include "zrect.h"
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+
+
+/*
+A sort-and-sweep broadphase. It tracks the overlapping pairs of an
+array of rects that is passed in again on every frame, with rect i
+standing for object i. The rect edges are kept sorted along both axes
+between frames. Each update re-sorts them by insertion sort, which is
+near linear when objects move little between frames. Every swap of a 
+start edge with an end edge updates the pair of objects involved, so 
+the update cost follows the number of swaps rather than the number of
+pairs. The first update, and any update that changes the object count,
+sorts from scratch with a radix sort and sweeps for the pairs.
+
+Rects overlap when their intersection has a positive area, as 
+ZRect_GetIntersection; rects may have negative width or height.*/
+typedef struct _ZSweep ZSweep;
+
+/*
+A pair of overlapping objects, _a < _b*/
+typedef struct _ZSWEEPPAIR {
+	Int32 a;
+	Int32 b;
+} ZSWEEPPAIR;
+
+
+
+
+
+/*
+Create an empty broadphase.
+@_lpResult: Z_OK on success, non-zero on failure (optional, can be NULL)
+@return   : an allocated broadphase, or NULL on failure
+            !must call ZSweep_Release when finished using it!*/
+extern ZSweep* ZAPI
+ZSweep_Create(
+	_Inout_opt_ ZRESULT* _lpResult);
+
+/*
+Destroy a broadphase.
+@_lpSweep: the broadphase to destroy*/
+extern Void ZAPI
+ZSweep_Release(
+	_Inout_ ZSweep* _lpSweep);
+
+/*
+Updates the overlapping pairs for the current positions of the objects,
+and records the pairs that started or stopped overlapping since the 
+previous update. When the object count shrinks, the pairs of the 
+objects dropped are reported as removed.
+@_lpSweep: the broadphase
+@_rects  : the bounds of the objects
+@_count  : the number of objects, below 2^31
+@return  : Z_OK, Z_EINVALIDARG, or Z_EOUTOFMEMORY. After a failure
+           the broadphase forgets its pairs, so the next update
+           reports every overlapping pair as added*/
+extern ZRESULT ZAPI
+ZSweep_Update(
+	_Inout_ ZSweep*      _lpSweep,
+	_In_    const ZRECT* _rects,
+	_In_    SizeT        _count);
+
+/*
+Returns the pairs that started overlapping in the last update.
+The array is valid until the next update.
+@_lpSweep: the broadphase
+@_lpCount: receives the number of pairs
+@return  : the pairs, in no particular order*/
+extern const ZSWEEPPAIR* ZAPI
+ZSweep_GetAdded(
+	_In_    const ZSweep* _lpSweep,
+	_Inout_ SizeT*        _lpCount);
+
+/*
+Returns the pairs that stopped overlapping in the last update.
+The array is valid until the next update.
+@_lpSweep: the broadphase
+@_lpCount: receives the number of pairs
+@return  : the pairs, in no particular order*/
+extern const ZSWEEPPAIR* ZAPI
+ZSweep_GetRemoved(
+	_In_    const ZSweep* _lpSweep,
+	_Inout_ SizeT*        _lpCount);
+
+/*
+Returns the number of pairs currently overlapping*/
+extern SizeT ZAPI
+ZSweep_GetPairCount(
+	_In_ const ZSweep* _lpSweep);
+
+/*
+Reports whether two objects overlapped at the last update.
+@_lpSweep: the broadphase
+@_a, _b  : the objects, in either order
+@return  : true if the pair overlaps*/
+extern Bool ZAPI
+ZSweep_IsOverlapping(
+	_In_ const ZSweep* _lpSweep,
+	_In_ Int32         _a,
+	_In_ Int32         _b);
+
+
+
+#if defined(__cplusplus)
+}
+#endif
+/*****************************************************************************/  
+#endif //EOF
+/*****************************************************************************/  
@@ -0,0 +1,79 @@
+/******************************************************************************
+* zutil - C Utility Library
+* Copyright (C) 2017-2021 Zachary T Harris. All Rights Reserved.  
+* Zlib license.
+* 
+* File: zutf8.h
+* Desc: utf-8 validation and length measurement
+*******************************************************************************
+
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+******************************************************************************/ 
+#ifndef __ZUTF8_H__
+#define __ZUTF8_H__
+
+#include "zcore.h"
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+
+
+/*
+Determines whether the given buffer holds well-formed UTF-8 (RFC 3629).
+Overlong forms, surrogates, values above U+10FFFF and sequences 
+truncated by the end of the buffer are all rejected.
+@_src  : the buffer to validate (need not be null-terminated)
+@_len  : size of the buffer in bytes
+@return: True if the buffer is valid UTF-8, else false*/
+extern Bool ZAPI
+ZUtf8_Validate(
+	_In_ Lpcstr _src,
+	_In_ SizeT  _len);
+
+/*
+Counts the code points in a UTF-8 buffer.
+The buffer is assumed to be valid (see ZUtf8_Validate).
+@_src  : the buffer to measure
+@_len  : size of the buffer in bytes
+@return: the number of code points*/
+extern SizeT ZAPI
+ZUtf8_CountCodePoints(
+	_In_ Lpcstr _src,
+	_In_ SizeT  _len);
+
+/*
+Counts the UTF-16 code units needed to hold a UTF-8 buffer, 
+so that the output of a conversion can be allocated exactly.
+The buffer is assumed to be valid (see ZUtf8_Validate).
+@_src  : the buffer to measure
+@_len  : size of the buffer in bytes
+@return: the number of 16-bit code units*/
+extern SizeT ZAPI
+ZUtf8_Utf16Length(
+	_In_ Lpcstr _src,
+	_In_ SizeT  _len);
+
+
+
+#if defined(__cplusplus)
+}
+#endif
+/*****************************************************************************/  
+#endif //EOF
+/*****************************************************************************/  
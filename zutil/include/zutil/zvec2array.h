@@ -0,0 +1,236 @@
+/******************************************************************************
+* zutil - C Utility Library
+* Copyright (C) 2017-2021 Zachary T Harris. All Rights Reserved.  
+* Zlib license.
+* 
+* File: zvec2array.h
+* Desc: structure-of-arrays 2D vectors with batch kernels
+*******************************************************************************
+
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+******************************************************************************/ 
+#ifndef __ZVEC2ARRAY_H__
+#define __ZVEC2ARRAY_H__
+
+#include "zvec2.h"
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+
+
+#define ZVEC2ARRAY_ALIGN 32 //alignment of the coordinate arrays in bytes
+#define ZVEC2ARRAY_PAD   8  //capacities are rounded up to this many vectors
+
+/*
+An array of 2D vectors in structure-of-arrays layout: all x coordinates
+are contiguous, followed by all y coordinates, so the batch kernels 
+below load whole vector registers of one coordinate at a time 
+(8 lanes with AVX2, 4 with SSE2 or NEON). Both coordinate arrays live in
+a single aligned allocation. A zero filled ZVEC2ARRAY is a valid empty 
+array.
+
+The kernels write to a destination array that may be one of their
+sources; it is resized to the source count first, which only allocates
+when it has to grow. Sources of a binary kernel must have equal counts.*/
+typedef struct _ZVEC2ARRAY {
+	Float* x;         //x coordinates, aligned to ZVEC2ARRAY_ALIGN
+	Float* y;         //y coordinates, aligned to ZVEC2ARRAY_ALIGN
+	SizeT  iCount;    //number of vectors
+	SizeT  iCapacity; //vectors that fit without reallocating
+	Void*  lpBlock;   //allocation holding both coordinate arrays
+} ZVEC2ARRAY;
+
+
+
+/*
+Element access:
+******************************************************************************/
+static FORCEINLINE ZVEC2
+ZVec2Array_Get(
+	_In_ const ZVEC2ARRAY* _array,
+	_In_ SizeT             _index) {
+
+	ZVEC2 vec;
+	vec.x = _array->x[_index];
+	vec.y = _array->y[_index];
+	return vec;
+}
+
+static FORCEINLINE Void
+ZVec2Array_Set(
+	_Inout_ ZVEC2ARRAY*  _array,
+	_In_    SizeT        _index,
+	_In_    const ZVEC2* _vec) {
+
+	_array->x[_index] = _vec->x;
+	_array->y[_index] = _vec->y;
+}
+
+
+
+/*
+Lifetime and conversion:
+******************************************************************************/
+/*
+Initializes an empty array with room for _capacity vectors.
+@_array   : the array to initialize
+@_capacity: number of vectors to reserve, may be 0
+@return   : Z_OK, or Z_EOUTOFMEMORY (_array is then left empty)*/
+extern ZRESULT ZAPI
+ZVec2Array_Init(
+	_Out_ ZVEC2ARRAY* _array,
+	_In_  SizeT       _capacity);
+
+/*
+Releases the memory owned by an array and leaves it empty.
+@_array: the array to release*/
+extern Void ZAPI
+ZVec2Array_Free(
+	_Inout_ ZVEC2ARRAY* _array);
+
+/*
+Sets the number of vectors, keeping the existing ones. 
+Vectors added at the end are uninitialized.
+@_array: the array to resize
+@_count: the new number of vectors
+@return: Z_OK, or Z_EOUTOFMEMORY (the array is left unchanged)*/
+extern ZRESULT ZAPI
+ZVec2Array_Resize(
+	_Inout_ ZVEC2ARRAY* _array,
+	_In_    SizeT       _count);
+
+/*
+Fills an array from interleaved ZVEC2 values.
+@_array: the array to fill, resized to _count
+@_src  : the vectors to copy
+@_count: number of vectors
+@return: Z_OK, or Z_EOUTOFMEMORY*/
+extern ZRESULT ZAPI
+ZVec2Array_FromAoS(
+	_Inout_ ZVEC2ARRAY*  _array,
+	_In_    const ZVEC2* _src,
+	_In_    SizeT        _count);
+
+/*
+Copies an array out to interleaved ZVEC2 values.
+@_array: the array to copy
+@_dst  : receives _array->iCount vectors*/
+extern Void ZAPI
+ZVec2Array_ToAoS(
+	_In_    const ZVEC2ARRAY* _array,
+	_Inout_ ZVEC2*            _dst);
+
+
+
+/*
+Batch kernels:
+******************************************************************************/
+/*
+Computes _dst[i] = _a[i] + _b[i].
+@return: Z_OK, Z_EINVALIDARG if the counts differ, or Z_EOUTOFMEMORY*/
+extern ZRESULT ZAPI
+ZVec2Array_Add(
+	_Inout_ ZVEC2ARRAY*       _dst,
+	_In_    const ZVEC2ARRAY* _a,
+	_In_    const ZVEC2ARRAY* _b);
+
+/*
+Computes _dst[i] = _a[i] - _b[i].
+@return: Z_OK, Z_EINVALIDARG if the counts differ, or Z_EOUTOFMEMORY*/
+extern ZRESULT ZAPI
+ZVec2Array_Sub(
+	_Inout_ ZVEC2ARRAY*       _dst,
+	_In_    const ZVEC2ARRAY* _a,
+	_In_    const ZVEC2ARRAY* _b);
+
+/*
+Scales every vector by per-axis factors.
+@return: Z_OK, or Z_EOUTOFMEMORY*/
+extern ZRESULT ZAPI
+ZVec2Array_Scale(
+	_Inout_ ZVEC2ARRAY*       _dst,
+	_In_    const ZVEC2ARRAY* _src,
+	_In_    Float             _sx,
+	_In_    Float             _sy);
+
+/*
+Computes _dst[i] = _a[i] + (_b[i] - _a[i]) * _t, as ZVec2_Lerp.
+@return: Z_OK, Z_EINVALIDARG if the counts differ, or Z_EOUTOFMEMORY*/
+extern ZRESULT ZAPI
+ZVec2Array_Lerp(
+	_Inout_ ZVEC2ARRAY*       _dst,
+	_In_    const ZVEC2ARRAY* _a,
+	_In_    const ZVEC2ARRAY* _b,
+	_In_    Float             _t);
+
+/*
+Scales every vector to unit length. Zero vectors stay zero 
+instead of becoming NaN.
+@return: Z_OK, or Z_EOUTOFMEMORY*/
+extern ZRESULT ZAPI
+ZVec2Array_Normalize(
+	_Inout_ ZVEC2ARRAY*       _dst,
+	_In_    const ZVEC2ARRAY* _src);
+
+/*
+Rotates every vector about the origin, as ZVec2_Rotation;
+the sine and cosine are evaluated once for the whole batch.
+@return: Z_OK, or Z_EOUTOFMEMORY*/
+extern ZRESULT ZAPI
+ZVec2Array_Rotate(
+	_Inout_ ZVEC2ARRAY*       _dst,
+	_In_    const ZVEC2ARRAY* _src,
+	_In_    Float             _radians);
+
+/*
+Computes the dot product of each pair of vectors.
+@_out  : receives _a->iCount values
+@return: Z_OK, or Z_EINVALIDARG if the counts differ*/
+extern ZRESULT ZAPI
+ZVec2Array_Dot(
+	_In_    const ZVEC2ARRAY* _a,
+	_In_    const ZVEC2ARRAY* _b,
+	_Inout_ Float*            _out);
+
+/*
+Computes the length of each vector.
+@_out: receives _src->iCount values*/
+extern Void ZAPI
+ZVec2Array_Length(
+	_In_    const ZVEC2ARRAY* _src,
+	_Inout_ Float*            _out);
+
+/*
+Computes the distance between each pair of points.
+@_out  : receives _a->iCount values
+@return: Z_OK, or Z_EINVALIDARG if the counts differ*/
+extern ZRESULT ZAPI
+ZVec2Array_Distance(
+	_In_    const ZVEC2ARRAY* _a,
+	_In_    const ZVEC2ARRAY* _b,
+	_Inout_ Float*            _out);
+
+
+
+#if defined(__cplusplus)
+}
+#endif
+/*****************************************************************************/  
+#endif //EOF
+/*****************************************************************************/  
@@ -0,0 +1,359 @@
+/******************************************************************************
+* zutil - C Utility Library
+* Copyright (C) 2017-2021 Zachary T Harris. All Rights Reserved.  
+* Zlib license.
+* 
+* File: zarena.c
+* Desc: bump-pointer arena allocator with savepoints
+*******************************************************************************
+
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+******************************************************************************/ 
+//for MAP_ANONYMOUS under a strict -std=c11; set before any system header
+#if !defined(_DEFAULT_SOURCE)
+#  define _DEFAULT_SOURCE 1
+#endif
+#include "zutil/zmath.h"
+#include "zutil/zarena.h"
+
+#if (Z_PLATFORM_WINDOWS)
+#  include "zutil/zplatform_win32.h"
+#else
+#  include "zutil/zplatform_posix.h"
+#  include <sys/mman.h>
+#  if !defined(MAP_ANONYMOUS) && defined(MAP_ANON)
+#    define MAP_ANONYMOUS MAP_ANON
+#  endif
+#endif 
+
+
+
+/*
+A block of heap memory, followed by its storage*/
+typedef struct _ZArenaChunk {
+	struct _ZArenaChunk* next; //following chunk, kept for reuse
+	SizeT                size; //bytes of storage
+} ZArenaChunk;
+
+struct _ZArena {
+	ZARENAFLAGS  eFlags;     //where the memory comes from
+	SizeT        iChunkSize; //chunk size, or commit step when virtual
+	ZArenaChunk* lpFirst;    //first chunk, NULL when virtual
+	ZArenaChunk* lpChunk;    //chunk being filled, NULL when virtual
+	Byte*        lpBase;     //storage being filled
+	SizeT        iUsed;      //bytes used in lpBase
+	SizeT        iSize;      //bytes usable in lpBase (committed when virtual)
+	SizeT        iReserved;  //bytes of address space reserved when virtual
+	SizeT        iFilled;    //bytes used in the chunks before lpChunk
+};
+
+
+
+
+
+/* Section 1:
+** virtual memory
+******************************************************************************/
+static SizeT
+ZArena_GetPageSize(Void) {
+#if (Z_PLATFORM_WINDOWS)
+	SYSTEM_INFO info;
+	GetSystemInfo(&info);
+	return (SizeT)info.dwPageSize;
+#else
+	return (SizeT)sysconf(_SC_PAGESIZE);
+#endif
+}
+
+
+static Byte*
+ZArena_Reserve(
+	_In_ SizeT _size) {
+#if (Z_PLATFORM_WINDOWS)
+	return (Byte*)VirtualAlloc(NULL, _size, MEM_RESERVE, PAGE_NOACCESS);
+#else
+	Void* base;
+	base = mmap(NULL, _size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	return (base == MAP_FAILED) ? NULL : (Byte*)base;
+#endif
+}
+
+
+static Bool
+ZArena_Commit(
+	_In_ Byte* _lpBase,
+	_In_ SizeT _size) {
+#if (Z_PLATFORM_WINDOWS)
+	return VirtualAlloc(_lpBase, _size, MEM_COMMIT, PAGE_READWRITE) != NULL;
+#else
+	return mprotect(_lpBase, _size, PROT_READ | PROT_WRITE) == 0;
+#endif
+}
+
+
+static Void
+ZArena_Unreserve(
+	_In_ Byte* _lpBase,
+	_In_ SizeT _size) {
+#if (Z_PLATFORM_WINDOWS)
+	Z_Unused(_size);
+	VirtualFree(_lpBase, 0, MEM_RELEASE);
+#else
+	munmap(_lpBase, _size);
+#endif
+}
+
+
+
+
+
+/* Section 2:
+** allocation
+******************************************************************************/
+/*
+Moves a default arena on to a chunk with room for _need bytes: the 
+next chunk if it is large enough, otherwise a new chunk inserted 
+before it.*/
+static Bool
+ZArena_NextChunk(
+	_Inout_ ZArena* _lpArena,
+	_In_    SizeT   _need) {
+
+	ZArenaChunk* chunk;
+	SizeT        size;
+
+	chunk = _lpArena->lpChunk->next;
+	if (!chunk || chunk->size < _need) {
+		size = Z_Max(_need, _lpArena->iChunkSize);
+		if (size > (SizeT)-1 - sizeof(ZArenaChunk))
+			return Z_FALSE;
+		chunk = (ZArenaChunk*)malloc(sizeof(ZArenaChunk) + size);
+		if (!chunk)
+			return Z_FALSE;
+		chunk->size = size;
+		chunk->next = _lpArena->lpChunk->next;
+		_lpArena->lpChunk->next = chunk;
+	}
+	_lpArena->iFilled += _lpArena->iUsed;
+	_lpArena->lpChunk  = chunk;
+	_lpArena->lpBase   = (Byte*)(chunk + 1);
+	_lpArena->iUsed    = 0;
+	_lpArena->iSize    = chunk->size;
+	return Z_TRUE;
+}
+
+
+/*
+Commits the pages of a virtual arena up to _end bytes*/
+static Bool
+ZArena_Grow(
+	_Inout_ ZArena* _lpArena,
+	_In_    SizeT   _end) {
+
+	SizeT size;
+	if (_end > _lpArena->iReserved)
+		return Z_FALSE;
+	size = (SizeT)ZMath_AlignU64(_end, _lpArena->iChunkSize);
+	size = Z_Min(size, _lpArena->iReserved);
+	if (!ZArena_Commit(_lpArena->lpBase + _lpArena->iSize, 
+		size - _lpArena->iSize))
+		return Z_FALSE;
+	_lpArena->iSize = size;
+	return Z_TRUE;
+}
+
+
+/*
+Allocates when the storage being filled is too small*/
+static Void*
+ZArena_AllocSlow(
+	_Inout_ ZArena* _lpArena,
+	_In_    SizeT   _size,
+	_In_    SizeT   _align) {
+
+	SizeT offset;
+	if (_lpArena->eFlags & ZARENA_VIRTUAL) {
+		offset = (SizeT)(ZMath_AlignU64(
+			(Uint64)(SizeT)(_lpArena->lpBase + _lpArena->iUsed), _align) -
+			(Uint64)(SizeT)_lpArena->lpBase);
+		if (_size > _lpArena->iReserved || 
+			offset > _lpArena->iReserved - _size ||
+			!ZArena_Grow(_lpArena, offset + _size))
+			return NULL;
+	}
+	else {
+		//a fresh chunk is only aligned as malloc aligns, so leave room
+		//for the padding
+		if (_size > (SizeT)-1 - _align || 
+			!ZArena_NextChunk(_lpArena, _size + _align - 1))
+			return NULL;
+		offset = (SizeT)(ZMath_AlignU64(
+			(Uint64)(SizeT)_lpArena->lpBase, _align) - 
+			(Uint64)(SizeT)_lpArena->lpBase);
+	}
+	_lpArena->iUsed = offset + _size;
+	return _lpArena->lpBase + offset;
+}
+
+
+Void*
+ZArena_Alloc(
+	_Inout_ ZArena* _lpArena,
+	_In_    SizeT   _size,
+	_In_    SizeT   _align) {
+
+	Uint64 base, address;
+
+	if (_align == 0)
+		_align = ZARENA_ALIGN;
+	if (_align & (_align - 1))
+		return NULL;
+	base    = (Uint64)(SizeT)_lpArena->lpBase;
+	address = ZMath_AlignU64(base + _lpArena->iUsed, _align);
+	if (address - base <= _lpArena->iSize && 
+		_size <= _lpArena->iSize - (SizeT)(address - base)) {
+		_lpArena->iUsed = (SizeT)(address - base) + _size;
+		return (Void*)(SizeT)address;
+	}
+	return ZArena_AllocSlow(_lpArena, _size, _align);
+}
+
+
+
+
+
+/* Section 3:
+** arena
+******************************************************************************/
+ZArena*
+ZArena_Create(
+	_In_        ZARENAFLAGS _eFlags,
+	_In_        SizeT       _size,
+	_Inout_opt_ ZRESULT*    _lpResult) {
+
+	ZArena* arena;
+	SizeT   page;
+
+	arena = (ZArena*)calloc(1, sizeof(ZArena));
+	if (!arena) {
+		if (_lpResult)
+			*_lpResult = Z_EOUTOFMEMORY;
+		return NULL;
+	}
+	arena->eFlags = _eFlags;
+	if (_eFlags & ZARENA_VIRTUAL) {
+		page = ZArena_GetPageSize();
+		arena->iChunkSize = (SizeT)ZMath_AlignU64(ZARENA_CHUNK_SIZE, page);
+		arena->iReserved  = (SizeT)ZMath_AlignU64(
+			_size ? _size : ZARENA_RESERVE, arena->iChunkSize);
+		arena->lpBase = ZArena_Reserve(arena->iReserved);
+	}
+	else {
+		arena->iChunkSize = _size ? _size : ZARENA_CHUNK_SIZE;
+		arena->lpFirst = (ZArenaChunk*)malloc(
+			sizeof(ZArenaChunk) + arena->iChunkSize);
+		if (arena->lpFirst) {
+			arena->lpFirst->next = NULL;
+			arena->lpFirst->size = arena->iChunkSize;
+			arena->lpChunk = arena->lpFirst;
+			arena->lpBase  = (Byte*)(arena->lpFirst + 1);
+			arena->iSize   = arena->iChunkSize;
+		}
+	}
+	if (!arena->lpBase) {
+		free(arena);
+		if (_lpResult)
+			*_lpResult = Z_EOUTOFMEMORY;
+		return NULL;
+	}
+	if (_lpResult)
+		*_lpResult = Z_OK;
+	return arena;
+}
+
+
+Void
+ZArena_Release(
+	_Inout_ ZArena* _lpArena) {
+
+	ZArenaChunk* chunk;
+	if (!_lpArena)
+		return;
+	if (_lpArena->eFlags & ZARENA_VIRTUAL)
+		ZArena_Unreserve(_lpArena->lpBase, _lpArena->iReserved);
+	while (_lpArena->lpFirst) {
+		chunk = _lpArena->lpFirst;
+		_lpArena->lpFirst = chunk->next;
+		free(chunk);
+	}
+	free(_lpArena);
+}
+
+
+ZARENAMARK
+ZArena_Mark(
+	_In_ const ZArena* _lpArena) {
+
+	ZARENAMARK mark;
+	mark.lpChunk = _lpArena->lpChunk;
+	mark.iUsed   = _lpArena->iUsed;
+	mark.iFilled = _lpArena->iFilled;
+	return mark;
+}
+
+
+Void
+ZArena_Rewind(
+	_Inout_ ZArena*           _lpArena,
+	_In_    const ZARENAMARK* _lpMark) {
+
+	ZArenaChunk* chunk;
+	if (!(_lpArena->eFlags & ZARENA_VIRTUAL)) {
+		chunk = (ZArenaChunk*)_lpMark->lpChunk;
+		_lpArena->lpChunk = chunk;
+		_lpArena->lpBase  = (Byte*)(chunk + 1);
+		_lpArena->iSize   = chunk->size;
+	}
+	_lpArena->iUsed   = _lpMark->iUsed;
+	_lpArena->iFilled = _lpMark->iFilled;
+}
+
+
+Void
+ZArena_Reset(
+	_Inout_ ZArena* _lpArena) {
+
+	if (!(_lpArena->eFlags & ZARENA_VIRTUAL)) {
+		_lpArena->lpChunk = _lpArena->lpFirst;
+		_lpArena->lpBase  = (Byte*)(_lpArena->lpFirst + 1);
+		_lpArena->iSize   = _lpArena->lpFirst->size;
+	}
+	_lpArena->iUsed   = 0;
+	_lpArena->iFilled = 0;
+}
+
+
+SizeT
+ZArena_GetUsed(
+	_In_ const ZArena* _lpArena) {
+
+	return _lpArena->iFilled + _lpArena->iUsed;
+}
+/*****************************************************************************/  
+//EOF
+/*****************************************************************************/  
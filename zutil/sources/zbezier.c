@@ -0,0 +1,206 @@
+/******************************************************************************
+* zutil - C Utility Library
+* Copyright (C) 2017-2021 Zachary T Harris. All Rights Reserved.  
+* Zlib license.
+* 
+* File: zbezier.c
+* Desc: adaptive flattening of quadratic and cubic Bezier curves
+*******************************************************************************
+
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+******************************************************************************/ 
+#include <math.h>
+#include "zutil/zbezier.h"
+
+
+
+/* Section 1:
+** helpers
+******************************************************************************/
+static FORCEINLINE Void
+ZBezier_Put(
+	_Inout_opt_ ZVEC2* _out,
+	_In_        SizeT  _capacity,
+	_In_        SizeT  _index,
+	_In_        Float  _x,
+	_In_        Float  _y) {
+
+	if (_index < _capacity) {
+		_out[_index].x = _x;
+		_out[_index].y = _y;
+	}
+}
+
+
+static FORCEINLINE Float
+ZBezier_Norm(
+	_In_ Float _x,
+	_In_ Float _y) {
+
+	return sqrtf(_x * _x + _y * _y);
+}
+
+
+
+
+/* Section 2:
+** flattening
+******************************************************************************/
+/*
+A segment over a parameter step h strays from the curve by at most
+h^2 / 8 times the largest |B''| over the step. B'' of a quadratic is
+the constant 2 (v0 - 2 v1 + v2), so its segments can all have the 
+same step: n = sqrt(|v0 - 2 v1 + v2| / (4 tolerance)). Points are 
+evaluated directly by Horner's rule rather than by forward 
+differences, whose rounding drifts over long runs of segments*/
+SizeT
+ZBezier_Flatten3(
+	_In_        const ZVEC2* _v0,
+	_In_        const ZVEC2* _v1,
+	_In_        const ZVEC2* _v2,
+	_In_        Float        _tolerance,
+	_Inout_opt_ ZVEC2*       _out,
+	_In_        SizeT        _capacity) {
+
+	Float ax, ay, cx, cy, t, n;
+	SizeT i, count;
+	if (!(_tolerance > 0.0f))
+		return 0;
+	ax = _v0->x - 2.0f * _v1->x + _v2->x;
+	ay = _v0->y - 2.0f * _v1->y + _v2->y;
+	cx = 2.0f * (_v1->x - _v0->x);
+	cy = 2.0f * (_v1->y - _v0->y);
+	n  = ceilf(sqrtf(ZBezier_Norm(ax, ay) / (4.0f * _tolerance)));
+	count = (n >= 1.0f) ? (SizeT)Z_Min(n, (Float)ZBEZIER_MAXSEGMENTS) : 1;
+
+	ZBezier_Put(_out, _capacity, 0, _v0->x, _v0->y);
+	for (i = 1; i < count; i++) {
+		t = (Float)i / (Float)count;
+		ZBezier_Put(_out, _capacity, i, _v0->x + t * (cx + t * ax),
+			_v0->y + t * (cy + t * ay));
+	}
+	ZBezier_Put(_out, _capacity, count, _v2->x, _v2->y);
+	return count + 1;
+}
+
+
+/*
+B'' of a cubic is 6 (a + t e), with a = v0 - 2 v1 + v2 and 
+e = v3 - 3 v2 + 3 v1 - v0, and |a + t e| is convex in t, so its 
+largest value over a span is at one of the ends. The curve is cut 
+into ZBEZIER_SPANS equal spans of t, and each is split evenly by the 
+bound over it; a single even split is used instead when it takes no 
+more segments. Sizing every step to the local bound would save a few
+more points but costs square roots and a division per point*/
+#define ZBEZIER_SPANS 4
+
+SizeT
+ZBezier_Flatten4(
+	_In_        const ZVEC2* _v0,
+	_In_        const ZVEC2* _v1,
+	_In_        const ZVEC2* _v2,
+	_In_        const ZVEC2* _v3,
+	_In_        Float        _tolerance,
+	_Inout_opt_ ZVEC2*       _out,
+	_In_        SizeT        _capacity) {
+
+	Float ax, ay, ex, ey, cx, cy, k, t, step, n;
+	Float m[ZBEZIER_SPANS + 1];
+	SizeT spans[ZBEZIER_SPANS], whole, total, count, last, i, j, s;
+	if (!(_tolerance > 0.0f))
+		return 0;
+	cx = 3.0f * (_v1->x - _v0->x);
+	cy = 3.0f * (_v1->y - _v0->y);
+	ax = _v0->x - 2.0f * _v1->x + _v2->x;
+	ay = _v0->y - 2.0f * _v1->y + _v2->y;
+	ex = _v3->x - 3.0f * (_v2->x - _v1->x) - _v0->x;
+	ey = _v3->y - 3.0f * (_v2->y - _v1->y) - _v0->y;
+	k  = 0.75f / _tolerance; //segments over a span: |span| sqrt(k |B''| / 6)
+
+	for (j = 0; j <= ZBEZIER_SPANS; j++) {
+		t = (Float)j / ZBEZIER_SPANS;
+		m[j] = ZBezier_Norm(ax + t * ex, ay + t * ey);
+	}
+	n = ceilf(sqrtf(k * Z_Max(m[0], m[ZBEZIER_SPANS])));
+	whole = (n >= 1.0f) ? (SizeT)Z_Min(n, (Float)ZBEZIER_MAXSEGMENTS) : 1;
+	total = 0;
+	for (j = 0; j < ZBEZIER_SPANS; j++) {
+		n = ceilf(sqrtf(k * Z_Max(m[j], m[j + 1])) / ZBEZIER_SPANS);
+		spans[j] = (n >= 1.0f) ? (SizeT)Z_Min(n, 
+			(Float)(ZBEZIER_MAXSEGMENTS / ZBEZIER_SPANS)) : 1;
+		total += spans[j];
+	}
+	if (whole <= total) {
+		spans[0] = whole;
+		s = 1;
+	}
+	else s = ZBEZIER_SPANS;
+
+	ZBezier_Put(_out, _capacity, 0, _v0->x, _v0->y);
+	count = 1;
+	for (j = 0; j < s; j++) {
+		step = 1.0f / (Float)(spans[j] * s);
+		last = (j == s - 1) ? spans[j] - 1 : spans[j]; //v3 is put exactly
+		for (i = 1; i <= last; i++) {
+			t = (Float)j / (Float)s + (Float)i * step;
+			ZBezier_Put(_out, _capacity, count++, 
+				_v0->x + t * (cx + t * (3.0f * ax + t * ex)),
+				_v0->y + t * (cy + t * (3.0f * ay + t * ey)));
+		}
+	}
+	ZBezier_Put(_out, _capacity, count, _v3->x, _v3->y);
+	return count + 1;
+}
+
+
+SizeT
+ZBezier_FlattenArray(
+	_In_        const ZBEZIER* _curves,
+	_In_        SizeT          _count,
+	_In_        Float          _tolerance,
+	_Inout_opt_ ZVEC2*         _out,
+	_In_        SizeT          _capacity,
+	_Inout_opt_ SizeT*         _offsets) {
+
+	const ZBEZIER* c;
+	ZVEC2* out;
+	SizeT i, total, room;
+	total = 0;
+	for (i = 0; i < _count; i++) {
+		c = &_curves[i];
+		if (_offsets)
+			_offsets[i] = total;
+		room = (_capacity > total) ? _capacity - total : 0;
+		out  = room ? _out + total : NULL;
+		if (c->iOrder == 3)
+			total += ZBezier_Flatten3(&c->p[0], &c->p[1], &c->p[2], 
+				_tolerance, out, room);
+		else if (c->iOrder == 4)
+			total += ZBezier_Flatten4(&c->p[0], &c->p[1], &c->p[2], 
+				&c->p[3], _tolerance, out, room);
+	}
+	if (_offsets)
+		_offsets[_count] = total;
+	return total;
+}
+
+
+
+/*****************************************************************************/  
+//EOF
+/*****************************************************************************/  
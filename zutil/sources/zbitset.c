@@ -0,0 +1,652 @@
+/******************************************************************************
+* zutil - C Utility Library
+* Copyright (C) 2017-2021 Zachary T Harris. All Rights Reserved.  
+* Zlib license.
+* 
+* File: zbitset.c
+* Desc: bitsets with vectorized set operations, iteration and rank/select
+*******************************************************************************
+
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+******************************************************************************/ 
+#include "zutil/zmath.h"
+#include "zutil/zbitset.h"
+
+#if (Z_ARCHITECTURE_AVX2)
+#  include <immintrin.h>
+#  define ZBITSET_AVX2 1
+#endif
+#if (Z_ARCHITECTURE_SSE2)
+#  include <emmintrin.h>
+#  define ZBITSET_SSE2 1
+#elif (Z_ARCHITECTURE_NEON)
+#  include <arm_neon.h>
+#  define ZBITSET_NEON 1
+#endif
+
+
+
+#define ZBITSET_AND    0
+#define ZBITSET_OR     1
+#define ZBITSET_XOR    2
+#define ZBITSET_ANDNOT 3
+#define ZBITSET_NOT    4
+
+#define ZBITSET_PAD         256 //capacities are rounded up to this many bits
+#define ZBITSET_BLOCKWORDS  (ZBITSETRANK_BLOCK / 64)
+
+
+
+
+
+/* Section 1:
+** storage
+******************************************************************************/
+/*
+Clears the bits past the count in the last word*/
+static FORCEINLINE Void
+ZBitset_ClearTail(
+	_Inout_ ZBITSET* _set) {
+
+	if (_set->iCount % 64)
+		_set->lpWords[_set->iCount / 64] &= (1ull << (_set->iCount % 64)) - 1;
+}
+
+
+/*
+Moves a set into a new block with room for _capacity bits*/
+static ZRESULT
+ZBitset_Realloc(
+	_Inout_ ZBITSET* _set,
+	_In_    SizeT    _capacity) {
+
+	Uint64* words;
+	_capacity = (SizeT)ZMath_AlignU64(_capacity, ZBITSET_PAD);
+	words = (Uint64*)malloc(ZBITSET_WORDS(_capacity) * sizeof(Uint64));
+	if (!words)
+		return Z_EOUTOFMEMORY;
+	if (_set->iCount)
+		memcpy(words, _set->lpWords, 
+			ZBITSET_WORDS(_set->iCount) * sizeof(Uint64));
+	free(_set->lpBlock);
+	_set->lpBlock   = words;
+	_set->lpWords   = words;
+	_set->iCapacity = _capacity;
+	return Z_OK;
+}
+
+
+ZRESULT
+ZBitset_Init(
+	_Out_ ZBITSET* _set,
+	_In_  SizeT    _count) {
+
+	memset(_set, 0, sizeof(ZBITSET));
+	return ZBitset_Resize(_set, _count);
+}
+
+
+Void
+ZBitset_InitFixed(
+	_Out_   ZBITSET* _set,
+	_Inout_ Uint64*  _words,
+	_In_    SizeT    _count) {
+
+	memset(_words, 0, ZBITSET_WORDS(_count) * sizeof(Uint64));
+	_set->lpWords   = _words;
+	_set->iCount    = _count;
+	_set->iCapacity = ZBITSET_WORDS(_count) * 64;
+	_set->lpBlock   = NULL;
+}
+
+
+Void
+ZBitset_Free(
+	_Inout_ ZBITSET* _set) {
+
+	free(_set->lpBlock);
+	memset(_set, 0, sizeof(ZBITSET));
+}
+
+
+ZRESULT
+ZBitset_Resize(
+	_Inout_ ZBITSET* _set,
+	_In_    SizeT    _count) {
+
+	ZRESULT result;
+	SizeT   used;
+	if (_count > _set->iCapacity) {
+		result = ZBitset_Realloc(_set, Z_Max(_count, _set->iCapacity * 2));
+		if (result != Z_OK)
+			return result;
+	}
+	used = ZBITSET_WORDS(_set->iCount);
+	if (_count > _set->iCount && ZBITSET_WORDS(_count) > used) {
+		memset(_set->lpWords + used, 0, 
+			(ZBITSET_WORDS(_count) - used) * sizeof(Uint64));
+	}
+	_set->iCount = _count;
+	ZBitset_ClearTail(_set);
+	return Z_OK;
+}
+
+
+Void
+ZBitset_SetRange(
+	_Inout_ ZBITSET* _set,
+	_In_    SizeT    _first,
+	_In_    SizeT    _count,
+	_In_    Bool     _value) {
+
+	Uint64* words;
+	Uint64  head, tail;
+	SizeT   w0, w1;
+	if (!_count)
+		return;
+	words = _set->lpWords;
+	w0   = _first / 64;
+	w1   = (_first + _count - 1) / 64;
+	head = ~0ull << (_first % 64);
+	tail = ~0ull >> (63 - (_first + _count - 1) % 64);
+	if (w0 == w1)
+		head &= tail;
+	if (_value)
+		words[w0] |= head;
+	else words[w0] &= ~head;
+	if (w0 == w1)
+		return;
+	memset(words + w0 + 1, _value ? 0xFF : 0, (w1 - w0 - 1) * sizeof(Uint64));
+	if (_value)
+		words[w1] |= tail;
+	else words[w1] &= ~tail;
+}
+
+
+
+
+/* Section 2:
+** set operations
+******************************************************************************/
+static FORCEINLINE Uint64
+ZBitset_Op(
+	_In_ Int32  _op,
+	_In_ Uint64 _a,
+	_In_ Uint64 _b) {
+
+	switch (_op) {
+	case ZBITSET_AND:    return _a & _b;
+	case ZBITSET_OR:     return _a | _b;
+	case ZBITSET_XOR:    return _a ^ _b;
+	case ZBITSET_ANDNOT: return _a & ~_b;
+	default:             return ~_a;
+	}
+}
+
+
+#if (ZBITSET_AVX2)
+static FORCEINLINE __m256i
+ZBitset_Op256(
+	_In_ Int32   _op,
+	_In_ __m256i _a,
+	_In_ __m256i _b) {
+
+	switch (_op) {
+	case ZBITSET_AND:    return _mm256_and_si256(_a, _b);
+	case ZBITSET_OR:     return _mm256_or_si256(_a, _b);
+	case ZBITSET_XOR:    return _mm256_xor_si256(_a, _b);
+	case ZBITSET_ANDNOT: return _mm256_andnot_si256(_b, _a);
+	default:             return _mm256_xor_si256(_a, _mm256_set1_epi32(-1));
+	}
+}
+#endif
+
+
+#if (ZBITSET_SSE2)
+static FORCEINLINE __m128i
+ZBitset_Op128(
+	_In_ Int32   _op,
+	_In_ __m128i _a,
+	_In_ __m128i _b) {
+
+	switch (_op) {
+	case ZBITSET_AND:    return _mm_and_si128(_a, _b);
+	case ZBITSET_OR:     return _mm_or_si128(_a, _b);
+	case ZBITSET_XOR:    return _mm_xor_si128(_a, _b);
+	case ZBITSET_ANDNOT: return _mm_andnot_si128(_b, _a);
+	default:             return _mm_xor_si128(_a, _mm_set1_epi32(-1));
+	}
+}
+#elif (ZBITSET_NEON)
+static FORCEINLINE uint64x2_t
+ZBitset_Op128(
+	_In_ Int32      _op,
+	_In_ uint64x2_t _a,
+	_In_ uint64x2_t _b) {
+
+	switch (_op) {
+	case ZBITSET_AND:    return vandq_u64(_a, _b);
+	case ZBITSET_OR:     return vorrq_u64(_a, _b);
+	case ZBITSET_XOR:    return veorq_u64(_a, _b);
+	case ZBITSET_ANDNOT: return vbicq_u64(_a, _b);
+	default:             return veorq_u64(_a, vdupq_n_u64(~0ull));
+	}
+}
+#endif
+
+
+/*
+Combines word arrays. The operation is a constant at every call site,
+so each one gets its own loops*/
+static FORCEINLINE Void
+ZBitset_Combine(
+	_In_    Int32         _op,
+	_Inout_ Uint64*       _dst,
+	_In_    const Uint64* _a,
+	_In_    const Uint64* _b,
+	_In_    SizeT         _words) {
+
+	SizeT i = 0;
+#if (ZBITSET_AVX2)
+	for (; i + 4 <= _words; i += 4) {
+		_mm256_storeu_si256((__m256i*)(_dst + i), ZBitset_Op256(_op,
+			_mm256_loadu_si256((const __m256i*)(_a + i)),
+			_mm256_loadu_si256((const __m256i*)(_b + i))));
+	}
+#endif
+#if (ZBITSET_SSE2)
+	for (; i + 2 <= _words; i += 2) {
+		_mm_storeu_si128((__m128i*)(_dst + i), ZBitset_Op128(_op,
+			_mm_loadu_si128((const __m128i*)(_a + i)),
+			_mm_loadu_si128((const __m128i*)(_b + i))));
+	}
+#elif (ZBITSET_NEON)
+	for (; i + 2 <= _words; i += 2) {
+		vst1q_u64((uint64_t*)(_dst + i), ZBitset_Op128(_op, 
+			vld1q_u64((const uint64_t*)(_a + i)), 
+			vld1q_u64((const uint64_t*)(_b + i))));
+	}
+#endif
+	for (; i < _words; i++)
+		_dst[i] = ZBitset_Op(_op, _a[i], _b[i]);
+}
+
+
+static FORCEINLINE ZRESULT
+ZBitset_Apply(
+	_In_    Int32          _op,
+	_Inout_ ZBITSET*       _dst,
+	_In_    const ZBITSET* _a,
+	_In_    const ZBITSET* _b) {
+
+	ZRESULT result;
+	if (_a->iCount != _b->iCount)
+		return Z_EINVALIDARG;
+	if (_dst->iCount != _a->iCount) {
+		result = ZBitset_Resize(_dst, _a->iCount);
+		if (result != Z_OK)
+			return result;
+	}
+	ZBitset_Combine(_op, _dst->lpWords, _a->lpWords, _b->lpWords, 
+		ZBITSET_WORDS(_a->iCount));
+	if (_op == ZBITSET_NOT)
+		ZBitset_ClearTail(_dst);
+	return Z_OK;
+}
+
+
+ZRESULT
+ZBitset_And(
+	_Inout_ ZBITSET*       _dst,
+	_In_    const ZBITSET* _a,
+	_In_    const ZBITSET* _b) {
+
+	return ZBitset_Apply(ZBITSET_AND, _dst, _a, _b);
+}
+
+
+ZRESULT
+ZBitset_Or(
+	_Inout_ ZBITSET*       _dst,
+	_In_    const ZBITSET* _a,
+	_In_    const ZBITSET* _b) {
+
+	return ZBitset_Apply(ZBITSET_OR, _dst, _a, _b);
+}
+
+
+ZRESULT
+ZBitset_Xor(
+	_Inout_ ZBITSET*       _dst,
+	_In_    const ZBITSET* _a,
+	_In_    const ZBITSET* _b) {
+
+	return ZBitset_Apply(ZBITSET_XOR, _dst, _a, _b);
+}
+
+
+ZRESULT
+ZBitset_AndNot(
+	_Inout_ ZBITSET*       _dst,
+	_In_    const ZBITSET* _a,
+	_In_    const ZBITSET* _b) {
+
+	return ZBitset_Apply(ZBITSET_ANDNOT, _dst, _a, _b);
+}
+
+
+ZRESULT
+ZBitset_Not(
+	_Inout_ ZBITSET*       _dst,
+	_In_    const ZBITSET* _a) {
+
+	return ZBitset_Apply(ZBITSET_NOT, _dst, _a, _a);
+}
+
+
+
+
+/* Section 3:
+** counting and searching
+******************************************************************************/
+/*
+Counts the set bits of a word array. AVX2 looks up the count of each 
+nibble with a byte shuffle, SSE2 adds bits in registers, NEON has a
+byte count instruction; the byte counts are summed per 64-bit lane*/
+static SizeT
+ZBitset_PopCount(
+	_In_ const Uint64* _words,
+	_In_ SizeT         _count) {
+
+	SizeT i = 0, total = 0;
+#if (ZBITSET_AVX2)
+	if (_count >= 4) {
+		__m256i lut, low, acc, v, c;
+		Uint64  lanes[4];
+		lut = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+			0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+		low = _mm256_set1_epi8(0x0F);
+		acc = _mm256_setzero_si256();
+		for (; i + 4 <= _count; i += 4) {
+			v = _mm256_loadu_si256((const __m256i*)(_words + i));
+			c = _mm256_add_epi8(
+				_mm256_shuffle_epi8(lut, _mm256_and_si256(v, low)),
+				_mm256_shuffle_epi8(lut, 
+					_mm256_and_si256(_mm256_srli_epi16(v, 4), low)));
+			acc = _mm256_add_epi64(acc, 
+				_mm256_sad_epu8(c, _mm256_setzero_si256()));
+		}
+		_mm256_storeu_si256((__m256i*)lanes, acc);
+		total += (SizeT)(lanes[0] + lanes[1] + lanes[2] + lanes[3]);
+	}
+#endif
+#if (ZBITSET_SSE2)
+	if (i + 2 <= _count) {
+		__m128i m1, m2, m4, acc, v;
+		Uint64  lanes[2];
+		m1  = _mm_set1_epi8(0x55);
+		m2  = _mm_set1_epi8(0x33);
+		m4  = _mm_set1_epi8(0x0F);
+		acc = _mm_setzero_si128();
+		for (; i + 2 <= _count; i += 2) {
+			v = _mm_loadu_si128((const __m128i*)(_words + i));
+			v = _mm_sub_epi8(v, _mm_and_si128(_mm_srli_epi16(v, 1), m1));
+			v = _mm_add_epi8(_mm_and_si128(v, m2), 
+				_mm_and_si128(_mm_srli_epi16(v, 2), m2));
+			v = _mm_and_si128(_mm_add_epi8(v, _mm_srli_epi16(v, 4)), m4);
+			acc = _mm_add_epi64(acc, _mm_sad_epu8(v, _mm_setzero_si128()));
+		}
+		_mm_storeu_si128((__m128i*)lanes, acc);
+		total += (SizeT)(lanes[0] + lanes[1]);
+	}
+#elif (ZBITSET_NEON)
+	if (i + 2 <= _count) {
+		uint64x2_t acc = vdupq_n_u64(0);
+		for (; i + 2 <= _count; i += 2) {
+			acc = vpadalq_u32(acc, vpaddlq_u16(vpaddlq_u8(
+				vcntq_u8(vld1q_u8((const uint8_t*)(_words + i))))));
+		}
+		total += (SizeT)(vgetq_lane_u64(acc, 0) + vgetq_lane_u64(acc, 1));
+	}
+#endif
+	for (; i < _count; i++)
+		total += (SizeT)Z_POPCOUNT64(_words[i]);
+	return total;
+}
+
+
+/*
+Counts the set bits of a word array below bit _index*/
+static FORCEINLINE SizeT
+ZBitset_RankWords(
+	_In_ const Uint64* _words,
+	_In_ SizeT         _index) {
+
+	SizeT total = ZBitset_PopCount(_words, _index / 64);
+	if (_index % 64) {
+		total += (SizeT)Z_POPCOUNT64(_words[_index / 64] & 
+			((1ull << (_index % 64)) - 1));
+	}
+	return total;
+}
+
+
+/*
+Finds the bit of rank _nth in a word with more than _nth set bits.
+The running counts of the bytes locate the byte holding it, leaving
+at most seven bits to step over*/
+static FORCEINLINE SizeT
+ZBitset_SelectInWord(
+	_In_ Uint64 _word,
+	_In_ SizeT  _nth) {
+
+	Uint64 s;
+	Uint32 shift;
+	s = _word - ((_word >> 1) & 0x5555555555555555ull);
+	s = (s & 0x3333333333333333ull) + ((s >> 2) & 0x3333333333333333ull);
+	s = ((s + (s >> 4)) & 0x0F0F0F0F0F0F0F0Full) * 0x0101010101010101ull;
+	for (shift = 0; shift < 56; shift += 8) {
+		if (((s >> shift) & 0xFF) > _nth)
+			break;
+	}
+	if (shift)
+		_nth -= (SizeT)((s >> (shift - 8)) & 0xFF);
+	_word >>= shift;
+	while (_nth--)
+		_word &= _word - 1;
+	return shift + (SizeT)Z_CTZ64(_word);
+}
+
+
+/*
+Finds the bit of rank _nth in a word array*/
+static SizeT
+ZBitset_SelectWords(
+	_In_ const Uint64* _words,
+	_In_ SizeT         _count,
+	_In_ SizeT         _nth) {
+
+	SizeT i, bits;
+	for (i = 0; i < _count; i++) {
+		bits = (SizeT)Z_POPCOUNT64(_words[i]);
+		if (_nth < bits)
+			return i * 64 + ZBitset_SelectInWord(_words[i], _nth);
+		_nth -= bits;
+	}
+	return ZBITSET_NONE;
+}
+
+
+SizeT
+ZBitset_Count(
+	_In_ const ZBITSET* _set) {
+
+	return ZBitset_PopCount(_set->lpWords, ZBITSET_WORDS(_set->iCount));
+}
+
+
+SizeT
+ZBitset_FindNext(
+	_In_ const ZBITSET* _set,
+	_In_ SizeT          _from) {
+
+	Uint64 bits;
+	SizeT  w, words;
+	if (_from >= _set->iCount)
+		return ZBITSET_NONE;
+	words = ZBITSET_WORDS(_set->iCount);
+	w = _from / 64;
+	bits = _set->lpWords[w] & (~0ull << (_from % 64));
+	while (!bits) {
+		if (++w == words)
+			return ZBITSET_NONE;
+		bits = _set->lpWords[w];
+	}
+	return w * 64 + (SizeT)Z_CTZ64(bits);
+}
+
+
+SizeT
+ZBitset_FindNextClear(
+	_In_ const ZBITSET* _set,
+	_In_ SizeT          _from) {
+
+	Uint64 bits;
+	SizeT  w, words, index;
+	if (_from >= _set->iCount)
+		return ZBITSET_NONE;
+	words = ZBITSET_WORDS(_set->iCount);
+	w = _from / 64;
+	bits = ~_set->lpWords[w] & (~0ull << (_from % 64));
+	while (!bits) {
+		if (++w == words)
+			return ZBITSET_NONE;
+		bits = ~_set->lpWords[w];
+	}
+	index = w * 64 + (SizeT)Z_CTZ64(bits);
+	return (index < _set->iCount) ? index : ZBITSET_NONE;
+}
+
+
+SizeT
+ZBitset_Rank(
+	_In_ const ZBITSET* _set,
+	_In_ SizeT          _index) {
+
+	return ZBitset_RankWords(_set->lpWords, _index);
+}
+
+
+SizeT
+ZBitset_Select(
+	_In_ const ZBITSET* _set,
+	_In_ SizeT          _nth) {
+
+	SizeT i, n, bits, words;
+	words = ZBITSET_WORDS(_set->iCount);
+	for (i = 0; i < words; i += n) {
+		n = Z_Min(words - i, ZBITSET_BLOCKWORDS);
+		bits = ZBitset_PopCount(_set->lpWords + i, n);
+		if (_nth < bits)
+			return i * 64 + ZBitset_SelectWords(_set->lpWords + i, n, _nth);
+		_nth -= bits;
+	}
+	return ZBITSET_NONE;
+}
+
+
+
+
+/* Section 4:
+** rank directory
+******************************************************************************/
+ZRESULT
+ZBitsetRank_Init(
+	_Out_ ZBITSETRANK*   _rank,
+	_In_  const ZBITSET* _set) {
+
+	SizeT b, words;
+	words = ZBITSET_WORDS(_set->iCount);
+	_rank->iBlocks  = (words + ZBITSET_BLOCKWORDS - 1) / ZBITSET_BLOCKWORDS;
+	_rank->lpCounts = (SizeT*)malloc((_rank->iBlocks + 1) * sizeof(SizeT));
+	if (!_rank->lpCounts) {
+		_rank->iBlocks = 0;
+		return Z_EOUTOFMEMORY;
+	}
+	_rank->lpCounts[0] = 0;
+	for (b = 0; b < _rank->iBlocks; b++) {
+		_rank->lpCounts[b + 1] = _rank->lpCounts[b] + ZBitset_PopCount(
+			_set->lpWords + b * ZBITSET_BLOCKWORDS, 
+			Z_Min(words - b * ZBITSET_BLOCKWORDS, ZBITSET_BLOCKWORDS));
+	}
+	return Z_OK;
+}
+
+
+Void
+ZBitsetRank_Free(
+	_Inout_ ZBITSETRANK* _rank) {
+
+	free(_rank->lpCounts);
+	_rank->lpCounts = NULL;
+	_rank->iBlocks  = 0;
+}
+
+
+SizeT
+ZBitsetRank_Rank(
+	_In_ const ZBITSETRANK* _rank,
+	_In_ const ZBITSET*     _set,
+	_In_ SizeT              _index) {
+
+	SizeT b = _index / ZBITSETRANK_BLOCK;
+	if (b >= _rank->iBlocks)
+		return _rank->lpCounts[_rank->iBlocks];
+	return _rank->lpCounts[b] + ZBitset_RankWords(
+		_set->lpWords + b * ZBITSET_BLOCKWORDS, _index % ZBITSETRANK_BLOCK);
+}
+
+
+SizeT
+ZBitsetRank_Select(
+	_In_ const ZBITSETRANK* _rank,
+	_In_ const ZBITSET*     _set,
+	_In_ SizeT              _nth) {
+
+	SizeT lo, hi, mid, words;
+	if (_nth >= _rank->lpCounts[_rank->iBlocks])
+		return ZBITSET_NONE;
+	lo = 0; //the block b with counts[b] <= _nth < counts[b + 1]
+	hi = _rank->iBlocks - 1;
+	while (lo < hi) {
+		mid = (lo + hi + 1) / 2;
+		if (_rank->lpCounts[mid] <= _nth)
+			lo = mid;
+		else hi = mid - 1;
+	}
+	words = ZBITSET_WORDS(_set->iCount) - lo * ZBITSET_BLOCKWORDS;
+	return lo * ZBITSETRANK_BLOCK + ZBitset_SelectWords(
+		_set->lpWords + lo * ZBITSET_BLOCKWORDS, 
+		Z_Min(words, ZBITSET_BLOCKWORDS), _nth - _rank->lpCounts[lo]);
+}
+
+
+
+/*****************************************************************************/  
+//EOF
+/*****************************************************************************/  
@@ -0,0 +1,543 @@
+/******************************************************************************
+* zutil - C Utility Library
+* Copyright (C) 2017-2021 Zachary T Harris. All Rights Reserved.  
+* Zlib license.
+* 
+* File: zeasing.c
+* Desc: Batch evaluation of the ZMath easing curves
+*******************************************************************************
+
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+******************************************************************************/ 
+#include <stdlib.h>
+#include <string.h>
+#include "zutil/zsimd.h"
+#include "zutil/zeasing.h"
+
+
+
+#define ZEASING_PROBES 64 //error probes per interval of a lookup table
+
+
+
+/* Section 1:
+** vector helpers
+******************************************************************************/
+#define ZEasing_K(c) ZSimd_Set1(c)
+
+/*
+Returns _a < _b ? _x : _y*/
+static FORCEINLINE ZSIMDF
+ZEasing_Below(
+	_In_ ZSIMDF _a,
+	_In_ Float  _b,
+	_In_ ZSIMDF _x,
+	_In_ ZSIMDF _y) {
+
+	return ZSimd_Select(ZSimd_CmpGt(ZEasing_K(_b), _a), _x, _y);
+}
+
+
+static FORCEINLINE ZSIMDF
+ZEasing_Pow4(
+	_In_ ZSIMDF _x) {
+
+	ZSIMDF x2 = ZSimd_Mul(_x, _x);
+	return ZSimd_Mul(x2, x2);
+}
+
+
+/*
+2^x for x in [-126, 126]: 2^n scaled by a minimax polynomial for 2^f,
+with n the nearest whole number and f in [-0.5, 0.5], 
+relative error below 2e-7*/
+static FORCEINLINE ZSIMDF
+ZEasing_Exp2(
+	_In_ ZSIMDF _x) {
+
+	ZSIMDF n, f, p;
+	n = ZSimd_Floor(ZSimd_Add(_x, ZEasing_K(0.5f)));
+	f = ZSimd_Sub(_x, n);
+	p = ZEasing_K(1.535336188319500e-4f);
+	p = ZSimd_MulAdd(p, f, ZEasing_K(1.339887440266574e-3f));
+	p = ZSimd_MulAdd(p, f, ZEasing_K(9.618437357674640e-3f));
+	p = ZSimd_MulAdd(p, f, ZEasing_K(5.550332471162809e-2f));
+	p = ZSimd_MulAdd(p, f, ZEasing_K(2.402264791363012e-1f));
+	p = ZSimd_MulAdd(p, f, ZEasing_K(6.931472028550421e-1f));
+	p = ZSimd_MulAdd(p, f, ZEasing_K(1.0f));
+	return ZSimd_Mul(p, ZSimd_Pow2i(n));
+}
+
+
+/*
+sin(x) for |x| below 100: x is reduced by the nearest multiple of pi
+in two parts, and the remainder in [-pi/2, pi/2] goes through the 
+Taylor series to x^11, absolute error below 2e-7 plus the reduction*/
+static FORCEINLINE ZSIMDF
+ZEasing_Sin(
+	_In_ ZSIMDF _x) {
+
+	ZSIMDF k, odd, r, r2, p;
+	k   = ZSimd_Floor(ZSimd_MulAdd(_x, ZEasing_K(1.0f / ZMATH_PI), 
+		ZEasing_K(0.5f)));
+	odd = ZSimd_Sub(k, ZSimd_Mul(ZEasing_K(2.0f), 
+		ZSimd_Floor(ZSimd_Mul(k, ZEasing_K(0.5f)))));
+	r   = ZSimd_Sub(_x, ZSimd_Mul(k, ZEasing_K(3.140625f)));
+	r   = ZSimd_Sub(r, ZSimd_Mul(k, ZEasing_K(9.67653589793e-4f)));
+	r   = ZSimd_Mul(r, ZSimd_Sub(ZEasing_K(1.0f), 
+		ZSimd_Mul(odd, ZEasing_K(2.0f))));
+	r2  = ZSimd_Mul(r, r);
+	p   = ZEasing_K(-2.505210839e-8f);
+	p   = ZSimd_MulAdd(p, r2, ZEasing_K(2.755731922e-6f));
+	p   = ZSimd_MulAdd(p, r2, ZEasing_K(-1.984126984e-4f));
+	p   = ZSimd_MulAdd(p, r2, ZEasing_K(8.333333333e-3f));
+	p   = ZSimd_MulAdd(p, r2, ZEasing_K(-1.666666667e-1f));
+	return ZSimd_MulAdd(ZSimd_Mul(p, r2), r, r);
+}
+
+
+static FORCEINLINE ZSIMDF
+ZEasing_Cos(
+	_In_ ZSIMDF _x) {
+
+	return ZEasing_Sin(ZSimd_Add(_x, ZEasing_K(ZMATH_PI2)));
+}
+
+
+
+
+/* Section 2:
+** curves
+******************************************************************************/
+static FORCEINLINE ZSIMDF
+ZEasing_QuartIn(ZSIMDF _f) {
+	return ZEasing_Pow4(_f);
+}
+
+static FORCEINLINE ZSIMDF
+ZEasing_QuartOut(ZSIMDF _f) {
+	ZSIMDF g = ZSimd_Sub(_f, ZEasing_K(1.0f));
+	return ZSimd_Sub(ZEasing_K(1.0f), ZEasing_Pow4(g));
+}
+
+static FORCEINLINE ZSIMDF
+ZEasing_QuartInOut(ZSIMDF _f) {
+	ZSIMDF g = ZSimd_Sub(_f, ZEasing_K(1.0f));
+	return ZEasing_Below(_f, 0.5f,
+		ZSimd_Mul(ZEasing_K(8.0f), ZEasing_Pow4(_f)),
+		ZSimd_Sub(ZEasing_K(1.0f), 
+			ZSimd_Mul(ZEasing_K(8.0f), ZEasing_Pow4(g))));
+}
+
+static FORCEINLINE ZSIMDF
+ZEasing_CubicIn(ZSIMDF _f) {
+	return ZSimd_Mul(ZSimd_Mul(_f, _f), _f);
+}
+
+static FORCEINLINE ZSIMDF
+ZEasing_CubicOut(ZSIMDF _f) {
+	ZSIMDF g = ZSimd_Sub(_f, ZEasing_K(1.0f));
+	return ZSimd_MulAdd(ZSimd_Mul(g, g), g, ZEasing_K(1.0f));
+}
+
+static FORCEINLINE ZSIMDF
+ZEasing_CubicInOut(ZSIMDF _f) {
+	ZSIMDF g = ZSimd_Sub(_f, ZEasing_K(1.0f));
+	return ZEasing_Below(_f, 0.5f,
+		ZSimd_Mul(ZEasing_K(4.0f), ZEasing_CubicIn(_f)),
+		ZSimd_MulAdd(ZEasing_K(4.0f), ZEasing_CubicIn(g), ZEasing_K(1.0f)));
+}
+
+static FORCEINLINE ZSIMDF
+ZEasing_QuadIn(ZSIMDF _f) {
+	return ZSimd_Mul(_f, _f);
+}
+
+static FORCEINLINE ZSIMDF
+ZEasing_QuadOut(ZSIMDF _f) {
+	return ZSimd_Mul(_f, ZSimd_Sub(ZEasing_K(2.0f), _f));
+}
+
+static FORCEINLINE ZSIMDF
+ZEasing_QuadInOut(ZSIMDF _f) {
+	return ZEasing_Below(_f, 0.5f,
+		ZSimd_Mul(ZEasing_K(2.0f), ZSimd_Mul(_f, _f)),
+		ZSimd_Sub(ZSimd_Mul(_f, ZSimd_Sub(ZEasing_K(4.0f),
+			ZSimd_Mul(ZEasing_K(2.0f), _f))), ZEasing_K(1.0f)));
+}
+
+static FORCEINLINE ZSIMDF
+ZEasing_SineIn(ZSIMDF _f) {
+	return ZEasing_Sin(ZSimd_Mul(_f, ZEasing_K(1.5707963f)));
+}
+
+static FORCEINLINE ZSIMDF
+ZEasing_SineOut(ZSIMDF _f) {
+	return ZSimd_Add(ZEasing_K(1.0f), ZEasing_Sin(ZSimd_Mul(
+		ZSimd_Sub(_f, ZEasing_K(1.0f)), ZEasing_K(1.5707963f))));
+}
+
+static FORCEINLINE ZSIMDF
+ZEasing_SineInOut(ZSIMDF _f) {
+	return ZSimd_Mul(ZEasing_K(0.5f), ZSimd_Add(ZEasing_K(1.0f), 
+		ZEasing_Sin(ZSimd_Mul(ZSimd_Sub(_f, ZEasing_K(0.5f)),
+			ZEasing_K(ZMATH_PI)))));
+}
+
+static FORCEINLINE ZSIMDF
+ZEasing_QuintIn(ZSIMDF _f) {
+	return ZSimd_Mul(ZEasing_Pow4(_f), _f);
+}
+
+static FORCEINLINE ZSIMDF
+ZEasing_QuintOut(ZSIMDF _f) {
+	ZSIMDF g = ZSimd_Sub(_f, ZEasing_K(1.0f));
+	return ZSimd_MulAdd(ZEasing_Pow4(g), g, ZEasing_K(1.0f));
+}
+
+static FORCEINLINE ZSIMDF
+ZEasing_QuintInOut(ZSIMDF _f) {
+	ZSIMDF g = ZSimd_Sub(_f, ZEasing_K(1.0f));
+	return ZEasing_Below(_f, 0.5f,
+		ZSimd_Mul(ZEasing_K(16.0f), ZEasing_QuintIn(_f)),
+		ZSimd_MulAdd(ZEasing_K(16.0f), ZEasing_QuintIn(g), 
+			ZEasing_K(1.0f)));
+}
+
+static FORCEINLINE ZSIMDF
+ZEasing_ExpoIn(ZSIMDF _f) {
+	return ZSimd_Mul(ZSimd_Sub(ZEasing_Exp2(ZSimd_Mul(_f, 
+		ZEasing_K(8.0f))), ZEasing_K(1.0f)), ZEasing_K(1.0f / 255.0f));
+}
+
+static FORCEINLINE ZSIMDF
+ZEasing_ExpoOut(ZSIMDF _f) {
+	return ZSimd_Sub(ZEasing_K(1.0f), 
+		ZEasing_Exp2(ZSimd_Mul(_f, ZEasing_K(-8.0f))));
+}
+
+static FORCEINLINE ZSIMDF
+ZEasing_ExpoInOut(ZSIMDF _f) {
+	ZSIMDF e;
+	//one 2^x serves both halves: 2^(16f) below 0.5, 2^(8 - 16f) above
+	e = ZEasing_Exp2(ZEasing_Below(_f, 0.5f,
+		ZSimd_Mul(_f, ZEasing_K(16.0f)),
+		ZSimd_MulAdd(_f, ZEasing_K(-16.0f), ZEasing_K(8.0f))));
+	return ZEasing_Below(_f, 0.5f,
+		ZSimd_Mul(ZSimd_Sub(e, ZEasing_K(1.0f)), ZEasing_K(1.0f / 510.0f)),
+		ZSimd_Sub(ZEasing_K(1.0f), ZSimd_Mul(ZEasing_K(0.5f), e)));
+}
+
+static FORCEINLINE ZSIMDF
+ZEasing_CircIn(ZSIMDF _f) {
+	return ZSimd_Sub(ZEasing_K(1.0f), ZSimd_Sqrt(ZSimd_Max(
+		ZSimd_Sub(ZEasing_K(1.0f), _f), ZEasing_K(0.0f))));
+}
+
+static FORCEINLINE ZSIMDF
+ZEasing_CircOut(ZSIMDF _f) {
+	return ZSimd_Sqrt(ZSimd_Max(_f, ZEasing_K(0.0f)));
+}
+
+static FORCEINLINE ZSIMDF
+ZEasing_CircInOut(ZSIMDF _f) {
+	ZSIMDF s;
+	//sqrt(1 - 2f) below 0.5, sqrt(2f - 1) above
+	s = ZSimd_Sqrt(ZSimd_Abs(ZSimd_MulAdd(_f, ZEasing_K(2.0f), 
+		ZEasing_K(-1.0f))));
+	return ZSimd_Mul(ZEasing_K(0.5f), ZEasing_Below(_f, 0.5f,
+		ZSimd_Sub(ZEasing_K(1.0f), s), ZSimd_Add(ZEasing_K(1.0f), s)));
+}
+
+static FORCEINLINE ZSIMDF
+ZEasing_BackIn(ZSIMDF _f) {
+	return ZSimd_Mul(ZSimd_Mul(_f, _f), 
+		ZSimd_MulAdd(_f, ZEasing_K(2.70158f), ZEasing_K(-1.70158f)));
+}
+
+static FORCEINLINE ZSIMDF
+ZEasing_BackOut(ZSIMDF _f) {
+	ZSIMDF g = ZSimd_Sub(_f, ZEasing_K(1.0f));
+	return ZSimd_MulAdd(ZSimd_Mul(g, g), 
+		ZSimd_MulAdd(g, ZEasing_K(2.70158f), ZEasing_K(1.70158f)), 
+		ZEasing_K(1.0f));
+}
+
+static FORCEINLINE ZSIMDF
+ZEasing_BackInOut(ZSIMDF _f) {
+	ZSIMDF g = ZSimd_Sub(_f, ZEasing_K(1.0f));
+	return ZEasing_Below(_f, 0.5f,
+		ZSimd_Mul(ZSimd_Mul(_f, _f), ZSimd_MulAdd(_f, 
+			ZEasing_K(14.0f), ZEasing_K(-5.0f))),
+		ZSimd_MulAdd(ZSimd_Mul(g, g), ZSimd_MulAdd(g,
+			ZEasing_K(14.0f), ZEasing_K(5.0f)), ZEasing_K(1.0f)));
+}
+
+static FORCEINLINE ZSIMDF
+ZEasing_BounceIn(ZSIMDF _f) {
+	return ZSimd_Mul(
+		ZEasing_Exp2(ZSimd_MulAdd(_f, ZEasing_K(6.0f), ZEasing_K(-6.0f))),
+		ZSimd_Abs(ZEasing_Sin(ZSimd_Mul(_f, ZEasing_K(ZMATH_PI * 3.5f)))));
+}
+
+static FORCEINLINE ZSIMDF
+ZEasing_BounceOut(ZSIMDF _f) {
+	return ZSimd_Sub(ZEasing_K(1.0f), ZSimd_Mul(
+		ZEasing_Exp2(ZSimd_Mul(_f, ZEasing_K(-6.0f))),
+		ZSimd_Abs(ZEasing_Cos(ZSimd_Mul(_f, ZEasing_K(ZMATH_PI * 3.5f))))));
+}
+
+static FORCEINLINE ZSIMDF
+ZEasing_BounceInOut(ZSIMDF _f) {
+	ZSIMDF e, s;
+	//8 * 2^(8f - 8) below 0.5, 8 * 2^(-8f) above
+	e = ZSimd_Mul(ZEasing_K(8.0f), ZEasing_Exp2(ZEasing_Below(_f, 0.5f,
+		ZSimd_MulAdd(_f, ZEasing_K(8.0f), ZEasing_K(-8.0f)),
+		ZSimd_Mul(_f, ZEasing_K(-8.0f)))));
+	s = ZSimd_Mul(e, ZSimd_Abs(
+		ZEasing_Sin(ZSimd_Mul(_f, ZEasing_K(ZMATH_PI * 7.0f)))));
+	return ZEasing_Below(_f, 0.5f, s, ZSimd_Sub(ZEasing_K(1.0f), s));
+}
+
+static FORCEINLINE ZSIMDF
+ZEasing_ElasticIn(ZSIMDF _f) {
+	return ZSimd_Mul(ZEasing_Pow4(_f), 
+		ZEasing_Sin(ZSimd_Mul(_f, ZEasing_K(ZMATH_PI * 4.5f))));
+}
+
+static FORCEINLINE ZSIMDF
+ZEasing_ElasticOut(ZSIMDF _f) {
+	ZSIMDF g = ZSimd_Sub(_f, ZEasing_K(1.0f));
+	return ZSimd_Sub(ZEasing_K(1.0f), ZSimd_Mul(ZEasing_Pow4(g), 
+		ZEasing_Cos(ZSimd_Mul(_f, ZEasing_K(ZMATH_PI * 4.5f)))));
+}
+
+static FORCEINLINE ZSIMDF
+ZEasing_ElasticInOut(ZSIMDF _f) {
+	ZSIMDF g, s, mid, low, high;
+	g    = ZSimd_Sub(_f, ZEasing_K(1.0f));
+	s    = ZEasing_Sin(ZSimd_Mul(_f, ZEasing_K(ZMATH_PI * 9.0f)));
+	low  = ZSimd_Mul(ZSimd_Mul(ZEasing_K(8.0f), ZEasing_Pow4(_f)), s);
+	high = ZSimd_Sub(ZEasing_K(1.0f), 
+		ZSimd_Mul(ZSimd_Mul(ZEasing_K(8.0f), ZEasing_Pow4(g)), s));
+	mid  = ZSimd_MulAdd(ZEasing_K(0.75f), 
+		ZEasing_Sin(ZSimd_Mul(_f, ZEasing_K(ZMATH_PI * 4.0f))), 
+		ZEasing_K(0.5f));
+	return ZEasing_Below(_f, 0.45f, low, 
+		ZEasing_Below(_f, 0.55f, mid, high));
+}
+
+
+/*
+Runs a curve over an array. Being inlined with a constant _curve, 
+each call becomes a loop with the curve inlined in its body. The 
+last partial vector goes through a padded copy, so every value is 
+computed the same way*/
+static FORCEINLINE Void
+ZEasing_Run(
+	_In_  ZSIMDF      (*_curve)(ZSIMDF),
+	_In_  const Float* _src,
+	_Out_ Float*       _dst,
+	_In_  SizeT        _count) {
+
+	Float tail[ZSIMD_LANES];
+	SizeT i, rest;
+	for (i = 0; i + ZSIMD_LANES <= _count; i += ZSIMD_LANES)
+		ZSimd_Store(_dst + i, _curve(ZSimd_Load(_src + i)));
+	rest = _count - i;
+	if (rest) {
+		memset(tail, 0, sizeof(tail));
+		memcpy(tail, _src + i, rest * sizeof(Float));
+		ZSimd_Store(tail, _curve(ZSimd_Load(tail)));
+		memcpy(_dst + i, tail, rest * sizeof(Float));
+	}
+}
+
+
+
+
+/* Section 3:
+** public
+******************************************************************************/
+#define ZEASING_CASE(e, curve)\
+	case e: ZEasing_Run(curve, _src, _dst, _count); return;
+
+Void
+ZEasing_Evaluate(
+	_In_  ZMATH_EASING _eEasing,
+	_In_  const Float* _src,
+	_Out_ Float*       _dst,
+	_In_  SizeT        _count) {
+
+	switch (_eEasing) {
+	ZEASING_CASE(ZMATH_EASING_QUARTIN, ZEasing_QuartIn)
+	ZEASING_CASE(ZMATH_EASING_QUARTOUT, ZEasing_QuartOut)
+	ZEASING_CASE(ZMATH_EASING_QUARTINOUT, ZEasing_QuartInOut)
+	ZEASING_CASE(ZMATH_EASING_CUBICIN, ZEasing_CubicIn)
+	ZEASING_CASE(ZMATH_EASING_CUBICOUT, ZEasing_CubicOut)
+	ZEASING_CASE(ZMATH_EASING_CUBICINOUT, ZEasing_CubicInOut)
+	ZEASING_CASE(ZMATH_EASING_QUADIN, ZEasing_QuadIn)
+	ZEASING_CASE(ZMATH_EASING_QUADOUT, ZEasing_QuadOut)
+	ZEASING_CASE(ZMATH_EASING_QUADINOUT, ZEasing_QuadInOut)
+	ZEASING_CASE(ZMATH_EASING_SINEIN, ZEasing_SineIn)
+	ZEASING_CASE(ZMATH_EASING_SINEOUT, ZEasing_SineOut)
+	ZEASING_CASE(ZMATH_EASING_SINEINOUT, ZEasing_SineInOut)
+	ZEASING_CASE(ZMATH_EASING_QUINTIN, ZEasing_QuintIn)
+	ZEASING_CASE(ZMATH_EASING_QUINTOUT, ZEasing_QuintOut)
+	ZEASING_CASE(ZMATH_EASING_QUINTINOUT, ZEasing_QuintInOut)
+	ZEASING_CASE(ZMATH_EASING_EXPOIN, ZEasing_ExpoIn)
+	ZEASING_CASE(ZMATH_EASING_EXPOOUT, ZEasing_ExpoOut)
+	ZEASING_CASE(ZMATH_EASING_EXPOINOUT, ZEasing_ExpoInOut)
+	ZEASING_CASE(ZMATH_EASING_CIRCIN, ZEasing_CircIn)
+	ZEASING_CASE(ZMATH_EASING_CIRCOUT, ZEasing_CircOut)
+	ZEASING_CASE(ZMATH_EASING_CIRCINOUT, ZEasing_CircInOut)
+	ZEASING_CASE(ZMATH_EASING_BACKIN, ZEasing_BackIn)
+	ZEASING_CASE(ZMATH_EASING_BACKOUT, ZEasing_BackOut)
+	ZEASING_CASE(ZMATH_EASING_BACKINOUT, ZEasing_BackInOut)
+	ZEASING_CASE(ZMATH_EASING_BOUNCEIN, ZEasing_BounceIn)
+	ZEASING_CASE(ZMATH_EASING_BOUNCEOUT, ZEasing_BounceOut)
+	ZEASING_CASE(ZMATH_EASING_BOUNCEINOUT, ZEasing_BounceInOut)
+	ZEASING_CASE(ZMATH_EASING_ELASTICIN, ZEasing_ElasticIn)
+	ZEASING_CASE(ZMATH_EASING_ELASTICOUT, ZEasing_ElasticOut)
+	ZEASING_CASE(ZMATH_EASING_ELASTICINOUT, ZEasing_ElasticInOut)
+	}
+	if (_dst != _src) //unknown curves pass progress through, as ZMath_Easing
+		memmove(_dst, _src, _count * sizeof(Float));
+}
+
+
+ZRESULT
+ZEasingLut_Init(
+	_Out_ ZEASINGLUT*  _lpLut,
+	_In_  ZMATH_EASING _eEasing,
+	_In_  SizeT        _size) {
+
+	Float t, lerp, error;
+	SizeT i, j;
+	memset(_lpLut, 0, sizeof(ZEASINGLUT));
+	if (!_size || _size > 0x7FFFFFFF) 
+		return Z_EINVALIDARG;
+	_lpLut->lpTable = (Float*)malloc((_size + 1) * sizeof(Float));
+	if (!_lpLut->lpTable)
+		return Z_EOUTOFMEMORY;
+	_lpLut->eEasing = _eEasing;
+	_lpLut->iSize   = _size;
+	for (i = 0; i <= _size; i++)
+		_lpLut->lpTable[i] = ZMath_Easing(_eEasing, (Float)i / (Float)_size);
+	for (i = 0; i < _size; i++) {
+		for (j = 1; j < ZEASING_PROBES; j++) {
+			t     = ((Float)i + (Float)j / ZEASING_PROBES) / (Float)_size;
+			lerp  = ZEasingLut_Sample(_lpLut, t);
+			error = fabsf(lerp - ZMath_Easing(_eEasing, t));
+			if (error > _lpLut->fMaxError)
+				_lpLut->fMaxError = error;
+		}
+	}
+	return Z_OK;
+}
+
+
+Void
+ZEasingLut_Free(
+	_Inout_ ZEASINGLUT* _lpLut) {
+
+	free(_lpLut->lpTable);
+	memset(_lpLut, 0, sizeof(ZEASINGLUT));
+}
+
+
+Float
+ZEasingLut_Sample(
+	_In_ const ZEASINGLUT* _lpLut,
+	_In_ Float             _t) {
+
+	Float x, a, b;
+	Int32 i;
+	x = Z_Min(Z_Max(_t, 0.0f), 1.0f) * (Float)_lpLut->iSize;
+	i = Z_Min((Int32)x, (Int32)_lpLut->iSize - 1);
+	a = _lpLut->lpTable[i];
+	b = _lpLut->lpTable[i + 1];
+	return a + (b - a) * (x - (Float)i);
+}
+
+
+Void
+ZEasingLut_Evaluate(
+	_In_  const ZEASINGLUT* _lpLut,
+	_In_  const Float*      _src,
+	_Out_ Float*            _dst,
+	_In_  SizeT             _count) {
+
+	const Float* table;
+	Float size, x, a, b;
+	Int32 k, last;
+	SizeT i = 0;
+	table = _lpLut->lpTable;
+	size  = (Float)_lpLut->iSize;
+	last  = (Int32)_lpLut->iSize - 1;
+#if (ZSIMD_AVX2)
+	{
+		__m256 vx, vf, va, vb;
+		__m256i vk;
+		for (; i + 8 <= _count; i += 8) {
+			vx = _mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(_src + i), 
+				_mm256_setzero_ps()), _mm256_set1_ps(1.0f));
+			vx = _mm256_mul_ps(vx, _mm256_set1_ps(size));
+			vk = _mm256_min_epi32(_mm256_cvttps_epi32(vx), 
+				_mm256_set1_epi32(last));
+			vf = _mm256_sub_ps(vx, _mm256_cvtepi32_ps(vk));
+			va = _mm256_i32gather_ps(table, vk, 4);
+			vb = _mm256_i32gather_ps(table + 1, vk, 4);
+			_mm256_storeu_ps(_dst + i, _mm256_add_ps(va, 
+				_mm256_mul_ps(_mm256_sub_ps(vb, va), vf)));
+		}
+	}
+#elif (ZSIMD_SSE2)
+	{
+		__m128 vx, vk, va, vb;
+		Int32 idx[4];
+		Float ta[4], tb[4];
+		for (; i + 4 <= _count; i += 4) {
+			vx = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(_src + i),
+				_mm_setzero_ps()), _mm_set1_ps(1.0f));
+			vx = _mm_mul_ps(vx, _mm_set1_ps(size));
+			vk = _mm_min_ps(_mm_cvtepi32_ps(_mm_cvttps_epi32(vx)),
+				_mm_set1_ps((Float)last));
+			_mm_storeu_si128((__m128i*)idx, _mm_cvttps_epi32(vk));
+			ta[0] = table[idx[0]]; tb[0] = table[idx[0] + 1];
+			ta[1] = table[idx[1]]; tb[1] = table[idx[1] + 1];
+			ta[2] = table[idx[2]]; tb[2] = table[idx[2] + 1];
+			ta[3] = table[idx[3]]; tb[3] = table[idx[3] + 1];
+			va = _mm_loadu_ps(ta);
+			vb = _mm_loadu_ps(tb);
+			_mm_storeu_ps(_dst + i, _mm_add_ps(va,
+				_mm_mul_ps(_mm_sub_ps(vb, va), _mm_sub_ps(vx, vk))));
+		}
+	}
+#endif
+	for (; i < _count; i++) {
+		x = Z_Min(Z_Max(_src[i], 0.0f), 1.0f) * size;
+		k = Z_Min((Int32)x, last);
+		a = table[k];
+		b = table[k + 1];
+		_dst[i] = a + (b - a) * (x - (Float)k);
+	}
+}
+/*****************************************************************************/  
+//EOF
+/*****************************************************************************/  
@@ -0,0 +1,1981 @@
+/******************************************************************************
+* zutil - C Utility Library
+* Copyright (C) 2017-2021 Zachary T Harris. All Rights Reserved.  
+* Zlib license.
+* 
+* File: zfixed.c
+* Desc: deterministic Q16.16 and Q32.32 fixed-point vectors and rects
+*******************************************************************************
+
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+******************************************************************************/ 
+#include <math.h>
+#include "zutil/zmath.h"
+#include "zutil/zfixed.h"
+
+#if (Z_ARCHITECTURE_AVX2)
+#  include <immintrin.h>
+#  define ZFIXED_AVX2 1
+#endif
+#if (Z_ARCHITECTURE_SSE2)
+#  include <emmintrin.h>
+#  define ZFIXED_SSE2 1
+#elif (Z_ARCHITECTURE_NEON)
+#  include <arm_neon.h>
+#  define ZFIXED_NEON 1
+#endif
+
+
+
+#define ZFIXED_CORDICSTEPS 36
+#define ZFIXED_CORDICGAIN  ((Int64)0x136E9DB5086BCB4Dll) //K in Q2.61
+
+/*
+A 128-bit integer, as two's complement when signed*/
+typedef struct _ZFIXEDU128 {
+	Uint64 hi;
+	Uint64 lo;
+} ZFIXEDU128;
+
+/*
+sin(i * pi / 512) in Q2.30 for i in [0, 256]*/
+static const Int32 ZFIXED_SINTABLE[257] = {
+	0x00000000, 0x006487C4, 0x00C90E90, 0x012D936C, 0x0192155F, 0x01F69373,
+	0x025B0CAF, 0x02BF801A, 0x0323ECBE, 0x038851A2, 0x03ECADCF, 0x0451004D,
+	0x04B54825, 0x0519845E, 0x057DB403, 0x05E1D61B, 0x0645E9AF, 0x06A9EDC9,
+	0x070DE172, 0x0771C3B3, 0x07D59396, 0x08395024, 0x089CF867, 0x09008B6A,
+	0x09640837, 0x09C76DD8, 0x0A2ABB59, 0x0A8DEFC3, 0x0AF10A22, 0x0B540982,
+	0x0BB6ECEF, 0x0C19B374, 0x0C7C5C1E, 0x0CDEE5F9, 0x0D415013, 0x0DA39978,
+	0x0E05C135, 0x0E67C65A, 0x0EC9A7F3, 0x0F2B650F, 0x0F8CFCBE, 0x0FEE6E0D,
+	0x104FB80E, 0x10B0D9D0, 0x1111D263, 0x1172A0D7, 0x11D3443F, 0x1233BBAC,
+	0x1294062F, 0x12F422DB, 0x135410C3, 0x13B3CEFA, 0x14135C94, 0x1472B8A5,
+	0x14D1E242, 0x1530D881, 0x158F9A76, 0x15EE2738, 0x164C7DDD, 0x16AA9D7E,
+	0x17088531, 0x1766340F, 0x17C3A931, 0x1820E3B0, 0x187DE2A7, 0x18DAA52F,
+	0x19372A64, 0x19937161, 0x19EF7944, 0x1A4B4128, 0x1AA6C82B, 0x1B020D6C,
+	0x1B5D100A, 0x1BB7CF23, 0x1C1249D8, 0x1C6C7F4A, 0x1CC66E99, 0x1D2016E9,
+	0x1D79775C, 0x1DD28F15, 0x1E2B5D38, 0x1E83E0EB, 0x1EDC1953, 0x1F340596,
+	0x1F8BA4DC, 0x1FE2F64C, 0x2039F90F, 0x2090AC4D, 0x20E70F32, 0x213D20E8,
+	0x2192E09B, 0x21E84D76, 0x223D66A8, 0x22922B5E, 0x22E69AC8, 0x233AB414,
+	0x238E7673, 0x23E1E117, 0x2434F332, 0x2487ABF7, 0x24DA0A9A, 0x252C0E4F,
+	0x257DB64C, 0x25CF01C8, 0x261FEFFA, 0x2670801A, 0x26C0B162, 0x2710830C,
+	0x275FF452, 0x27AF0472, 0x27FDB2A7, 0x284BFE2F, 0x2899E64A, 0x28E76A37,
+	0x29348937, 0x2981428C, 0x29CD9578, 0x2A19813F, 0x2A650525, 0x2AB02071,
+	0x2AFAD269, 0x2B451A55, 0x2B8EF77D, 0x2BD8692B, 0x2C216EAA, 0x2C6A0746,
+	0x2CB2324C, 0x2CF9EF09, 0x2D413CCD, 0x2D881AE8, 0x2DCE88AA, 0x2E148566,
+	0x2E5A1070, 0x2E9F291B, 0x2EE3CEBE, 0x2F2800AF, 0x2F6BBE45, 0x2FAF06DA,
+	0x2FF1D9C7, 0x30343667, 0x30761C18, 0x30B78A36, 0x30F8801F, 0x3138FD35,
+	0x317900D6, 0x31B88A66, 0x31F79948, 0x32362CE0, 0x32744493, 0x32B1DFC9,
+	0x32EEFDEA, 0x332B9E5E, 0x3367C090, 0x33A363EC, 0x33DE87DE, 0x34192BD5,
+	0x34534F41, 0x348CF190, 0x34C61236, 0x34FEB0A5, 0x3536CC52, 0x356E64B2,
+	0x35A5793C, 0x35DC0968, 0x361214B0, 0x36479A8E, 0x367C9A7E, 0x36B113FD,
+	0x36E5068A, 0x371871A5, 0x374B54CE, 0x377DAF89, 0x37AF8159, 0x37E0C9C3,
+	0x3811884D, 0x3841BC7F, 0x387165E3, 0x38A08402, 0x38CF1669, 0x38FD1CA4,
+	0x392A9642, 0x395782D3, 0x3983E1E8, 0x39AFB313, 0x39DAF5E8, 0x3A05A9FD,
+	0x3A2FCEE8, 0x3A596442, 0x3A8269A3, 0x3AAADEA6, 0x3AD2C2E8, 0x3AFA1605,
+	0x3B20D79E, 0x3B470753, 0x3B6CA4C4, 0x3B91AF97, 0x3BB6276E, 0x3BDA0BF0,
+	0x3BFD5CC4, 0x3C201994, 0x3C42420A, 0x3C63D5D1, 0x3C84D496, 0x3CA53E09,
+	0x3CC511D9, 0x3CE44FB7, 0x3D02F757, 0x3D21086C, 0x3D3E82AE, 0x3D5B65D2,
+	0x3D77B192, 0x3D9365A8, 0x3DAE81CF, 0x3DC905C5, 0x3DE2F148, 0x3DFC4418,
+	0x3E14FDF7, 0x3E2D1EA8, 0x3E44A5EF, 0x3E5B9392, 0x3E71E759, 0x3E87A10C,
+	0x3E9CC076, 0x3EB14563, 0x3EC52FA0, 0x3ED87EFC, 0x3EEB3347, 0x3EFD4C54,
+	0x3F0EC9F5, 0x3F1FABFF, 0x3F2FF24A, 0x3F3F9CAB, 0x3F4EAAFE, 0x3F5D1D1D,
+	0x3F6AF2E3, 0x3F782C30, 0x3F84C8E2, 0x3F90C8DA, 0x3F9C2BFB, 0x3FA6F228,
+	0x3FB11B48, 0x3FBAA740, 0x3FC395F9, 0x3FCBE75E, 0x3FD39B5A, 0x3FDAB1D9,
+	0x3FE12ACB, 0x3FE7061F, 0x3FEC43C7, 0x3FF0E3B6, 0x3FF4E5E0, 0x3FF84A3C,
+	0x3FFB10C1, 0x3FFD3969, 0x3FFEC42D, 0x3FFFB10B, 0x40000000
+};
+
+/*
+atan(2^-i) in 2^-64 turns*/
+static const Uint64 ZFIXED_ATANTABLE[ZFIXED_CORDICSTEPS] = {
+	0x2000000000000000ull,
+	0x12E4051D9DF30866ull,
+	0x09FB385B5EE39E8Eull,
+	0x051111D41DDD9A1Bull,
+	0x028B0D430E589AEDull,
+	0x0145D7E159046278ull,
+	0x00A2F61E5C28262Aull,
+	0x00517C5511D442AFull,
+	0x0028BE5346D0C337ull,
+	0x00145F2EBB30AB38ull,
+	0x000A2F980091BA7Bull,
+	0x000517CC14A80CB7ull,
+	0x00028BE60CDFEC62ull,
+	0x000145F306C172F2ull,
+	0x0000A2F9836AE911ull,
+	0x0000517CC1B6BA7Cull,
+	0x000028BE60DB85FCull,
+	0x0000145F306DC816ull,
+	0x00000A2F9836E4AEull,
+	0x00000517CC1B726Bull,
+	0x0000028BE60DB938ull,
+	0x00000145F306DC9Cull,
+	0x000000A2F9836E4Eull,
+	0x000000517CC1B727ull,
+	0x00000028BE60DB94ull,
+	0x000000145F306DCAull,
+	0x0000000A2F9836E5ull,
+	0x0000000517CC1B72ull,
+	0x000000028BE60DB9ull,
+	0x0000000145F306DDull,
+	0x00000000A2F9836Eull,
+	0x00000000517CC1B7ull,
+	0x0000000028BE60DCull,
+	0x00000000145F306Eull,
+	0x000000000A2F9837ull,
+	0x000000000517CC1Bull
+};
+
+
+
+
+
+/* Section 1:
+** integer helpers
+******************************************************************************/
+static FORCEINLINE ZFIXED
+ZFixed_WrapAdd(
+	_In_ ZFIXED _a,
+	_In_ ZFIXED _b) {
+
+	return (ZFIXED)((Uint32)_a + (Uint32)_b);
+}
+
+
+static FORCEINLINE ZFIXED
+ZFixed_WrapSub(
+	_In_ ZFIXED _a,
+	_In_ ZFIXED _b) {
+
+	return (ZFIXED)((Uint32)_a - (Uint32)_b);
+}
+
+
+static FORCEINLINE ZFIXED64
+ZFixed64_WrapAdd(
+	_In_ ZFIXED64 _a,
+	_In_ ZFIXED64 _b) {
+
+	return (ZFIXED64)((Uint64)_a + (Uint64)_b);
+}
+
+
+static FORCEINLINE ZFIXED64
+ZFixed64_WrapSub(
+	_In_ ZFIXED64 _a,
+	_In_ ZFIXED64 _b) {
+
+	return (ZFIXED64)((Uint64)_a - (Uint64)_b);
+}
+
+
+/*
+Signed 64x64 to 128-bit product*/
+static FORCEINLINE ZFIXEDU128
+ZFixed_Mul128(
+	_In_ Int64 _a,
+	_In_ Int64 _b) {
+
+	ZFIXEDU128 p;
+#if defined(__SIZEOF_INT128__)
+	__int128 q = (__int128)_a * _b;
+	p.hi = (Uint64)(q >> 64);
+	p.lo = (Uint64)q;
+#elif defined(_MSC_VER) && defined(_M_X64)
+	Int64 hi;
+	p.lo = (Uint64)_mul128(_a, _b, &hi);
+	p.hi = (Uint64)hi;
+#else
+	Uint64 ua, ub, p00, p01, p10, mid;
+	ua  = (Uint64)_a;
+	ub  = (Uint64)_b;
+	p00 = (ua & 0xFFFFFFFFu) * (ub & 0xFFFFFFFFu);
+	p01 = (ua & 0xFFFFFFFFu) * (ub >> 32);
+	p10 = (ua >> 32) * (ub & 0xFFFFFFFFu);
+	mid = (p00 >> 32) + (p01 & 0xFFFFFFFFu) + (p10 & 0xFFFFFFFFu);
+	p.lo = (mid << 32) | (p00 & 0xFFFFFFFFu);
+	p.hi = (ua >> 32) * (ub >> 32) + (p01 >> 32) + (p10 >> 32) + (mid >> 32);
+	if (_a < 0)
+		p.hi -= ub;
+	if (_b < 0)
+		p.hi -= ua;
+#endif
+	return p;
+}
+
+
+static FORCEINLINE ZFIXEDU128
+ZFixed_Add128(
+	_In_ ZFIXEDU128 _a,
+	_In_ ZFIXEDU128 _b) {
+
+	ZFIXEDU128 r;
+	r.lo = _a.lo + _b.lo;
+	r.hi = _a.hi + _b.hi + (r.lo < _a.lo);
+	return r;
+}
+
+
+static FORCEINLINE ZFIXEDU128
+ZFixed_Sub128(
+	_In_ ZFIXEDU128 _a,
+	_In_ ZFIXEDU128 _b) {
+
+	ZFIXEDU128 r;
+	r.lo = _a.lo - _b.lo;
+	r.hi = _a.hi - _b.hi - (_a.lo < _b.lo);
+	return r;
+}
+
+
+/*
+Shifts a 128-bit value right by 1 to 63 bits, rounding to nearest, 
+and keeps the low 64 bits of the result*/
+static FORCEINLINE ZFIXED64
+ZFixed_Round128(
+	_In_ ZFIXEDU128 _p,
+	_In_ Int32      _shift) {
+
+	Uint64 lo = _p.lo + (1ull << (_shift - 1));
+	Uint64 hi = _p.hi + (lo < _p.lo);
+	return (ZFIXED64)((hi << (64 - _shift)) | (lo >> _shift));
+}
+
+
+/*
+Divides a 128-bit value by a 64-bit one, _hi < _d.
+@_rem  : receives the remainder
+@return: the quotient*/
+static FORCEINLINE Uint64
+ZFixed_DivU128(
+	_In_    Uint64  _hi,
+	_In_    Uint64  _lo,
+	_In_    Uint64  _d,
+	_Inout_ Uint64* _rem) {
+
+#if defined(__SIZEOF_INT128__)
+	unsigned __int128 n = ((unsigned __int128)_hi << 64) | _lo;
+	*_rem = (Uint64)(n % _d);
+	return (Uint64)(n / _d);
+#elif defined(_MSC_VER) && defined(_M_X64) && (_MSC_VER >= 1920)
+	return _udiv128(_hi, _lo, _d, _rem);
+#else
+	Uint64 q, rem;
+	Int32  i;
+	q   = 0;
+	rem = _hi;
+	for (i = 0; i < 64; i++) {
+		Uint64 top = rem >> 63;
+		rem  = (rem << 1) | (_lo >> 63);
+		_lo <<= 1;
+		q   <<= 1;
+		if (top || rem >= _d) {
+			rem -= _d;
+			q   |= 1;
+		}
+	}
+	*_rem = rem;
+	return q;
+#endif
+}
+
+
+/*
+Divides a signed 128-bit value by a signed 64-bit one, rounding to
+nearest with ties toward positive infinity and saturating*/
+static ZFIXED64
+ZFixed_Div128(
+	_In_ ZFIXEDU128 _n,
+	_In_ Int64      _d) {
+
+	Uint64 hi, lo, d, q, rem;
+	Bool   negative, roundUp;
+
+	negative = ((Int64)_n.hi < 0) != (_d < 0);
+	hi = _n.hi;
+	lo = _n.lo;
+	if ((Int64)hi < 0) {
+		lo = 0 - lo;
+		hi = ~hi + (lo == 0);
+	}
+	d = (_d < 0) ? 0 - (Uint64)_d : (Uint64)_d;
+	if (d == 0)
+		return (hi | lo) ? (negative ? ZFIXED64_MIN : ZFIXED64_MAX) : 0;
+	if (hi >= d)
+		return negative ? ZFIXED64_MIN : ZFIXED64_MAX;
+
+	q = ZFixed_DivU128(hi, lo, d, &rem);
+	roundUp = negative ? (rem > d - rem) : (rem >= d - rem);
+	if (roundUp)
+		q++;
+	if (!negative && (q >> 63))
+		return ZFIXED64_MAX;
+	if (negative && q > 0x8000000000000000ull)
+		return ZFIXED64_MIN;
+	return negative ? (ZFIXED64)(0 - q) : (ZFIXED64)q;
+}
+
+
+/*
+Computes the square root of a 128-bit value below 2^126, rounded to 
+nearest, two bits at a time*/
+static Uint64
+ZFixed_ISqrt(
+	_In_ Uint64 _hi,
+	_In_ Uint64 _lo) {
+
+	Uint64 root, rem, bits, trial;
+	Int32  shift;
+
+	if (_hi)
+		shift = (127 - Z_CLZ64(_hi)) & ~1;
+	else if (_lo)
+		shift = (63 - Z_CLZ64(_lo)) & ~1;
+	else
+		return 0;
+
+	root = 0;
+	rem  = 0;
+	for (; shift >= 0; shift -= 2) {
+		bits  = (shift >= 64) ? (_hi >> (shift - 64)) & 3 : (_lo >> shift) & 3;
+		trial = (root << 2) | 1;
+		if ((rem >> 62) || ((rem << 2) | bits) >= trial) {
+			rem  = ((rem << 2) | bits) - trial;
+			root = (root << 1) | 1;
+		}
+		else {
+			rem  = (rem << 2) | bits;
+			root = root << 1;
+		}
+	}
+	if (rem > root)
+		root++;
+	return root;
+}
+
+
+/*
+Divides by a positive integer, rounding toward negative infinity*/
+static FORCEINLINE Int64
+ZFixed_FloorDiv(
+	_In_ Int64 _n,
+	_In_ Int64 _d) {
+
+	Int64 q = _n / _d;
+	if ((_n % _d) < 0)
+		q--;
+	return q;
+}
+
+
+
+
+
+/* Section 2:
+** scalar arithmetic
+******************************************************************************/
+ZFIXED
+ZFixed_FromFloat(
+	_In_ Float _value) {
+
+	Real64 v;
+	v = floor((Real64)_value * 65536.0 + 0.5);
+	if (v != v)
+		return 0;
+	if (v >= 2147483647.0)
+		return ZFIXED_MAX;
+	if (v <= -2147483648.0)
+		return ZFIXED_MIN;
+	return (ZFIXED)v;
+}
+
+
+Float
+ZFixed_ToFloat(
+	_In_ ZFIXED _value) {
+
+	return (Float)((Real64)_value / 65536.0);
+}
+
+
+ZFIXED
+ZFixed_Div(
+	_In_ ZFIXED _a,
+	_In_ ZFIXED _b) {
+
+	Int64 n, d, q, rem;
+	Bool  negative, roundUp;
+
+	negative = (_a < 0) != (_b < 0);
+	n = (_a < 0) ? -(Int64)_a : (Int64)_a;
+	d = (_b < 0) ? -(Int64)_b : (Int64)_b;
+	if (d == 0)
+		return _a ? (negative ? ZFIXED_MIN : ZFIXED_MAX) : 0;
+
+	n <<= ZFIXED_SHIFT;
+	q   = n / d;
+	rem = n % d;
+	roundUp = negative ? (rem > d - rem) : (rem >= d - rem);
+	if (roundUp)
+		q++;
+	if (!negative && q > 0x7FFFFFFFll)
+		return ZFIXED_MAX;
+	if (negative && q > 0x80000000ll)
+		return ZFIXED_MIN;
+	return (ZFIXED)(negative ? -q : q);
+}
+
+
+ZFIXED
+ZFixed_Sqrt(
+	_In_ ZFIXED _value) {
+
+	if (_value <= 0)
+		return 0;
+	return (ZFIXED)ZFixed_ISqrt(0, (Uint64)_value << ZFIXED_SHIFT);
+}
+
+
+ZFIXED64
+ZFixed64_FromReal64(
+	_In_ Real64 _value) {
+
+	Real64 v;
+	v = _value * 4294967296.0;
+	if (v != v)
+		return 0;
+	//above 2^52 every double is an integer, and adding 0.5 could round
+	if (fabs(v) < 4503599627370496.0)
+		v = floor(v + 0.5);
+	if (v >= 9223372036854775807.0)
+		return ZFIXED64_MAX;
+	if (v <= -9223372036854775808.0)
+		return ZFIXED64_MIN;
+	return (ZFIXED64)v;
+}
+
+
+Real64
+ZFixed64_ToReal64(
+	_In_ ZFIXED64 _value) {
+
+	return (Real64)_value * (1.0 / 4294967296.0);
+}
+
+
+ZFIXED64
+ZFixed64_Mul(
+	_In_ ZFIXED64 _a,
+	_In_ ZFIXED64 _b) {
+
+	return ZFixed_Round128(ZFixed_Mul128(_a, _b), 32);
+}
+
+
+ZFIXED64
+ZFixed64_Div(
+	_In_ ZFIXED64 _a,
+	_In_ ZFIXED64 _b) {
+
+	ZFIXEDU128 n;
+	n.hi = (Uint64)(_a >> 32);
+	n.lo = (Uint64)_a << 32;
+	return ZFixed_Div128(n, _b);
+}
+
+
+ZFIXED64
+ZFixed64_Sqrt(
+	_In_ ZFIXED64 _value) {
+
+	if (_value <= 0)
+		return 0;
+	return (ZFIXED64)ZFixed_ISqrt(
+		(Uint64)_value >> 32, (Uint64)_value << 32);
+}
+
+
+
+
+
+/* Section 3:
+** angles and trigonometry
+******************************************************************************/
+/*
+Computes a sine in Q2.30. The angle is split into a table entry and 
+a remainder d below pi / 512, and sin(a + d) is expanded to the third 
+order, the table giving both sin(a) and cos(a). The error is within a 
+few units of Q2.30.*/
+static FORCEINLINE Int32
+ZFixed_SinQ30(
+	_In_ ZANGLE _angle) {
+
+	Uint32 a, i;
+	Int64  sn, cs, d, d2, d3, s;
+	a = _angle & (ZANGLE_QUARTER - 1);
+	if (_angle & ZANGLE_QUARTER)
+		a = ZANGLE_QUARTER - a;
+	i  = a >> 22;
+	sn = ZFIXED_SINTABLE[i];
+	cs = ZFIXED_SINTABLE[256 - i];
+	//the remainder in Q2.30 radians, pi / 2 being 1686629713 in Q2.30
+	d  = ((Int64)(a & 0x3FFFFFu) * 1686629713 + (1 << 29)) >> 30;
+	d2 = (d * d) >> 30;
+	d3 = (d2 * d) >> 30;
+	s  = (sn << 30) + cs * d - ((sn * d2) >> 1) - (cs * d3) / 6;
+	s  = (s + (1 << 29)) >> 30;
+	return (Int32)((_angle & ZANGLE_HALF) ? -s : s);
+}
+
+
+/*
+Rotates (K, 0) by an angle with CORDIC, giving the cosine and sine 
+in Q2.61*/
+static Void
+ZFixed_Cordic(
+	_In_    ZANGLE _angle,
+	_Inout_ Int64* _cos,
+	_Inout_ Int64* _sin) {
+
+	Int64 x, y, z, nx, m;
+	Bool  flip;
+	Int32 i;
+
+	//fold the angle into [-90, 90] degrees, where CORDIC converges
+	flip = ((_angle + ZANGLE_QUARTER) & ZANGLE_HALF) != 0;
+	if (flip)
+		_angle += ZANGLE_HALF;
+	z = (Int64)((Uint64)_angle << 32);
+	x = ZFIXED_CORDICGAIN;
+	y = 0;
+	//turn toward z = 0; m is -1 when turning clockwise, and (v ^ m) - m
+	//negates v under it, keeping the loop free of branches
+	for (i = 0; i < ZFIXED_CORDICSTEPS; i++) {
+		m  = z >> 63;
+		nx = x - (((y >> i) ^ m) - m);
+		y += ((x >> i) ^ m) - m;
+		z -= ((Int64)ZFIXED_ATANTABLE[i] ^ m) - m;
+		x  = nx;
+	}
+	*_cos = flip ? -x : x;
+	*_sin = flip ? -y : y;
+}
+
+
+/*
+Computes the direction of a vector with CORDIC. The components may be
+in any fixed-point format, as long as it is the same one.*/
+static ZANGLE
+ZFixed_CordicAtan2(
+	_In_ Int64 _y,
+	_In_ Int64 _x) {
+
+	Uint64 ux, uy, z;
+	Int64  x, y, nx, m;
+	Int32  i, shift;
+	ZANGLE angle;
+
+	if (!_x && !_y)
+		return 0;
+	//work on the first quadrant, scaled so the larger component is 
+	//2^60 or more, leaving room for the CORDIC gain
+	ux = (_x < 0) ? 0 - (Uint64)_x : (Uint64)_x;
+	uy = (_y < 0) ? 0 - (Uint64)_y : (Uint64)_y;
+	shift = Z_CLZ64(ux | uy) - 3;
+	if (shift >= 0) {
+		ux <<= shift;
+		uy <<= shift;
+	}
+	else {
+		ux >>= -shift;
+		uy >>= -shift;
+	}
+	x = (Int64)ux;
+	y = (Int64)uy;
+	z = 0;
+	//turn toward y = 0, m being -1 when turning counterclockwise
+	for (i = 0; i < ZFIXED_CORDICSTEPS; i++) {
+		m  = (y - 1) >> 63;
+		nx = x + (((y >> i) ^ m) - m);
+		y -= ((x >> i) ^ m) - m;
+		z += (ZFIXED_ATANTABLE[i] ^ (Uint64)m) - (Uint64)m;
+		x  = nx;
+	}
+	angle = (ZANGLE)((z + 0x80000000u) >> 32);
+	if (_x < 0)
+		angle = ZANGLE_HALF - angle;
+	if (_y < 0)
+		angle = 0 - angle;
+	return angle;
+}
+
+
+ZANGLE
+ZAngle_FromDegrees(
+	_In_ ZFIXED _degrees) {
+
+	//angle = degrees * 2^16 / 360, rounded
+	Int64 n = (Int64)_degrees * 65536;
+	return (ZANGLE)(Uint64)ZFixed_FloorDiv(2 * n + 360, 720);
+}
+
+
+ZANGLE
+ZAngle_FromRadians(
+	_In_ ZFIXED _radians) {
+
+	//2^32 / (2 pi) in Q16.16
+	return (ZANGLE)(Uint64)(((Int64)_radians * 683565276 + 0x8000) >> 16);
+}
+
+
+ZFIXED
+ZAngle_ToDegrees(
+	_In_ ZANGLE _angle) {
+
+	return (ZFIXED)(((Int64)(Int32)_angle * 360 + 0x8000) >> 16);
+}
+
+
+ZFIXED
+ZAngle_ToRadians(
+	_In_ ZANGLE _angle) {
+
+	//2 pi in Q3.29, the product scaled by 2^-45
+	return (ZFIXED)(((Int64)(Int32)_angle * 3373259426ll + 
+		(1ll << 44)) >> 45);
+}
+
+
+ZFIXED
+ZFixed_Sin(
+	_In_ ZANGLE _angle) {
+
+	return (ZFixed_SinQ30(_angle) + 0x2000) >> 14;
+}
+
+
+ZFIXED
+ZFixed_Cos(
+	_In_ ZANGLE _angle) {
+
+	return (ZFixed_SinQ30(_angle + ZANGLE_QUARTER) + 0x2000) >> 14;
+}
+
+
+ZANGLE
+ZFixed_Atan2(
+	_In_ ZFIXED _y,
+	_In_ ZFIXED _x) {
+
+	return ZFixed_CordicAtan2(_y, _x);
+}
+
+
+Void
+ZFixed64_SinCos(
+	_In_        ZANGLE    _angle,
+	_Inout_opt_ ZFIXED64* _sin,
+	_Inout_opt_ ZFIXED64* _cos) {
+
+	Int64 c, s;
+	ZFixed_Cordic(_angle, &c, &s);
+	if (_sin)
+		*_sin = (s + (1ll << 28)) >> 29;
+	if (_cos)
+		*_cos = (c + (1ll << 28)) >> 29;
+}
+
+
+ZANGLE
+ZFixed64_Atan2(
+	_In_ ZFIXED64 _y,
+	_In_ ZFIXED64 _x) {
+
+	return ZFixed_CordicAtan2(_y, _x);
+}
+
+
+
+
+
+/* Section 4:
+** Q16.16 vectors
+******************************************************************************/
+ZFVEC2
+ZFVec2_FromVec2(
+	_In_ const ZVEC2* _v0) {
+
+	ZFVEC2 out;
+	out.x = ZFixed_FromFloat(_v0->x);
+	out.y = ZFixed_FromFloat(_v0->y);
+	return out;
+}
+
+
+ZVEC2
+ZFVec2_ToVec2(
+	_In_ const ZFVEC2* _v0) {
+
+	ZVEC2 out;
+	out.x = ZFixed_ToFloat(_v0->x);
+	out.y = ZFixed_ToFloat(_v0->y);
+	return out;
+}
+
+
+ZFVEC2
+ZFVec2_Add(
+	_In_ const ZFVEC2* _v0,
+	_In_ const ZFVEC2* _v1) {
+
+	ZFVEC2 out;
+	out.x = ZFixed_WrapAdd(_v0->x, _v1->x);
+	out.y = ZFixed_WrapAdd(_v0->y, _v1->y);
+	return out;
+}
+
+
+ZFVEC2
+ZFVec2_Sub(
+	_In_ const ZFVEC2* _v0,
+	_In_ const ZFVEC2* _v1) {
+
+	ZFVEC2 out;
+	out.x = ZFixed_WrapSub(_v0->x, _v1->x);
+	out.y = ZFixed_WrapSub(_v0->y, _v1->y);
+	return out;
+}
+
+
+ZFVEC2
+ZFVec2_Scale(
+	_In_ const ZFVEC2* _v0,
+	_In_ ZFIXED        _scale) {
+
+	ZFVEC2 out;
+	out.x = ZFixed_Mul(_v0->x, _scale);
+	out.y = ZFixed_Mul(_v0->y, _scale);
+	return out;
+}
+
+
+ZFIXED
+ZFVec2_DotProduct(
+	_In_ const ZFVEC2* _v0,
+	_In_ const ZFVEC2* _v1) {
+
+	Int64 dp;
+	//the sum reaches 2^63 at (MIN, MIN) . (MIN, MIN): add unsigned and wrap
+	dp = (Int64)((Uint64)((Int64)_v0->x * _v1->x) + 
+		(Uint64)((Int64)_v0->y * _v1->y) + ZFIXED_HALF);
+	return (ZFIXED)(dp >> ZFIXED_SHIFT);
+}
+
+
+ZFIXED
+ZFVec2_CrossProduct(
+	_In_ const ZFVEC2* _v0,
+	_In_ const ZFVEC2* _v1) {
+
+	Int64 cp;
+	cp = (Int64)_v0->x * _v1->y - (Int64)_v0->y * _v1->x;
+	return (ZFIXED)((cp + ZFIXED_HALF) >> ZFIXED_SHIFT);
+}
+
+
+ZFIXED
+ZFVec2_Length(
+	_In_ const ZFVEC2* _v0) {
+
+	Uint64 sq, length;
+	sq = (Uint64)((Int64)_v0->x * _v0->x) + 
+		(Uint64)((Int64)_v0->y * _v0->y);
+	length = ZFixed_ISqrt(0, sq);
+	return (length > (Uint64)ZFIXED_MAX) ? ZFIXED_MAX : (ZFIXED)length;
+}
+
+
+ZFIXED
+ZFVec2_Distance(
+	_In_ const ZFVEC2* _v0,
+	_In_ const ZFVEC2* _v1) {
+
+	Int64  dx, dy;
+	Uint64 ux, uy, sq, length;
+	dx = (Int64)_v0->x - _v1->x;
+	dy = (Int64)_v0->y - _v1->y;
+	ux = (Uint64)((dx < 0) ? -dx : dx);
+	uy = (Uint64)((dy < 0) ? -dy : dy);
+	//the differences span 33 bits, so the sum may carry out
+	sq = ux * ux + uy * uy;
+	length = ZFixed_ISqrt(sq < ux * ux, sq);
+	return (length > (Uint64)ZFIXED_MAX) ? ZFIXED_MAX : (ZFIXED)length;
+}
+
+
+ZFVEC2
+ZFVec2_Unit(
+	_In_ const ZFVEC2* _v0) {
+
+	ZFVEC2 out;
+	ZFIXED length;
+	length = ZFVec2_Length(_v0);
+	if (length == 0) {
+		out.x = 0;
+		out.y = 0;
+		return out;
+	}
+	out.x = ZFixed_Div(_v0->x, length);
+	out.y = ZFixed_Div(_v0->y, length);
+	return out;
+}
+
+
+ZANGLE
+ZFVec2_Angle(
+	_In_ const ZFVEC2* _v0) {
+
+	return ZFixed_CordicAtan2(_v0->y, _v0->x);
+}
+
+
+ZFVEC2
+ZFVec2_Rectangular(
+	_In_ ZFIXED _length,
+	_In_ ZANGLE _angle) {
+
+	ZFVEC2 out;
+	Int64  cs, sn;
+	cs = ZFixed_SinQ30(_angle + ZANGLE_QUARTER);
+	sn = ZFixed_SinQ30(_angle);
+	out.x = (ZFIXED)((_length * cs + (1 << 29)) >> 30);
+	out.y = (ZFIXED)((_length * sn + (1 << 29)) >> 30);
+	return out;
+}
+
+
+ZFVEC2
+ZFVec2_Rotation(
+	_In_ const ZFVEC2* _v0,
+	_In_ ZANGLE        _angle) {
+
+	ZFVEC2 out;
+	Int64  cs, sn;
+	cs = ZFixed_SinQ30(_angle + ZANGLE_QUARTER);
+	sn = ZFixed_SinQ30(_angle);
+	out.x = (ZFIXED)((_v0->x * cs - _v0->y * sn + (1 << 29)) >> 30);
+	out.y = (ZFIXED)((_v0->x * sn + _v0->y * cs + (1 << 29)) >> 30);
+	return out;
+}
+
+
+ZFVEC2
+ZFVec2_Lerp(
+	_In_ const ZFVEC2* _v0,
+	_In_ const ZFVEC2* _v1,
+	_In_ ZFIXED        _t) {
+
+	ZFVEC2 out;
+	out.x = ZFixed_WrapAdd(_v0->x, 
+		ZFixed_Mul(ZFixed_WrapSub(_v1->x, _v0->x), _t));
+	out.y = ZFixed_WrapAdd(_v0->y, 
+		ZFixed_Mul(ZFixed_WrapSub(_v1->y, _v0->y), _t));
+	return out;
+}
+
+
+ZFVEC2
+ZFVec2_Min(
+	_In_ const ZFVEC2* _v0,
+	_In_ const ZFVEC2* _v1) {
+
+	ZFVEC2 out;
+	out.x = Z_Min(_v0->x, _v1->x);
+	out.y = Z_Min(_v0->y, _v1->y);
+	return out;
+}
+
+
+ZFVEC2
+ZFVec2_Max(
+	_In_ const ZFVEC2* _v0,
+	_In_ const ZFVEC2* _v1) {
+
+	ZFVEC2 out;
+	out.x = Z_Max(_v0->x, _v1->x);
+	out.y = Z_Max(_v0->y, _v1->y);
+	return out;
+}
+
+
+ZFVEC2
+ZFVec2_Floor(
+	_In_ const ZFVEC2* _v0) {
+
+	ZFVEC2 out;
+	out.x = (ZFIXED)((Uint32)_v0->x & 0xFFFF0000u);
+	out.y = (ZFIXED)((Uint32)_v0->y & 0xFFFF0000u);
+	return out;
+}
+
+
+ZFVEC2
+ZFVec2_Ceil(
+	_In_ const ZFVEC2* _v0) {
+
+	ZFVEC2 out;
+	out.x = (ZFIXED)(((Uint32)_v0->x + 0xFFFFu) & 0xFFFF0000u);
+	out.y = (ZFIXED)(((Uint32)_v0->y + 0xFFFFu) & 0xFFFF0000u);
+	return out;
+}
+
+
+ZFVEC2
+ZFVec2_Projection(
+	_In_ const ZFVEC2* _v0,
+	_In_ const ZFVEC2* _v1) {
+
+	ZFVEC2 out;
+	Int64  d01, d11;
+	d01 = (Int64)((Uint64)((Int64)_v0->x * _v1->x) + 
+		(Uint64)((Int64)_v0->y * _v1->y));
+	d11 = (Int64)((Uint64)((Int64)_v1->x * _v1->x) + 
+		(Uint64)((Int64)_v1->y * _v1->y));
+	if (d11 == 0) {
+		out.x = 0;
+		out.y = 0;
+		return out;
+	}
+	//only _v1 = (MIN, MIN) reaches d11 = 2^63, where the projection is
+	//the mean of the components of _v0 on both axes
+	if (d11 < 0) {
+		out.x = (ZFIXED)(((Int64)_v0->x + _v0->y + 1) >> 1);
+		out.y = out.x;
+		return out;
+	}
+	//_v1 * d01 / d11 with a single rounding
+	out.x = (ZFIXED)ZFixed_Div128(ZFixed_Mul128(_v1->x, d01), d11);
+	out.y = (ZFIXED)ZFixed_Div128(ZFixed_Mul128(_v1->y, d01), d11);
+	return out;
+}
+
+
+ZFVEC2
+ZFVec2_Reflection(
+	_In_ const ZFVEC2* _v0,
+	_In_ const ZFVEC2* _normal) {
+
+	ZFVEC2 out;
+	ZFIXED dp;
+	dp = ZFixed_WrapAdd(ZFVec2_DotProduct(_v0, _normal), 
+		ZFVec2_DotProduct(_v0, _normal));
+	out.x = ZFixed_WrapSub(ZFixed_Mul(_normal->x, dp), _v0->x);
+	out.y = ZFixed_WrapSub(ZFixed_Mul(_normal->y, dp), _v0->y);
+	return out;
+}
+
+
+ZFVEC2
+ZFVec2_Slide(
+	_In_ const ZFVEC2* _v0,
+	_In_ const ZFVEC2* _normal) {
+
+	ZFVEC2 out;
+	ZFIXED dp;
+	dp = ZFVec2_DotProduct(_v0, _normal);
+	out.x = ZFixed_WrapSub(_v0->x, ZFixed_Mul(_normal->x, dp));
+	out.y = ZFixed_WrapSub(_v0->y, ZFixed_Mul(_normal->y, dp));
+	return out;
+}
+
+
+ZFVEC2
+ZFVec2_Tangent(
+	_In_ const ZFVEC2* _v0) {
+
+	ZFVEC2 out;
+	out.x = _v0->y;
+	out.y = ZFixed_WrapSub(0, _v0->x);
+	return out;
+}
+
+
+
+
+
+/* Section 5:
+** Q16.16 rectangles
+******************************************************************************/
+ZFRECT
+ZFRect_FromRect(
+	_In_ const ZRECT* _r0) {
+
+	ZFRECT out;
+	out.x = ZFixed_FromFloat(_r0->x);
+	out.y = ZFixed_FromFloat(_r0->y);
+	out.w = ZFixed_FromFloat(_r0->w);
+	out.h = ZFixed_FromFloat(_r0->h);
+	return out;
+}
+
+
+ZRECT
+ZFRect_ToRect(
+	_In_ const ZFRECT* _r0) {
+
+	ZRECT out;
+	out.x = ZFixed_ToFloat(_r0->x);
+	out.y = ZFixed_ToFloat(_r0->y);
+	out.w = ZFixed_ToFloat(_r0->w);
+	out.h = ZFixed_ToFloat(_r0->h);
+	return out;
+}
+
+
+Bool
+ZFRect_IsEqual(
+	_In_ const ZFRECT* _r0,
+	_In_ const ZFRECT* _r1) {
+
+	return
+		(_r0->x == _r1->x) &&
+		(_r0->y == _r1->y) &&
+		(_r0->w == _r1->w) &&
+		(_r0->h == _r1->h);
+}
+
+
+ZFVEC2
+ZFRect_GetCenter(
+	_In_ const ZFRECT* _r0) {
+
+	ZFVEC2 center;
+	center.x = ZFixed_WrapAdd(_r0->x, (ZFIXED)(((Int64)_r0->w + 1) >> 1));
+	center.y = ZFixed_WrapAdd(_r0->y, (ZFIXED)(((Int64)_r0->h + 1) >> 1));
+	return center;
+}
+
+
+ZFIXED
+ZFRect_GetArea(
+	_In_ const ZFRECT* _r0) {
+
+	return ZFixed_Mul(_r0->w, _r0->h);
+}
+
+
+ZFIXED
+ZFRect_GetRight(
+	_In_ const ZFRECT* _r0) {
+
+	return ZFixed_WrapAdd(_r0->x, _r0->w);
+}
+
+
+ZFIXED
+ZFRect_GetBottom(
+	_In_ const ZFRECT* _r0) {
+
+	return ZFixed_WrapAdd(_r0->y, _r0->h);
+}
+
+
+Bool
+ZFRect_ContainsPoint(
+	_In_ const ZFRECT* _r0,
+	_In_ ZFIXED        _x,
+	_In_ ZFIXED        _y) {
+
+	ZFIXED r, b;
+	r = ZFixed_WrapAdd(_r0->x, _r0->w);
+	b = ZFixed_WrapAdd(_r0->y, _r0->h);
+	return !(
+		(_x <  Z_Min(_r0->x, r)) ||
+		(_x >= Z_Max(_r0->x, r)) ||
+		(_y <  Z_Min(_r0->y, b)) ||
+		(_y >= Z_Max(_r0->y, b)));
+}
+
+
+Bool
+ZFRect_ContainsRect(
+	_In_ const ZFRECT* _r0,
+	_In_ const ZFRECT* _r1) {
+
+	return !(
+		(_r1->x < _r0->x) ||
+		(_r1->y < _r0->y) ||
+		(ZFRect_GetRight(_r1)  > ZFRect_GetRight(_r0)) ||
+		(ZFRect_GetBottom(_r1) > ZFRect_GetBottom(_r0)));
+}
+
+
+Bool
+ZFRect_GetIntersection(
+	_In_        const ZFRECT* _r0,
+	_In_        const ZFRECT* _r1,
+	_Inout_opt_ ZFRECT*       _out) {
+
+	ZFIXED r0, b0, r1, b1, left, top, right, bottom;
+	r0 = ZFixed_WrapAdd(_r0->x, _r0->w);
+	b0 = ZFixed_WrapAdd(_r0->y, _r0->h);
+	r1 = ZFixed_WrapAdd(_r1->x, _r1->w);
+	b1 = ZFixed_WrapAdd(_r1->y, _r1->h);
+	left   = Z_Max(Z_Min(_r0->x, r0), Z_Min(_r1->x, r1));
+	top    = Z_Max(Z_Min(_r0->y, b0), Z_Min(_r1->y, b1));
+	right  = Z_Min(Z_Max(_r0->x, r0), Z_Max(_r1->x, r1));
+	bottom = Z_Min(Z_Max(_r0->y, b0), Z_Max(_r1->y, b1));
+
+	if ((left < right) && (top < bottom)) {
+		if (_out) {
+			_out->x = left;
+			_out->y = top;
+			_out->w = ZFixed_WrapSub(right, left);
+			_out->h = ZFixed_WrapSub(bottom, top);
+		}
+		return Z_TRUE;
+	}
+	if (_out) {
+		_out->x = 0;
+		_out->y = 0;
+		_out->w = 0;
+		_out->h = 0;
+	}
+	return Z_FALSE;
+}
+
+
+ZFRECT
+ZFRect_Merge(
+	_In_ const ZFRECT* _r0,
+	_In_ const ZFRECT* _r1) {
+
+	ZFRECT out;
+	out.x = Z_Min(_r0->x, _r1->x);
+	out.y = Z_Min(_r0->y, _r1->y);
+	out.w = ZFixed_WrapSub(
+		Z_Max(ZFRect_GetRight(_r0), ZFRect_GetRight(_r1)), out.x);
+	out.h = ZFixed_WrapSub(
+		Z_Max(ZFRect_GetBottom(_r0), ZFRect_GetBottom(_r1)), out.y);
+	return out;
+}
+
+
+Void
+ZFRect_Normalize(
+	_Inout_ ZFRECT* _r0) {
+
+	if (_r0->w < 0) {
+		_r0->x = ZFixed_WrapAdd(_r0->x, _r0->w);
+		_r0->w = ZFixed_WrapSub(0, _r0->w);
+	}
+	if (_r0->h < 0) {
+		_r0->y = ZFixed_WrapAdd(_r0->y, _r0->h);
+		_r0->h = ZFixed_WrapSub(0, _r0->h);
+	}
+}
+
+
+
+
+
+/* Section 6:
+** Q32.32 vectors and rectangles
+******************************************************************************/
+ZLVEC2
+ZLVec2_FromVec2(
+	_In_ const ZVEC2* _v0) {
+
+	ZLVEC2 out;
+	out.x = ZFixed64_FromReal64(_v0->x);
+	out.y = ZFixed64_FromReal64(_v0->y);
+	return out;
+}
+
+
+ZVEC2
+ZLVec2_ToVec2(
+	_In_ const ZLVEC2* _v0) {
+
+	ZVEC2 out;
+	out.x = (Float)ZFixed64_ToReal64(_v0->x);
+	out.y = (Float)ZFixed64_ToReal64(_v0->y);
+	return out;
+}
+
+
+ZLVEC2
+ZLVec2_Add(
+	_In_ const ZLVEC2* _v0,
+	_In_ const ZLVEC2* _v1) {
+
+	ZLVEC2 out;
+	out.x = ZFixed64_WrapAdd(_v0->x, _v1->x);
+	out.y = ZFixed64_WrapAdd(_v0->y, _v1->y);
+	return out;
+}
+
+
+ZLVEC2
+ZLVec2_Sub(
+	_In_ const ZLVEC2* _v0,
+	_In_ const ZLVEC2* _v1) {
+
+	ZLVEC2 out;
+	out.x = ZFixed64_WrapSub(_v0->x, _v1->x);
+	out.y = ZFixed64_WrapSub(_v0->y, _v1->y);
+	return out;
+}
+
+
+ZLVEC2
+ZLVec2_Scale(
+	_In_ const ZLVEC2* _v0,
+	_In_ ZFIXED64      _scale) {
+
+	ZLVEC2 out;
+	out.x = ZFixed64_Mul(_v0->x, _scale);
+	out.y = ZFixed64_Mul(_v0->y, _scale);
+	return out;
+}
+
+
+ZFIXED64
+ZLVec2_DotProduct(
+	_In_ const ZLVEC2* _v0,
+	_In_ const ZLVEC2* _v1) {
+
+	return ZFixed_Round128(ZFixed_Add128(
+		ZFixed_Mul128(_v0->x, _v1->x),
+		ZFixed_Mul128(_v0->y, _v1->y)), 32);
+}
+
+
+ZFIXED64
+ZLVec2_CrossProduct(
+	_In_ const ZLVEC2* _v0,
+	_In_ const ZLVEC2* _v1) {
+
+	return ZFixed_Round128(ZFixed_Sub128(
+		ZFixed_Mul128(_v0->x, _v1->y),
+		ZFixed_Mul128(_v0->y, _v1->x)), 32);
+}
+
+
+/*
+Computes the length of a Q32.32 vector from its exact sum of squares*/
+static ZFIXED64
+ZLVec2_Hypot(
+	_In_ ZFIXED64 _x,
+	_In_ ZFIXED64 _y) {
+
+	ZFIXEDU128 sq;
+	Uint64     length;
+	sq = ZFixed_Add128(ZFixed_Mul128(_x, _x), ZFixed_Mul128(_y, _y));
+	if (sq.hi >> 62)
+		return ZFIXED64_MAX;
+	length = ZFixed_ISqrt(sq.hi, sq.lo);
+	return (length >> 63) ? ZFIXED64_MAX : (ZFIXED64)length;
+}
+
+
+ZFIXED64
+ZLVec2_Length(
+	_In_ const ZLVEC2* _v0) {
+
+	return ZLVec2_Hypot(_v0->x, _v0->y);
+}
+
+
+ZFIXED64
+ZLVec2_Distance(
+	_In_ const ZLVEC2* _v0,
+	_In_ const ZLVEC2* _v1) {
+
+	return ZLVec2_Hypot(
+		ZFixed64_WrapSub(_v0->x, _v1->x),
+		ZFixed64_WrapSub(_v0->y, _v1->y));
+}
+
+
+ZLVEC2
+ZLVec2_Unit(
+	_In_ const ZLVEC2* _v0) {
+
+	ZLVEC2   out;
+	ZFIXED64 length;
+	length = ZLVec2_Length(_v0);
+	if (length == 0) {
+		out.x = 0;
+		out.y = 0;
+		return out;
+	}
+	out.x = ZFixed64_Div(_v0->x, length);
+	out.y = ZFixed64_Div(_v0->y, length);
+	return out;
+}
+
+
+ZANGLE
+ZLVec2_Angle(
+	_In_ const ZLVEC2* _v0) {
+
+	return ZFixed_CordicAtan2(_v0->y, _v0->x);
+}
+
+
+ZLVEC2
+ZLVec2_Rectangular(
+	_In_ ZFIXED64 _length,
+	_In_ ZANGLE   _angle) {
+
+	ZLVEC2 out;
+	Int64  cs, sn;
+	ZFixed_Cordic(_angle, &cs, &sn);
+	out.x = ZFixed_Round128(ZFixed_Mul128(_length, cs), 61);
+	out.y = ZFixed_Round128(ZFixed_Mul128(_length, sn), 61);
+	return out;
+}
+
+
+ZLVEC2
+ZLVec2_Rotation(
+	_In_ const ZLVEC2* _v0,
+	_In_ ZANGLE        _angle) {
+
+	ZLVEC2 out;
+	Int64  cs, sn;
+	ZFixed_Cordic(_angle, &cs, &sn);
+	out.x = ZFixed_Round128(ZFixed_Sub128(
+		ZFixed_Mul128(_v0->x, cs), ZFixed_Mul128(_v0->y, sn)), 61);
+	out.y = ZFixed_Round128(ZFixed_Add128(
+		ZFixed_Mul128(_v0->x, sn), ZFixed_Mul128(_v0->y, cs)), 61);
+	return out;
+}
+
+
+ZLVEC2
+ZLVec2_Lerp(
+	_In_ const ZLVEC2* _v0,
+	_In_ const ZLVEC2* _v1,
+	_In_ ZFIXED64      _t) {
+
+	ZLVEC2 out;
+	out.x = ZFixed64_WrapAdd(_v0->x, 
+		ZFixed64_Mul(ZFixed64_WrapSub(_v1->x, _v0->x), _t));
+	out.y = ZFixed64_WrapAdd(_v0->y, 
+		ZFixed64_Mul(ZFixed64_WrapSub(_v1->y, _v0->y), _t));
+	return out;
+}
+
+
+ZLVEC2
+ZLVec2_Min(
+	_In_ const ZLVEC2* _v0,
+	_In_ const ZLVEC2* _v1) {
+
+	ZLVEC2 out;
+	out.x = Z_Min(_v0->x, _v1->x);
+	out.y = Z_Min(_v0->y, _v1->y);
+	return out;
+}
+
+
+ZLVEC2
+ZLVec2_Max(
+	_In_ const ZLVEC2* _v0,
+	_In_ const ZLVEC2* _v1) {
+
+	ZLVEC2 out;
+	out.x = Z_Max(_v0->x, _v1->x);
+	out.y = Z_Max(_v0->y, _v1->y);
+	return out;
+}
+
+
+ZLVEC2
+ZLVec2_Floor(
+	_In_ const ZLVEC2* _v0) {
+
+	ZLVEC2 out;
+	out.x = (ZFIXED64)((Uint64)_v0->x & 0xFFFFFFFF00000000ull);
+	out.y = (ZFIXED64)((Uint64)_v0->y & 0xFFFFFFFF00000000ull);
+	return out;
+}
+
+
+ZLVEC2
+ZLVec2_Ceil(
+	_In_ const ZLVEC2* _v0) {
+
+	ZLVEC2 out;
+	out.x = (ZFIXED64)(((Uint64)_v0->x + 0xFFFFFFFFull) & 
+		0xFFFFFFFF00000000ull);
+	out.y = (ZFIXED64)(((Uint64)_v0->y + 0xFFFFFFFFull) & 
+		0xFFFFFFFF00000000ull);
+	return out;
+}
+
+
+ZLVEC2
+ZLVec2_Projection(
+	_In_ const ZLVEC2* _v0,
+	_In_ const ZLVEC2* _v1) {
+
+	ZLVEC2   out;
+	ZFIXED64 d11;
+	d11 = ZLVec2_DotProduct(_v1, _v1);
+	if (d11 == 0) {
+		out.x = 0;
+		out.y = 0;
+		return out;
+	}
+	return ZLVec2_Scale(_v1, 
+		ZFixed64_Div(ZLVec2_DotProduct(_v0, _v1), d11));
+}
+
+
+ZLVEC2
+ZLVec2_Reflection(
+	_In_ const ZLVEC2* _v0,
+	_In_ const ZLVEC2* _normal) {
+
+	ZLVEC2   out;
+	ZFIXED64 dp;
+	dp = ZLVec2_DotProduct(_v0, _normal);
+	dp = ZFixed64_WrapAdd(dp, dp);
+	out.x = ZFixed64_WrapSub(ZFixed64_Mul(_normal->x, dp), _v0->x);
+	out.y = ZFixed64_WrapSub(ZFixed64_Mul(_normal->y, dp), _v0->y);
+	return out;
+}
+
+
+ZLVEC2
+ZLVec2_Slide(
+	_In_ const ZLVEC2* _v0,
+	_In_ const ZLVEC2* _normal) {
+
+	ZLVEC2   out;
+	ZFIXED64 dp;
+	dp = ZLVec2_DotProduct(_v0, _normal);
+	out.x = ZFixed64_WrapSub(_v0->x, ZFixed64_Mul(_normal->x, dp));
+	out.y = ZFixed64_WrapSub(_v0->y, ZFixed64_Mul(_normal->y, dp));
+	return out;
+}
+
+
+ZLVEC2
+ZLVec2_Tangent(
+	_In_ const ZLVEC2* _v0) {
+
+	ZLVEC2 out;
+	out.x = _v0->y;
+	out.y = ZFixed64_WrapSub(0, _v0->x);
+	return out;
+}
+
+
+ZLRECT
+ZLRect_FromRect(
+	_In_ const ZRECT* _r0) {
+
+	ZLRECT out;
+	out.x = ZFixed64_FromReal64(_r0->x);
+	out.y = ZFixed64_FromReal64(_r0->y);
+	out.w = ZFixed64_FromReal64(_r0->w);
+	out.h = ZFixed64_FromReal64(_r0->h);
+	return out;
+}
+
+
+ZRECT
+ZLRect_ToRect(
+	_In_ const ZLRECT* _r0) {
+
+	ZRECT out;
+	out.x = (Float)ZFixed64_ToReal64(_r0->x);
+	out.y = (Float)ZFixed64_ToReal64(_r0->y);
+	out.w = (Float)ZFixed64_ToReal64(_r0->w);
+	out.h = (Float)ZFixed64_ToReal64(_r0->h);
+	return out;
+}
+
+
+Bool
+ZLRect_IsEqual(
+	_In_ const ZLRECT* _r0,
+	_In_ const ZLRECT* _r1) {
+
+	return
+		(_r0->x == _r1->x) &&
+		(_r0->y == _r1->y) &&
+		(_r0->w == _r1->w) &&
+		(_r0->h == _r1->h);
+}
+
+
+ZLVEC2
+ZLRect_GetCenter(
+	_In_ const ZLRECT* _r0) {
+
+	ZLVEC2 center;
+	center.x = ZFixed64_WrapAdd(_r0->x, (_r0->w >> 1) + (_r0->w & 1));
+	center.y = ZFixed64_WrapAdd(_r0->y, (_r0->h >> 1) + (_r0->h & 1));
+	return center;
+}
+
+
+ZFIXED64
+ZLRect_GetArea(
+	_In_ const ZLRECT* _r0) {
+
+	return ZFixed64_Mul(_r0->w, _r0->h);
+}
+
+
+ZFIXED64
+ZLRect_GetRight(
+	_In_ const ZLRECT* _r0) {
+
+	return ZFixed64_WrapAdd(_r0->x, _r0->w);
+}
+
+
+ZFIXED64
+ZLRect_GetBottom(
+	_In_ const ZLRECT* _r0) {
+
+	return ZFixed64_WrapAdd(_r0->y, _r0->h);
+}
+
+
+Bool
+ZLRect_ContainsPoint(
+	_In_ const ZLRECT* _r0,
+	_In_ ZFIXED64      _x,
+	_In_ ZFIXED64      _y) {
+
+	ZFIXED64 r, b;
+	r = ZFixed64_WrapAdd(_r0->x, _r0->w);
+	b = ZFixed64_WrapAdd(_r0->y, _r0->h);
+	return !(
+		(_x <  Z_Min(_r0->x, r)) ||
+		(_x >= Z_Max(_r0->x, r)) ||
+		(_y <  Z_Min(_r0->y, b)) ||
+		(_y >= Z_Max(_r0->y, b)));
+}
+
+
+Bool
+ZLRect_ContainsRect(
+	_In_ const ZLRECT* _r0,
+	_In_ const ZLRECT* _r1) {
+
+	return !(
+		(_r1->x < _r0->x) ||
+		(_r1->y < _r0->y) ||
+		(ZLRect_GetRight(_r1)  > ZLRect_GetRight(_r0)) ||
+		(ZLRect_GetBottom(_r1) > ZLRect_GetBottom(_r0)));
+}
+
+
+Bool
+ZLRect_GetIntersection(
+	_In_        const ZLRECT* _r0,
+	_In_        const ZLRECT* _r1,
+	_Inout_opt_ ZLRECT*       _out) {
+
+	ZFIXED64 r0, b0, r1, b1, left, top, right, bottom;
+	r0 = ZFixed64_WrapAdd(_r0->x, _r0->w);
+	b0 = ZFixed64_WrapAdd(_r0->y, _r0->h);
+	r1 = ZFixed64_WrapAdd(_r1->x, _r1->w);
+	b1 = ZFixed64_WrapAdd(_r1->y, _r1->h);
+	left   = Z_Max(Z_Min(_r0->x, r0), Z_Min(_r1->x, r1));
+	top    = Z_Max(Z_Min(_r0->y, b0), Z_Min(_r1->y, b1));
+	right  = Z_Min(Z_Max(_r0->x, r0), Z_Max(_r1->x, r1));
+	bottom = Z_Min(Z_Max(_r0->y, b0), Z_Max(_r1->y, b1));
+
+	if ((left < right) && (top < bottom)) {
+		if (_out) {
+			_out->x = left;
+			_out->y = top;
+			_out->w = ZFixed64_WrapSub(right, left);
+			_out->h = ZFixed64_WrapSub(bottom, top);
+		}
+		return Z_TRUE;
+	}
+	if (_out) {
+		_out->x = 0;
+		_out->y = 0;
+		_out->w = 0;
+		_out->h = 0;
+	}
+	return Z_FALSE;
+}
+
+
+ZLRECT
+ZLRect_Merge(
+	_In_ const ZLRECT* _r0,
+	_In_ const ZLRECT* _r1) {
+
+	ZLRECT out;
+	out.x = Z_Min(_r0->x, _r1->x);
+	out.y = Z_Min(_r0->y, _r1->y);
+	out.w = ZFixed64_WrapSub(
+		Z_Max(ZLRect_GetRight(_r0), ZLRect_GetRight(_r1)), out.x);
+	out.h = ZFixed64_WrapSub(
+		Z_Max(ZLRect_GetBottom(_r0), ZLRect_GetBottom(_r1)), out.y);
+	return out;
+}
+
+
+Void
+ZLRect_Normalize(
+	_Inout_ ZLRECT* _r0) {
+
+	if (_r0->w < 0) {
+		_r0->x = ZFixed64_WrapAdd(_r0->x, _r0->w);
+		_r0->w = ZFixed64_WrapSub(0, _r0->w);
+	}
+	if (_r0->h < 0) {
+		_r0->y = ZFixed64_WrapAdd(_r0->y, _r0->h);
+		_r0->h = ZFixed64_WrapSub(0, _r0->h);
+	}
+}
+
+
+
+
+
+/* Section 7:
+** batch kernels
+******************************************************************************/
+/*
+The vector paths form the same 64-bit products as the scalar code and
+round them the same way, so their results are identical. Products are
+formed in pairs of 64-bit lanes: the even and the odd 32-bit lanes on
+AVX2, the low and the high halves on NEON. SSE2 has no signed widening
+multiply, and emulating one is slower than the scalar loop, so the 
+multiplying kernels only vectorize on AVX2 and NEON.*/
+#if (ZFIXED_AVX2)
+static FORCEINLINE Void
+ZFixed_MulAVX2(
+	_In_    __m256i  _a,
+	_In_    __m256i  _b,
+	_Inout_ __m256i* _even,
+	_Inout_ __m256i* _odd) {
+
+	*_even = _mm256_mul_epi32(_a, _b);
+	*_odd  = _mm256_mul_epi32(
+		_mm256_srli_epi64(_a, 32), _mm256_srli_epi64(_b, 32));
+}
+
+
+static FORCEINLINE __m256i
+ZFixed_NarrowAVX2(
+	_In_ __m256i _even,
+	_In_ __m256i _odd,
+	_In_ Int32   _shift) {
+
+	__m256i half = _mm256_set1_epi64x(1ll << (_shift - 1));
+	_even = _mm256_srli_epi64(_mm256_add_epi64(_even, half), _shift);
+	_odd  = _mm256_slli_epi64(_mm256_add_epi64(_odd, half), 32 - _shift);
+	return _mm256_blend_epi32(_even, _odd, 0xAA);
+}
+
+
+static FORCEINLINE Void
+ZFixed_TransposeAVX2(
+	_Inout_ __m256i* _r) {
+
+	__m256i t0, t1, t2, t3;
+	t0 = _mm256_unpacklo_epi32(_r[0], _r[1]);
+	t1 = _mm256_unpacklo_epi32(_r[2], _r[3]);
+	t2 = _mm256_unpackhi_epi32(_r[0], _r[1]);
+	t3 = _mm256_unpackhi_epi32(_r[2], _r[3]);
+	_r[0] = _mm256_unpacklo_epi64(t0, t1);
+	_r[1] = _mm256_unpackhi_epi64(t0, t1);
+	_r[2] = _mm256_unpacklo_epi64(t2, t3);
+	_r[3] = _mm256_unpackhi_epi64(t2, t3);
+}
+#endif
+
+#if (ZFIXED_SSE2)
+static FORCEINLINE __m128i
+ZFixed_MinSSE2(
+	_In_ __m128i _a,
+	_In_ __m128i _b) {
+
+	__m128i gt = _mm_cmpgt_epi32(_a, _b);
+	return _mm_or_si128(_mm_and_si128(gt, _b), _mm_andnot_si128(gt, _a));
+}
+
+
+static FORCEINLINE __m128i
+ZFixed_MaxSSE2(
+	_In_ __m128i _a,
+	_In_ __m128i _b) {
+
+	__m128i gt = _mm_cmpgt_epi32(_a, _b);
+	return _mm_or_si128(_mm_and_si128(gt, _a), _mm_andnot_si128(gt, _b));
+}
+
+
+static FORCEINLINE Void
+ZFixed_TransposeSSE2(
+	_Inout_ __m128i* _r) {
+
+	__m128i t0, t1, t2, t3;
+	t0 = _mm_unpacklo_epi32(_r[0], _r[1]);
+	t1 = _mm_unpacklo_epi32(_r[2], _r[3]);
+	t2 = _mm_unpackhi_epi32(_r[0], _r[1]);
+	t3 = _mm_unpackhi_epi32(_r[2], _r[3]);
+	_r[0] = _mm_unpacklo_epi64(t0, t1);
+	_r[1] = _mm_unpackhi_epi64(t0, t1);
+	_r[2] = _mm_unpacklo_epi64(t2, t3);
+	_r[3] = _mm_unpackhi_epi64(t2, t3);
+}
+#endif
+
+#if (ZFIXED_NEON)
+static FORCEINLINE int32x4_t
+ZFixed_NarrowNEON(
+	_In_ int64x2_t _low,
+	_In_ int64x2_t _high,
+	_In_ Int32     _shift) {
+
+	int64x2_t half  = vdupq_n_s64(1ll << (_shift - 1));
+	int64x2_t shift = vdupq_n_s64(-_shift);
+	return vcombine_s32(
+		vmovn_s64(vshlq_s64(vaddq_s64(_low, half), shift)),
+		vmovn_s64(vshlq_s64(vaddq_s64(_high, half), shift)));
+}
+#endif
+
+
+Void
+ZFVec2_MulAddArray(
+	_In_    const ZFVEC2* _a,
+	_In_    const ZFVEC2* _b,
+	_In_    ZFIXED        _scale,
+	_Inout_ ZFVEC2*       _dst,
+	_In_    SizeT         _count) {
+
+	const ZFIXED* a = (const ZFIXED*)_a;
+	const ZFIXED* b = (const ZFIXED*)_b;
+	ZFIXED*       dst = (ZFIXED*)_dst;
+	SizeT         i = 0, n = _count * 2;
+
+#if (ZFIXED_AVX2)
+	__m256i vs = _mm256_set1_epi32(_scale);
+	for (; i + 8 <= n; i += 8) {
+		__m256i va, vb, even, odd;
+		va = _mm256_loadu_si256((const __m256i*)(a + i));
+		vb = _mm256_loadu_si256((const __m256i*)(b + i));
+		ZFixed_MulAVX2(vb, vs, &even, &odd);
+		_mm256_storeu_si256((__m256i*)(dst + i), _mm256_add_epi32(
+			va, ZFixed_NarrowAVX2(even, odd, ZFIXED_SHIFT)));
+	}
+#elif (ZFIXED_NEON)
+	int32x2_t vs = vdup_n_s32(_scale);
+	for (; i + 4 <= n; i += 4) {
+		int32x4_t va, vb;
+		va = vld1q_s32((const int32_t*)(a + i));
+		vb = vld1q_s32((const int32_t*)(b + i));
+		vst1q_s32((int32_t*)(dst + i), vaddq_s32(va, ZFixed_NarrowNEON(
+			vmull_s32(vget_low_s32(vb), vs),
+			vmull_s32(vget_high_s32(vb), vs), ZFIXED_SHIFT)));
+	}
+#endif
+	for (; i < n; i++)
+		dst[i] = ZFixed_WrapAdd(a[i], ZFixed_Mul(b[i], _scale));
+}
+
+
+Void
+ZFVec2_RotateArray(
+	_In_    const ZFVEC2* _src,
+	_In_    ZANGLE        _angle,
+	_Inout_ ZFVEC2*       _dst,
+	_In_    SizeT         _count) {
+
+	const ZFIXED* src = (const ZFIXED*)_src;
+	ZFIXED*       dst = (ZFIXED*)_dst;
+	SizeT         i = 0, n = _count * 2;
+	Int32         cs, sn;
+
+	cs = ZFixed_SinQ30(_angle + ZANGLE_QUARTER);
+	sn = ZFixed_SinQ30(_angle);
+	//each lane is v * cos + swapped(v) * (-sin, sin), 
+	//that is (x cos - y sin, y cos + x sin)
+#if (ZFIXED_AVX2)
+	{
+		__m256i vc = _mm256_set1_epi32(cs);
+		__m256i vs = _mm256_set_epi32(sn, -sn, sn, -sn, sn, -sn, sn, -sn);
+		for (; i + 8 <= n; i += 8) {
+			__m256i v, w, e0, o0, e1, o1;
+			v = _mm256_loadu_si256((const __m256i*)(src + i));
+			w = _mm256_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1));
+			ZFixed_MulAVX2(v, vc, &e0, &o0);
+			ZFixed_MulAVX2(w, vs, &e1, &o1);
+			_mm256_storeu_si256((__m256i*)(dst + i), ZFixed_NarrowAVX2(
+				_mm256_add_epi64(e0, e1), _mm256_add_epi64(o0, o1), 30));
+		}
+	}
+#elif (ZFIXED_NEON)
+	{
+		int32_t   sv[2] = { -sn, sn };
+		int32x2_t vc = vdup_n_s32(cs);
+		int32x2_t vs = vld1_s32(sv);
+		for (; i + 4 <= n; i += 4) {
+			int32x4_t v, w;
+			v = vld1q_s32((const int32_t*)(src + i));
+			w = vrev64q_s32(v);
+			vst1q_s32((int32_t*)(dst + i), ZFixed_NarrowNEON(
+				vmlal_s32(vmull_s32(vget_low_s32(v), vc),
+					vget_low_s32(w), vs),
+				vmlal_s32(vmull_s32(vget_high_s32(v), vc),
+					vget_high_s32(w), vs), 30));
+		}
+	}
+#endif
+	for (; i < n; i += 2) {
+		Int64 x = src[i], y = src[i + 1];
+		dst[i]     = (ZFIXED)((x * cs - y * sn + (1 << 29)) >> 30);
+		dst[i + 1] = (ZFIXED)((x * sn + y * cs + (1 << 29)) >> 30);
+	}
+}
+
+
+SizeT
+ZFRect_IntersectArray(
+	_In_    const ZFRECT* _a,
+	_In_    const ZFRECT* _b,
+	_Inout_ ZFRECT*       _dst,
+	_In_    SizeT         _count) {
+
+	SizeT i = 0, hits = 0;
+
+	//transpose blocks of rects to one register per field, mirroring
+	//ZFRect_GetIntersection lane by lane
+#if (ZFIXED_AVX2)
+	for (; i + 8 <= _count; i += 8) {
+		__m256i a[4], b[4], ar, ab, br, bb, l, t, r, btm, ok;
+		Int32   k;
+		for (k = 0; k < 4; k++) {
+			a[k] = _mm256_loadu_si256((const __m256i*)(_a + i + 2 * k));
+			b[k] = _mm256_loadu_si256((const __m256i*)(_b + i + 2 * k));
+		}
+		ZFixed_TransposeAVX2(a);
+		ZFixed_TransposeAVX2(b);
+		ar  = _mm256_add_epi32(a[0], a[2]);
+		ab  = _mm256_add_epi32(a[1], a[3]);
+		br  = _mm256_add_epi32(b[0], b[2]);
+		bb  = _mm256_add_epi32(b[1], b[3]);
+		l   = _mm256_max_epi32(
+			_mm256_min_epi32(a[0], ar), _mm256_min_epi32(b[0], br));
+		t   = _mm256_max_epi32(
+			_mm256_min_epi32(a[1], ab), _mm256_min_epi32(b[1], bb));
+		r   = _mm256_min_epi32(
+			_mm256_max_epi32(a[0], ar), _mm256_max_epi32(b[0], br));
+		btm = _mm256_min_epi32(
+			_mm256_max_epi32(a[1], ab), _mm256_max_epi32(b[1], bb));
+		ok  = _mm256_and_si256(
+			_mm256_cmpgt_epi32(r, l), _mm256_cmpgt_epi32(btm, t));
+		a[0] = _mm256_and_si256(ok, l);
+		a[1] = _mm256_and_si256(ok, t);
+		a[2] = _mm256_and_si256(ok, _mm256_sub_epi32(r, l));
+		a[3] = _mm256_and_si256(ok, _mm256_sub_epi32(btm, t));
+		ZFixed_TransposeAVX2(a);
+		for (k = 0; k < 4; k++)
+			_mm256_storeu_si256((__m256i*)(_dst + i + 2 * k), a[k]);
+		hits += Z_POPCOUNT32(
+			(Uint32)_mm256_movemask_ps(_mm256_castsi256_ps(ok)));
+	}
+#elif (ZFIXED_SSE2)
+	for (; i + 4 <= _count; i += 4) {
+		__m128i a[4], b[4], ar, ab, br, bb, l, t, r, btm, ok;
+		Int32   k;
+		for (k = 0; k < 4; k++) {
+			a[k] = _mm_loadu_si128((const __m128i*)(_a + i + k));
+			b[k] = _mm_loadu_si128((const __m128i*)(_b + i + k));
+		}
+		ZFixed_TransposeSSE2(a);
+		ZFixed_TransposeSSE2(b);
+		ar  = _mm_add_epi32(a[0], a[2]);
+		ab  = _mm_add_epi32(a[1], a[3]);
+		br  = _mm_add_epi32(b[0], b[2]);
+		bb  = _mm_add_epi32(b[1], b[3]);
+		l   = ZFixed_MaxSSE2(
+			ZFixed_MinSSE2(a[0], ar), ZFixed_MinSSE2(b[0], br));
+		t   = ZFixed_MaxSSE2(
+			ZFixed_MinSSE2(a[1], ab), ZFixed_MinSSE2(b[1], bb));
+		r   = ZFixed_MinSSE2(
+			ZFixed_MaxSSE2(a[0], ar), ZFixed_MaxSSE2(b[0], br));
+		btm = ZFixed_MinSSE2(
+			ZFixed_MaxSSE2(a[1], ab), ZFixed_MaxSSE2(b[1], bb));
+		ok  = _mm_and_si128(_mm_cmpgt_epi32(r, l), _mm_cmpgt_epi32(btm, t));
+		a[0] = _mm_and_si128(ok, l);
+		a[1] = _mm_and_si128(ok, t);
+		a[2] = _mm_and_si128(ok, _mm_sub_epi32(r, l));
+		a[3] = _mm_and_si128(ok, _mm_sub_epi32(btm, t));
+		ZFixed_TransposeSSE2(a);
+		for (k = 0; k < 4; k++)
+			_mm_storeu_si128((__m128i*)(_dst + i + k), a[k]);
+		hits += Z_POPCOUNT32(
+			(Uint32)_mm_movemask_ps(_mm_castsi128_ps(ok)));
+	}
+#elif (ZFIXED_NEON)
+	for (; i + 4 <= _count; i += 4) {
+		int32x4x4_t a, b;
+		int32x4_t   ar, ab, br, bb, l, t, r, btm;
+		uint32x4_t  ok;
+		a   = vld4q_s32((const int32_t*)(_a + i));
+		b   = vld4q_s32((const int32_t*)(_b + i));
+		ar  = vaddq_s32(a.val[0], a.val[2]);
+		ab  = vaddq_s32(a.val[1], a.val[3]);
+		br  = vaddq_s32(b.val[0], b.val[2]);
+		bb  = vaddq_s32(b.val[1], b.val[3]);
+		l   = vmaxq_s32(vminq_s32(a.val[0], ar), vminq_s32(b.val[0], br));
+		t   = vmaxq_s32(vminq_s32(a.val[1], ab), vminq_s32(b.val[1], bb));
+		r   = vminq_s32(vmaxq_s32(a.val[0], ar), vmaxq_s32(b.val[0], br));
+		btm = vminq_s32(vmaxq_s32(a.val[1], ab), vmaxq_s32(b.val[1], bb));
+		ok  = vandq_u32(vcgtq_s32(r, l), vcgtq_s32(btm, t));
+		a.val[0] = vreinterpretq_s32_u32(
+			vandq_u32(ok, vreinterpretq_u32_s32(l)));
+		a.val[1] = vreinterpretq_s32_u32(
+			vandq_u32(ok, vreinterpretq_u32_s32(t)));
+		a.val[2] = vreinterpretq_s32_u32(
+			vandq_u32(ok, vreinterpretq_u32_s32(vsubq_s32(r, l))));
+		a.val[3] = vreinterpretq_s32_u32(
+			vandq_u32(ok, vreinterpretq_u32_s32(vsubq_s32(btm, t))));
+		vst4q_s32((int32_t*)(_dst + i), a);
+		ok = vshrq_n_u32(ok, 31);
+		hits += vgetq_lane_u32(ok, 0) + vgetq_lane_u32(ok, 1) +
+			vgetq_lane_u32(ok, 2) + vgetq_lane_u32(ok, 3);
+	}
+#endif
+	for (; i < _count; i++)
+		hits += ZFRect_GetIntersection(_a + i, _b + i, _dst + i);
+	return hits;
+}
+/*****************************************************************************/  
+//EOF
+/*****************************************************************************/  
@@ -26,6 +26,7 @@ freely, subject to the following restrictions:
 ******************************************************************************/  
 #include "zutil/zstring.h"
 #include "zutil/zendian.h"
+#include "zutil/zutf8.h"
 #include "zutil/ziconv.h" 
 
 #if (Z_PLATFORM_WINDOWS)
@@ -74,8 +75,13 @@ enum {
 
 
 struct _ZIconV {
-	Int32 iFmtSrc; //source format
-	Int32 iFmtDst; //destination format
+	Int32 iFmtSrc;   //source format (byte order resolved once detected)
+	Int32 iFmtDst;   //destination format
+	Int32 iOpenSrc;  //source format as requested by ZIconV_Open
+	Int32 iOpenDst;  //destination format as requested by ZIconV_Open
+	Bool  bWriteBom; //destination byte order marker is still to be written
+	SizeT nCarry;    //number of bytes held in carry
+	Byte  carry[4];  //incomplete source sequence left by the previous call
 };
 
 static struct {
@@ -128,7 +134,7 @@ Z_GetEnv(
 		ExpandEnvironmentStrings(temp, env, sizeof(env));
 	return (env[0] != '\0') ? strdup(env) : NULL;
 #else
-	Char* env = getenv(variable);
+	Char* env = getenv(_var);
 	return (env && env[0]) ? strdup(env) : NULL;
 #endif 
 }
@@ -167,15 +173,409 @@ ZIconV_GetLocale(
 }
 
 
-ZIconV
-ZIconV_Open(
-	_In_ Lpcstr _tocode,
-	_In_ Lpcstr _fromcode) {
 
-	Int32  iFmtSrc, iFmtDst, it;
-	Char   fromcode_buffer[64];
-	Char   tocode_buffer[64];
-	ZIconV iconv;
+
+/*
+Decodes a single character from _src.
+@return: number of bytes consumed,
+         or 0 if _src ends in the middle of a sequence*/
+static SizeT
+ZIconV_Decode(
+	_In_    Int32       _iFormat,
+	_In_    const Byte* _src,
+	_In_    SizeT       _srclen,
+	_Inout_ Uint32*     _ch) {
+
+	Uint32 ch;
+	SizeT  it, left;
+	Bool   overlong;
+
+	switch (_iFormat) {
+	case ENCODING_ASCII:
+		*_ch = (Uint32)(_src[0] & 0x7F);
+		return 1;
+
+	case ENCODING_LATIN1:
+		*_ch = (Uint32)_src[0];
+		return 1;
+
+	case ENCODING_UTF8:
+	{/* RFC 3629 */
+		left = 0;
+		overlong = Z_FALSE;
+		if (_src[0] >= 0xF0) {
+			if ((_src[0] & 0xF8) != 0xF0)
+				ch = UNKNOWN_UNICODE;
+			else {
+				if (_src[0] == 0xF0 && _srclen > 1
+					&& (_src[1] & 0xF0) == 0x80) {
+					overlong = Z_TRUE;
+				}
+				ch = (Uint32)(_src[0] & 0x07);
+				left = 3;
+			}
+		}
+		else if (_src[0] >= 0xE0) {
+			if ((_src[0] & 0xF0) != 0xE0)
+				ch = UNKNOWN_UNICODE;
+			else {
+				if (_src[0] == 0xE0 && _srclen > 1
+					&& (_src[1] & 0xE0) == 0x80) {
+					overlong = Z_TRUE;
+				}
+				ch = (Uint32)(_src[0] & 0x0F);
+				left = 2;
+			}
+		}
+		else if (_src[0] >= 0xC0) {
+			if ((_src[0] & 0xE0) != 0xC0)
+				ch = UNKNOWN_UNICODE;
+			else {
+				if ((_src[0] & 0xDE) == 0xC0) {
+					overlong = Z_TRUE;
+				}
+				ch = (Uint32)(_src[0] & 0x1F);
+				left = 1;
+			}
+		}
+		else {
+			if ((_src[0] & 0x80) != 0x00)
+				ch = UNKNOWN_UNICODE;
+			else ch = (Uint32)_src[0];
+		}
+		for (it = 1; it <= left; ++it) {
+			if (it >= _srclen) {
+				return 0; //sequence continues in the next buffer
+			}
+			if ((_src[it] & 0xC0) != 0x80) {
+				ch = UNKNOWN_UNICODE;
+				break;
+			}
+			ch <<= 6;
+			ch |= (_src[it] & 0x3F);
+		}
+		if (overlong) {
+			ch = UNKNOWN_UNICODE;
+		}
+		if ((ch >= 0xD800 && ch <= 0xDFFF) ||
+			(ch == 0xFFFE || ch == 0xFFFF) || ch > 0x10FFFF) {
+			ch = UNKNOWN_UNICODE;
+		}
+		*_ch = ch;
+		return it;
+	}
+
+	case ENCODING_UTF16BE:
+	case ENCODING_UTF16LE:
+	{/* RFC 2781 */
+		Uint32 W1, W2;
+		Int32  hi = (_iFormat == ENCODING_UTF16BE) ? 0 : 1;
+		if (_srclen < 2) {
+			return 0;
+		}
+		W1 = ((Uint32)_src[hi] << 8) | (Uint32)_src[hi ^ 1];
+		if (W1 < 0xD800 || W1 > 0xDFFF) {
+			*_ch = W1;
+			return 2;
+		}
+		if (W1 > 0xDBFF) {
+			*_ch = UNKNOWN_UNICODE;
+			return 2;
+		}
+		if (_srclen < 4) {
+			return 0;
+		}
+		W2 = ((Uint32)_src[2 + hi] << 8) | (Uint32)_src[2 + (hi ^ 1)];
+		if (W2 < 0xDC00 || W2 > 0xDFFF) {
+			*_ch = UNKNOWN_UNICODE;
+			return 4;
+		}
+		*_ch = (((W1 & 0x3FF) << 10) | (W2 & 0x3FF)) + 0x10000;
+		return 4;
+	}
+
+	case ENCODING_UCS2LE:
+		if (_srclen < 2) {
+			return 0;
+		}
+		*_ch = ((Uint32)_src[1] << 8) | (Uint32)_src[0];
+		return 2;
+
+	case ENCODING_UCS2BE:
+		if (_srclen < 2) {
+			return 0;
+		}
+		*_ch = ((Uint32)_src[0] << 8) | (Uint32)_src[1];
+		return 2;
+
+	case ENCODING_UCS4BE:
+	case ENCODING_UTF32BE:
+		if (_srclen < 4) {
+			return 0;
+		}
+		*_ch = ((Uint32)_src[0] << 24) |
+			((Uint32)_src[1] << 16) |
+			((Uint32)_src[2] << 8) | (Uint32)_src[3];
+		return 4;
+
+	case ENCODING_UCS4LE:
+	case ENCODING_UTF32LE:
+		if (_srclen < 4) {
+			return 0;
+		}
+		*_ch = ((Uint32)_src[3] << 24) |
+			((Uint32)_src[2] << 16) |
+			((Uint32)_src[1] << 8) | (Uint32)_src[0];
+		return 4;
+	}
+	*_ch = UNKNOWN_UNICODE;
+	return 1;
+}
+
+
+/*
+Encodes a single character into _dst.
+@return: number of bytes written, or 0 if _dst is too small*/
+static SizeT
+ZIconV_Encode(
+	_In_    Int32  _iFormat,
+	_In_    Uint32 _ch,
+	_Inout_ Byte*  _dst,
+	_In_    SizeT  _dstlen) {
+
+	switch (_iFormat) {
+	case ENCODING_ASCII:
+		if (_dstlen < 1) {
+			return 0;
+		}
+		_dst[0] = (_ch > 0x7F) ? UNKNOWN_ASCII : (Byte)_ch;
+		return 1;
+
+	case ENCODING_LATIN1:
+		if (_dstlen < 1) {
+			return 0;
+		}
+		_dst[0] = (_ch > 0xFF) ? UNKNOWN_ASCII : (Byte)_ch;
+		return 1;
+
+	case ENCODING_UTF8:
+	{/* RFC 3629 */
+		if (_ch > 0x10FFFF) {
+			_ch = UNKNOWN_UNICODE;
+		}
+		if (_ch <= 0x7F) {
+			if (_dstlen < 1) {
+				return 0;
+			}
+			_dst[0] = (Byte)_ch;
+			return 1;
+		}
+		else if (_ch <= 0x7FF) {
+			if (_dstlen < 2) {
+				return 0;
+			}
+			_dst[0] = 0xC0 | (Byte)((_ch >> 6) & 0x1F);
+			_dst[1] = 0x80 | (Byte)(_ch & 0x3F);
+			return 2;
+		}
+		else if (_ch <= 0xFFFF) {
+			if (_dstlen < 3) {
+				return 0;
+			}
+			_dst[0] = 0xE0 | (Byte)((_ch >> 12) & 0x0F);
+			_dst[1] = 0x80 | (Byte)((_ch >> 6) & 0x3F);
+			_dst[2] = 0x80 | (Byte)(_ch & 0x3F);
+			return 3;
+		}
+		if (_dstlen < 4) {
+			return 0;
+		}
+		_dst[0] = 0xF0 | (Byte)((_ch >> 18) & 0x07);
+		_dst[1] = 0x80 | (Byte)((_ch >> 12) & 0x3F);
+		_dst[2] = 0x80 | (Byte)((_ch >> 6) & 0x3F);
+		_dst[3] = 0x80 | (Byte)(_ch & 0x3F);
+		return 4;
+	}
+
+	case ENCODING_UTF16BE:
+	case ENCODING_UTF16LE:
+	{/* RFC 2781 */
+		Uint32 W1, W2;
+		Int32  hi = (_iFormat == ENCODING_UTF16BE) ? 0 : 1;
+		if (_ch > 0x10FFFF) {
+			_ch = UNKNOWN_UNICODE;
+		}
+		if (_ch < 0x10000) {
+			if (_dstlen < 2) {
+				return 0;
+			}
+			_dst[hi] = (Byte)(_ch >> 8);
+			_dst[hi ^ 1] = (Byte)_ch;
+			return 2;
+		}
+		if (_dstlen < 4) {
+			return 0;
+		}
+		_ch = _ch - 0x10000;
+		W1 = 0xD800 | ((_ch >> 10) & 0x3FF);
+		W2 = 0xDC00 | (_ch & 0x3FF);
+		_dst[hi] = (Byte)(W1 >> 8);
+		_dst[hi ^ 1] = (Byte)W1;
+		_dst[2 + hi] = (Byte)(W2 >> 8);
+		_dst[2 + (hi ^ 1)] = (Byte)W2;
+		return 4;
+	}
+
+	case ENCODING_UCS2BE:
+	case ENCODING_UCS2LE:
+	{
+		Int32 hi = (_iFormat == ENCODING_UCS2BE) ? 0 : 1;
+		if (_ch > 0xFFFF) {
+			_ch = UNKNOWN_UNICODE;
+		}
+		if (_dstlen < 2) {
+			return 0;
+		}
+		_dst[hi] = (Byte)(_ch >> 8);
+		_dst[hi ^ 1] = (Byte)_ch;
+		return 2;
+	}
+
+	case ENCODING_UTF32BE:
+	case ENCODING_UTF32LE:
+		if (_ch > 0x10FFFF) {
+			_ch = UNKNOWN_UNICODE;
+		}
+		/* fallthrough */
+	case ENCODING_UCS4BE:
+	case ENCODING_UCS4LE:
+	{
+		Int32 be;
+		if (_ch > 0x7FFFFFFF) {
+			_ch = UNKNOWN_UNICODE;
+		}
+		if (_dstlen < 4) {
+			return 0;
+		}
+		be = (_iFormat == ENCODING_UTF32BE || _iFormat == ENCODING_UCS4BE);
+		_dst[be ? 0 : 3] = (Byte)(_ch >> 24);
+		_dst[be ? 1 : 2] = (Byte)(_ch >> 16);
+		_dst[be ? 2 : 1] = (Byte)(_ch >> 8);
+		_dst[be ? 3 : 0] = (Byte)_ch;
+		return 4;
+	}
+	}
+	return 0;
+}
+
+
+static Void
+ZIconV_Reset(
+	_Inout_ ZIconV _lpIconV) {
+
+	_lpIconV->iFmtSrc   = _lpIconV->iOpenSrc;
+	_lpIconV->iFmtDst   = _lpIconV->iOpenDst;
+	_lpIconV->bWriteBom = Z_FALSE;
+	_lpIconV->nCarry    = 0;
+
+	/*
+	UTF-16 and UTF-32 output without an explicit byte order
+	is written in host order, preceded by a byte order marker*/
+	if (_lpIconV->iOpenDst == ENCODING_UTF16) {
+		_lpIconV->iFmtDst   = ENCODING_UTF16NATIVE;
+		_lpIconV->bWriteBom = Z_TRUE;
+	}
+	else if (_lpIconV->iOpenDst == ENCODING_UTF32) {
+		_lpIconV->iFmtDst   = ENCODING_UTF32NATIVE;
+		_lpIconV->bWriteBom = Z_TRUE;
+	}
+}
+
+
+/*
+Resolves the byte order of UTF-16 and UTF-32 input from its first code unit.
+The unit is collected into the carry buffer so that a marker split across
+two calls is still recognised, and it is dropped if it is a marker.
+@return: True once the byte order is known, False if more input is needed*/
+static Bool
+ZIconV_ResolveByteOrder(
+	_Inout_ ZIconV  _lpIconV,
+	_Inout_ Lpcstr* _src,
+	_Inout_ SizeT*  _srclen) {
+
+	SizeT unit, nfill;
+	Byte* p;
+
+	if (_lpIconV->iFmtSrc == ENCODING_UTF16)
+		unit = 2;
+	else if (_lpIconV->iFmtSrc == ENCODING_UTF32)
+		unit = 4;
+	else return Z_TRUE;
+
+	nfill = Z_Min(*_srclen, unit - _lpIconV->nCarry);
+	memcpy(_lpIconV->carry + _lpIconV->nCarry, *_src, nfill);
+	_lpIconV->nCarry += nfill;
+	*_src += nfill;
+	*_srclen -= nfill;
+	if (_lpIconV->nCarry < unit) {
+		return Z_FALSE;
+	}
+	p = _lpIconV->carry;
+	if (unit == 2) {
+		if (p[0] == 0xFF && p[1] == 0xFE)
+			_lpIconV->iFmtSrc = ENCODING_UTF16LE;
+		else if (p[0] == 0xFE && p[1] == 0xFF)
+			_lpIconV->iFmtSrc = ENCODING_UTF16BE;
+	}
+	else {
+		if (p[0] == 0xFF && p[1] == 0xFE &&
+			p[2] == 0x00 && p[3] == 0x00)
+			_lpIconV->iFmtSrc = ENCODING_UTF32LE;
+		else if (p[0] == 0x00 && p[1] == 0x00 &&
+			p[2] == 0xFE && p[3] == 0xFF)
+			_lpIconV->iFmtSrc = ENCODING_UTF32BE;
+	}
+	if (_lpIconV->iFmtSrc == ENCODING_UTF16 ||
+		_lpIconV->iFmtSrc == ENCODING_UTF32) {
+		/*
+		No marker, default to host order and keep the unit as data*/
+		_lpIconV->iFmtSrc = (unit == 2) ?
+			ENCODING_UTF16NATIVE : ENCODING_UTF32NATIVE;
+	}
+	else _lpIconV->nCarry = 0;
+	return Z_TRUE;
+}
+
+
+/*
+Per-thread cache of resolved descriptors, keyed by the exact encoding names
+passed in. A hit skips the case-insensitive scan of the encodings table, and
+the string conversion functions convert through the cached descriptor 
+directly, so they need no descriptor allocation either.*/
+#define ZICONV_CACHE_SIZE 4
+#define ZICONV_CACHE_NAME 32
+
+typedef struct {
+	Char           tocode[ZICONV_CACHE_NAME];
+	Char           fromcode[ZICONV_CACHE_NAME];
+	Bool           bKeyed; //names are stored and the slot can be matched
+	struct _ZIconV iconv;
+} ZIconVCacheEntry;
+
+static THREADLOCAL ZIconVCacheEntry s_cache[ZICONV_CACHE_SIZE];
+static THREADLOCAL Int32            s_cacheNext;
+
+
+static Bool
+ZIconV_FindFormats(
+	_In_    Lpcstr _tocode,
+	_In_    Lpcstr _fromcode,
+	_Inout_ Int32* _iFmtDst,
+	_Inout_ Int32* _iFmtSrc) {
+
+	Int32 iFmtSrc, iFmtDst, it;
+	Char  fromcode_buffer[64];
+	Char  tocode_buffer[64];
 
 	iFmtSrc = ENCODING_UNKNOWN;
 	iFmtDst = ENCODING_UNKNOWN;
@@ -188,7 +588,7 @@ ZIconV_Open(
 		_tocode = ZIconV_GetLocale(
 			tocode_buffer, sizeof(tocode_buffer));
 	}
-	for (it = 0; it < Z_ArraySize(encodings); ++it) {
+	for (it = 0; it < (Int32)Z_ArraySize(encodings); ++it) {
 		if (ZString_StrCaseCmp(_fromcode, encodings[it].cName) == 0) {
 			iFmtSrc = encodings[it].iFormat;
 			if (iFmtDst != ENCODING_UNKNOWN)
@@ -200,11 +600,90 @@ ZIconV_Open(
 				break;
 		}
 	}
-	if (iFmtSrc != ENCODING_UNKNOWN && iFmtDst != ENCODING_UNKNOWN) {
+	*_iFmtSrc = iFmtSrc;
+	*_iFmtDst = iFmtDst;
+	return iFmtSrc != ENCODING_UNKNOWN && iFmtDst != ENCODING_UNKNOWN;
+}
+
+
+/*
+Returns this thread's cached descriptor for the given encodings, 
+reset and ready for a new stream, or (ZIconV)-1 if unsupported*/
+static ZIconV
+ZIconV_Lookup(
+	_In_ Lpcstr _tocode,
+	_In_ Lpcstr _fromcode) {
+
+	ZIconVCacheEntry* entry;
+	Int32             it, iFmtSrc, iFmtDst;
+
+	_tocode = _tocode ? _tocode : "";
+	_fromcode = _fromcode ? _fromcode : "";
+
+	for (it = 0; it < ZICONV_CACHE_SIZE; ++it) {
+		entry = &s_cache[it];
+		if (entry->bKeyed &&
+			strcmp(entry->tocode, _tocode) == 0 &&
+			strcmp(entry->fromcode, _fromcode) == 0) {
+			ZIconV_Reset(&entry->iconv);
+			return &entry->iconv;
+		}
+	}
+	if (!ZIconV_FindFormats(_tocode, _fromcode, &iFmtDst, &iFmtSrc)) {
+		return (ZIconV)-1;
+	}
+	/*
+	Names too long to store still get a slot to convert through,
+	they are just never matched by later lookups*/
+	entry = &s_cache[s_cacheNext];
+	entry->bKeyed =
+		strlen(_tocode) < ZICONV_CACHE_NAME &&
+		strlen(_fromcode) < ZICONV_CACHE_NAME;
+	if (entry->bKeyed) {
+		strcpy(entry->tocode, _tocode);
+		strcpy(entry->fromcode, _fromcode);
+	}
+	s_cacheNext = (s_cacheNext + 1) % ZICONV_CACHE_SIZE;
+	entry->iconv.iOpenSrc = iFmtSrc;
+	entry->iconv.iOpenDst = iFmtDst;
+	ZIconV_Reset(&entry->iconv);
+	return &entry->iconv;
+}
+
+
+/*
+Lookup with the fallback used by the string conversion functions:
+unsupported locale encodings are treated as UTF-8*/
+static ZIconV
+ZIconV_LookupString(
+	_In_ Lpcstr _tocode,
+	_In_ Lpcstr _fromcode) {
+
+	ZIconV iconv;
+	iconv = ZIconV_Lookup(_tocode, _fromcode);
+	if (iconv == (ZIconV)-1) {
+		if (!_tocode || !*_tocode)
+			_tocode = "UTF-8";
+		if (!_fromcode || !*_fromcode)
+			_fromcode = "UTF-8";
+		iconv = ZIconV_Lookup(_tocode, _fromcode);
+	}
+	return iconv;
+}
+
+
+ZIconV
+ZIconV_Open(
+	_In_ Lpcstr _tocode,
+	_In_ Lpcstr _fromcode) {
+
+	ZIconV cached, iconv;
+
+	cached = ZIconV_Lookup(_tocode, _fromcode);
+	if (cached != (ZIconV)-1) {
 		iconv = (ZIconV)malloc(sizeof(*iconv));
 		if (iconv) {
-			iconv->iFmtSrc = iFmtSrc;
-			iconv->iFmtDst = iFmtDst;
+			*iconv = *cached;
 			return iconv;
 		}
 	}
@@ -212,7 +691,7 @@ ZIconV_Open(
 }
 
 
-SizeT 
+SizeT
 ZIconV_Init(
 	_Inout_ ZIconV _lpIconV,
 	_In_    Lpcstr*  _inbuffer,
@@ -225,527 +704,111 @@ ZIconV_Init(
 	Lpcstr src;
 	Char*  dst;
 	SizeT  total, srclen, dstlen;
+	SizeT  nread, nwrite, nfill;
+	Byte   seq[8];
 	Uint32 ch;
 
 	ch = 0;
 	if (!_inbuffer || !*_inbuffer) {
-		return 0;//Reset the context 
+		ZIconV_Reset(_lpIconV);
+		return 0;//Reset the context
 	}
-	if (!_outbuffer || !*_outbuffer ||
-		!_outbytesleft || !*_outbytesleft) {
+	if (!_outbuffer || !*_outbuffer || !_outbytesleft) {
 		return Z_EICONVTOOBIG;
 	}
+	if (!_inbytesleft) {
+		_inbytesleft = &srclen;
+		srclen = 0;
+	}
 	src = *_inbuffer;
-	srclen = (_inbytesleft ? *_inbytesleft : 0);
+	srclen = *_inbytesleft;
 	dst = *_outbuffer;
 	dstlen = *_outbytesleft;
 
-	switch (_lpIconV->iFmtSrc) {
-	case ENCODING_UTF16:
-	{/*
-		Scan for a byte order marker */
-		Uint8* p = (Uint8*)src;
-		SizeT n = srclen / 2;
-		while (n) {
-			if (p[0] == 0xFF && p[1] == 0xFE) {
-				_lpIconV->iFmtSrc = ENCODING_UTF16BE;
-				break;
-			}
-			else if (p[0] == 0xFE && p[1] == 0xFF) {
-				_lpIconV->iFmtSrc = ENCODING_UTF16LE;
-				break;
-			}
-			p += 2;
-			--n;
-		}
-		if (n == 0) {
-			/*default to host order */
-			_lpIconV->iFmtSrc = ENCODING_UTF16NATIVE;
-		}
-	}
-	break;
-	case ENCODING_UTF32:
-	{/*
-	 Scan for a byte order marker */
-		Uint8* p = (Uint8*)src;
-		SizeT  n = srclen / 4;
-		while (n) {
-			if (p[0] == 0xFF && p[1] == 0xFE &&
-				p[2] == 0x00 && p[3] == 0x00) {
-				_lpIconV->iFmtSrc = ENCODING_UTF32BE;
-				break;
-			}
-			else if (p[0] == 0x00 && p[1] == 0x00 &&
-				p[2] == 0xFE && p[3] == 0xFF) {
-				_lpIconV->iFmtSrc = ENCODING_UTF32LE;
-				break;
-			}
-			p += 4;
-			--n;
-		}
-		if (n == 0) {
-			/*default to host order */
-			_lpIconV->iFmtSrc = ENCODING_UTF32NATIVE;
-		}
-	}
-	break;
-	}
-
-	switch (_lpIconV->iFmtSrc) {
-	case ENCODING_UTF16:
-		/*
-		Default to host order, need to add byte order marker */
-		if (dstlen < 2) {
+	if (_lpIconV->bWriteBom) {
+		nwrite = ZIconV_Encode(
+			_lpIconV->iFmtDst, UNICODE_BOM, (Byte*)dst, dstlen);
+		if (nwrite == 0) {
 			return Z_EICONVTOOBIG;
 		}
-		*(Uint16*)dst = UNICODE_BOM;
-		dst += 2;
-		dstlen -= 2;
-		_lpIconV->iFmtDst = ENCODING_UTF16NATIVE;
-		break;
-
-	case ENCODING_UTF32:
-		/*
-		Default to host order, need to add byte order marker */
-		if (dstlen < 4) {
-			return Z_EICONVTOOBIG;
-		}
-		*(Uint32*)dst = UNICODE_BOM;
-		dst += 4;
-		dstlen -= 4;
-		_lpIconV->iFmtDst = ENCODING_UTF32NATIVE;
-		break;
+		dst += nwrite;
+		dstlen -= nwrite;
+		_lpIconV->bWriteBom = Z_FALSE;
+		*_outbuffer = dst;
+		*_outbytesleft = dstlen;
+	}
+	/*
+	The marker is consumed, or held as data in the carry, for good:
+	store the advanced input so a call cut short by a full output 
+	buffer resumes after it*/
+	if (!ZIconV_ResolveByteOrder(_lpIconV, &src, &srclen)) {
+		*_inbuffer = src;
+		*_inbytesleft = srclen;
+		return 0;
 	}
+	*_inbuffer = src;
+	*_inbytesleft = srclen;
 
 	total = 0;
-	while (srclen > 0) {
+	while (srclen > 0 || _lpIconV->nCarry > 0) {
 		/*
-		Decode a character */
-		switch (_lpIconV->iFmtSrc) {
-		case ENCODING_ASCII:
-		{
-			Byte* p = (Byte*)src;
-			ch = (Uint32)(p[0] & 0x7F);
-			++src;
-			--srclen;
-		}
-		break;
-		case ENCODING_LATIN1:
-		{
-			Byte* p = (Byte*)src;
-			ch = (Uint32)p[0];
-			++src;
-			--srclen;
-		}
-		break;
-		case ENCODING_UTF8:
-		{/* RFC 3629 */
-			Byte* p = (Byte*)src;
-			SizeT left = 0;
-			Bool  overlong = Z_FALSE;
-			if (p[0] >= 0xF0) {
-				if ((p[0] & 0xF8) != 0xF0)
-					ch = UNKNOWN_UNICODE;
-				else {
-					if (p[0] == 0xF0 && srclen > 1
-						&& (p[1] & 0xF0) == 0x80) {
-						overlong = Z_TRUE;
-					}
-					ch = (Uint32)(p[0] & 0x07);
-					left = 3;
-				}
-			}
-			else if (p[0] >= 0xE0) {
-				if ((p[0] & 0xF0) != 0xE0)
-					ch = UNKNOWN_UNICODE;
-				else {
-					if (p[0] == 0xE0 && srclen > 1
-						&& (p[1] & 0xE0) == 0x80) {
-						overlong = Z_TRUE;
-					}
-					ch = (Uint32)(p[0] & 0x0F);
-					left = 2;
-				}
-			}
-			else if (p[0] >= 0xC0) {
-				if ((p[0] & 0xE0) != 0xC0)
-					ch = UNKNOWN_UNICODE;
-				else {
-					if ((p[0] & 0xDE) == 0xC0) {
-						overlong = Z_TRUE;
-					}
-					ch = (Uint32)(p[0] & 0x1F);
-					left = 1;
-				}
-			}
-			else {
-				if ((p[0] & 0x80) != 0x00)
-					ch = UNKNOWN_UNICODE;
-				else ch = (Uint32)p[0];
-			}
-			++src;
-			--srclen;
-			if (srclen < left) {
-				return Z_EICONVINVAL;
-			}
-			while (left--) {
-				++p;
-				if ((p[0] & 0xC0) != 0x80) {
-					ch = UNKNOWN_UNICODE;
-					break;
-				}
-				ch <<= 6;
-				ch |= (p[0] & 0x3F);
-				++src;
-				--srclen;
-			}
-			if (overlong) {
-				ch = UNKNOWN_UNICODE;
-			}
-			if ((ch >= 0xD800 && ch <= 0xDFFF) ||
-				(ch == 0xFFFE || ch == 0xFFFF) || ch > 0x10FFFF) {
-				ch = UNKNOWN_UNICODE;
-			}
-		}
-		break;
-		case ENCODING_UTF16BE:
-		{/* RFC 2781 */
-			Byte* p = (Byte*)src;
-			Uint16 W1, W2;
-			if (srclen < 2) {
-				return Z_EICONVINVAL;
-			}
-			W1 = ((Uint16)p[0] << 8) | (Uint16)p[1];
-			src += 2;
-			srclen -= 2;
-			if (W1 < 0xD800 || W1 > 0xDFFF) {
-				ch = (Uint32)W1;
+		Decode a character, completing the sequence
+		held over from the previous call first */
+		if (_lpIconV->nCarry > 0) {
+			nfill = Z_Min(srclen, sizeof(seq) - _lpIconV->nCarry);
+			memcpy(seq, _lpIconV->carry, _lpIconV->nCarry);
+			memcpy(seq + _lpIconV->nCarry, src, nfill);
+			nread = ZIconV_Decode(
+				_lpIconV->iFmtSrc, seq, _lpIconV->nCarry + nfill, &ch);
+			if (nread == 0) {
+				memcpy(_lpIconV->carry + _lpIconV->nCarry, src, nfill);
+				_lpIconV->nCarry += nfill;
+				src += nfill;
+				srclen -= nfill;
 				break;
 			}
-			if (W1 > 0xDBFF) {
-				ch = UNKNOWN_UNICODE;
-				break;
-			}
-			if (srclen < 2) {
-				return Z_EICONVINVAL;
-			}
-			p = (Byte*)src;
-			W2 = ((Uint16)p[0] << 8) | (Uint16)p[1];
-			src += 2;
-			srclen -= 2;
-			if (W2 < 0xDC00 || W2 > 0xDFFF) {
-				ch = UNKNOWN_UNICODE;
-				break;
-			}
-			ch = (((Uint32)(W1 & 0x3FF) << 10) |
-				(Uint32)(W2 & 0x3FF)) + 0x10000;
+			assert(nread >= _lpIconV->nCarry);
+			nread -= _lpIconV->nCarry;
 		}
-		break;
-		case ENCODING_UTF16LE:
-		{/* RFC 2781 */
-			Byte*p = (Byte*)src;
-			Uint16 W1, W2;
-			if (srclen < 2) {
-				return Z_EICONVINVAL;
-			}
-			W1 = ((Uint16)p[1] << 8) | (Uint16)p[0];
-			src += 2;
-			srclen -= 2;
-			if (W1 < 0xD800 || W1 > 0xDFFF) {
-				ch = (Uint32)W1;
-				break;
-			}
-			if (W1 > 0xDBFF) {
-				ch = UNKNOWN_UNICODE;
+		else {
+			nread = ZIconV_Decode(
+				_lpIconV->iFmtSrc, (const Byte*)src, srclen, &ch);
+			if (nread == 0) {
+				memcpy(_lpIconV->carry, src, srclen);
+				_lpIconV->nCarry = srclen;
+				src += srclen;
+				srclen = 0;
 				break;
 			}
-			if (srclen < 2) {
-				return Z_EICONVINVAL;
-			}
-			p = (Byte*)src;
-			W2 = ((Uint16)p[1] << 8) | (Uint16)p[0];
-			src += 2;
-			srclen -= 2;
-			if (W2 < 0xDC00 || W2 > 0xDFFF) {
-				ch = UNKNOWN_UNICODE;
-				break;
-			}
-			ch = (((Uint32)(W1 & 0x3FF) << 10) |
-				(Uint32)(W2 & 0x3FF)) + 0x10000;
-		}
-		break;
-		case ENCODING_UCS2LE:
-		{
-			Byte*p = (Byte*)src;
-			if (srclen < 2) {
-				return Z_EICONVINVAL;
-			}
-			ch = ((Uint32)p[1] << 8) | (Uint32)p[0];
-			src += 2;
-			srclen -= 2;
-		}
-		break;
-		case ENCODING_UCS2BE:
-		{
-			Byte*p = (Byte*)src;
-			if (srclen < 2) {
-				return Z_EICONVINVAL;
-			}
-			ch = ((Uint32)p[0] << 8) | (Uint32)p[1];
-			src += 2;
-			srclen -= 2;
-		}
-		break;
-		case ENCODING_UCS4BE:
-		case ENCODING_UTF32BE:
-		{
-			Byte*p = (Byte*)src;
-			if (srclen < 4) {
-				return Z_EICONVINVAL;
-			}
-			ch = ((Uint32)p[0] << 24) |
-				((Uint32)p[1] << 16) |
-				((Uint32)p[2] << 8) | (Uint32)p[3];
-			src += 4;
-			srclen -= 4;
-		}
-		break;
-		case ENCODING_UCS4LE:
-		case ENCODING_UTF32LE:
-		{
-			Byte* p = (Byte*)src;
-			if (srclen < 4) {
-				return Z_EICONVINVAL;
-			}
-			ch = ((Uint32)p[3] << 24) |
-				((Uint32)p[2] << 16) |
-				((Uint32)p[1] << 8) | (Uint32)p[0];
-			src += 4;
-			srclen -= 4;
-		}
-		break;
 		}
 		/*
 		Encode a character */
-		switch (_lpIconV->iFmtDst) {
-		case ENCODING_ASCII:
-		{
-			Byte* p = (Byte*)dst;
-			if (dstlen < 1) {
-				return Z_EICONVTOOBIG;
-			}
-			if (ch > 0x7F)
-				*p = UNKNOWN_ASCII;
-			else *p = (Byte)ch;
-			++dst;
-			--dstlen;
-		}
-		break;
-		case ENCODING_LATIN1:
-		{
-			Byte* p = (Byte*)dst;
-			if (dstlen < 1) {
-				return Z_EICONVTOOBIG;
-			}
-			if (ch > 0xFF)
-				*p = UNKNOWN_ASCII;
-			else *p = (Byte)ch;
-
-			++dst;
-			--dstlen;
-		}
-		break;
-		case ENCODING_UTF8:
-		{   /* RFC 3629 */
-			Byte* p = (Byte*)dst;
-			if (ch > 0x10FFFF) {
-				ch = UNKNOWN_UNICODE;
-			}
-			if (ch <= 0x7F) {
-				if (dstlen < 1) {
-					return Z_EICONVTOOBIG;
-				}
-				*p = (Byte)ch;
-				++dst;
-				--dstlen;
-			}
-			else if (ch <= 0x7FF) {
-				if (dstlen < 2) {
-					return Z_EICONVTOOBIG;
-				}
-				p[0] = 0xC0 | (Byte)((ch >> 6) & 0x1F);
-				p[1] = 0x80 | (Byte)(ch & 0x3F);
-				dst += 2;
-				dstlen -= 2;
-			}
-			else if (ch <= 0xFFFF) {
-				if (dstlen < 3) {
-					return Z_EICONVTOOBIG;
-				}
-				p[0] = 0xE0 | (Byte)((ch >> 12) & 0x0F);
-				p[1] = 0x80 | (Byte)((ch >> 6) & 0x3F);
-				p[2] = 0x80 | (Byte)(ch & 0x3F);
-				dst += 3;
-				dstlen -= 3;
-			}
-			else {
-				if (dstlen < 4) {
-					return Z_EICONVTOOBIG;
-				}
-				p[0] = 0xF0 | (Byte)((ch >> 18) & 0x07);
-				p[1] = 0x80 | (Byte)((ch >> 12) & 0x3F);
-				p[2] = 0x80 | (Byte)((ch >> 6) & 0x3F);
-				p[3] = 0x80 | (Byte)(ch & 0x3F);
-				dst += 4;
-				dstlen -= 4;
-			}
-		}
-		break;
-		case ENCODING_UTF16BE:
-		{/* RFC 2781 */
-			Byte*p = (Byte*)dst;
-			if (ch > 0x10FFFF) {
-				ch = UNKNOWN_UNICODE;
-			}
-			if (ch < 0x10000) {
-				if (dstlen < 2) {
-					return Z_EICONVTOOBIG;
-				}
-				p[0] = (Byte)(ch >> 8);
-				p[1] = (Byte)ch;
-				dst += 2;
-				dstlen -= 2;
-			}
-			else {
-				Uint16 W1, W2;
-				if (dstlen < 4) {
-					return Z_EICONVTOOBIG;
-				}
-				ch = ch - 0x10000;
-				W1 = 0xD800 | (Uint16)((ch >> 10) & 0x3FF);
-				W2 = 0xDC00 | (Uint16)(ch & 0x3FF);
-				p[0] = (Uint8)(W1 >> 8);
-				p[1] = (Uint8)W1;
-				p[2] = (Uint8)(W2 >> 8);
-				p[3] = (Uint8)W2;
-				dst += 4;
-				dstlen -= 4;
-			}
-		}
-		break;
-		case ENCODING_UTF16LE:
-		{/* RFC 2781 */
-			Byte*p = (Byte*)dst;
-			if (ch > 0x10FFFF) {
-				ch = UNKNOWN_UNICODE;
-			}
-			if (ch < 0x10000) {
-				if (dstlen < 2) {
-					return Z_EICONVTOOBIG;
-				}
-				p[1] = (Byte)(ch >> 8);
-				p[0] = (Byte)ch;
-				dst += 2;
-				dstlen -= 2;
-			}
-			else {
-				Uint16 W1, W2;
-				if (dstlen < 4) {
-					return Z_EICONVTOOBIG;
-				}
-				ch = ch - 0x10000;
-				W1 = 0xD800 | (Uint16)((ch >> 10) & 0x3FF);
-				W2 = 0xDC00 | (Uint16)(ch & 0x3FF);
-				p[1] = (Uint8)(W1 >> 8);
-				p[0] = (Uint8)W1;
-				p[3] = (Uint8)(W2 >> 8);
-				p[2] = (Uint8)W2;
-				dst += 4;
-				dstlen -= 4;
-			}
-		}
-		break;
-		case ENCODING_UCS2BE:
-		{
-			Byte *p = (Byte*)dst;
-			if (ch > 0xFFFF) {
-				ch = UNKNOWN_UNICODE;
-			}
-			if (dstlen < 2) {
-				return Z_EICONVTOOBIG;
-			}
-			p[0] = (Byte)(ch >> 8);
-			p[1] = (Byte)ch;
-			dst += 2;
-			dstlen -= 2;
-		}
-		break;
-		case ENCODING_UCS2LE:
-		{
-			Byte* p = (Byte*)dst;
-			if (ch > 0xFFFF) {
-				ch = UNKNOWN_UNICODE;
-			}
-			if (dstlen < 2) {
-				return Z_EICONVTOOBIG;
-			}
-			p[1] = (Byte)(ch >> 8);
-			p[0] = (Byte)ch;
-			dst += 2;
-			dstlen -= 2;
-		}
-		break;
-		case ENCODING_UTF32BE:
-			if (ch > 0x10FFFF) {
-				ch = UNKNOWN_UNICODE;
-			}
-			/* fallthrough */
-		case ENCODING_UCS4BE:
-			if (ch > 0x7FFFFFFF)
-				ch = UNKNOWN_UNICODE;
-			{
-				Byte* p = (Byte*)dst;
-				if (dstlen < 4) {
-					return Z_EICONVTOOBIG;
-				}
-				p[0] = (Byte)(ch >> 24);
-				p[1] = (Byte)(ch >> 16);
-				p[2] = (Byte)(ch >> 8);
-				p[3] = (Byte)ch;
-				dst += 4;
-				dstlen -= 4;
-			}
-			break;
-		case ENCODING_UTF32LE:
-			if (ch > 0x10FFFF) {
-				ch = UNKNOWN_UNICODE;
-			}
-			/* fallthrough */
-		case ENCODING_UCS4LE:
-			if (ch > 0x7FFFFFFF)
-				ch = UNKNOWN_UNICODE;
-			{
-				Byte* p = (Byte*)dst;
-				if (dstlen < 4) {
-					return Z_EICONVTOOBIG;
-				}
-				p[3] = (Byte)(ch >> 24);
-				p[2] = (Byte)(ch >> 16);
-				p[1] = (Byte)(ch >> 8);
-				p[0] = (Byte)ch;
-				dst += 4;
-				dstlen -= 4;
-			}
-			break;
+		nwrite = ZIconV_Encode(_lpIconV->iFmtDst, ch, (Byte*)dst, dstlen);
+		if (nwrite == 0) {
+			/*
+			The buffers stop before this character and the carry still
+			holds its start, so the next call converts it again*/
+			*_inbuffer = src;
+			*_inbytesleft = srclen;
+			*_outbuffer = dst;
+			*_outbytesleft = dstlen;
+			return Z_EICONVTOOBIG;
 		}
 		/*
 		Update state */
-		*_inbuffer = src;
-		*_inbytesleft = srclen;
-		*_outbuffer = dst;
-		*_outbytesleft = dstlen;
+		_lpIconV->nCarry = 0;
+		src += nread;
+		srclen -= nread;
+		dst += nwrite;
+		dstlen -= nwrite;
 		++total;
 	}
+	/*
+	Trailing bytes of an incomplete sequence now belong to the context*/
+	*_inbuffer = src;
+	*_inbytesleft = srclen;
+	*_outbuffer = dst;
+	*_outbytesleft = dstlen;
 	return total;
 }
 
@@ -760,40 +823,113 @@ ZIconV_Close(
 }
 
 
-Char* 
-ZIconV_ConvertString(
-	_In_ Lpcstr _tocode,
-	_In_ Lpcstr _fromcode,
-	_In_ Lpcstr _inbuffer,
-	_In_ SizeT  _inbytesleft) {
+/*
+Computes the exact output size of valid UTF-8 input from its code point
+counts, for destinations where that is a fixed function of the counts.
+@return: True if the size was computed, False if a conversion pass is needed*/
+static Bool
+ZIconV_SizeFromUtf8(
+	_In_    ZIconV  _lpIconV,
+	_In_    Lpcstr  _inbuffer,
+	_In_    SizeT   _inbytesleft,
+	_Inout_ SizeT*  _lpSize) {
+
+	SizeT size;
+
+	if (_lpIconV->iFmtSrc != ENCODING_UTF8 ||
+		!ZUtf8_Validate(_inbuffer, _inbytesleft)) {
+		return Z_FALSE;
+	}
+	switch (_lpIconV->iFmtDst) {
+	case ENCODING_UTF8:
+		size = _inbytesleft;
+		break;
+	case ENCODING_ASCII:
+	case ENCODING_LATIN1:
+		size = ZUtf8_CountCodePoints(_inbuffer, _inbytesleft);
+		break;
+	case ENCODING_UTF16BE:
+	case ENCODING_UTF16LE:
+		size = 2 * ZUtf8_Utf16Length(_inbuffer, _inbytesleft);
+		break;
+	case ENCODING_UCS2BE:
+	case ENCODING_UCS2LE:
+		size = 2 * ZUtf8_CountCodePoints(_inbuffer, _inbytesleft);
+		break;
+	default:
+		size = 4 * ZUtf8_CountCodePoints(_inbuffer, _inbytesleft);
+		break;
+	}
+	if (_lpIconV->bWriteBom) {
+		size += (_lpIconV->iOpenDst == ENCODING_UTF16) ? 2 : 4;
+	}
+	*_lpSize = size;
+	return Z_TRUE;
+}
+
+
+ZRESULT
+ZIconV_GetConvertedSize(
+	_In_    Lpcstr _tocode,
+	_In_    Lpcstr _fromcode,
+	_In_    Lpcstr _inbuffer,
+	_In_    SizeT  _inbytesleft,
+	_Inout_ SizeT* _lpSize) {
 
 	ZIconV iconv;
-	Char*  string;
+	Char   scratch[64];
 	Char*  outbuffer;
-	SizeT  stringsize, outbytesleft, returncode = 0;
-
-	iconv = ZIconV_Open(_tocode, _fromcode);
+	SizeT  outbytesleft, size;
 
+	iconv = ZIconV_LookupString(_tocode, _fromcode);
 	if (iconv == (ZIconV)-1) {
-		if (!_tocode || !*_tocode)
-			_tocode = "UTF-8";
-		if (!_fromcode || !*_fromcode)
-			_fromcode = "UTF-8";
-		iconv = ZIconV_Open(_tocode, _fromcode);
+		return Z_EUNSUPPORTED;
 	}
-	if (iconv == (ZIconV)-1) {
-		return NULL;
+	if (ZIconV_SizeFromUtf8(iconv, _inbuffer, _inbytesleft, _lpSize)) {
+		return Z_OK;
 	}
-	stringsize = _inbytesleft > 4 ? _inbytesleft : 4;
-	string = (Char*)malloc(stringsize);
-	if (!string) {
-		ZIconV_Close(iconv);
-		return NULL;
+	size = 0;
+	while (_inbytesleft > 0) {
+		const SizeT oldinbytesleft = _inbytesleft;
+		outbuffer = scratch;
+		outbytesleft = sizeof(scratch);
+		ZIconV_Init(
+			iconv,
+			&_inbuffer,
+			&_inbytesleft,
+			&outbuffer,
+			&outbytesleft);
+
+		size += sizeof(scratch) - outbytesleft;
+		if (oldinbytesleft == _inbytesleft)
+			break; //Avoid infinite loops when nothing gets converted
 	}
-	outbuffer = string;
-	outbytesleft = stringsize;
-	memset(outbuffer, 0, 4);
+	*_lpSize = size;
+	return Z_OK;
+}
+
+
+ZRESULT
+ZIconV_ConvertBuffer(
+	_In_        Lpcstr _tocode,
+	_In_        Lpcstr _fromcode,
+	_In_        Lpcstr _inbuffer,
+	_In_        SizeT  _inbytesleft,
+	_Inout_     Char*  _outbuffer,
+	_In_        SizeT  _outbytesleft,
+	_Inout_opt_ SizeT* _lpWritten) {
+
+	ZIconV  iconv;
+	Char*   outbuffer;
+	SizeT   returncode;
+	ZRESULT zresult;
 
+	iconv = ZIconV_LookupString(_tocode, _fromcode);
+	if (iconv == (ZIconV)-1) {
+		return Z_EUNSUPPORTED;
+	}
+	zresult = Z_OK;
+	outbuffer = _outbuffer;
 	while (_inbytesleft > 0) {
 		const SizeT oldinbytesleft = _inbytesleft;
 		returncode = ZIconV_Init(
@@ -801,39 +937,84 @@ ZIconV_ConvertString(
 			&_inbuffer,
 			&_inbytesleft,
 			&outbuffer,
-			&outbytesleft);
-
-		switch (returncode) {
-		case Z_EICONVTOOBIG:
-		{
-			Char* oldstring = string;
-			stringsize *= 2;
-			string = (Char*)realloc(string, stringsize);
-			if (!string) {
-				ZIconV_Close(iconv);
-				return NULL;
-			}
-			outbuffer = string + (outbuffer - oldstring);
-			outbytesleft = stringsize - (outbuffer - string);
-			memset(outbuffer, 0, 4);
-		} break;
-
-		case Z_EICONVILSEQ:
-			++_inbuffer;
-			--_inbytesleft;
-			break;
+			&_outbytesleft);
 
-		case Z_EICONVINVAL:
-		case Z_EICONVERROR:
-			_inbytesleft = 0;
+		if (returncode == (SizeT)Z_EICONVTOOBIG) {
+			zresult = Z_EICONVTOOBIG;
 			break;
 		}
 		if (oldinbytesleft == _inbytesleft)
 			break; //Avoid infinite loops when nothing gets converted
 	}
-	ZIconV_Close(iconv);
+	if (_lpWritten) {
+		*_lpWritten = (SizeT)(outbuffer - _outbuffer);
+	}
+	return zresult;
+}
+
+
+Char* 
+ZIconV_ConvertString(
+	_In_ Lpcstr _tocode,
+	_In_ Lpcstr _fromcode,
+	_In_ Lpcstr _inbuffer,
+	_In_ SizeT  _inbytesleft) {
+
+	Char* string;
+	SizeT stringsize;
+
+	if (Z_FAILURE(ZIconV_GetConvertedSize(
+		_tocode, _fromcode, _inbuffer, _inbytesleft, &stringsize))) {
+		return NULL;
+	}
+	/*
+	Allocate once at the exact size, plus a zeroed 
+	terminator wide enough for any destination encoding*/
+	string = (Char*)malloc(stringsize + 4);
+	if (!string) {
+		return NULL;
+	}
+	memset(string + stringsize, 0, 4);
+	if (Z_FAILURE(ZIconV_ConvertBuffer(
+		_tocode, _fromcode, _inbuffer, _inbytesleft,
+		string, stringsize, NULL))) {
+		free(string);
+		return NULL;
+	}
+	return string;
+}
+
+
+Char* 
+ZIconV_ConvertStringArena(
+	_Inout_ ZArena* _lpArena,
+	_In_    Lpcstr  _tocode,
+	_In_    Lpcstr  _fromcode,
+	_In_    Lpcstr  _inbuffer,
+	_In_    SizeT   _inbytesleft) {
+
+	Char*      string;
+	SizeT      stringsize;
+	ZARENAMARK mark;
+
+	if (Z_FAILURE(ZIconV_GetConvertedSize(
+		_tocode, _fromcode, _inbuffer, _inbytesleft, &stringsize))) {
+		return NULL;
+	}
+	mark   = ZArena_Mark(_lpArena);
+	string = (Char*)ZArena_Alloc(_lpArena, stringsize + 4, 4);
+	if (!string) {
+		return NULL;
+	}
+	memset(string + stringsize, 0, 4);
+	if (Z_FAILURE(ZIconV_ConvertBuffer(
+		_tocode, _fromcode, _inbuffer, _inbytesleft,
+		string, stringsize, NULL))) {
+		ZArena_Rewind(_lpArena, &mark);
+		return NULL;
+	}
 	return string;
 }
 /*****************************************************************************/  
 //EOF
-/*****************************************************************************/ 
\ No newline at end of file
+/*****************************************************************************/  
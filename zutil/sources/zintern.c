@@ -0,0 +1,444 @@
+/******************************************************************************
+* zutil - C Utility Library
+* Copyright (C) 2017-2021 Zachary T Harris. All Rights Reserved.  
+* Zlib license.
+* 
+* File: zintern.c
+* Desc: concurrent string interning table
+*******************************************************************************
+
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+******************************************************************************/ 
+#include "zutil/zmutex.h"
+#include "zutil/zintern.h"
+
+
+
+
+
+/* Section 1:
+** internal data
+******************************************************************************/
+#define ZINTERN_SHARDS     16     //independently locked sub-tables
+#define ZINTERN_SHARD_BITS 4      //log2 of ZINTERN_SHARDS
+#define ZINTERN_MIN_SLOTS  64     //initial number of slots of a shard
+#define ZINTERN_CHUNK_SIZE 0x4000 //default size of a storage chunk
+#define ZINTERN_MAX_LENGTH 0x7FFFFFFF
+
+#define ZINTERN_K0 0x9E3779B97F4A7C15ULL //hashing multipliers
+#define ZINTERN_K1 0xBF58476D1CE4E5B9ULL 
+#define ZINTERN_HI 0x8080808080808080ULL //high bit of every byte
+
+
+/*
+Stored immediately before the characters of every interned string*/
+typedef struct {
+	Uint32 length; //length in bytes, excluding the terminator
+	Uint32 hash;   //full hash of the string
+} ZInternHeader;
+
+/*
+A block of string storage, strings are never moved once written*/
+typedef struct _ZInternChunk {
+	struct _ZInternChunk* next; //previously filled chunk
+	SizeT                 used; //bytes handed out
+	SizeT                 size; //bytes available after this header
+} ZInternChunk;
+
+typedef struct {
+	ZMutex*       mutex;    //guards everything below
+	Lpcstr*       slots;    //open addressing table of handles
+	SizeT         capacity; //number of slots, a power of two
+	SizeT         count;    //number of strings stored
+	ZInternChunk* chunks;   //chunk being filled, then older chunks
+} ZInternShard;
+
+struct _ZIntern {
+	Int32        flags;
+	ZInternShard shards[ZINTERN_SHARDS];
+};
+
+
+
+#define ZIntern_GetHeader(handle) \
+	((const ZInternHeader*)(handle) - 1)
+
+
+
+
+
+/* Section 2:
+** hashing and matching
+******************************************************************************/
+/*
+Loads up to 8 bytes into a word, zero filling the rest*/
+static FORCEINLINE Uint64
+ZIntern_LoadWord(
+	_In_ Lpcstr _src,
+	_In_ SizeT  _len) {
+
+	Uint64 word = 0;
+	memcpy(&word, _src, _len);
+	return word;
+}
+
+
+/*
+Lowercases the ASCII letters of 8 bytes at once, other bytes are kept*/
+static FORCEINLINE Uint64
+ZIntern_FoldCase(
+	_In_ Uint64 _word) {
+
+	Uint64 heptets, geA, gtZ, upper;
+	heptets = _word & ~ZINTERN_HI;
+	geA = heptets + 0x3F3F3F3F3F3F3F3FULL; //high bit set if byte >= 'A'
+	gtZ = heptets + 0x2525252525252525ULL; //high bit set if byte >  'Z'
+	upper = (geA ^ gtZ) & ~_word & ZINTERN_HI;
+	return _word | (upper >> 2);
+}
+
+
+static Uint32
+ZIntern_Hash(
+	_In_ Lpcstr _str,
+	_In_ SizeT  _len,
+	_In_ Bool   _fold) {
+
+	Uint64 hash, word;
+
+	hash = (Uint64)_len * ZINTERN_K0;
+	while (_len > 0) {
+		const SizeT n = Z_Min(_len, 8);
+		word = ZIntern_LoadWord(_str, n);
+		if (_fold) {
+			word = ZIntern_FoldCase(word);
+		}
+		hash = (((hash << 5) | (hash >> 59)) ^ word) * ZINTERN_K0;
+		_str += n;
+		_len -= n;
+	}
+	hash ^= hash >> 32;
+	hash *= ZINTERN_K1;
+	hash ^= hash >> 29;
+	return (Uint32)hash;
+}
+
+
+static Bool
+ZIntern_Equal(
+	_In_ Lpcstr _str1,
+	_In_ Lpcstr _str2,
+	_In_ SizeT  _len,
+	_In_ Bool   _fold) {
+
+	Uint64 word1, word2;
+
+	if (!_fold) {
+		return memcmp(_str1, _str2, _len) == 0;
+	}
+	while (_len > 0) {
+		const SizeT n = Z_Min(_len, 8);
+		word1 = ZIntern_FoldCase(ZIntern_LoadWord(_str1, n));
+		word2 = ZIntern_FoldCase(ZIntern_LoadWord(_str2, n));
+		if (word1 != word2) {
+			return Z_FALSE;
+		}
+		_str1 += n;
+		_str2 += n;
+		_len -= n;
+	}
+	return Z_TRUE;
+}
+
+
+
+
+
+/* Section 3:
+** shard management
+******************************************************************************/
+/*
+Looks a string up in a shard.
+@_lpSlot: receives the empty slot where the string belongs if absent
+@return : the handle, or NULL if the string is absent*/
+static Lpcstr
+ZIntern_Probe(
+	_In_    const ZInternShard* _shard,
+	_In_    Lpcstr              _str,
+	_In_    SizeT               _len,
+	_In_    Uint32              _hash,
+	_In_    Bool                _fold,
+	_Inout_ SizeT*              _lpSlot) {
+
+	const ZInternHeader* header;
+	Lpcstr handle;
+	SizeT  mask, slot;
+
+	if (!_shard->capacity) {
+		return NULL;
+	}
+	mask = _shard->capacity - 1;
+	slot = _hash & mask;
+	while ((handle = _shard->slots[slot]) != NULL) {
+		header = ZIntern_GetHeader(handle);
+		if (header->hash == _hash && header->length == _len &&
+			ZIntern_Equal(handle, _str, _len, _fold)) {
+			return handle;
+		}
+		slot = (slot + 1) & mask;
+	}
+	*_lpSlot = slot;
+	return NULL;
+}
+
+
+/*
+Doubles the slot table of a shard, reusing the stored hashes*/
+static ZRESULT
+ZIntern_Grow(
+	_Inout_ ZInternShard* _shard) {
+
+	Lpcstr* slots;
+	SizeT   capacity, mask, slot, index;
+
+	capacity = _shard->capacity ? _shard->capacity * 2 : ZINTERN_MIN_SLOTS;
+	slots = (Lpcstr*)calloc(capacity, sizeof(Lpcstr));
+	if (!slots) {
+		return Z_EOUTOFMEMORY;
+	}
+	mask = capacity - 1;
+	for (index = 0; index < _shard->capacity; ++index) {
+		if (_shard->slots[index]) {
+			slot = ZIntern_GetHeader(_shard->slots[index])->hash & mask;
+			while (slots[slot]) {
+				slot = (slot + 1) & mask;
+			}
+			slots[slot] = _shard->slots[index];
+		}
+	}
+	free((Void*)_shard->slots);
+	_shard->slots = slots;
+	_shard->capacity = capacity;
+	return Z_OK;
+}
+
+
+/*
+Copies a string into the chunk storage of a shard*/
+static Lpcstr
+ZIntern_Store(
+	_Inout_ ZInternShard* _shard,
+	_In_    Lpcstr        _str,
+	_In_    SizeT         _len,
+	_In_    Uint32        _hash) {
+
+	ZInternChunk*  chunk;
+	ZInternHeader* header;
+	SizeT          size;
+
+	size = (sizeof(ZInternHeader) + _len + 1 + 7) & ~(SizeT)7;
+	chunk = _shard->chunks;
+	if (!chunk || chunk->size - chunk->used < size) {
+		const SizeT chunksize = Z_Max(size, ZINTERN_CHUNK_SIZE);
+		chunk = (ZInternChunk*)malloc(sizeof(ZInternChunk) + chunksize);
+		if (!chunk) {
+			return NULL;
+		}
+		chunk->next = _shard->chunks;
+		chunk->used = 0;
+		chunk->size = chunksize;
+		_shard->chunks = chunk;
+	}
+	header = (ZInternHeader*)((Byte*)(chunk + 1) + chunk->used);
+	chunk->used += size;
+	header->length = (Uint32)_len;
+	header->hash = _hash;
+	memcpy(header + 1, _str, _len);
+	((Char*)(header + 1))[_len] = '\0';
+	return (Lpcstr)(header + 1);
+}
+
+
+static Void
+ZIntern_FreeShard(
+	_Inout_ ZInternShard* _shard) {
+
+	ZInternChunk* chunk;
+	while (_shard->chunks) {
+		chunk = _shard->chunks;
+		_shard->chunks = chunk->next;
+		free(chunk);
+	}
+	free((Void*)_shard->slots);
+	if (_shard->mutex) {
+		ZMutex_Release(_shard->mutex);
+	}
+	memset(_shard, 0, sizeof(ZInternShard));
+}
+
+
+
+
+
+/* Section 4:
+** public interface functions
+******************************************************************************/
+ZIntern*
+ZIntern_Create(
+	_In_        ZINTERNFLAGS _eFlags,
+	_Inout_opt_ ZRESULT*     _lpResult) {
+
+	ZIntern* table;
+	Int32    index;
+
+	table = (ZIntern*)calloc(1, sizeof(ZIntern));
+	if (!table) {
+		if (_lpResult) {
+			*_lpResult = Z_EOUTOFMEMORY;
+		}
+		return NULL;
+	}
+	table->flags = _eFlags;
+	for (index = 0; index < ZINTERN_SHARDS; ++index) {
+		table->shards[index].mutex = ZMutex_Create();
+		if (!table->shards[index].mutex) {
+			ZIntern_Release(table);
+			if (_lpResult) {
+				*_lpResult = Z_EFAIL;
+			}
+			return NULL;
+		}
+	}
+	if (_lpResult) {
+		*_lpResult = Z_OK;
+	}
+	return table;
+}
+
+
+ZRESULT
+ZIntern_Release(
+	_Inout_ ZIntern* _lpIntern) {
+
+	Int32 index;
+
+	if (!_lpIntern) {
+		return Z_EINVALIDARG;
+	}
+	for (index = 0; index < ZINTERN_SHARDS; ++index) {
+		ZIntern_FreeShard(&_lpIntern->shards[index]);
+	}
+	free(_lpIntern);
+	return Z_OK;
+}
+
+
+Lpcstr
+ZIntern_InternN(
+	_Inout_ ZIntern* _lpIntern,
+	_In_    Lpcstr   _str,
+	_In_    SizeT    _len) {
+
+	ZInternShard* shard;
+	Lpcstr        handle;
+	SizeT         slot;
+	Uint32        hash;
+	Bool          fold;
+
+	if (_len > ZINTERN_MAX_LENGTH) {
+		return NULL;
+	}
+	fold = (_lpIntern->flags & ZINTERN_CASEINSENSITIVE) != 0;
+	hash = ZIntern_Hash(_str, _len, fold);
+	shard = &_lpIntern->shards[hash >> (32 - ZINTERN_SHARD_BITS)];
+
+	ZMutex_Lock(shard->mutex);
+	handle = ZIntern_Probe(shard, _str, _len, hash, fold, &slot);
+	if (!handle) {
+		/*
+		Keep the load factor under 3/4 so that probe sequences stay short*/
+		if ((shard->count + 1) * 4 > shard->capacity * 3) {
+			if (Z_FAILURE(ZIntern_Grow(shard))) {
+				ZMutex_Unlock(shard->mutex);
+				return NULL;
+			}
+			ZIntern_Probe(shard, _str, _len, hash, fold, &slot);
+		}
+		handle = ZIntern_Store(shard, _str, _len, hash);
+		if (handle) {
+			shard->slots[slot] = handle;
+			shard->count++;
+		}
+	}
+	ZMutex_Unlock(shard->mutex);
+	return handle;
+}
+
+
+Lpcstr
+ZIntern_FindN(
+	_Inout_ ZIntern* _lpIntern,
+	_In_    Lpcstr   _str,
+	_In_    SizeT    _len) {
+
+	ZInternShard* shard;
+	Lpcstr        handle;
+	SizeT         slot;
+	Uint32        hash;
+	Bool          fold;
+
+	if (_len > ZINTERN_MAX_LENGTH) {
+		return NULL;
+	}
+	fold = (_lpIntern->flags & ZINTERN_CASEINSENSITIVE) != 0;
+	hash = ZIntern_Hash(_str, _len, fold);
+	shard = &_lpIntern->shards[hash >> (32 - ZINTERN_SHARD_BITS)];
+
+	ZMutex_Lock(shard->mutex);
+	handle = ZIntern_Probe(shard, _str, _len, hash, fold, &slot);
+	ZMutex_Unlock(shard->mutex);
+	return handle;
+}
+
+
+SizeT
+ZIntern_Length(
+	_In_ Lpcstr _handle) {
+
+	return ZIntern_GetHeader(_handle)->length;
+}
+
+
+SizeT
+ZIntern_Count(
+	_Inout_ ZIntern* _lpIntern) {
+
+	SizeT count;
+	Int32 index;
+
+	count = 0;
+	for (index = 0; index < ZINTERN_SHARDS; ++index) {
+		ZMutex_Lock(_lpIntern->shards[index].mutex);
+		count += _lpIntern->shards[index].count;
+		ZMutex_Unlock(_lpIntern->shards[index].mutex);
+	}
+	return count;
+}
+/*****************************************************************************/  
+//EOF
+/*****************************************************************************/  
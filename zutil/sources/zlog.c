@@ -26,6 +26,7 @@ freely, subject to the following restrictions:
 ******************************************************************************/  
 #include "zutil/zthread.h" 
 #include "zutil/zlog.h" 
+#include "zutil/zstrbuilder.h"
 
 
 
@@ -34,8 +35,8 @@ freely, subject to the following restrictions:
 /* Section 1:
 ** internal data*/
 //***************************************************************************//
-#define ZLOG_OUT_C_FORMAT "%c %s %ld %s:%d: "
 #define ZLOG_MAX_FILENAME 255 
+#define ZLOG_MAX_PREFIX   (ZLOG_MAX_FILENAME + 72) //prefix of one line
 
 #define ZLog_ModeEnabled(flags, flag) \
     (flags & flag) == flag
@@ -181,14 +182,43 @@ typedef struct {
 	Dword dwThreadId;
 	Long  milliseconds;
 	Char  timestamp[32];
+	SizeT prefixlen;
+	Char  prefix[ZLOG_MAX_PREFIX];
 } ZLogOutData;
 
 
 
+/*
+Writes the line prefix "L timestamp thread file:line: " once per message,
+so that it is shared by the console and file outputs*/
+static Void
+ZLog_WritePrefix(
+	_Inout_ ZLogOutData* _outdata,
+	_In_    Lpcstr       _filename,
+	_In_    Int32        _linenumber) {
+
+	ZSTRBUILDER sb;
+	ZStrBuilder_InitBuffer(&sb, _outdata->prefix, sizeof(_outdata->prefix));
+	ZStrBuilder_AppendChar(&sb, _outdata->levelchar);
+	ZStrBuilder_AppendChar(&sb, ' ');
+	ZStrBuilder_AppendStr(&sb, _outdata->timestamp);
+	ZStrBuilder_AppendChar(&sb, ' ');
+	ZStrBuilder_AppendUint(&sb, _outdata->dwThreadId);
+	ZStrBuilder_AppendChar(&sb, ' ');
+	ZStrBuilder_AppendStr(&sb, _filename);
+	ZStrBuilder_AppendChar(&sb, ':');
+	ZStrBuilder_AppendInt(&sb, _linenumber);
+	ZStrBuilder_AppendN(&sb, ": ", 2);
+	_outdata->prefixlen = ZStrBuilder_Length(&sb);
+}
+
+
 static Void
 ZLog_InitOutputData(
 	_Inout_ ZLogOutData* _outdata,
-	_In_    ZLOGLEVEL    _level) {
+	_In_    ZLOGLEVEL    _level,
+	_In_    Lpcstr       _filename,
+	_In_    Int32        _linenumber) {
 
 	struct timeval tNow;
 	ZChrono_GetTimeOfDay(&tNow, NULL);
@@ -211,13 +241,12 @@ ZLog_InitOutputData(
 		sizeof(_outdata->timestamp));
 
 	_outdata->dwThreadId = ZThread_CurrentId();
+	ZLog_WritePrefix(_outdata, _filename, _linenumber);
 } 
  
 
 static Long 
 ZLog_PrintData( 
-	_In_    Lpcstr       _filename,
-	_In_    Int32        _linenumber,
 	_In_    Lpcstr       _format,
 	_In_    ZLogOutData* _outdata, 
 	_In_    va_list      _vaList,
@@ -227,19 +256,8 @@ ZLog_PrintData(
 	Int32 iResult;
 	Long  sizeout; 
 
-	sizeout = 0; 
-	iResult = fprintf(
-		_lpFile, 
-		ZLOG_OUT_C_FORMAT,
-		_outdata->levelchar, 
-		_outdata->timestamp, 
-		_outdata->dwThreadId, 
-		_filename, 
-		_linenumber);
-
-	if (iResult > 0) {
-		sizeout += iResult;
-	}
+	sizeout = (Long)fwrite(
+		_outdata->prefix, 1, _outdata->prefixlen, _lpFile);
 	iResult = vfprintf(_lpFile, _format, _vaList);
 	if (iResult > 0) {
 		sizeout += iResult;
@@ -258,11 +276,9 @@ ZLog_PrintData(
 }
 
 
-#define ZLOG_PRINT(file, line, fmat, n) \
+#define ZLOG_PRINT(fmat, n)             \
 	va_start(args[n], fmat);            \
 	ZLog_PrintData( 			        \
-		file, 					        \
-		line, 					        \
 		fmat,				            \
 		&outdata,				        \
 		args[n],				        \
@@ -434,14 +450,14 @@ ZLog_Output(
 		return;
 	} 
 	ZMutex_Lock(s_mutex);
-	ZLog_InitOutputData(&outdata, _level); 
+	ZLog_InitOutputData(&outdata, _level, _file, _line); 
 
 	if (ZLog_ModeEnabled(s_modeflag, ZLOGMODE_CONSOLE)) {
-		ZLOG_PRINT(_file, _line, _format, 0);
+		ZLOG_PRINT(_format, 0);
 	}
 	if (ZLog_ModeEnabled(s_modeflag, ZLOGMODE_FILEOUT)) {
 		if (ZLog_SwapFile()) {
-			ZLOG_PRINT(_file, _line, _format, 1);
+			ZLOG_PRINT(_format, 1);
 		}
 	}
 	ZMutex_Unlock(s_mutex);
@@ -0,0 +1,347 @@
+/******************************************************************************
+* zutil - C Utility Library
+* Copyright (C) 2017-2021 Zachary T Harris. All Rights Reserved.  
+* Zlib license.
+* 
+* File: zmat23.c
+* Desc: 2D affine transforms with batched point and rect transformation
+*******************************************************************************
+
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+******************************************************************************/ 
+#include <math.h>
+#include "zutil/zsimd.h"
+#include "zutil/zmat23.h"
+
+
+
+
+
+/* Section 1:
+** construction
+******************************************************************************/
+ZMAT23
+ZMat23_Identity(Void) {
+
+	ZMAT23 out;
+	out.a  = 1; out.b  = 0;
+	out.c  = 0; out.d  = 1;
+	out.tx = 0; out.ty = 0;
+	return out;
+}
+
+
+ZMAT23
+ZMat23_Translation(
+	_In_ Float _tx,
+	_In_ Float _ty) {
+
+	ZMAT23 out;
+	out.a  = 1;   out.b  = 0;
+	out.c  = 0;   out.d  = 1;
+	out.tx = _tx; out.ty = _ty;
+	return out;
+}
+
+
+ZMAT23
+ZMat23_Rotation(
+	_In_ Float _radians) {
+
+	ZMAT23 out;
+	Float  cs, sn;
+	cs = cosf(_radians);
+	sn = sinf(_radians);
+	out.a  = cs;  out.b  = sn;
+	out.c  = -sn; out.d  = cs;
+	out.tx = 0;   out.ty = 0;
+	return out;
+}
+
+
+ZMAT23
+ZMat23_Scaling(
+	_In_ Float _sx,
+	_In_ Float _sy) {
+
+	ZMAT23 out;
+	out.a  = _sx; out.b  = 0;
+	out.c  = 0;   out.d  = _sy;
+	out.tx = 0;   out.ty = 0;
+	return out;
+}
+
+
+ZMAT23
+ZMat23_Compose(
+	_In_ const ZVEC2* _position,
+	_In_ Float        _radians,
+	_In_ const ZVEC2* _scale) {
+
+	ZMAT23 out;
+	Float  cs, sn;
+	cs = cosf(_radians);
+	sn = sinf(_radians);
+	out.a  = cs * _scale->x;
+	out.b  = sn * _scale->x;
+	out.c  = -sn * _scale->y;
+	out.d  = cs * _scale->y;
+	out.tx = _position->x;
+	out.ty = _position->y;
+	return out;
+}
+
+
+ZMAT23
+ZMat23_Concat(
+	_In_ const ZMAT23* _first,
+	_In_ const ZMAT23* _second) {
+
+	const ZMAT23* f = _first;
+	const ZMAT23* s = _second;
+	ZMAT23 out;
+	out.a  = s->a * f->a  + s->c * f->b;
+	out.b  = s->b * f->a  + s->d * f->b;
+	out.c  = s->a * f->c  + s->c * f->d;
+	out.d  = s->b * f->c  + s->d * f->d;
+	out.tx = s->a * f->tx + s->c * f->ty + s->tx;
+	out.ty = s->b * f->tx + s->d * f->ty + s->ty;
+	return out;
+}
+
+
+Bool
+ZMat23_Invert(
+	_In_    const ZMAT23* _mat,
+	_Inout_ ZMAT23*       _out) {
+
+	const ZMAT23* m = _mat;
+	ZMAT23 out;
+	Float  det, inv;
+
+	det = m->a * m->d - m->b * m->c;
+	if (det == 0 || !isfinite(det))
+		return Z_FALSE;
+	inv    = 1.0f / det;
+	out.a  =  m->d * inv;
+	out.b  = -m->b * inv;
+	out.c  = -m->c * inv;
+	out.d  =  m->a * inv;
+	out.tx = -(out.a * m->tx + out.c * m->ty);
+	out.ty = -(out.b * m->tx + out.d * m->ty);
+	*_out  = out;
+	return Z_TRUE;
+}
+
+
+
+
+
+/* Section 2:
+** application
+******************************************************************************/
+ZVEC2
+ZMat23_Apply(
+	_In_ const ZMAT23* _mat,
+	_In_ const ZVEC2*  _point) {
+
+	ZVEC2 out;
+	out.x = _mat->a * _point->x + _mat->c * _point->y + _mat->tx;
+	out.y = _mat->b * _point->x + _mat->d * _point->y + _mat->ty;
+	return out;
+}
+
+
+Void
+ZMat23_ApplyArray(
+	_In_    const ZMAT23* _mat,
+	_In_    const ZVEC2*  _src,
+	_Inout_ ZVEC2*        _dst,
+	_In_    SizeT         _count) {
+
+	const Float* src;
+	Float* dst;
+	SizeT  i = 0;
+
+	src = (const Float*)_src;
+	dst = (Float*)_dst;
+#if (ZSIMD_AVX2)
+	{
+		//four points per register: broadcast each x and y within its pair
+		__m256 ab = _mm256_setr_ps(
+			_mat->a, _mat->b, _mat->a, _mat->b, 
+			_mat->a, _mat->b, _mat->a, _mat->b);
+		__m256 cd = _mm256_setr_ps(
+			_mat->c, _mat->d, _mat->c, _mat->d, 
+			_mat->c, _mat->d, _mat->c, _mat->d);
+		__m256 t  = _mm256_setr_ps(
+			_mat->tx, _mat->ty, _mat->tx, _mat->ty, 
+			_mat->tx, _mat->ty, _mat->tx, _mat->ty);
+		for (; i + 4 <= _count; i += 4) {
+			__m256 p  = _mm256_loadu_ps(src + 2 * i);
+			__m256 xs = _mm256_moveldup_ps(p);
+			__m256 ys = _mm256_movehdup_ps(p);
+			_mm256_storeu_ps(dst + 2 * i, ZSimd_MulAdd(xs, ab, 
+				ZSimd_MulAdd(ys, cd, t)));
+		}
+	}
+#elif (ZSIMD_SSE2)
+	{
+		//two points per register: (x0, x0, x1, x1) and (y0, y0, y1, y1)
+		__m128 ab = _mm_setr_ps(_mat->a, _mat->b, _mat->a, _mat->b);
+		__m128 cd = _mm_setr_ps(_mat->c, _mat->d, _mat->c, _mat->d);
+		__m128 t  = _mm_setr_ps(_mat->tx, _mat->ty, _mat->tx, _mat->ty);
+		for (; i + 2 <= _count; i += 2) {
+			__m128 p  = _mm_loadu_ps(src + 2 * i);
+			__m128 xs = _mm_shuffle_ps(p, p, _MM_SHUFFLE(2, 2, 0, 0));
+			__m128 ys = _mm_shuffle_ps(p, p, _MM_SHUFFLE(3, 3, 1, 1));
+			_mm_storeu_ps(dst + 2 * i, _mm_add_ps(
+				_mm_add_ps(_mm_mul_ps(xs, ab), _mm_mul_ps(ys, cd)), t));
+		}
+	}
+#elif (ZSIMD_NEON)
+	for (; i + 4 <= _count; i += 4) {
+		float32x4x2_t p = vld2q_f32(src + 2 * i);
+		float32x4x2_t r;
+		r.val[0] = vmlaq_n_f32(vmlaq_n_f32(vdupq_n_f32(_mat->tx), 
+			p.val[0], _mat->a), p.val[1], _mat->c);
+		r.val[1] = vmlaq_n_f32(vmlaq_n_f32(vdupq_n_f32(_mat->ty), 
+			p.val[0], _mat->b), p.val[1], _mat->d);
+		vst2q_f32(dst + 2 * i, r);
+	}
+#endif
+	for (; i < _count; ++i) {
+		Float x = src[2 * i], y = src[2 * i + 1];
+		dst[2 * i]     = _mat->a * x + _mat->c * y + _mat->tx;
+		dst[2 * i + 1] = _mat->b * x + _mat->d * y + _mat->ty;
+	}
+}
+
+
+ZRESULT
+ZMat23_ApplySoA(
+	_In_    const ZMAT23*     _mat,
+	_In_    const ZVEC2ARRAY* _src,
+	_Inout_ ZVEC2ARRAY*       _dst) {
+
+	ZSIMDF  a, b, c, d, tx, ty;
+	ZRESULT result;
+	SizeT   i = 0, n;
+
+	n = _src->iCount;
+	if (_dst->iCount != n) {
+		result = ZVec2Array_Resize(_dst, n);
+		if (Z_FAILURE(result))
+			return result;
+	}
+	a  = ZSimd_Set1(_mat->a);
+	b  = ZSimd_Set1(_mat->b);
+	c  = ZSimd_Set1(_mat->c);
+	d  = ZSimd_Set1(_mat->d);
+	tx = ZSimd_Set1(_mat->tx);
+	ty = ZSimd_Set1(_mat->ty);
+	for (; i + ZSIMD_LANES <= n; i += ZSIMD_LANES) {
+		ZSIMDF x = ZSimd_Load(_src->x + i);
+		ZSIMDF y = ZSimd_Load(_src->y + i);
+		ZSimd_Store(_dst->x + i, ZSimd_MulAdd(a, x, ZSimd_MulAdd(c, y, tx)));
+		ZSimd_Store(_dst->y + i, ZSimd_MulAdd(b, x, ZSimd_MulAdd(d, y, ty)));
+	}
+	for (; i < n; ++i) {
+		Float x = _src->x[i], y = _src->y[i];
+		_dst->x[i] = _mat->a * x + _mat->c * y + _mat->tx;
+		_dst->y[i] = _mat->b * x + _mat->d * y + _mat->ty;
+	}
+	return Z_OK;
+}
+
+
+/*
+The image of a rect is a parallelogram spanned by the transformed width 
+and height edges (a*w, b*w) and (c*h, d*h) from the transformed origin. 
+Its bounds along each axis are the origin plus the negative parts of both 
+edges, extended by the magnitudes of both edges. This holds for either 
+sign of w and h, so unnormalized rects need no special case.*/
+Void
+ZMat23_TransformRects(
+	_In_    const ZMAT23* _mat,
+	_In_    const ZRECT*  _src,
+	_Inout_ ZRECT*        _dst,
+	_In_    SizeT         _count) {
+
+	SizeT i = 0;
+#if (ZSIMD_SSE2 || ZSIMD_AVX2)
+	{
+		//one rect per register, lanes (x, y, w, h)
+		__m128 ab   = _mm_setr_ps(_mat->a, _mat->b, _mat->a, _mat->b);
+		__m128 cd   = _mm_setr_ps(_mat->c, _mat->d, _mat->c, _mat->d);
+		__m128 t    = _mm_setr_ps(_mat->tx, _mat->ty, 0, 0);
+		__m128 zero = _mm_setzero_ps();
+		__m128 sign = _mm_set1_ps(-0.0f);
+		for (; i < _count; ++i) {
+			__m128 r  = _mm_loadu_ps(_src[i].v);
+			__m128 xw = _mm_mul_ps(ab, 
+				_mm_shuffle_ps(r, r, _MM_SHUFFLE(2, 2, 0, 0)));
+			__m128 yh = _mm_mul_ps(cd, 
+				_mm_shuffle_ps(r, r, _MM_SHUFFLE(3, 3, 1, 1)));
+			__m128 e0 = _mm_movehl_ps(xw, xw); //(a*w, b*w)
+			__m128 e1 = _mm_movehl_ps(yh, yh); //(c*h, d*h)
+			__m128 lo = _mm_add_ps(_mm_add_ps(_mm_add_ps(xw, yh), t),
+				_mm_add_ps(_mm_min_ps(e0, zero), _mm_min_ps(e1, zero)));
+			__m128 sz = _mm_add_ps(
+				_mm_andnot_ps(sign, e0), _mm_andnot_ps(sign, e1));
+			_mm_storeu_ps(_dst[i].v, _mm_movelh_ps(lo, sz));
+		}
+	}
+#elif (ZSIMD_NEON)
+	{
+		//four rects per iteration, deinterleaved into x, y, w and h
+		float32x4_t zero = vdupq_n_f32(0);
+		for (; i + 4 <= _count; i += 4) {
+			float32x4x4_t r = vld4q_f32(_src[i].v);
+			float32x4x4_t o;
+			float32x4_t aw = vmulq_n_f32(r.val[2], _mat->a);
+			float32x4_t bw = vmulq_n_f32(r.val[2], _mat->b);
+			float32x4_t ch = vmulq_n_f32(r.val[3], _mat->c);
+			float32x4_t dh = vmulq_n_f32(r.val[3], _mat->d);
+			o.val[0] = vaddq_f32(vmlaq_n_f32(vmlaq_n_f32(
+				vdupq_n_f32(_mat->tx), r.val[0], _mat->a), r.val[1], _mat->c),
+				vaddq_f32(vminq_f32(aw, zero), vminq_f32(ch, zero)));
+			o.val[1] = vaddq_f32(vmlaq_n_f32(vmlaq_n_f32(
+				vdupq_n_f32(_mat->ty), r.val[0], _mat->b), r.val[1], _mat->d),
+				vaddq_f32(vminq_f32(bw, zero), vminq_f32(dh, zero)));
+			o.val[2] = vaddq_f32(vabsq_f32(aw), vabsq_f32(ch));
+			o.val[3] = vaddq_f32(vabsq_f32(bw), vabsq_f32(dh));
+			vst4q_f32(_dst[i].v, o);
+		}
+	}
+#endif
+	for (; i < _count; ++i) {
+		ZRECT r = _src[i];
+		Float aw = _mat->a * r.w, bw = _mat->b * r.w;
+		Float ch = _mat->c * r.h, dh = _mat->d * r.h;
+		_dst[i].x = _mat->a * r.x + _mat->c * r.y + _mat->tx +
+			Z_Min(aw, 0) + Z_Min(ch, 0);
+		_dst[i].y = _mat->b * r.x + _mat->d * r.y + _mat->ty +
+			Z_Min(bw, 0) + Z_Min(dh, 0);
+		_dst[i].w = fabsf(aw) + fabsf(ch);
+		_dst[i].h = fabsf(bw) + fabsf(dh);
+	}
+}
+/*****************************************************************************/  
+//EOF
+/*****************************************************************************/  
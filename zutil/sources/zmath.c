@@ -26,6 +26,7 @@ freely, subject to the following restrictions:
 ******************************************************************************/ 
 #include "zutil/zvec2.h"
 #include "zutil/zmath.h"
+#include "zutil/zrng.h"
 
 
 
@@ -149,12 +150,14 @@ ZMath_AngleSubtract(
 Int32 
 ZMath_BitCount(
 	_In_ Int32 x) {
+	return Z_POPCOUNT32((Uint32)x);
+}
+
 
-	x -= ((x >> 0x01) & 0x55555555);
-	x = (((x >> 0x02) & 0x33333333) + (x & 0x33333333));
-	x = (((x >> 0x04) + x) & 0x0F0F0F0F);
-	x += (x >> 0x08);
-	return ((x + (x >> 0x10)) & 0x0000003F);
+Int32 
+ZMath_BitCountU64(
+	_In_ Uint64 x) {
+	return Z_POPCOUNT64(x);
 }
 
 
@@ -162,11 +165,35 @@ Int32
 ZMath_BitReverse(
 	_In_ Int32 x) {
 
-	x = (((x >> 0x01) & 0x55555555) | ((x & 0x55555555) << 0x01));
-	x = (((x >> 0x02) & 0x33333333) | ((x & 0x33333333) << 0x02));
-	x = (((x >> 0x04) & 0x0F0F0F0F) | ((x & 0x0F0F0F0F) << 0x04));
-	x = (((x >> 0x08) & 0x00FF00FF) | ((x & 0x00FF00FF) << 0x08));
-	return ((x >> 0x10) | (x << 0x10));
+#if defined(Z_BITREVERSE32)
+	return (Int32)Z_BITREVERSE32((Uint32)x);
+#else
+	Uint32 u;
+	u = Z_BSWAP32((Uint32)x); //bytes reversed, then bits within them
+	u = ((u >> 0x04) & 0x0F0F0F0F) | ((u & 0x0F0F0F0F) << 0x04);
+	u = ((u >> 0x02) & 0x33333333) | ((u & 0x33333333) << 0x02);
+	u = ((u >> 0x01) & 0x55555555) | ((u & 0x55555555) << 0x01);
+	return (Int32)u;
+#endif
+}
+
+
+Uint64 
+ZMath_BitReverseU64(
+	_In_ Uint64 x) {
+
+#if defined(Z_BITREVERSE64)
+	return Z_BITREVERSE64(x);
+#else
+	x = Z_BSWAP64(x);
+	x = ((x >> 0x04) & 0x0F0F0F0F0F0F0F0Full) | 
+		((x & 0x0F0F0F0F0F0F0F0Full) << 0x04);
+	x = ((x >> 0x02) & 0x3333333333333333ull) | 
+		((x & 0x3333333333333333ull) << 0x02);
+	x = ((x >> 0x01) & 0x5555555555555555ull) | 
+		((x & 0x5555555555555555ull) << 0x01);
+	return x;
+#endif
 }
 
 
@@ -188,17 +215,26 @@ Int32
 ZMath_CeilPowerOf2(
 	_In_ Int32 x) {
 
-	x--;
-	x |= x >> 0x01;
-	x |= x >> 0x02;
-	x |= x >> 0x04;
-	x |= x >> 0x08;
-	x |= x >> 0x10;
-	x++;
-	return x;
+	if (x <= 1)
+		return (x == 1);
+	if (x > 0x40000000)
+		return 0;
+	return (Int32)(1u << (32 - Z_CLZ32((Uint32)x - 1)));
 } 
 
 
+Uint64 
+ZMath_CeilPowerOf2U64(
+	_In_ Uint64 x) {
+
+	if (x <= 1)
+		return x;
+	if (x > 0x8000000000000000ull)
+		return 0;
+	return 1ull << (64 - Z_CLZ64(x - 1));
+}
+
+
 Float
 ZMath_Fabs(
 	_In_ Float x) {
@@ -214,16 +250,22 @@ Int32
 ZMath_FloorPowerOf2(
 	_In_ Int32 x) {
 
-	x |= x >> 0x01;
-	x |= x >> 0x02;
-	x |= x >> 0x04;
-	x |= x >> 0x08;
-	x |= x >> 0x10;
-	x++;
-	return x >> 0x01;
+	if (x <= 0)
+		return 0;
+	return (Int32)(1u << (31 - Z_CLZ32((Uint32)x)));
 } 
 
 
+Uint64 
+ZMath_FloorPowerOf2U64(
+	_In_ Uint64 x) {
+
+	if (x == 0)
+		return 0;
+	return 1ull << (63 - Z_CLZ64(x));
+}
+
+
 Float 
 ZMath_Fraction(
 	_In_ Float x) {
@@ -254,10 +296,17 @@ ZMath_Log2f(
 Int32 
 ZMath_Log2i(
 	_In_ Int32 x) { 
-	return ZMath_Log2f((Float)x);
+	return (x > 0) ? 31 - Z_CLZ32((Uint32)x) : -1;
 } 
 
 
+Int32 
+ZMath_Log2U64(
+	_In_ Uint64 x) { 
+	return x ? 63 - Z_CLZ64(x) : -1;
+}
+
+
 Int32 
 ZMath_MaskForFloatSign(
 	_In_ Float x) { 
@@ -350,12 +399,14 @@ ZMath_Easing(
 		return _f * _f * (2.70158f * _f - 1.70158f);
 
 	case ZMATH_EASING_BACKOUT:
-		return 1.f + (--_f) * _f * (2.70158f * _f + 1.70158f);
+		_f -= 1.f;
+		return 1.f + _f * _f * (2.70158f * _f + 1.70158f);
 
 	case ZMATH_EASING_BACKINOUT:
 		if (_f < 0.5f)
 			return _f * _f * (7.f * _f - 2.5f) * 2.f;
-		return 1.f + (--_f) * _f * 2.f * (7.f * _f + 2.5f);
+		_f -= 1.f;
+		return 1.f + _f * _f * 2.f * (7.f * _f + 2.5f);
 
 	case ZMATH_EASING_CIRCIN:
 		return 1.f - sqrtf(1.f - _f);
@@ -384,7 +435,8 @@ ZMath_Easing(
 		return _f * f2 * f2;
 
 	case ZMATH_EASING_QUINTOUT:
-		f2 = (--_f) * _f;
+		_f -= 1.f;
+		f2  = _f * _f;
 		return 1.f + _f * f2 * f2;
 
 	case ZMATH_EASING_QUINTINOUT:
@@ -392,14 +444,15 @@ ZMath_Easing(
 			f2 = _f * _f;
 			return 16.f * _f * f2 * f2;
 		}
-		f2 = (--_f) * _f;
+		_f -= 1.f;
+		f2  = _f * _f;
 		return 1.f + 16.f * _f * f2 * f2;
 
 	case ZMATH_EASING_SINEIN:
 		return sinf(1.5707963f * _f);
 
 	case ZMATH_EASING_SINEOUT:
-		return 1 + sinf(1.5707963f * (--_f));
+		return 1 + sinf(1.5707963f * (_f - 1.f));
 
 	case ZMATH_EASING_SINEINOUT:
 		return 0.5f * (1 + sinf(ZMATH_PI * (_f - 0.5f)));
@@ -419,19 +472,21 @@ ZMath_Easing(
 		return _f * _f * _f;
 
 	case ZMATH_EASING_CUBICOUT:
-		return 1.f + (--_f) * _f * _f;
+		_f -= 1.f;
+		return 1.f + _f * _f * _f;
 
 	case ZMATH_EASING_CUBICINOUT:
 		if (_f < 0.5f)
 			return 4.f * _f * _f * _f;
-		return 1.f + (--_f) * (2.f * (--_f)) * (2.f * _f);
+		_f -= 1.f;
+		return 1.f + 4.f * _f * _f * _f;
 
 	case ZMATH_EASING_QUARTIN:
 		_f *= _f;
 		return _f * _f;
 
 	case ZMATH_EASING_QUARTOUT:
-		_f = (--_f) * _f;
+		_f = (_f - 1.f) * (_f - 1.f);
 		return 1.f - _f * _f;
 
 	case ZMATH_EASING_QUARTINOUT:
@@ -439,7 +494,7 @@ ZMath_Easing(
 			_f *= _f;
 			return 8.f * _f * _f;
 		}
-		_f = (--_f) * _f;
+		_f = (_f - 1.f) * (_f - 1.f);
 		return 1.f - 8.f * _f * _f;
 	} 
 	return _f; 
@@ -453,16 +508,15 @@ ZMath_Easing(
 Random Numbers
 ******************************************************************************/
 #define	Z_ONE    0x3F800000UL 
-#define	Z_MASK   0x007FFFFFUL 
-#define ZMAXRAND 0x7FFF
 
-static Dword m_seed;
+static THREADLOCAL Dword m_seed;
 
 
 Void
 ZMath_SetRandSeed(
 	_In_ Dword _dwSeed) { 
 	m_seed = _dwSeed;
+	ZRng_Init(ZRng_GetDefault(), ZRNG_XOSHIRO256PP, _dwSeed);
 }
 
 
@@ -476,16 +530,10 @@ Int32
 ZMath_RandInt(
 	_In_ Int32 _iMaxValue) {
 
-	Int32 iResult;
-	if (_iMaxValue == 0) {
-		return 0; //(prevent divide by zero)
+	if (_iMaxValue <= 0) {
+		return 0; //(empty range)
 	}
-	m_seed =
-		1664525L * m_seed + 1013904223L;
-	iResult = ((Int32)m_seed & ZMAXRAND);
-	iResult = (iResult >>
-		      (0x10 - ZMath_BitsForInteger(_iMaxValue))) % _iMaxValue;
-	return iResult;
+	return (Int32)ZRng_Bounded(ZRng_GetDefault(), (Uint32)_iMaxValue);
 }  
 	 
 
@@ -495,8 +543,7 @@ ZMath_RandFloat(
 
 	Float fResult;
 	Dword dwRand;
-	m_seed = 1664525L * m_seed + 1013904223L;
-	dwRand = Z_ONE | (m_seed & Z_MASK);
+	dwRand = Z_ONE | (ZRng_NextU32(ZRng_GetDefault()) >> 9);
 	if (_signed)
 		fResult = (2.0f * (*(Float*)&dwRand) - 3.0f);
 	else fResult = ((*(Float*)&dwRand) - 1.0f);
@@ -506,30 +553,7 @@ ZMath_RandFloat(
 
 Byte 
 ZMath_RandByte(Void) {
-	static Byte randbytes[] = {
-	    0,   8, 109, 220, 222, 241, 149, 107,  75, 248, 254, 140,  16,  66,
-	    74,  21, 211,  47,  80, 242, 154,  27, 205, 128, 161,  89,  77,  36,
-	    95, 110,  85,  48, 212, 140, 211, 249,  22,  79, 200,  50,  28, 188,
-	    52, 140, 202, 120,  68, 145,  62,  70, 184, 190,  91, 197, 152, 224,
-	    149, 104,  25, 178, 252, 182, 202, 182, 141, 197,   4,  81, 181, 242,
-	    145,  42,  39, 227, 156, 198, 225, 193, 219,  93, 122, 175, 249,   0,
-	    175, 143,  70, 239,  46, 246, 163,  53, 163, 109, 168, 135,   2, 235,
-	    25,  92,  20, 145, 138,  77,  69, 166,  78, 176, 173, 212, 166, 113,
-	    94, 161,  41,  50, 239,  49, 111, 164,  70,  60,   2,  37, 171,  75,
-	    136, 156,  11,  56,  42, 146, 138, 229,  73, 146,  77,  61,  98, 196,
-	    135, 106,  63, 197, 195,  86,  96, 203, 113, 101, 170, 247, 181, 113,
-	    80, 250, 108,   7, 255, 237, 129, 226,  79, 107, 112, 166, 103, 241,
-	    24, 223, 239, 120, 198,  58,  60,  82, 128,   3, 184,  66, 143, 224,
-	    145, 224,  81, 206, 163,  45,  63,  90, 168, 114,  59,  33, 159,  95,
-	    28, 139, 123,  98, 125, 196,  15,  70, 194, 253,  54,  14, 109, 226,
-	    71,  17, 161,  93, 186,  87, 244, 138,  20,  52, 123, 251,  26,  36,
-	    17,  46,  52, 231, 232,  76,  31, 221,  84,  37, 216, 165, 212, 106,
-	    197, 242,  98,  43,  39, 175, 254, 145, 190,  84, 118, 222, 187, 136,
-	    120, 163, 236, 249
-	};
-	static Int32 idx;
-	idx = (idx + 1) & 0xFF;
-	return randbytes[idx];
+	return (Byte)(ZRng_NextU32(ZRng_GetDefault()) >> 24);
 }
 /*****************************************************************************/  
 //EOF
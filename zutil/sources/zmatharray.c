@@ -0,0 +1,525 @@
+/******************************************************************************
+* zutil - C Utility Library
+* Copyright (C) 2017-2021 Zachary T Harris. All Rights Reserved.  
+* Zlib license.
+* 
+* File: zmatharray.c
+* Desc: Batch transcendental and reciprocal functions over Float arrays
+*******************************************************************************
+
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+******************************************************************************/ 
+#include <float.h>
+#include <math.h>
+#include <string.h>
+#include "zutil/zsimd.h"
+#include "zutil/zmatharray.h"
+
+
+
+#define ZMathArray_K(c) ZSimd_Set1(c)
+#define ZMATHARRAY_SINCOS_MAX 8192.0f //largest |x| reduced in vectors
+
+
+
+/* Section 1:
+** kernels
+******************************************************************************/
+/*
+Sine and cosine of the lanes past ZMATHARRAY_SINCOS_MAX (infinities
+included), left to the C library: its reduction is exact at any 
+magnitude, where the vector one would leave z far outside [-pi/4, 
+pi/4] and ZSimd_Floor out of its range*/
+static Void
+ZMathArray_SinCosLarge(
+	_In_    ZSIMDF  _x,
+	_Inout_ ZSIMDF* _lpSin,
+	_Inout_ ZSIMDF* _lpCos) {
+
+	Float x[ZSIMD_LANES], s[ZSIMD_LANES], c[ZSIMD_LANES];
+	SizeT k;
+	ZSimd_Store(x, _x);
+	ZSimd_Store(s, *_lpSin);
+	ZSimd_Store(c, *_lpCos);
+	for (k = 0; k < ZSIMD_LANES; k++) {
+		if (fabsf(x[k]) > ZMATHARRAY_SINCOS_MAX) {
+			s[k] = sinf(x[k]);
+			c[k] = cosf(x[k]);
+		}
+	}
+	*_lpSin = ZSimd_Load(s);
+	*_lpCos = ZSimd_Load(c);
+}
+
+
+/*
+Sine and cosine after Cephes sinf/cosf: the argument is reduced by 
+multiples of pi/2 to [-pi/4, pi/4] (in three parts when accurate, so
+the reduction stays exact up to |x| = 8192) and both polynomials are 
+evaluated, the octant choosing which one is the sine. Larger |x| go
+to ZMathArray_SinCosLarge, at the cost of a branch per vector. With a
+constant _fast and an unused output, inlining drops the work for that
+output*/
+static FORCEINLINE Void
+ZMathArray_SinCosV(
+	_In_  ZSIMDF  _x,
+	_In_  Bool    _fast,
+	_Out_ ZSIMDF* _lpSin,
+	_Out_ ZSIMDF* _lpCos) {
+
+	ZSIMDF ax, j, q, z, zz, ps, pc, swap, one, neg;
+	one = ZMathArray_K(1.0f);
+	neg = ZMathArray_K(-1.0f);
+	ax  = ZSimd_Abs(_x);
+	j   = ZSimd_Floor(ZSimd_Mul(ax, ZMathArray_K(1.27323954473516f)));
+	j   = ZSimd_Floor(ZSimd_MulAdd(j, ZMathArray_K(0.5f), ZMathArray_K(0.5f)));
+	j   = ZSimd_Add(j, j); //odd octants round up to even
+	q   = ZSimd_Mul(j, ZMathArray_K(0.5f));
+	q   = ZSimd_Sub(q, ZSimd_Mul(ZMathArray_K(4.0f), 
+		ZSimd_Floor(ZSimd_Mul(q, ZMathArray_K(0.25f))))); //octant pair 0..3
+	if (_fast)
+		z = ZSimd_Sub(ax, ZSimd_Mul(j, ZMathArray_K(0.785398163397448f)));
+	else {
+		z = ZSimd_Sub(ax, ZSimd_Mul(j, ZMathArray_K(0.78515625f)));
+		z = ZSimd_Sub(z, ZSimd_Mul(j, ZMathArray_K(2.4187564849853515625e-4f)));
+		z = ZSimd_Sub(z, ZSimd_Mul(j, ZMathArray_K(3.77489497744594108e-8f)));
+	}
+	zz = ZSimd_Mul(z, z);
+	if (_fast) {
+		ps = ZSimd_MulAdd(zz, ZMathArray_K(8.152991966e-3f), 
+			ZMathArray_K(-1.666283379e-1f));
+		pc = ZSimd_MulAdd(zz, ZMathArray_K(4.048893681e-2f), 
+			ZMathArray_K(-4.997763076e-1f));
+	}
+	else {
+		ps = ZSimd_MulAdd(zz, ZMathArray_K(-1.9515295891e-4f), 
+			ZMathArray_K(8.3321608736e-3f));
+		ps = ZSimd_MulAdd(ps, zz, ZMathArray_K(-1.6666654611e-1f));
+		pc = ZSimd_MulAdd(zz, ZMathArray_K(2.443315711809948e-5f), 
+			ZMathArray_K(-1.388731625493765e-3f));
+		pc = ZSimd_MulAdd(pc, zz, ZMathArray_K(4.166664568298827e-2f));
+		pc = ZSimd_MulAdd(pc, zz, ZMathArray_K(-0.5f));
+	}
+	ps   = ZSimd_MulAdd(ZSimd_Mul(ps, zz), z, z);
+	pc   = ZSimd_MulAdd(pc, zz, one);
+	swap = ZSimd_CmpGt(ZSimd_Sub(q, ZSimd_Mul(ZMathArray_K(2.0f),
+		ZSimd_Floor(ZSimd_Mul(q, ZMathArray_K(0.5f))))), ZMathArray_K(0.5f));
+	*_lpSin = ZSimd_Mul(ZSimd_Select(swap, pc, ps), ZSimd_Mul(
+		ZSimd_Select(ZSimd_CmpGt(q, ZMathArray_K(1.5f)), neg, one),
+		ZSimd_Select(ZSimd_CmpGt(ZMathArray_K(0.0f), 
+			ZSimd_CopySign(one, _x)), neg, one))); //sin(-0) = -0
+	*_lpCos = ZSimd_Mul(ZSimd_Select(swap, ps, pc), ZSimd_Select(
+		ZSimd_And(ZSimd_CmpGt(q, ZMathArray_K(0.5f)),
+			ZSimd_CmpLe(q, ZMathArray_K(2.5f))), neg, one));
+	if (ZSimd_MoveMask(ZSimd_CmpGt(ax, ZMathArray_K(ZMATHARRAY_SINCOS_MAX))))
+		ZMathArray_SinCosLarge(_x, _lpSin, _lpCos);
+}
+
+
+/*
+e^x after Cephes expf: x = n ln2 + r with |r| <= ln2 / 2, e^r by a 
+polynomial, and 2^n applied in two halves so that results near the 
+overflow and denormal ends are still scaled correctly*/
+static FORCEINLINE ZSIMDF
+ZMathArray_ExpV(
+	_In_ ZSIMDF _x,
+	_In_ Bool   _fast) {
+
+	ZSIMDF x, n, r, p, h;
+	x = ZSimd_Min(ZSimd_Max(_x, ZMathArray_K(-104.0f)), ZMathArray_K(89.0f));
+	n = ZSimd_Floor(ZSimd_MulAdd(x, ZMathArray_K(1.44269504088896341f), 
+		ZMathArray_K(0.5f)));
+	if (_fast) {
+		r = ZSimd_Sub(ZSimd_Mul(x, ZMathArray_K(1.44269504088896341f)), n);
+		p = ZSimd_MulAdd(r, ZMathArray_K(9.681756350e-3f), 
+			ZMathArray_K(5.591975024e-2f));
+		p = ZSimd_MulAdd(p, r, ZMathArray_K(2.402202433e-1f));
+		p = ZSimd_MulAdd(p, r, ZMathArray_K(6.931215158e-1f));
+		p = ZSimd_MulAdd(p, r, ZMathArray_K(1.0f));
+	}
+	else {
+		r = ZSimd_Sub(x, ZSimd_Mul(n, ZMathArray_K(0.693359375f)));
+		r = ZSimd_Sub(r, ZSimd_Mul(n, ZMathArray_K(-2.12194440e-4f)));
+		p = ZSimd_MulAdd(r, ZMathArray_K(1.9875691500e-4f), 
+			ZMathArray_K(1.3981999507e-3f));
+		p = ZSimd_MulAdd(p, r, ZMathArray_K(8.3334519073e-3f));
+		p = ZSimd_MulAdd(p, r, ZMathArray_K(4.1665795894e-2f));
+		p = ZSimd_MulAdd(p, r, ZMathArray_K(1.6666665459e-1f));
+		p = ZSimd_MulAdd(p, r, ZMathArray_K(5.0000001201e-1f));
+		p = ZSimd_MulAdd(ZSimd_Mul(p, r), r, ZSimd_Add(r, ZMathArray_K(1.0f)));
+	}
+	h = ZSimd_Floor(ZSimd_Mul(n, ZMathArray_K(0.5f)));
+	p = ZSimd_Mul(ZSimd_Mul(p, ZSimd_Pow2i(h)), ZSimd_Pow2i(ZSimd_Sub(n, h)));
+	return ZSimd_Select(ZSimd_CmpLe(_x, _x), p, _x); //NaN stays NaN
+}
+
+
+/*
+ln(x) after Cephes logf: x = 2^e * m with m in [sqrt(1/2), sqrt(2)), 
+ln(m) by a polynomial in m - 1 and e ln2 added in two parts. Denormals
+are scaled up first; zero, negative, infinite and NaN inputs give 
+-inf, NaN, inf and NaN*/
+static FORCEINLINE ZSIMDF
+ZMathArray_LogV(
+	_In_ ZSIMDF _x,
+	_In_ Bool   _fast) {
+
+	ZSIMDF x, e, m, r, rr, p, tiny, big;
+	tiny = ZSimd_CmpGt(ZMathArray_K(FLT_MIN), _x);
+	x = ZSimd_Select(tiny, ZSimd_Mul(_x, ZMathArray_K(8388608.0f)), _x);
+	e = ZSimd_Sub(ZSimd_Exponent(x), 
+		ZSimd_And(tiny, ZMathArray_K(23.0f)));
+	m = ZSimd_Mantissa(x);
+	big = ZSimd_CmpGt(m, ZMathArray_K(ZMATH_SQRT2));
+	r = ZSimd_Sub(ZSimd_Select(big, ZSimd_Mul(m, ZMathArray_K(0.5f)), m), 
+		ZMathArray_K(1.0f));
+	e = ZSimd_Add(e, ZSimd_And(big, ZMathArray_K(1.0f)));
+	rr = ZSimd_Mul(r, r);
+	if (_fast) {
+		p = ZSimd_MulAdd(r, ZMathArray_K(1.751292236e-1f), 
+			ZMathArray_K(-2.734986006e-1f));
+		p = ZSimd_MulAdd(p, r, ZMathArray_K(3.373453488e-1f));
+		p = ZSimd_MulAdd(p, r, ZMathArray_K(-4.992335839e-1f));
+		p = ZSimd_MulAdd(p, r, ZMathArray_K(9.999188731e-1f));
+		p = ZSimd_MulAdd(p, r, ZSimd_Mul(e, ZMathArray_K(ZMATH_LN2)));
+	}
+	else {
+		p = ZSimd_MulAdd(r, ZMathArray_K(7.0376836292e-2f), 
+			ZMathArray_K(-1.1514610310e-1f));
+		p = ZSimd_MulAdd(p, r, ZMathArray_K(1.1676998740e-1f));
+		p = ZSimd_MulAdd(p, r, ZMathArray_K(-1.2420140846e-1f));
+		p = ZSimd_MulAdd(p, r, ZMathArray_K(1.4249322787e-1f));
+		p = ZSimd_MulAdd(p, r, ZMathArray_K(-1.6668057665e-1f));
+		p = ZSimd_MulAdd(p, r, ZMathArray_K(2.0000714765e-1f));
+		p = ZSimd_MulAdd(p, r, ZMathArray_K(-2.4999993993e-1f));
+		p = ZSimd_MulAdd(p, r, ZMathArray_K(3.3333331174e-1f));
+		p = ZSimd_Mul(ZSimd_Mul(p, r), rr);
+		p = ZSimd_MulAdd(e, ZMathArray_K(-2.12194440e-4f), p);
+		p = ZSimd_MulAdd(rr, ZMathArray_K(-0.5f), p);
+		p = ZSimd_MulAdd(e, ZMathArray_K(0.693359375f), ZSimd_Add(r, p));
+	}
+	p = ZSimd_Select(ZSimd_CmpGt(_x, ZMathArray_K(FLT_MAX)), 
+		ZMathArray_K(INFINITY), p);
+	p = ZSimd_Select(ZSimd_CmpGt(_x, ZMathArray_K(0.0f)), p, 
+		ZSimd_Select(ZSimd_CmpGt(ZMathArray_K(0.0f), _x), 
+			ZMathArray_K(NAN), ZMathArray_K(-INFINITY)));
+	return ZSimd_Select(ZSimd_CmpLe(_x, _x), p, _x);
+}
+
+
+/*
+atan2(y, x) after Cephes atanf: the ratio of the smaller to the 
+larger magnitude, in [0, 1], goes through an odd polynomial (after a
+reduction past tan(pi/8) when accurate), then the octant is restored.
+The half plane and the sign come from the sign bits of x and y, so 
+that zeros follow the C library: atan2(+-0, -0) = +-pi and 
+atan2(+-0, +0) = +-0*/
+static FORCEINLINE ZSIMDF
+ZMathArray_Atan2V(
+	_In_ ZSIMDF _y,
+	_In_ ZSIMDF _x,
+	_In_ Bool   _fast) {
+
+	ZSIMDF ax, ay, mn, mx, t, z, r, big, zero;
+	zero = ZMathArray_K(0.0f);
+	ax = ZSimd_Abs(_x);
+	ay = ZSimd_Abs(_y);
+	mn = ZSimd_Min(ax, ay);
+	mx = ZSimd_Max(ax, ay);
+	if (_fast) { //estimate refined by one Newton step
+		t = ZSimd_RcpEst(mx);
+		t = ZSimd_Mul(t, ZSimd_Sub(ZMathArray_K(2.0f), ZSimd_Mul(mx, t)));
+		t = ZSimd_Mul(mn, t);
+	}
+	else t = ZSimd_Div(mn, mx);
+	t = ZSimd_Select(ZSimd_CmpGt(mx, zero), t, zero); //atan2(0, 0) = 0
+	t = ZSimd_Select(ZSimd_CmpGt(mn, ZMathArray_K(FLT_MAX)), 
+		ZMathArray_K(1.0f), t); //both infinite
+	t = ZSimd_Min(t, ZMathArray_K(1.0f));
+	if (_fast) {
+		z = ZSimd_Mul(t, t);
+		r = ZSimd_MulAdd(z, ZMathArray_K(2.084509605e-2f), 
+			ZMathArray_K(-8.515633047e-2f));
+		r = ZSimd_MulAdd(r, z, ZMathArray_K(1.801593021e-1f));
+		r = ZSimd_MulAdd(r, z, ZMathArray_K(-3.303047980e-1f));
+		r = ZSimd_MulAdd(r, z, ZMathArray_K(9.998663320e-1f));
+		r = ZSimd_Mul(r, t);
+	}
+	else {
+		big = ZSimd_CmpGt(t, ZMathArray_K(0.414213562373095f));
+		t = ZSimd_Select(big, ZSimd_Div(ZSimd_Sub(t, ZMathArray_K(1.0f)),
+			ZSimd_Add(t, ZMathArray_K(1.0f))), t);
+		z = ZSimd_Mul(t, t);
+		r = ZSimd_MulAdd(z, ZMathArray_K(8.05374449538e-2f), 
+			ZMathArray_K(-1.38776856032e-1f));
+		r = ZSimd_MulAdd(r, z, ZMathArray_K(1.99777106478e-1f));
+		r = ZSimd_MulAdd(r, z, ZMathArray_K(-3.33329491539e-1f));
+		r = ZSimd_MulAdd(ZSimd_Mul(r, z), t, t);
+		r = ZSimd_Add(r, ZSimd_And(big, ZMathArray_K(ZMATH_PI4)));
+	}
+	r = ZSimd_Select(ZSimd_CmpGt(ay, ax), 
+		ZSimd_Sub(ZMathArray_K(ZMATH_PI2), r), r);
+	r = ZSimd_Select(ZSimd_CmpGt(zero, ZSimd_CopySign(ZMathArray_K(1.0f), _x)),
+		ZSimd_Sub(ZMathArray_K(ZMATH_PI), r), r);
+	r = ZSimd_CopySign(r, _y);
+	return ZSimd_Select(ZSimd_And(ZSimd_CmpLe(_x, _x), ZSimd_CmpLe(_y, _y)),
+		r, ZSimd_Add(_x, _y));
+}
+
+
+static FORCEINLINE ZSIMDF
+ZMathArray_SinAccurate(ZSIMDF _x) {
+	ZSIMDF s, c;
+	ZMathArray_SinCosV(_x, Z_FALSE, &s, &c);
+	return s;
+}
+
+static FORCEINLINE ZSIMDF
+ZMathArray_SinFast(ZSIMDF _x) {
+	ZSIMDF s, c;
+	ZMathArray_SinCosV(_x, Z_TRUE, &s, &c);
+	return s;
+}
+
+static FORCEINLINE ZSIMDF
+ZMathArray_CosAccurate(ZSIMDF _x) {
+	ZSIMDF s, c;
+	ZMathArray_SinCosV(_x, Z_FALSE, &s, &c);
+	return c;
+}
+
+static FORCEINLINE ZSIMDF
+ZMathArray_CosFast(ZSIMDF _x) {
+	ZSIMDF s, c;
+	ZMathArray_SinCosV(_x, Z_TRUE, &s, &c);
+	return c;
+}
+
+static FORCEINLINE ZSIMDF
+ZMathArray_ExpAccurate(ZSIMDF _x) {
+	return ZMathArray_ExpV(_x, Z_FALSE);
+}
+
+static FORCEINLINE ZSIMDF
+ZMathArray_ExpFast(ZSIMDF _x) {
+	return ZMathArray_ExpV(_x, Z_TRUE);
+}
+
+static FORCEINLINE ZSIMDF
+ZMathArray_LogAccurate(ZSIMDF _x) {
+	return ZMathArray_LogV(_x, Z_FALSE);
+}
+
+static FORCEINLINE ZSIMDF
+ZMathArray_LogFast(ZSIMDF _x) {
+	return ZMathArray_LogV(_x, Z_TRUE);
+}
+
+static FORCEINLINE ZSIMDF
+ZMathArray_RsqrtAccurate(ZSIMDF _x) {
+	return ZSimd_Div(ZMathArray_K(1.0f), ZSimd_Sqrt(_x));
+}
+
+static FORCEINLINE ZSIMDF
+ZMathArray_RsqrtFast(ZSIMDF _x) {
+	return ZSimd_RsqrtEst(_x);
+}
+
+static FORCEINLINE ZSIMDF
+ZMathArray_RcpAccurate(ZSIMDF _x) {
+	return ZSimd_Div(ZMathArray_K(1.0f), _x);
+}
+
+static FORCEINLINE ZSIMDF
+ZMathArray_RcpFast(ZSIMDF _x) {
+	return ZSimd_RcpEst(_x);
+}
+
+
+
+
+/* Section 2:
+** array loops
+******************************************************************************/
+/*
+Runs a one input kernel over an array. Inlined with a constant 
+_kernel, each call becomes a loop with the kernel inlined in its body.
+The last partial vector goes through a copy padded with ones*/
+static FORCEINLINE Void
+ZMathArray_Run(
+	_In_  ZSIMDF      (*_kernel)(ZSIMDF),
+	_In_  const Float* _src,
+	_Out_ Float*       _dst,
+	_In_  SizeT        _count) {
+
+	Float tail[ZSIMD_LANES];
+	SizeT i, k, rest;
+	for (i = 0; i + ZSIMD_LANES <= _count; i += ZSIMD_LANES)
+		ZSimd_Store(_dst + i, _kernel(ZSimd_Load(_src + i)));
+	rest = _count - i;
+	if (rest) {
+		for (k = 0; k < ZSIMD_LANES; k++)
+			tail[k] = (k < rest) ? _src[i + k] : 1.0f;
+		ZSimd_Store(tail, _kernel(ZSimd_Load(tail)));
+		memcpy(_dst + i, tail, rest * sizeof(Float));
+	}
+}
+
+
+#define ZMATHARRAY_RUN(name)\
+	if (_precision == ZMATHARRAY_FAST)\
+		ZMathArray_Run(ZMathArray_##name##Fast, _src, _dst, _count);\
+	else ZMathArray_Run(ZMathArray_##name##Accurate, _src, _dst, _count)
+
+
+
+
+/* Section 3:
+** public
+******************************************************************************/
+Void
+ZMathArray_Sin(
+	_In_  const Float*         _src,
+	_Out_ Float*               _dst,
+	_In_  SizeT                _count,
+	_In_  ZMATHARRAY_PRECISION _precision) {
+
+	ZMATHARRAY_RUN(Sin);
+}
+
+
+Void
+ZMathArray_Cos(
+	_In_  const Float*         _src,
+	_Out_ Float*               _dst,
+	_In_  SizeT                _count,
+	_In_  ZMATHARRAY_PRECISION _precision) {
+
+	ZMATHARRAY_RUN(Cos);
+}
+
+
+Void
+ZMathArray_SinCos(
+	_In_  const Float*         _src,
+	_Out_ Float*               _sin,
+	_Out_ Float*               _cos,
+	_In_  SizeT                _count,
+	_In_  ZMATHARRAY_PRECISION _precision) {
+
+	Float tail[ZSIMD_LANES], tailc[ZSIMD_LANES];
+	ZSIMDF s, c;
+	SizeT i, k, rest;
+	Bool fast = (_precision == ZMATHARRAY_FAST);
+	for (i = 0; i + ZSIMD_LANES <= _count; i += ZSIMD_LANES) {
+		if (fast)
+			ZMathArray_SinCosV(ZSimd_Load(_src + i), Z_TRUE, &s, &c);
+		else ZMathArray_SinCosV(ZSimd_Load(_src + i), Z_FALSE, &s, &c);
+		ZSimd_Store(_sin + i, s);
+		ZSimd_Store(_cos + i, c);
+	}
+	rest = _count - i;
+	if (rest) {
+		for (k = 0; k < ZSIMD_LANES; k++)
+			tail[k] = (k < rest) ? _src[i + k] : 0.0f;
+		ZMathArray_SinCosV(ZSimd_Load(tail), fast, &s, &c);
+		ZSimd_Store(tail, s);
+		ZSimd_Store(tailc, c);
+		memcpy(_sin + i, tail, rest * sizeof(Float));
+		memcpy(_cos + i, tailc, rest * sizeof(Float));
+	}
+}
+
+
+Void
+ZMathArray_Atan2(
+	_In_  const Float*         _y,
+	_In_  const Float*         _x,
+	_Out_ Float*               _dst,
+	_In_  SizeT                _count,
+	_In_  ZMATHARRAY_PRECISION _precision) {
+
+	Float taily[ZSIMD_LANES], tailx[ZSIMD_LANES];
+	SizeT i, k, rest;
+	Bool fast = (_precision == ZMATHARRAY_FAST);
+	for (i = 0; i + ZSIMD_LANES <= _count; i += ZSIMD_LANES) {
+		if (fast)
+			ZSimd_Store(_dst + i, ZMathArray_Atan2V(ZSimd_Load(_y + i),
+				ZSimd_Load(_x + i), Z_TRUE));
+		else ZSimd_Store(_dst + i, ZMathArray_Atan2V(ZSimd_Load(_y + i),
+			ZSimd_Load(_x + i), Z_FALSE));
+	}
+	rest = _count - i;
+	if (rest) {
+		for (k = 0; k < ZSIMD_LANES; k++) {
+			taily[k] = (k < rest) ? _y[i + k] : 0.0f;
+			tailx[k] = (k < rest) ? _x[i + k] : 1.0f;
+		}
+		ZSimd_Store(taily, ZMathArray_Atan2V(ZSimd_Load(taily),
+			ZSimd_Load(tailx), fast));
+		memcpy(_dst + i, taily, rest * sizeof(Float));
+	}
+}
+
+
+Void
+ZMathArray_Exp(
+	_In_  const Float*         _src,
+	_Out_ Float*               _dst,
+	_In_  SizeT                _count,
+	_In_  ZMATHARRAY_PRECISION _precision) {
+
+	ZMATHARRAY_RUN(Exp);
+}
+
+
+Void
+ZMathArray_Log(
+	_In_  const Float*         _src,
+	_Out_ Float*               _dst,
+	_In_  SizeT                _count,
+	_In_  ZMATHARRAY_PRECISION _precision) {
+
+	ZMATHARRAY_RUN(Log);
+}
+
+
+Void
+ZMathArray_Rsqrt(
+	_In_  const Float*         _src,
+	_Out_ Float*               _dst,
+	_In_  SizeT                _count,
+	_In_  ZMATHARRAY_PRECISION _precision) {
+
+	ZMATHARRAY_RUN(Rsqrt);
+}
+
+
+Void
+ZMathArray_Rcp(
+	_In_  const Float*         _src,
+	_Out_ Float*               _dst,
+	_In_  SizeT                _count,
+	_In_  ZMATHARRAY_PRECISION _precision) {
+
+	ZMATHARRAY_RUN(Rcp);
+}
+
+/*****************************************************************************/  
+//EOF
+/*****************************************************************************/  
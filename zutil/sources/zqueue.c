@@ -39,23 +39,61 @@ struct _ZQueue {
 	SizeT       datasize;
 	ZQueueData* head;
 	ZQueueData* tail;
+	ZArena*     arena; //arena the elements come from, or NULL for the heap
 };
 
+//size of an arena element, rounded up so that the data after it is aligned
+#define ZQUEUE_HEADERSIZE \
+	((sizeof(ZQueueData) + ZARENA_ALIGN - 1) & ~(SizeT)(ZARENA_ALIGN - 1))
 
 
 
 
+
+/*
+Frees an element unless it was taken from an arena*/
+static Void
+ZQueue_FreeData(
+	_In_    const ZQueue* _lpQueue,
+	_Inout_ ZQueueData*   _lpData) {
+
+	if (!_lpQueue->arena) {
+		free(_lpData->data);
+		free(_lpData);
+	}
+}
+
+
 ZQueue*
 ZQueue_Create(
 	_In_ SizeT _datasize) {
 
 	ZQueue* queue;
-	queue = (ZQueue*)malloc(sizeof(queue));
+	queue = (ZQueue*)malloc(sizeof(ZQueue));
+	if (queue != NULL) {
+		queue->datasize = _datasize;
+		queue->count    = 0;
+		queue->head     = NULL;
+		queue->tail     = NULL;
+		queue->arena    = NULL;
+	}
+	return queue;
+}
+
+
+ZQueue*
+ZQueue_CreateArena(
+	_Inout_ ZArena* _lpArena,
+	_In_    SizeT   _datasize) {
+
+	ZQueue* queue;
+	queue = ZArena_New(_lpArena, ZQueue);
 	if (queue != NULL) {
 		queue->datasize = _datasize;
 		queue->count    = 0;
 		queue->head     = NULL;
 		queue->tail     = NULL;
+		queue->arena    = _lpArena;
 	}
 	return queue;
 }
@@ -69,14 +107,25 @@ ZQueue_Push(
 	ZQueueData* newData;
 
 	if (_lpQueue != NULL) {
-		newData = (ZQueueData*)malloc(sizeof(ZQueueData));
-		if (newData == NULL) {
-			return Z_EOUTOFMEMORY;
+		if (_lpQueue->arena) {
+			//the element and its data share one allocation
+			newData = (ZQueueData*)ZArena_Alloc(_lpQueue->arena,
+				ZQUEUE_HEADERSIZE + _lpQueue->datasize, 0);
+			if (newData == NULL) {
+				return Z_EOUTOFMEMORY;
+			}
+			newData->data = (Byte*)newData + ZQUEUE_HEADERSIZE;
 		}
-		newData->data = malloc(_lpQueue->datasize);
-		if (newData->data == NULL) {
-			free(newData);
-			return Z_EOUTOFMEMORY;
+		else {
+			newData = (ZQueueData*)malloc(sizeof(ZQueueData));
+			if (newData == NULL) {
+				return Z_EOUTOFMEMORY;
+			}
+			newData->data = malloc(_lpQueue->datasize);
+			if (newData->data == NULL) {
+				free(newData);
+				return Z_EOUTOFMEMORY;
+			}
 		}
 		newData->next = NULL;
 		memcpy(newData->data, _lpData, _lpQueue->datasize);
@@ -108,8 +157,7 @@ ZQueue_Pop(
 		if (_lpQueue->count == 1) {
 			if (_lpData)
 				memcpy(_lpData, oldData->data, _lpQueue->datasize);
-			free(oldData->data);
-			free(oldData);
+			ZQueue_FreeData(_lpQueue, oldData);
 			_lpQueue->head = NULL;
 			_lpQueue->tail = NULL;
 			_lpQueue->count--;
@@ -118,8 +166,7 @@ ZQueue_Pop(
 		_lpQueue->head = _lpQueue->head->next;
 		if (_lpData)
 			memcpy(_lpData, oldData->data, _lpQueue->datasize);
-		free(oldData->data);
-		free(oldData);
+		ZQueue_FreeData(_lpQueue, oldData);
 		_lpQueue->count--;
 	}
 }
@@ -146,8 +193,7 @@ ZQueue_Clear(
 		while (!ZQueue_IsEmpty(_lpQueue)) {
 			tmp = _lpQueue->head;
 			_lpQueue->head = _lpQueue->head->next;
-			free(tmp->data);
-			free(tmp);
+			ZQueue_FreeData(_lpQueue, tmp);
 			_lpQueue->count--;
 		}
 		return Z_OK;
@@ -179,7 +225,8 @@ ZQueue_Release(
 
 	if (_lpQueue) {
 		ZQueue_Clear(_lpQueue);
-		free(_lpQueue);
+		if (!_lpQueue->arena)
+			free(_lpQueue);
 		_lpQueue = NULL;
 	}
 }
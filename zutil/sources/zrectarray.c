@@ -0,0 +1,499 @@
+/******************************************************************************
+* zutil - C Utility Library
+* Copyright (C) 2017-2021 Zachary T Harris. All Rights Reserved.  
+* Zlib license.
+* 
+* File: zrectarray.c
+* Desc: batched queries over rectangles in structure-of-arrays layout
+*******************************************************************************
+
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+******************************************************************************/ 
+#include "zutil/zmath.h"
+#include "zutil/zsimd.h"
+#include "zutil/zrectarray.h"
+
+
+
+#define ZRECTARRAY_OVERLAP 0
+#define ZRECTARRAY_INSIDE  1
+#define ZRECTARRAY_POINT   2
+
+
+
+
+
+/* Section 1:
+** storage
+******************************************************************************/
+/*
+Moves an array into a new block with room for _capacity rects*/
+static ZRESULT
+ZRectArray_Realloc(
+	_Inout_ ZRECTARRAY* _array,
+	_In_    SizeT       _capacity) {
+
+	Void*  block;
+	Float* edges;
+
+	_capacity = (SizeT)ZMath_AlignU64(_capacity, ZRECTARRAY_PAD);
+	block = malloc(4 * _capacity * sizeof(Float) + ZRECTARRAY_ALIGN);
+	if (!block)
+		return Z_EOUTOFMEMORY;
+	edges = (Float*)(SizeT)ZMath_AlignU64((SizeT)block, ZRECTARRAY_ALIGN);
+	if (_array->iCount) {
+		SizeT size = _array->iCount * sizeof(Float);
+		memcpy(edges,                 _array->left,   size);
+		memcpy(edges + _capacity,     _array->top,    size);
+		memcpy(edges + _capacity * 2, _array->right,  size);
+		memcpy(edges + _capacity * 3, _array->bottom, size);
+	}
+	free(_array->lpBlock);
+	_array->lpBlock   = block;
+	_array->left      = edges;
+	_array->top       = edges + _capacity;
+	_array->right     = edges + _capacity * 2;
+	_array->bottom    = edges + _capacity * 3;
+	_array->iCapacity = _capacity;
+	return Z_OK;
+}
+
+
+/*
+Resizes the destination of a kernel to the source count*/
+static FORCEINLINE ZRESULT
+ZRectArray_Prepare(
+	_Inout_ ZRECTARRAY* _dst,
+	_In_    SizeT       _count) {
+
+	if (_dst->iCount == _count)
+		return Z_OK;
+	return ZRectArray_Resize(_dst, _count);
+}
+
+
+ZRESULT
+ZRectArray_Init(
+	_Out_ ZRECTARRAY* _array,
+	_In_  SizeT       _capacity) {
+
+	memset(_array, 0, sizeof(ZRECTARRAY));
+	if (!_capacity)
+		return Z_OK;
+	return ZRectArray_Realloc(_array, _capacity);
+}
+
+
+Void
+ZRectArray_Free(
+	_Inout_ ZRECTARRAY* _array) {
+
+	free(_array->lpBlock);
+	memset(_array, 0, sizeof(ZRECTARRAY));
+}
+
+
+ZRESULT
+ZRectArray_Resize(
+	_Inout_ ZRECTARRAY* _array,
+	_In_    SizeT       _count) {
+
+	ZRESULT result;
+	if (_count > _array->iCapacity) {
+		result = ZRectArray_Realloc(
+			_array, Z_Max(_count, _array->iCapacity + _array->iCapacity / 2));
+		if (Z_FAILURE(result))
+			return result;
+	}
+	_array->iCount = _count;
+	return Z_OK;
+}
+
+
+ZRESULT
+ZRectArray_FromAoS(
+	_Inout_ ZRECTARRAY*  _array,
+	_In_    const ZRECT* _src,
+	_In_    SizeT        _count) {
+
+	ZRESULT result;
+	SizeT   i = 0;
+
+	result = ZRectArray_Prepare(_array, _count);
+	if (Z_FAILURE(result))
+		return result;
+#if (ZSIMD_SSE2 || ZSIMD_AVX2)
+	for (; i + 4 <= _count; i += 4) {
+		//4x4 transpose of (x, y, w, h) into edge vectors
+		__m128 r0 = _mm_loadu_ps(_src[i].v);
+		__m128 r1 = _mm_loadu_ps(_src[i + 1].v);
+		__m128 r2 = _mm_loadu_ps(_src[i + 2].v);
+		__m128 r3 = _mm_loadu_ps(_src[i + 3].v);
+		__m128 x, y, r, b;
+		_MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+		r = _mm_add_ps(r0, r2);
+		b = _mm_add_ps(r1, r3);
+		x = _mm_min_ps(r0, r);
+		y = _mm_min_ps(r1, b);
+		_mm_store_ps(_array->left + i,   x);
+		_mm_store_ps(_array->top + i,    y);
+		_mm_store_ps(_array->right + i,  _mm_max_ps(r0, r));
+		_mm_store_ps(_array->bottom + i, _mm_max_ps(r1, b));
+	}
+#elif (ZSIMD_NEON)
+	for (; i + 4 <= _count; i += 4) {
+		float32x4x4_t v = vld4q_f32(_src[i].v);
+		float32x4_t   r = vaddq_f32(v.val[0], v.val[2]);
+		float32x4_t   b = vaddq_f32(v.val[1], v.val[3]);
+		vst1q_f32(_array->left + i,   vminq_f32(v.val[0], r));
+		vst1q_f32(_array->top + i,    vminq_f32(v.val[1], b));
+		vst1q_f32(_array->right + i,  vmaxq_f32(v.val[0], r));
+		vst1q_f32(_array->bottom + i, vmaxq_f32(v.val[1], b));
+	}
+#endif
+	for (; i < _count; ++i)
+		ZRectArray_Set(_array, i, &_src[i]);
+	return Z_OK;
+}
+
+
+Void
+ZRectArray_ToAoS(
+	_In_    const ZRECTARRAY* _array,
+	_Inout_ ZRECT*            _dst) {
+
+	SizeT i;
+	for (i = 0; i < _array->iCount; ++i)
+		_dst[i] = ZRectArray_Get(_array, i);
+}
+
+
+
+
+
+/* Section 2:
+** queries
+******************************************************************************/
+/*
+Tests a batch of rects against the query edges. The query kind is a
+constant at every call site, so each query gets its own loop*/
+static FORCEINLINE ZSIMDF
+ZRectArray_Test(
+	_In_ Int32  _kind,
+	_In_ ZSIMDF _l,
+	_In_ ZSIMDF _t,
+	_In_ ZSIMDF _r,
+	_In_ ZSIMDF _b,
+	_In_ ZSIMDF _ql,
+	_In_ ZSIMDF _qt,
+	_In_ ZSIMDF _qr,
+	_In_ ZSIMDF _qb) {
+
+	switch (_kind) {
+	case ZRECTARRAY_OVERLAP:
+		return ZSimd_And(
+			ZSimd_CmpGt(ZSimd_Min(_r, _qr), ZSimd_Max(_l, _ql)),
+			ZSimd_CmpGt(ZSimd_Min(_b, _qb), ZSimd_Max(_t, _qt)));
+	case ZRECTARRAY_INSIDE:
+		return ZSimd_And(
+			ZSimd_And(ZSimd_CmpLe(_ql, _l), ZSimd_CmpLe(_r, _qr)),
+			ZSimd_And(ZSimd_CmpLe(_qt, _t), ZSimd_CmpLe(_b, _qb)));
+	default:
+		return ZSimd_And(
+			ZSimd_And(ZSimd_CmpLe(_l, _ql), ZSimd_CmpGt(_r, _ql)),
+			ZSimd_And(ZSimd_CmpLe(_t, _qt), ZSimd_CmpGt(_b, _qt)));
+	}
+}
+
+
+static FORCEINLINE Uint32
+ZRectArray_TestOne(
+	_In_ Int32             _kind,
+	_In_ const ZRECTARRAY* _array,
+	_In_ SizeT             _index,
+	_In_ const Float*      _q) {
+
+	Float l = _array->left[_index], t = _array->top[_index];
+	Float r = _array->right[_index], b = _array->bottom[_index];
+	switch (_kind) {
+	case ZRECTARRAY_OVERLAP:
+		return Z_Max(l, _q[0]) < Z_Min(r, _q[2]) &&
+			Z_Max(t, _q[1]) < Z_Min(b, _q[3]);
+	case ZRECTARRAY_INSIDE:
+		return l >= _q[0] && r <= _q[2] && t >= _q[1] && b <= _q[3];
+	default:
+		return l <= _q[0] && r > _q[0] && t <= _q[1] && b > _q[1];
+	}
+}
+
+
+/*
+Runs a query over the array one mask word (32 rects) at a time.
+_q holds the query edges (left, top, right, bottom)*/
+static FORCEINLINE SizeT
+ZRectArray_Query(
+	_In_    Int32             _kind,
+	_In_    const ZRECTARRAY* _array,
+	_In_    const Float*      _q,
+	_Inout_ Uint32*           _mask) {
+
+	ZSIMDF ql, qt, qr, qb;
+	SizeT  i = 0, n, hits = 0;
+	Uint32 bits, j;
+
+	n  = _array->iCount;
+	ql = ZSimd_Set1(_q[0]);
+	qt = ZSimd_Set1(_q[1]);
+	qr = ZSimd_Set1(_q[2]);
+	qb = ZSimd_Set1(_q[3]);
+	for (; i + 32 <= n; i += 32) {
+		bits = 0;
+		for (j = 0; j < 32; j += ZSIMD_LANES) {
+			bits |= ZSimd_MoveMask(ZRectArray_Test(_kind,
+				ZSimd_Load(_array->left + i + j),
+				ZSimd_Load(_array->top + i + j),
+				ZSimd_Load(_array->right + i + j),
+				ZSimd_Load(_array->bottom + i + j),
+				ql, qt, qr, qb)) << j;
+		}
+		_mask[i / 32] = bits;
+		hits += (Uint32)Z_POPCOUNT32(bits);
+	}
+	if (i < n) {
+		bits = 0;
+		for (j = 0; i + j < n; ++j)
+			bits |= ZRectArray_TestOne(_kind, _array, i + j, _q) << j;
+		_mask[i / 32] = bits;
+		hits += (Uint32)Z_POPCOUNT32(bits);
+	}
+	return hits;
+}
+
+
+SizeT
+ZRectArray_QueryOverlap(
+	_In_    const ZRECTARRAY* _array,
+	_In_    const ZRECT*      _rect,
+	_Inout_ Uint32*           _mask) {
+
+	Float q[4];
+	q[0] = Z_Min(_rect->x, _rect->x + _rect->w);
+	q[1] = Z_Min(_rect->y, _rect->y + _rect->h);
+	q[2] = Z_Max(_rect->x, _rect->x + _rect->w);
+	q[3] = Z_Max(_rect->y, _rect->y + _rect->h);
+	return ZRectArray_Query(ZRECTARRAY_OVERLAP, _array, q, _mask);
+}
+
+
+SizeT
+ZRectArray_QueryInside(
+	_In_    const ZRECTARRAY* _array,
+	_In_    const ZRECT*      _rect,
+	_Inout_ Uint32*           _mask) {
+
+	Float q[4];
+	q[0] = Z_Min(_rect->x, _rect->x + _rect->w);
+	q[1] = Z_Min(_rect->y, _rect->y + _rect->h);
+	q[2] = Z_Max(_rect->x, _rect->x + _rect->w);
+	q[3] = Z_Max(_rect->y, _rect->y + _rect->h);
+	return ZRectArray_Query(ZRECTARRAY_INSIDE, _array, q, _mask);
+}
+
+
+SizeT
+ZRectArray_QueryPoint(
+	_In_    const ZRECTARRAY* _array,
+	_In_    Float             _x,
+	_In_    Float             _y,
+	_Inout_ Uint32*           _mask) {
+
+	Float q[4];
+	q[0] = q[2] = _x;
+	q[1] = q[3] = _y;
+	return ZRectArray_Query(ZRECTARRAY_POINT, _array, q, _mask);
+}
+
+
+SizeT
+ZRectArray_MaskToIndices(
+	_In_    const Uint32* _mask,
+	_In_    SizeT         _count,
+	_Inout_ SizeT*        _indices) {
+
+	SizeT  w, n = 0;
+	Uint32 bits;
+	for (w = 0; w < ZRECTARRAY_MASKWORDS(_count); ++w) {
+		bits = _mask[w];
+		while (bits) {
+			_indices[n++] = w * 32 + Z_CTZ32(bits);
+			bits &= bits - 1;
+		}
+	}
+	return n;
+}
+
+
+
+
+
+/* Section 3:
+** batch kernels
+******************************************************************************/
+ZRESULT
+ZRectArray_Intersect(
+	_Inout_     ZRECTARRAY*       _dst,
+	_In_        const ZRECTARRAY* _a,
+	_In_        const ZRECTARRAY* _b,
+	_Inout_opt_ Uint32*           _mask) {
+
+	ZRESULT result;
+	SizeT   i = 0, n;
+
+	n = _a->iCount;
+	if (_b->iCount != n)
+		return Z_EINVALIDARG;
+	result = ZRectArray_Prepare(_dst, n);
+	if (Z_FAILURE(result))
+		return result;
+	if (_mask)
+		memset(_mask, 0, ZRECTARRAY_MASKWORDS(n) * sizeof(Uint32));
+	for (; i + ZSIMD_LANES <= n; i += ZSIMD_LANES) {
+		ZSIMDF l = ZSimd_Max(ZSimd_Load(_a->left + i), ZSimd_Load(_b->left + i));
+		ZSIMDF t = ZSimd_Max(ZSimd_Load(_a->top + i), ZSimd_Load(_b->top + i));
+		ZSIMDF r = ZSimd_Min(ZSimd_Load(_a->right + i), ZSimd_Load(_b->right + i));
+		ZSIMDF b = ZSimd_Min(ZSimd_Load(_a->bottom + i), ZSimd_Load(_b->bottom + i));
+		ZSIMDF hit = ZSimd_And(ZSimd_CmpGt(r, l), ZSimd_CmpGt(b, t));
+		ZSimd_Store(_dst->left + i,   ZSimd_And(hit, l));
+		ZSimd_Store(_dst->top + i,    ZSimd_And(hit, t));
+		ZSimd_Store(_dst->right + i,  ZSimd_And(hit, r));
+		ZSimd_Store(_dst->bottom + i, ZSimd_And(hit, b));
+		if (_mask)
+			_mask[i / 32] |= ZSimd_MoveMask(hit) << (i % 32);
+	}
+	for (; i < n; ++i) {
+		Float l = Z_Max(_a->left[i], _b->left[i]);
+		Float t = Z_Max(_a->top[i], _b->top[i]);
+		Float r = Z_Min(_a->right[i], _b->right[i]);
+		Float b = Z_Min(_a->bottom[i], _b->bottom[i]);
+		if (l < r && t < b) {
+			_dst->left[i]   = l;
+			_dst->top[i]    = t;
+			_dst->right[i]  = r;
+			_dst->bottom[i] = b;
+			if (_mask)
+				_mask[i / 32] |= 1u << (i % 32);
+		}
+		else {
+			_dst->left[i]  = _dst->top[i]    = 0;
+			_dst->right[i] = _dst->bottom[i] = 0;
+		}
+	}
+	return Z_OK;
+}
+
+
+ZRESULT
+ZRectArray_Merge(
+	_Inout_ ZRECTARRAY*       _dst,
+	_In_    const ZRECTARRAY* _a,
+	_In_    const ZRECTARRAY* _b) {
+
+	ZRESULT result;
+	SizeT   i = 0, n;
+
+	n = _a->iCount;
+	if (_b->iCount != n)
+		return Z_EINVALIDARG;
+	result = ZRectArray_Prepare(_dst, n);
+	if (Z_FAILURE(result))
+		return result;
+	for (; i + ZSIMD_LANES <= n; i += ZSIMD_LANES) {
+		ZSimd_Store(_dst->left + i, 
+			ZSimd_Min(ZSimd_Load(_a->left + i), ZSimd_Load(_b->left + i)));
+		ZSimd_Store(_dst->top + i, 
+			ZSimd_Min(ZSimd_Load(_a->top + i), ZSimd_Load(_b->top + i)));
+		ZSimd_Store(_dst->right + i, 
+			ZSimd_Max(ZSimd_Load(_a->right + i), ZSimd_Load(_b->right + i)));
+		ZSimd_Store(_dst->bottom + i, 
+			ZSimd_Max(ZSimd_Load(_a->bottom + i), ZSimd_Load(_b->bottom + i)));
+	}
+	for (; i < n; ++i) {
+		_dst->left[i]   = Z_Min(_a->left[i], _b->left[i]);
+		_dst->top[i]    = Z_Min(_a->top[i], _b->top[i]);
+		_dst->right[i]  = Z_Max(_a->right[i], _b->right[i]);
+		_dst->bottom[i] = Z_Max(_a->bottom[i], _b->bottom[i]);
+	}
+	return Z_OK;
+}
+
+
+Bool
+ZRectArray_GetBounds(
+	_In_    const ZRECTARRAY* _array,
+	_Inout_ ZRECT*            _out) {
+
+	Float  edges[4][ZSIMD_LANES];
+	Float  l, t, r, b;
+	SizeT  i = 0, n, j;
+
+	n = _array->iCount;
+	if (!n) {
+		_out->x = _out->y = _out->w = _out->h = 0;
+		return Z_FALSE;
+	}
+	l = _array->left[0];
+	t = _array->top[0];
+	r = _array->right[0];
+	b = _array->bottom[0];
+	if (n >= ZSIMD_LANES) {
+		ZSIMDF vl = ZSimd_Load(_array->left);
+		ZSIMDF vt = ZSimd_Load(_array->top);
+		ZSIMDF vr = ZSimd_Load(_array->right);
+		ZSIMDF vb = ZSimd_Load(_array->bottom);
+		for (i = ZSIMD_LANES; i + ZSIMD_LANES <= n; i += ZSIMD_LANES) {
+			vl = ZSimd_Min(vl, ZSimd_Load(_array->left + i));
+			vt = ZSimd_Min(vt, ZSimd_Load(_array->top + i));
+			vr = ZSimd_Max(vr, ZSimd_Load(_array->right + i));
+			vb = ZSimd_Max(vb, ZSimd_Load(_array->bottom + i));
+		}
+		ZSimd_Store(edges[0], vl);
+		ZSimd_Store(edges[1], vt);
+		ZSimd_Store(edges[2], vr);
+		ZSimd_Store(edges[3], vb);
+		for (j = 0; j < ZSIMD_LANES; ++j) {
+			l = Z_Min(l, edges[0][j]);
+			t = Z_Min(t, edges[1][j]);
+			r = Z_Max(r, edges[2][j]);
+			b = Z_Max(b, edges[3][j]);
+		}
+	}
+	for (; i < n; ++i) {
+		l = Z_Min(l, _array->left[i]);
+		t = Z_Min(t, _array->top[i]);
+		r = Z_Max(r, _array->right[i]);
+		b = Z_Max(b, _array->bottom[i]);
+	}
+	_out->x = l;
+	_out->y = t;
+	_out->w = r - l;
+	_out->h = b - t;
+	return Z_TRUE;
+}
+/*****************************************************************************/  
+//EOF
+/*****************************************************************************/  
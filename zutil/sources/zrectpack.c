@@ -0,0 +1,644 @@
+/******************************************************************************
+* zutil - C Utility Library
+* Copyright (C) 2017-2021 Zachary T Harris. All Rights Reserved.  
+* Zlib license.
+* 
+* File: zrectpack.c
+* Desc: rectangle packing for texture atlases
+*******************************************************************************
+
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+******************************************************************************/ 
+#include <math.h>
+#include "zutil/zrectpack.h"
+
+
+
+#define ZRECTPACK_MINCAPACITY 64 //smallest node and free rect arrays
+
+
+
+/*
+A segment of the skyline: the outline is at height y over [x, x + w)*/
+typedef struct {
+	Int32 x, y, w;
+} ZRECTPACKNODE;
+
+/*
+A rect in integer units, used for free rects and placements*/
+typedef struct {
+	Int32 x, y, w, h;
+} ZRECTPACKBOX;
+
+/*
+A rect of a batch, with its sort keys*/
+typedef struct {
+	Int32 iMajor;
+	Int32 iMinor;
+	SizeT iIndex;
+} ZRECTPACKITEM;
+
+struct _ZRectPack {
+	Int32               iWidth;         //size of the bin
+	Int32               iHeight;
+	ZRECTPACK_HEURISTIC eHeuristic;     //packing heuristic
+	ZRECTPACKNODE*      lpNodes;        //skyline segments, sorted by x
+	SizeT               iNodes;
+	SizeT               iNodeCapacity;
+	ZRECTPACKBOX*       lpFree;         //maximal free rects
+	SizeT               iFree;
+	SizeT               iFreeCapacity;
+	ZRECTPACKBOX*       lpSplit;        //free rects cut by the last placement
+	SizeT               iSplit;
+	SizeT               iSplitCapacity;
+	Uint64              iUsedArea;      //area of the rects placed
+	Int32               iUsedHeight;    //largest bottom edge placed
+};
+
+
+
+
+
+/* Section 1:
+** storage
+******************************************************************************/
+static ZRESULT
+ZRectPack_Reserve(
+	_Inout_ Void** _lpArray,
+	_Inout_ SizeT* _lpCapacity,
+	_In_    SizeT  _count,
+	_In_    SizeT  _size) {
+
+	Void* array;
+	SizeT capacity;
+	if (_count <= *_lpCapacity)
+		return Z_OK;
+	capacity = Z_Max(Z_Max(*_lpCapacity * 2, _count), ZRECTPACK_MINCAPACITY);
+	array = realloc(*_lpArray, capacity * _size);
+	if (!array)
+		return Z_EOUTOFMEMORY;
+	*_lpArray    = array;
+	*_lpCapacity = capacity;
+	return Z_OK;
+}
+
+
+static FORCEINLINE Bool
+ZRectPack_Contains(
+	_In_ const ZRECTPACKBOX* _outer,
+	_In_ const ZRECTPACKBOX* _inner) {
+
+	//the result is hard to predict, so it is evaluated without branches
+	return
+		(_inner->x >= _outer->x) & 
+		(_inner->y >= _outer->y) &
+		(_inner->x + _inner->w <= _outer->x + _outer->w) &
+		(_inner->y + _inner->h <= _outer->y + _outer->h);
+}
+
+
+/*
+Rounds the size of a rect up to whole units.
+@return: Z_OK, Z_ERANGE if it is larger than the bin, 
+         or Z_EINVALIDARG if it is negative or NaN*/
+static ZRESULT
+ZRectPack_GetSize(
+	_In_    const ZRectPack* _lpPack,
+	_In_    const ZRECT*     _rect,
+	_Inout_ Int32*           _w,
+	_Inout_ Int32*           _h) {
+
+	if (!(_rect->w >= 0) || !(_rect->h >= 0))
+		return Z_EINVALIDARG;
+	if (_rect->w > (Float)_lpPack->iWidth || _rect->h > (Float)_lpPack->iHeight)
+		return Z_ERANGE;
+	*_w = (Int32)ceilf(_rect->w);
+	*_h = (Int32)ceilf(_rect->h);
+	if (*_w > _lpPack->iWidth || *_h > _lpPack->iHeight)
+		return Z_ERANGE;
+	return Z_OK;
+}
+
+
+
+
+
+/* Section 2:
+** skyline bottom-left
+******************************************************************************/
+/*
+Finds the height at which a rect rests when its left edge is at the
+start of a skyline segment.
+@return: the top of the rect, or -1 if it does not fit there*/
+static Int32
+ZRectPack_SkylineFit(
+	_In_ const ZRectPack* _lpPack,
+	_In_ SizeT            _node,
+	_In_ Int32            _w,
+	_In_ Int32            _h) {
+
+	const ZRECTPACKNODE* nodes = _lpPack->lpNodes;
+	Int32 y, left;
+
+	y    = nodes[_node].y;
+	left = _w;
+	//the skyline spans the bin, so the segments run out only after
+	//the rect is covered
+	while (left > 0) {
+		y = Z_Max(y, nodes[_node].y);
+		if (y + _h > _lpPack->iHeight)
+			return -1;
+		left -= nodes[_node].w;
+		_node++;
+	}
+	return y;
+}
+
+
+/*
+Raises the skyline over a rect placed at the start of a segment*/
+static Void
+ZRectPack_SkylineAdd(
+	_Inout_ ZRectPack*          _lpPack,
+	_In_    SizeT               _node,
+	_In_    const ZRECTPACKBOX* _box) {
+
+	ZRECTPACKNODE* nodes = _lpPack->lpNodes;
+	SizeT          i;
+
+	memmove(nodes + _node + 1, nodes + _node,
+		(_lpPack->iNodes - _node) * sizeof(ZRECTPACKNODE));
+	_lpPack->iNodes++;
+	nodes[_node].x = _box->x;
+	nodes[_node].y = _box->y + _box->h;
+	nodes[_node].w = _box->w;
+	//trim the segments now under the new one
+	i = _node + 1;
+	while (i < _lpPack->iNodes) {
+		Int32 end = nodes[i - 1].x + nodes[i - 1].w;
+		if (nodes[i].x >= end)
+			break;
+		if (nodes[i].x + nodes[i].w <= end) {
+			memmove(nodes + i, nodes + i + 1, 
+				(_lpPack->iNodes - i - 1) * sizeof(ZRECTPACKNODE));
+			_lpPack->iNodes--;
+			continue;
+		}
+		nodes[i].w -= end - nodes[i].x;
+		nodes[i].x  = end;
+		break;
+	}
+	//merge neighbors at the same height
+	for (i = (_node > 0) ? _node - 1 : 0; i + 1 < _lpPack->iNodes; ) {
+		if (nodes[i].y == nodes[i + 1].y) {
+			nodes[i].w += nodes[i + 1].w;
+			memmove(nodes + i + 1, nodes + i + 2, 
+				(_lpPack->iNodes - i - 2) * sizeof(ZRECTPACKNODE));
+			_lpPack->iNodes--;
+		}
+		else if (i > _node) {
+			break;
+		}
+		else {
+			i++;
+		}
+	}
+}
+
+
+static ZRESULT
+ZRectPack_SkylineInsert(
+	_Inout_ ZRectPack*    _lpPack,
+	_Inout_ ZRECTPACKBOX* _box) {
+
+	const ZRECTPACKNODE* nodes;
+	SizeT   i, best;
+	Int32   y, top, bestTop, bestWidth;
+	ZRESULT result;
+
+	result = ZRectPack_Reserve((Void**)&_lpPack->lpNodes, 
+		&_lpPack->iNodeCapacity, _lpPack->iNodes + 1, sizeof(ZRECTPACKNODE));
+	if (Z_FAILURE(result))
+		return result;
+	nodes     = _lpPack->lpNodes;
+	best      = _lpPack->iNodes;
+	bestTop   = 0x7FFFFFFF;
+	bestWidth = 0x7FFFFFFF;
+	for (i = 0; i < _lpPack->iNodes; i++) {
+		//segments are sorted by x, so no later one fits either
+		if (nodes[i].x + _box->w > _lpPack->iWidth)
+			break;
+		y = ZRectPack_SkylineFit(_lpPack, i, _box->w, _box->h);
+		if (y < 0)
+			continue;
+		top = y + _box->h;
+		if (top < bestTop || (top == bestTop && nodes[i].w < bestWidth)) {
+			best      = i;
+			bestTop   = top;
+			bestWidth = nodes[i].w;
+		}
+	}
+	if (best == _lpPack->iNodes)
+		return Z_ERANGE;
+
+	_box->x = nodes[best].x;
+	_box->y = bestTop - _box->h;
+	ZRectPack_SkylineAdd(_lpPack, best, _box);
+	return Z_OK;
+}
+
+
+
+
+
+/* Section 3:
+** maximal rectangles, best short side fit
+******************************************************************************/
+static FORCEINLINE ZRESULT
+ZRectPack_PushSplit(
+	_Inout_ ZRectPack* _lpPack,
+	_In_    Int32      _x,
+	_In_    Int32      _y,
+	_In_    Int32      _w,
+	_In_    Int32      _h) {
+
+	ZRECTPACKBOX* box;
+	ZRESULT       result;
+	result = ZRectPack_Reserve((Void**)&_lpPack->lpSplit, 
+		&_lpPack->iSplitCapacity, _lpPack->iSplit + 1, sizeof(ZRECTPACKBOX));
+	if (Z_FAILURE(result))
+		return result;
+	box = &_lpPack->lpSplit[_lpPack->iSplit++];
+	box->x = _x;
+	box->y = _y;
+	box->w = _w;
+	box->h = _h;
+	return Z_OK;
+}
+
+
+/*
+Cuts the free rects that overlap a placed rect into the maximal free 
+rects around it, then prunes the new rects contained in other free 
+rects. Only the new rects need testing: each lies inside the free rect
+it was cut from, so an older rect inside a new one would have been 
+inside that free rect too, and pruned already.*/
+static ZRESULT
+ZRectPack_MaxRectsSplit(
+	_Inout_ ZRectPack*          _lpPack,
+	_In_    const ZRECTPACKBOX* _box) {
+
+	ZRECTPACKBOX* free;
+	ZRECTPACKBOX* split;
+	ZRECTPACKBOX  f;
+	SizeT         i, j, k, count, base;
+	Int32         right, bottom;
+	ZRESULT       result;
+
+	right  = _box->x + _box->w;
+	bottom = _box->y + _box->h;
+	_lpPack->iSplit = 0;
+	free  = _lpPack->lpFree;
+	count = _lpPack->iFree;
+	for (i = 0; i < count; ) {
+		f = free[i];
+		if (f.x >= right || f.x + f.w <= _box->x ||
+			f.y >= bottom || f.y + f.h <= _box->y) {
+			i++;
+			continue;
+		}
+		result = Z_OK;
+		if (_box->x > f.x)
+			result |= ZRectPack_PushSplit(_lpPack, 
+				f.x, f.y, _box->x - f.x, f.h);
+		if (right < f.x + f.w)
+			result |= ZRectPack_PushSplit(_lpPack, 
+				right, f.y, f.x + f.w - right, f.h);
+		if (_box->y > f.y)
+			result |= ZRectPack_PushSplit(_lpPack, 
+				f.x, f.y, f.w, _box->y - f.y);
+		if (bottom < f.y + f.h)
+			result |= ZRectPack_PushSplit(_lpPack, 
+				f.x, bottom, f.w, f.y + f.h - bottom);
+		if (result != Z_OK)
+			return Z_EOUTOFMEMORY;
+		free[i] = free[--count];
+	}
+	_lpPack->iFree = count;
+
+	result = ZRectPack_Reserve((Void**)&_lpPack->lpFree, 
+		&_lpPack->iFreeCapacity, count + _lpPack->iSplit, sizeof(ZRECTPACKBOX));
+	if (Z_FAILURE(result))
+		return result;
+	//prune the new rects among themselves first, there are only a few,
+	//then test the survivors against the older rects
+	split = _lpPack->lpSplit;
+	base  = 0;
+	for (k = 0; k < _lpPack->iSplit; k++) {
+		for (j = 0; j < base; j++) {
+			if (ZRectPack_Contains(&split[j], &split[k]))
+				break;
+		}
+		if (j < base)
+			continue;
+		for (j = 0; j < base; ) {
+			if (ZRectPack_Contains(&split[k], &split[j]))
+				split[j] = split[--base];
+			else
+				j++;
+		}
+		split[base++] = split[k];
+	}
+	_lpPack->iSplit = base;
+	free = _lpPack->lpFree;
+	base = count;
+	for (k = 0; k < _lpPack->iSplit; k++) {
+		for (j = 0; j < base; j++) {
+			if (ZRectPack_Contains(&free[j], &split[k]))
+				break;
+		}
+		if (j == base)
+			free[count++] = split[k];
+	}
+	_lpPack->iFree = count;
+	return Z_OK;
+}
+
+
+static ZRESULT
+ZRectPack_MaxRectsInsert(
+	_Inout_ ZRectPack*    _lpPack,
+	_Inout_ ZRECTPACKBOX* _box) {
+
+	const ZRECTPACKBOX* free;
+	SizeT  i, best;
+	Int32  dw, dh, shortSide, longSide, bestShort, bestLong;
+
+	free      = _lpPack->lpFree;
+	best      = _lpPack->iFree;
+	bestShort = 0x7FFFFFFF;
+	bestLong  = 0x7FFFFFFF;
+	for (i = 0; i < _lpPack->iFree; i++) {
+		dw = free[i].w - _box->w;
+		dh = free[i].h - _box->h;
+		if (dw < 0 || dh < 0)
+			continue;
+		shortSide = Z_Min(dw, dh);
+		longSide  = Z_Max(dw, dh);
+		if (shortSide < bestShort || 
+			(shortSide == bestShort && longSide < bestLong)) {
+			best      = i;
+			bestShort = shortSide;
+			bestLong  = longSide;
+		}
+	}
+	if (best == _lpPack->iFree)
+		return Z_ERANGE;
+
+	_box->x = free[best].x;
+	_box->y = free[best].y;
+	return ZRectPack_MaxRectsSplit(_lpPack, _box);
+}
+
+
+
+
+
+/* Section 4:
+** packer
+******************************************************************************/
+ZRectPack*
+ZRectPack_Create(
+	_In_        Int32               _width,
+	_In_        Int32               _height,
+	_In_        ZRECTPACK_HEURISTIC _heuristic,
+	_Inout_opt_ ZRESULT*            _lpResult) {
+
+	ZRectPack* pack;
+	if (_width < 1 || _height < 1 || 
+		(_heuristic != ZRECTPACK_SKYLINE_BL && 
+		 _heuristic != ZRECTPACK_MAXRECTS_BSSF)) {
+		if (_lpResult)
+			*_lpResult = Z_EINVALIDARG;
+		return NULL;
+	}
+	pack = (ZRectPack*)calloc(1, sizeof(ZRectPack));
+	if (!pack) {
+		if (_lpResult)
+			*_lpResult = Z_EOUTOFMEMORY;
+		return NULL;
+	}
+	pack->iWidth     = _width;
+	pack->iHeight    = _height;
+	pack->eHeuristic = _heuristic;
+	if (Z_FAILURE(ZRectPack_Reserve((Void**)&pack->lpNodes, 
+			&pack->iNodeCapacity, 1, sizeof(ZRECTPACKNODE))) ||
+		Z_FAILURE(ZRectPack_Reserve((Void**)&pack->lpFree, 
+			&pack->iFreeCapacity, 1, sizeof(ZRECTPACKBOX)))) {
+		ZRectPack_Release(pack);
+		if (_lpResult)
+			*_lpResult = Z_EOUTOFMEMORY;
+		return NULL;
+	}
+	ZRectPack_Reset(pack);
+	if (_lpResult)
+		*_lpResult = Z_OK;
+	return pack;
+}
+
+
+Void
+ZRectPack_Release(
+	_Inout_ ZRectPack* _lpPack) {
+
+	if (!_lpPack)
+		return;
+	free(_lpPack->lpNodes);
+	free(_lpPack->lpFree);
+	free(_lpPack->lpSplit);
+	free(_lpPack);
+}
+
+
+Void
+ZRectPack_Reset(
+	_Inout_ ZRectPack* _lpPack) {
+
+	_lpPack->lpNodes[0].x = 0;
+	_lpPack->lpNodes[0].y = 0;
+	_lpPack->lpNodes[0].w = _lpPack->iWidth;
+	_lpPack->iNodes = 1;
+	_lpPack->lpFree[0].x = 0;
+	_lpPack->lpFree[0].y = 0;
+	_lpPack->lpFree[0].w = _lpPack->iWidth;
+	_lpPack->lpFree[0].h = _lpPack->iHeight;
+	_lpPack->iFree       = 1;
+	_lpPack->iUsedArea   = 0;
+	_lpPack->iUsedHeight = 0;
+}
+
+
+/*
+Places a rect of whole units*/
+static ZRESULT
+ZRectPack_Place(
+	_Inout_ ZRectPack* _lpPack,
+	_In_    Int32      _w,
+	_In_    Int32      _h,
+	_Inout_ ZRECT*     _rect) {
+
+	ZRECTPACKBOX box;
+	ZRESULT      result;
+
+	if (_w == 0 || _h == 0) {
+		_rect->x = 0;
+		_rect->y = 0;
+		return Z_OK;
+	}
+	box.x = 0;
+	box.y = 0;
+	box.w = _w;
+	box.h = _h;
+	if (_lpPack->eHeuristic == ZRECTPACK_SKYLINE_BL)
+		result = ZRectPack_SkylineInsert(_lpPack, &box);
+	else
+		result = ZRectPack_MaxRectsInsert(_lpPack, &box);
+	if (result != Z_OK)
+		return result;
+	_rect->x = (Float)box.x;
+	_rect->y = (Float)box.y;
+	_lpPack->iUsedArea  += (Uint64)box.w * (Uint64)box.h;
+	_lpPack->iUsedHeight = Z_Max(_lpPack->iUsedHeight, box.y + box.h);
+	return Z_OK;
+}
+
+
+ZRESULT
+ZRectPack_Insert(
+	_Inout_ ZRectPack* _lpPack,
+	_Inout_ ZRECT*     _rect) {
+
+	Int32   w, h;
+	ZRESULT result;
+	result = ZRectPack_GetSize(_lpPack, _rect, &w, &h);
+	if (result != Z_OK)
+		return result;
+	return ZRectPack_Place(_lpPack, w, h, _rect);
+}
+
+
+static int
+ZRectPack_CompareItems(
+	_In_ const void* _a,
+	_In_ const void* _b) {
+
+	const ZRECTPACKITEM* a = (const ZRECTPACKITEM*)_a;
+	const ZRECTPACKITEM* b = (const ZRECTPACKITEM*)_b;
+	if (a->iMajor != b->iMajor)
+		return (a->iMajor > b->iMajor) ? -1 : 1;
+	if (a->iMinor != b->iMinor)
+		return (a->iMinor > b->iMinor) ? -1 : 1;
+	return (a->iIndex < b->iIndex) ? -1 : (a->iIndex > b->iIndex);
+}
+
+
+ZRESULT
+ZRectPack_InsertBatch(
+	_Inout_     ZRectPack* _lpPack,
+	_Inout_     ZRECT*     _rects,
+	_In_        SizeT      _count,
+	_Inout_opt_ SizeT*     _lpPlaced) {
+
+	ZRECTPACKITEM* items;
+	SizeT          i, placed;
+	Int32          w, h;
+	ZRESULT        result, status;
+
+	if (_lpPlaced)
+		*_lpPlaced = 0;
+	for (i = 0; i < _count; i++) {
+		if (!(_rects[i].w >= 0) || !(_rects[i].h >= 0))
+			return Z_EINVALIDARG;
+	}
+	items = (ZRECTPACKITEM*)malloc(Z_Max(_count, 1) * sizeof(ZRECTPACKITEM));
+	if (!items)
+		return Z_EOUTOFMEMORY;
+	//sizes too large for the bin sort first and fail right away
+	for (i = 0; i < _count; i++) {
+		w = (Int32)Z_Min(ceilf(_rects[i].w), (Float)_lpPack->iWidth + 1);
+		h = (Int32)Z_Min(ceilf(_rects[i].h), (Float)_lpPack->iHeight + 1);
+		if (_lpPack->eHeuristic == ZRECTPACK_SKYLINE_BL) {
+			items[i].iMajor = h;
+			items[i].iMinor = w;
+		}
+		else {
+			items[i].iMajor = Z_Max(w, h);
+			items[i].iMinor = Z_Min(w, h);
+		}
+		items[i].iIndex = i;
+	}
+	qsort(items, _count, sizeof(ZRECTPACKITEM), ZRectPack_CompareItems);
+
+	status = Z_OK;
+	placed = 0;
+	for (i = 0; i < _count; i++) {
+		ZRECT* rect = &_rects[items[i].iIndex];
+		result = ZRectPack_GetSize(_lpPack, rect, &w, &h);
+		if (result == Z_OK)
+			result = ZRectPack_Place(_lpPack, w, h, rect);
+		if (result == Z_OK) {
+			placed++;
+			continue;
+		}
+		rect->x = -1;
+		rect->y = -1;
+		if (result == Z_EOUTOFMEMORY) {
+			status = result;
+			for (i++; i < _count; i++) {
+				_rects[items[i].iIndex].x = -1;
+				_rects[items[i].iIndex].y = -1;
+			}
+			break;
+		}
+		status = Z_ERANGE;
+	}
+	free(items);
+	if (_lpPlaced)
+		*_lpPlaced = placed;
+	return status;
+}
+
+
+Float
+ZRectPack_GetOccupancy(
+	_In_ const ZRectPack* _lpPack) {
+
+	return (Float)((Real64)_lpPack->iUsedArea / 
+		((Real64)_lpPack->iWidth * (Real64)_lpPack->iHeight));
+}
+
+
+Int32
+ZRectPack_GetUsedHeight(
+	_In_ const ZRectPack* _lpPack) {
+
+	return _lpPack->iUsedHeight;
+}
+/*****************************************************************************/  
+//EOF
+/*****************************************************************************/  
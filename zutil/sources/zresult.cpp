@@ -121,6 +121,7 @@ ZResult_FromErrno(
 	case ENOMEM      : return Z_EOUTOFMEMORY;
 	case ENOSPC      : return Z_EUNSUPPORTED; 
 	case EPERM       : return Z_EPERMISSION;  
+	case ERANGE      : return Z_ERANGE;
 	case ETIMEDOUT   : return Z_ETIMEDOUT;
 	}
 	return Z_EFAIL;
@@ -0,0 +1,997 @@
+/******************************************************************************
+* zutil - C Utility Library
+* Copyright (C) 2017-2021 Zachary T Harris. All Rights Reserved.  
+* Zlib license.
+* 
+* File: zrng.c
+* Desc: Seedable pseudo random number generators
+*******************************************************************************
+
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+******************************************************************************/ 
+#include <math.h>
+#include <string.h>
+#include "zutil/zatomic.h"
+#include "zutil/zsimd.h"
+#include "zutil/zrng.h"
+
+
+
+#define ZRNG_PCGMULT  6364136223846793005ull
+#define ZRNG_FLOAT    (1.0f / 16777216.0f)         //2^-24
+#define ZRNG_REAL64   (1.0 / 9007199254740992.0)  //2^-53
+#define ZRNG_LANES    8   //interleaved generators of a bulk fill
+#define ZRNG_BLOCK    16  //32-bit values per step of the lanes
+#define ZRNG_FILLMIN  256 //smallest fill worth seeding the lanes for
+
+
+
+/*
+Bulk fills step ZRNG_LANES xoshiro256++ generators side by side, 
+ZRNGV_WIDTH of them per vector. Lane i writes its 64-bit output to
+values 2i (low half) and 2i + 1 (high half) of each block, which is
+what a little endian vector store of the lanes does, so every width
+produces the same values.*/
+#if (ZSIMD_AVX2)
+typedef __m256i ZRNGV;
+#  define ZRNGV_WIDTH 4
+#  define ZRngV_Load(p)         _mm256_loadu_si256((const __m256i*)(p))
+#  define ZRngV_Save(p, a)      _mm256_storeu_si256((__m256i*)(p), a)
+#  define ZRngV_Add(a, b)       _mm256_add_epi64(a, b)
+#  define ZRngV_Xor(a, b)       _mm256_xor_si256(a, b)
+#  define ZRngV_Shl(a, k)       _mm256_slli_epi64(a, k)
+#  define ZRngV_Shr(a, k)       _mm256_srli_epi64(a, k)
+#  define ZRngV_StoreU32(p, a)  _mm256_storeu_si256((__m256i*)(p), a)
+#  define ZRngV_StoreFloat(p, a)\
+     _mm256_storeu_ps(p, _mm256_mul_ps(_mm256_cvtepi32_ps(\
+       _mm256_srli_epi32(a, 8)), _mm256_set1_ps(ZRNG_FLOAT)))
+#elif (ZSIMD_SSE2)
+typedef __m128i ZRNGV;
+#  define ZRNGV_WIDTH 2
+#  define ZRngV_Load(p)         _mm_loadu_si128((const __m128i*)(p))
+#  define ZRngV_Save(p, a)      _mm_storeu_si128((__m128i*)(p), a)
+#  define ZRngV_Add(a, b)       _mm_add_epi64(a, b)
+#  define ZRngV_Xor(a, b)       _mm_xor_si128(a, b)
+#  define ZRngV_Shl(a, k)       _mm_slli_epi64(a, k)
+#  define ZRngV_Shr(a, k)       _mm_srli_epi64(a, k)
+#  define ZRngV_StoreU32(p, a)  _mm_storeu_si128((__m128i*)(p), a)
+#  define ZRngV_StoreFloat(p, a)\
+     _mm_storeu_ps(p, _mm_mul_ps(_mm_cvtepi32_ps(\
+       _mm_srli_epi32(a, 8)), _mm_set1_ps(ZRNG_FLOAT)))
+#elif (ZSIMD_NEON)
+typedef uint64x2_t ZRNGV;
+#  define ZRNGV_WIDTH 2
+#  define ZRngV_Load(p)         vld1q_u64(p)
+#  define ZRngV_Save(p, a)      vst1q_u64(p, a)
+#  define ZRngV_Add(a, b)       vaddq_u64(a, b)
+#  define ZRngV_Xor(a, b)       veorq_u64(a, b)
+#  define ZRngV_Shl(a, k)       vshlq_n_u64(a, k)
+#  define ZRngV_Shr(a, k)       vshrq_n_u64(a, k)
+#  define ZRngV_StoreU32(p, a)  vst1q_u32(p, vreinterpretq_u32_u64(a))
+#  define ZRngV_StoreFloat(p, a)\
+     vst1q_f32(p, vmulq_n_f32(vcvtq_f32_u32(\
+       vshrq_n_u32(vreinterpretq_u32_u64(a), 8)), ZRNG_FLOAT))
+#else
+typedef Uint64 ZRNGV;
+#  define ZRNGV_WIDTH 1
+#  define ZRngV_Load(p)         (*(p))
+#  define ZRngV_Save(p, a)      (*(p) = (a))
+#  define ZRngV_Add(a, b)       ((a) + (b))
+#  define ZRngV_Xor(a, b)       ((a) ^ (b))
+#  define ZRngV_Shl(a, k)       ((a) << (k))
+#  define ZRngV_Shr(a, k)       ((a) >> (k))
+#  define ZRngV_StoreU32(p, a)\
+     ((p)[0] = (Uint32)(a), (p)[1] = (Uint32)((a) >> 32))
+#  define ZRngV_StoreFloat(p, a)\
+     ((p)[0] = (Float)((Uint32)(a) >> 8) * ZRNG_FLOAT,\
+      (p)[1] = (Float)((Uint32)((a) >> 32) >> 8) * ZRNG_FLOAT)
+#endif
+#define ZRngV_Rotl(a, k) ZRngV_Xor(ZRngV_Shl(a, k), ZRngV_Shr(a, 64 - (k)))
+#define ZRNGV_COUNT      (ZRNG_LANES / ZRNGV_WIDTH)
+
+
+
+static THREADLOCAL ZRNG s_rng;      //default generator of the thread
+static THREADLOCAL Bool s_rngInit;  //s_rng has been seeded
+static ZATOMIC32        s_rngCount; //threads that have seeded s_rng
+
+
+
+/* Section 1:
+** generators
+******************************************************************************/
+static FORCEINLINE Uint64
+ZRng_Rotl(
+	_In_ Uint64 _x,
+	_In_ Int32  _k) {
+
+	return (_x << _k) | (_x >> (64 - _k));
+}
+
+
+static FORCEINLINE Uint64
+ZRng_SplitMix64(
+	_Inout_ Uint64* _lpState) {
+
+	Uint64 z;
+	z = (*_lpState += 0x9E3779B97F4A7C15ull);
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+	return z ^ (z >> 31);
+}
+
+
+static FORCEINLINE Uint64
+ZRng_Xoshiro(
+	_Inout_ Uint64* _s) {
+
+	Uint64 result, t;
+	result = ZRng_Rotl(_s[0] + _s[3], 23) + _s[0];
+	t      = _s[1] << 17;
+	_s[2] ^= _s[0];
+	_s[3] ^= _s[1];
+	_s[1] ^= _s[2];
+	_s[0] ^= _s[3];
+	_s[2] ^= t;
+	_s[3]  = ZRng_Rotl(_s[3], 45);
+	return result;
+}
+
+
+static FORCEINLINE Uint32
+ZRng_Pcg(
+	_Inout_ ZRNG* _lpRng) {
+
+	Uint64 old;
+	Uint32 xorshifted, rot;
+	old = _lpRng->pcg.state;
+	_lpRng->pcg.state = old * ZRNG_PCGMULT + _lpRng->pcg.inc;
+	xorshifted = (Uint32)(((old >> 18) ^ old) >> 27);
+	rot        = (Uint32)(old >> 59);
+	return (xorshifted >> rot) | (xorshifted << ((0 - rot) & 31));
+}
+
+
+/*
+Jumps a xoshiro256++ state by the polynomial in _poly*/
+static Void
+ZRng_XoshiroJump(
+	_Inout_ Uint64*       _s,
+	_In_    const Uint64* _poly) {
+
+	Uint64 t[4] = { 0, 0, 0, 0 };
+	Int32 i, b;
+	for (i = 0; i < 4; i++) {
+		for (b = 0; b < 64; b++) {
+			if (_poly[i] & (1ull << b)) {
+				t[0] ^= _s[0];
+				t[1] ^= _s[1];
+				t[2] ^= _s[2];
+				t[3] ^= _s[3];
+			}
+			ZRng_Xoshiro(_s);
+		}
+	}
+	memcpy(_s, t, sizeof(t));
+}
+
+
+/*
+Advances a PCG32 state by _delta steps in O(log _delta)*/
+static Void
+ZRng_PcgAdvance(
+	_Inout_ ZRNG*  _lpRng,
+	_In_    Uint64 _delta) {
+
+	Uint64 curMult, curPlus, accMult, accPlus;
+	curMult = ZRNG_PCGMULT;
+	curPlus = _lpRng->pcg.inc;
+	accMult = 1;
+	accPlus = 0;
+	while (_delta) {
+		if (_delta & 1) {
+			accMult *= curMult;
+			accPlus  = accPlus * curMult + curPlus;
+		}
+		curPlus  = (curMult + 1) * curPlus;
+		curMult *= curMult;
+		_delta >>= 1;
+	}
+	_lpRng->pcg.state = accMult * _lpRng->pcg.state + accPlus;
+}
+
+
+
+
+/* Section 2:
+** bulk fills
+******************************************************************************/
+/*
+Runs _blocks steps of the lanes, writing ZRNG_BLOCK 32-bit integers or
+Floats per step*/
+static Void
+ZRng_FillLanes(
+	_Inout_ Uint64 _lanes[4][ZRNG_LANES],
+	_Out_   Handle _dst,
+	_In_    SizeT  _blocks,
+	_In_    Bool   _float) {
+
+	ZRNGV s0[ZRNGV_COUNT], s1[ZRNGV_COUNT];
+	ZRNGV s2[ZRNGV_COUNT], s3[ZRNGV_COUNT];
+	ZRNGV r, t;
+	Uint32* u;
+	Float* f;
+	SizeT i, j;
+	u = (Uint32*)_dst;
+	f = (Float*)_dst;
+	for (j = 0; j < ZRNGV_COUNT; j++) {
+		s0[j] = ZRngV_Load(&_lanes[0][j * ZRNGV_WIDTH]);
+		s1[j] = ZRngV_Load(&_lanes[1][j * ZRNGV_WIDTH]);
+		s2[j] = ZRngV_Load(&_lanes[2][j * ZRNGV_WIDTH]);
+		s3[j] = ZRngV_Load(&_lanes[3][j * ZRNGV_WIDTH]);
+	}
+	for (i = 0; i < _blocks; i++) {
+		for (j = 0; j < ZRNGV_COUNT; j++) {
+			r = ZRngV_Add(ZRngV_Rotl(ZRngV_Add(s0[j], s3[j]), 23), s0[j]);
+			t = ZRngV_Shl(s1[j], 17);
+			s2[j] = ZRngV_Xor(s2[j], s0[j]);
+			s3[j] = ZRngV_Xor(s3[j], s1[j]);
+			s1[j] = ZRngV_Xor(s1[j], s2[j]);
+			s0[j] = ZRngV_Xor(s0[j], s3[j]);
+			s2[j] = ZRngV_Xor(s2[j], t);
+			s3[j] = ZRngV_Rotl(s3[j], 45);
+			if (_float)
+				ZRngV_StoreFloat(f + j * 2 * ZRNGV_WIDTH, r);
+			else ZRngV_StoreU32(u + j * 2 * ZRNGV_WIDTH, r);
+		}
+		u += ZRNG_BLOCK;
+		f += ZRNG_BLOCK;
+	}
+	for (j = 0; j < ZRNGV_COUNT; j++) {
+		ZRngV_Save(&_lanes[0][j * ZRNGV_WIDTH], s0[j]);
+		ZRngV_Save(&_lanes[1][j * ZRNGV_WIDTH], s1[j]);
+		ZRngV_Save(&_lanes[2][j * ZRNGV_WIDTH], s2[j]);
+		ZRngV_Save(&_lanes[3][j * ZRNGV_WIDTH], s3[j]);
+	}
+}
+
+
+/*
+Seeds the lanes of a bulk fill from a generator*/
+static Void
+ZRng_SeedLanes(
+	_Inout_ ZRNG*  _lpRng,
+	_Out_   Uint64 _lanes[4][ZRNG_LANES]) {
+
+	Uint64 seed;
+	SizeT i;
+	for (i = 0; i < ZRNG_LANES; i++) {
+		seed = ZRng_NextU64(_lpRng);
+		_lanes[0][i] = ZRng_SplitMix64(&seed);
+		_lanes[1][i] = ZRng_SplitMix64(&seed);
+		_lanes[2][i] = ZRng_SplitMix64(&seed);
+		_lanes[3][i] = ZRng_SplitMix64(&seed);
+	}
+}
+
+
+static Void
+ZRng_Fill(
+	_Inout_ ZRNG*  _lpRng,
+	_Out_   Handle _dst,
+	_In_    SizeT  _count,
+	_In_    Bool   _float) {
+
+	Uint64 lanes[4][ZRNG_LANES];
+	Uint32 tail[ZRNG_BLOCK];
+	SizeT i, blocks;
+	if (_lpRng->eType != ZRNG_XOSHIRO256PP || _count < ZRNG_FILLMIN) {
+		for (i = 0; i < _count; i++) {
+			if (_float)
+				((Float*)_dst)[i] = ZRng_NextFloat(_lpRng);
+			else ((Uint32*)_dst)[i] = ZRng_NextU32(_lpRng);
+		}
+		return;
+	}
+	ZRng_SeedLanes(_lpRng, lanes);
+	blocks = _count / ZRNG_BLOCK;
+	ZRng_FillLanes(lanes, _dst, blocks, _float);
+	if (_count > blocks * ZRNG_BLOCK) {
+		ZRng_FillLanes(lanes, tail, 1, _float);
+		memcpy((Uint32*)_dst + blocks * ZRNG_BLOCK, tail,
+			(_count - blocks * ZRNG_BLOCK) * sizeof(Uint32));
+	}
+}
+
+
+
+
+/* Section 3:
+** distributions
+******************************************************************************/
+/*
+Ziggurat tables of Marsaglia and Tsang for the normal distribution 
+(128 layers, tail at ZRNG_NORMALR) and the exponential distribution
+(256 layers, tail at ZRNG_EXPR). A draw takes the layer from the low 
+bits of a random integer and a 24-bit value from the bits above, kept
+apart so the value does not depend on the layer, and scales the value
+by the layer width. It is accepted when it lands inside the layer's 
+rectangle, which happens for about 99% of draws. Thresholds (k) and 
+widths (w) are per unit of the 24-bit value, and f holds the density
+at each layer edge.*/
+#define ZRNG_NORMALR 3.442620f
+#define ZRNG_EXPR    7.697117f
+#define ZRNG_CHUNK   256 //values transformed per step of a distribution fill
+
+static const Int32 s_kn[128] = {
+	0x00ED5A44, 0x00000000, 0x00C01E36, 0x00D9C88F, 0x00E4B68D, 0x00EAC00A,
+	0x00EE9243, 0x00F1344B, 0x00F3208B, 0x00F4979C, 0x00F5BEC5, 0x00F6AD05,
+	0x00F77151, 0x00F815CE, 0x00F8A199, 0x00F919D8, 0x00F98259, 0x00F9DDFD,
+	0x00FA2EFC, 0x00FA7711, 0x00FAB79C, 0x00FAF1BA, 0x00FB2651, 0x00FB561C,
+	0x00FB81BA, 0x00FBA9AD, 0x00FBCE63, 0x00FBF039, 0x00FC0F81, 0x00FC2C7D,
+	0x00FC476B, 0x00FC607B, 0x00FC77DD, 0x00FC8DB6, 0x00FCA22A, 0x00FCB557,
+	0x00FCC757, 0x00FCD844, 0x00FCE832, 0x00FCF734, 0x00FD055B, 0x00FD12B8,
+	0x00FD1F58, 0x00FD2B47, 0x00FD3692, 0x00FD4141, 0x00FD4B60, 0x00FD54F5,
+	0x00FD5E09, 0x00FD66A4, 0x00FD6ECB, 0x00FD7684, 0x00FD7DD5, 0x00FD84C4,
+	0x00FD8B53, 0x00FD9188, 0x00FD9766, 0x00FD9CF1, 0x00FDA22C, 0x00FDA71A,
+	0x00FDABBE, 0x00FDB019, 0x00FDB42E, 0x00FDB800, 0x00FDBB8F, 0x00FDBEDD,
+	0x00FDC1EC, 0x00FDC4BD, 0x00FDC751, 0x00FDC9A8, 0x00FDCBC4, 0x00FDCDA5,
+	0x00FDCF4C, 0x00FDD0B8, 0x00FDD1E9, 0x00FDD2E0, 0x00FDD39C, 0x00FDD41D,
+	0x00FDD462, 0x00FDD46A, 0x00FDD435, 0x00FDD3C0, 0x00FDD30C, 0x00FDD215,
+	0x00FDD0DA, 0x00FDCF58, 0x00FDCD8E, 0x00FDCB79, 0x00FDC914, 0x00FDC65D,
+	0x00FDC350, 0x00FDBFE8, 0x00FDBC1F, 0x00FDB7F1, 0x00FDB357, 0x00FDAE49,
+	0x00FDA8BF, 0x00FDA2B0, 0x00FD9C12, 0x00FD94D9, 0x00FD8CF7, 0x00FD845D,
+	0x00FD7AFA, 0x00FD70B8, 0x00FD6580, 0x00FD5938, 0x00FD4BBE, 0x00FD3CED,
+	0x00FD2C98, 0x00FD1A89, 0x00FD0680, 0x00FCF02E, 0x00FCD732, 0x00FCBB14,
+	0x00FC9B3B, 0x00FC76E6, 0x00FC4D18, 0x00FC1C7F, 0x00FBE354, 0x00FB9F18,
+	0x00FB4C34, 0x00FAE541, 0x00FA61C1, 0x00F9B369, 0x00F8C01E, 0x00F75217,
+	0x00F4E442, 0x00EFACC9
+};
+
+static const Float s_wn[128] = {
+	2.2131718e-07f, 1.62315885e-08f, 2.16288232e-08f, 2.54242405e-08f,
+	2.84575119e-08f, 3.10335189e-08f, 3.33006476e-08f, 3.53433443e-08f,
+	3.72146722e-08f, 3.89503612e-08f, 4.05757383e-08f, 4.21094661e-08f,
+	4.35657448e-08f, 4.49556516e-08f, 4.62880116e-08f, 4.75699942e-08f,
+	4.88074967e-08f, 5.00054504e-08f, 5.11680156e-08f, 5.2298752e-08f,
+	5.3400715e-08f, 5.44765726e-08f, 5.55286519e-08f, 5.65590028e-08f,
+	5.75694479e-08f, 5.85616107e-08f, 5.95369478e-08f, 6.04967738e-08f,
+	6.14422717e-08f, 6.23745251e-08f, 6.32945287e-08f, 6.42031779e-08f,
+	6.51013181e-08f, 6.59897097e-08f, 6.68690774e-08f, 6.77400749e-08f,
+	6.86033275e-08f, 6.94594178e-08f, 7.03088858e-08f, 7.11522503e-08f,
+	7.19900015e-08f, 7.28225871e-08f, 7.36504475e-08f, 7.44740092e-08f,
+	7.52936558e-08f, 7.61097851e-08f, 7.69227526e-08f, 7.77329134e-08f,
+	7.85406087e-08f, 7.93461794e-08f, 8.01499311e-08f, 8.09521978e-08f,
+	8.17532637e-08f, 8.25534485e-08f, 8.33530365e-08f, 8.4152326e-08f,
+	8.49515942e-08f, 8.57511324e-08f, 8.65512249e-08f, 8.73521557e-08f,
+	8.81541951e-08f, 8.89576341e-08f, 8.97627501e-08f, 9.05698272e-08f,
+	9.13791567e-08f, 9.21910299e-08f, 9.30057311e-08f, 9.38235658e-08f,
+	9.46448395e-08f, 9.54698578e-08f, 9.62989404e-08f, 9.71324141e-08f,
+	9.7970613e-08f, 9.88138851e-08f, 9.96625857e-08f, 1.00517084e-07f,
+	1.01377765e-07f, 1.02245018e-07f, 1.03119262e-07f, 1.04000932e-07f,
+	1.04890482e-07f, 1.05788374e-07f, 1.06695111e-07f, 1.07611228e-07f,
+	1.08537257e-07f, 1.09473795e-07f, 1.10421446e-07f, 1.11380885e-07f,
+	1.12352794e-07f, 1.13337912e-07f, 1.14337048e-07f, 1.15351035e-07f,
+	1.16380797e-07f, 1.17427305e-07f, 1.18491627e-07f, 1.19574892e-07f,
+	1.20678365e-07f, 1.21803382e-07f, 1.22951406e-07f, 1.24124071e-07f,
+	1.25323126e-07f, 1.26550532e-07f, 1.27808462e-07f, 1.29099291e-07f,
+	1.30425718e-07f, 1.31790728e-07f, 1.33197688e-07f, 1.34650449e-07f,
+	1.36153346e-07f, 1.37711382e-07f, 1.39330339e-07f, 1.41016926e-07f,
+	1.42779015e-07f, 1.44625943e-07f, 1.46568908e-07f, 1.48621467e-07f,
+	1.50800332e-07f, 1.53126336e-07f, 1.55626068e-07f, 1.5833416e-07f,
+	1.61296938e-07f, 1.64578523e-07f, 1.68271384e-07f, 1.72516351e-07f,
+	1.77544138e-07f, 1.83774759e-07f, 1.92110832e-07f, 2.0519613e-07f
+};
+
+static const Float s_fn[128] = {
+	1.0f, 0.963599682f, 0.936282694f, 0.913043618f,
+	0.892281651f, 0.873243034f, 0.855500579f, 0.838783622f,
+	0.822907209f, 0.807738304f, 0.793177009f, 0.779146075f,
+	0.765584171f, 0.752441585f, 0.73967725f, 0.727256894f,
+	0.715151489f, 0.70333612f, 0.69178915f, 0.680491865f,
+	0.669427693f, 0.658581972f, 0.647941828f, 0.637495458f,
+	0.627232492f, 0.617143393f, 0.607219517f, 0.597453177f,
+	0.58783704f, 0.57836467f, 0.569029987f, 0.559827387f,
+	0.550751805f, 0.541798353f, 0.53296268f, 0.524240553f,
+	0.515628219f, 0.50712204f, 0.498718649f, 0.490414828f,
+	0.482207656f, 0.474094301f, 0.466072142f, 0.458138704f,
+	0.450291634f, 0.442528725f, 0.434847832f, 0.427246988f,
+	0.419724345f, 0.412278026f, 0.404906422f, 0.397607863f,
+	0.3903808f, 0.383223802f, 0.376135468f, 0.369114459f,
+	0.362159491f, 0.355269372f, 0.348442972f, 0.341679156f,
+	0.334976852f, 0.328335106f, 0.321752906f, 0.315229386f,
+	0.308763623f, 0.302354842f, 0.29600215f, 0.289704859f,
+	0.283462197f, 0.277273506f, 0.271138072f, 0.265055299f,
+	0.25902456f, 0.253045291f, 0.247116953f, 0.241238996f,
+	0.235410944f, 0.229632318f, 0.223902702f, 0.21822165f,
+	0.212588772f, 0.207003713f, 0.201466113f, 0.195975646f,
+	0.190532044f, 0.185134992f, 0.179784268f, 0.174479634f,
+	0.169220895f, 0.164007857f, 0.158840373f, 0.153718308f,
+	0.148641571f, 0.143610075f, 0.138623774f, 0.133682653f,
+	0.128786713f, 0.123935983f, 0.119130544f, 0.11437051f,
+	0.109656021f, 0.104987256f, 0.100364439f, 0.0957878456f,
+	0.0912578031f, 0.0867746696f, 0.0823388994f, 0.0779509842f,
+	0.0736115053f, 0.0693211183f, 0.0650805831f, 0.0608907714f,
+	0.0567526631f, 0.0526674017f, 0.0486362949f, 0.0446608625f,
+	0.0407428667f, 0.0368843898f, 0.0330878869f, 0.0293563176f,
+	0.0256932918f, 0.022103304f, 0.0185921025f, 0.0151672978f,
+	0.0118394783f, 0.00862448476f, 0.00554899499f, 0.00266962918f
+};
+
+static const Int32 s_ke[256] = {
+	0x00E290A1, 0x00000000, 0x009BEADE, 0x00C377AC, 0x00D4DDB9, 0x00DE893F,
+	0x00E4A8E8, 0x00E8DFF1, 0x00EBF2DE, 0x00EE49A6, 0x00F0204E, 0x00F19BDB,
+	0x00F2D458, 0x00F3DA10, 0x00F4B86D, 0x00F577AD, 0x00F61DE8, 0x00F6AFB7,
+	0x00F730A5, 0x00F7A376, 0x00F80A5B, 0x00F86718, 0x00F8BB1B, 0x00F90790,
+	0x00F94D70, 0x00F98D8C, 0x00F9C892, 0x00F9FF17, 0x00FA3199, 0x00FA6085,
+	0x00FA8C3A, 0x00FAB508, 0x00FADB36, 0x00FAFF04, 0x00FB20A6, 0x00FB404F,
+	0x00FB5E29, 0x00FB7A59, 0x00FB9503, 0x00FBAE44, 0x00FBC638, 0x00FBDCF8,
+	0x00FBF29A, 0x00FC0731, 0x00FC1AD1, 0x00FC2D8B, 0x00FC3F6C, 0x00FC5083,
+	0x00FC60DD, 0x00FC7086, 0x00FC7F88, 0x00FC8DEC, 0x00FC9BBD, 0x00FCA902,
+	0x00FCB5C3, 0x00FCC208, 0x00FCCDD7, 0x00FCD935, 0x00FCE42A, 0x00FCEEBA,
+	0x00FCF8EB, 0x00FD02C0, 0x00FD0C3F, 0x00FD156B, 0x00FD1E48, 0x00FD26DA,
+	0x00FD2F25, 0x00FD372A, 0x00FD3EEE, 0x00FD4673, 0x00FD4DBC, 0x00FD54CB,
+	0x00FD5BA2, 0x00FD6245, 0x00FD68B4, 0x00FD6EF1, 0x00FD7500, 0x00FD7AE1,
+	0x00FD8096, 0x00FD8620, 0x00FD8B82, 0x00FD90BC, 0x00FD95D1, 0x00FD9AC1,
+	0x00FD9F8D, 0x00FDA437, 0x00FDA8BF, 0x00FDAD28, 0x00FDB171, 0x00FDB59C,
+	0x00FDB9A9, 0x00FDBD9B, 0x00FDC170, 0x00FDC52B, 0x00FDC8CC, 0x00FDCC54,
+	0x00FDCFC3, 0x00FDD319, 0x00FDD659, 0x00FDD982, 0x00FDDC94, 0x00FDDF91,
+	0x00FDE279, 0x00FDE54D, 0x00FDE80C, 0x00FDEAB7, 0x00FDED50, 0x00FDEFD5,
+	0x00FDF248, 0x00FDF4AA, 0x00FDF6F9, 0x00FDF937, 0x00FDFB64, 0x00FDFD81,
+	0x00FDFF8D, 0x00FE018A, 0x00FE0376, 0x00FE0553, 0x00FE0721, 0x00FE08DF,
+	0x00FE0A8F, 0x00FE0C30, 0x00FE0DC3, 0x00FE0F48, 0x00FE10BF, 0x00FE1228,
+	0x00FE1383, 0x00FE14D1, 0x00FE1611, 0x00FE1745, 0x00FE186B, 0x00FE1984,
+	0x00FE1A90, 0x00FE1B8F, 0x00FE1C82, 0x00FE1D68, 0x00FE1E42, 0x00FE1F0F,
+	0x00FE1FCF, 0x00FE2083, 0x00FE212B, 0x00FE21C7, 0x00FE2256, 0x00FE22D9,
+	0x00FE234F, 0x00FE23BA, 0x00FE2418, 0x00FE2469, 0x00FE24AF, 0x00FE24E8,
+	0x00FE2514, 0x00FE2534, 0x00FE2547, 0x00FE254E, 0x00FE2548, 0x00FE2535,
+	0x00FE2515, 0x00FE24E8, 0x00FE24AE, 0x00FE2466, 0x00FE2411, 0x00FE23AF,
+	0x00FE233E, 0x00FE22C0, 0x00FE2233, 0x00FE2198, 0x00FE20EE, 0x00FE2035,
+	0x00FE1F6D, 0x00FE1E96, 0x00FE1DAE, 0x00FE1CB7, 0x00FE1BB0, 0x00FE1A97,
+	0x00FE196E, 0x00FE1832, 0x00FE16E5, 0x00FE1586, 0x00FE1414, 0x00FE128E,
+	0x00FE10F5, 0x00FE0F47, 0x00FE0D84, 0x00FE0BAC, 0x00FE09BD, 0x00FE07B7,
+	0x00FE059A, 0x00FE0364, 0x00FE0115, 0x00FDFEAB, 0x00FDFC26, 0x00FDF986,
+	0x00FDF6C8, 0x00FDF3EC, 0x00FDF0F0, 0x00FDEDD3, 0x00FDEA95, 0x00FDE733,
+	0x00FDE3AB, 0x00FDDFFD, 0x00FDDC27, 0x00FDD826, 0x00FDD3F9, 0x00FDCF9D,
+	0x00FDCB11, 0x00FDC651, 0x00FDC15B, 0x00FDBC2C, 0x00FDB6C2, 0x00FDB117,
+	0x00FDAB2A, 0x00FDA4F5, 0x00FD9E76, 0x00FD97A6, 0x00FD9081, 0x00FD8901,
+	0x00FD8121, 0x00FD78D9, 0x00FD7022, 0x00FD66F4, 0x00FD5D47, 0x00FD530F,
+	0x00FD4843, 0x00FD3CD5, 0x00FD30B9, 0x00FD23DE, 0x00FD1634, 0x00FD07A7,
+	0x00FCF821, 0x00FCE789, 0x00FCD5C2, 0x00FCC2AA, 0x00FCAE1D, 0x00FC97ED,
+	0x00FC7FE6, 0x00FC65CC, 0x00FC4957, 0x00FC2A2F, 0x00FC07EE, 0x00FBE213,
+	0x00FBB805, 0x00FB8900, 0x00FB5411, 0x00FB1800, 0x00FAD334, 0x00FA8392,
+	0x00FA263B, 0x00F9B72D, 0x00F930A1, 0x00F889F0, 0x00F7B577, 0x00F69C65,
+	0x00F51530, 0x00F2CB0E, 0x00EEEFB1, 0x00E6DA6E
+};
+
+static const Float s_we[256] = {
+	5.18388617e-07f, 3.80588538e-09f, 6.24886187e-09f, 8.18401436e-09f,
+	9.84237314e-09f, 1.13224203e-08f, 1.26762094e-08f, 1.39349989e-08f,
+	1.51192161e-08f, 1.62430513e-08f, 1.73168164e-08f, 1.8348274e-08f,
+	1.93434424e-08f, 2.03070929e-08f, 2.1243082e-08f, 2.21545786e-08f,
+	2.30442279e-08f, 2.3914259e-08f, 2.47665746e-08f, 2.56028141e-08f,
+	2.64244004e-08f, 2.72325771e-08f, 2.80284453e-08f, 2.88129733e-08f,
+	2.95870333e-08f, 3.03513978e-08f, 3.11067723e-08f, 3.18537872e-08f,
+	3.25930181e-08f, 3.33249908e-08f, 3.40501849e-08f, 3.4769041e-08f,
+	3.5481964e-08f, 3.61893306e-08f, 3.6891489e-08f, 3.75887552e-08f,
+	3.82814385e-08f, 3.89698123e-08f, 3.96541431e-08f, 4.0334676e-08f,
+	4.10116385e-08f, 4.16852508e-08f, 4.23557189e-08f, 4.30232348e-08f,
+	4.36879795e-08f, 4.43501307e-08f, 4.50098518e-08f, 4.56672957e-08f,
+	4.63226222e-08f, 4.69759627e-08f, 4.76274593e-08f, 4.82772435e-08f,
+	4.89254361e-08f, 4.95721615e-08f, 5.02175297e-08f, 5.0861658e-08f,
+	5.15046494e-08f, 5.2146607e-08f, 5.27876303e-08f, 5.34278151e-08f,
+	5.40672573e-08f, 5.47060495e-08f, 5.53442696e-08f, 5.59820137e-08f,
+	5.66193563e-08f, 5.72563827e-08f, 5.78931711e-08f, 5.85297961e-08f,
+	5.91663358e-08f, 5.98028649e-08f, 6.04394472e-08f, 6.10761575e-08f,
+	6.17130667e-08f, 6.23502387e-08f, 6.29877448e-08f, 6.36256487e-08f,
+	6.42640074e-08f, 6.49028991e-08f, 6.55423733e-08f, 6.61825013e-08f,
+	6.68233398e-08f, 6.74649456e-08f, 6.81073828e-08f, 6.87507082e-08f,
+	6.93949858e-08f, 7.00402651e-08f, 7.06866174e-08f, 7.13340853e-08f,
+	7.19827327e-08f, 7.26326235e-08f, 7.32838004e-08f, 7.39363344e-08f,
+	7.45902753e-08f, 7.52456728e-08f, 7.5902598e-08f, 7.65610935e-08f,
+	7.72212232e-08f, 7.7883044e-08f, 7.85466057e-08f, 7.92119721e-08f,
+	7.98792001e-08f, 8.05483396e-08f, 8.12194614e-08f, 8.18926083e-08f,
+	8.25678441e-08f, 8.32452329e-08f, 8.39248244e-08f, 8.46066825e-08f,
+	8.52908641e-08f, 8.59774403e-08f, 8.66664536e-08f, 8.73579822e-08f,
+	8.80520759e-08f, 8.87487985e-08f, 8.94482213e-08f, 9.0150408e-08f,
+	9.08554156e-08f, 9.1563308e-08f, 9.22741634e-08f, 9.29880457e-08f,
+	9.37050117e-08f, 9.44251468e-08f, 9.51485077e-08f, 9.58751727e-08f,
+	9.66052127e-08f, 9.73386989e-08f, 9.80757164e-08f, 9.88163293e-08f,
+	9.95606158e-08f, 1.00308661e-07f, 1.01060543e-07f, 1.0181634e-07f,
+	1.02576138e-07f, 1.03340021e-07f, 1.04108075e-07f, 1.04880385e-07f,
+	1.05657051e-07f, 1.06438158e-07f, 1.07223798e-07f, 1.08014063e-07f,
+	1.08809061e-07f, 1.09608884e-07f, 1.10413644e-07f, 1.11223429e-07f,
+	1.12038364e-07f, 1.12858544e-07f, 1.13684088e-07f, 1.1451511e-07f,
+	1.15351725e-07f, 1.16194052e-07f, 1.17042227e-07f, 1.17896363e-07f,
+	1.18756589e-07f, 1.19623053e-07f, 1.20495869e-07f, 1.21375209e-07f,
+	1.22261184e-07f, 1.23153967e-07f, 1.24053713e-07f, 1.2496055e-07f,
+	1.25874678e-07f, 1.26796223e-07f, 1.27725386e-07f, 1.28662336e-07f,
+	1.29607258e-07f, 1.30560338e-07f, 1.31521759e-07f, 1.32491735e-07f,
+	1.33470465e-07f, 1.34458176e-07f, 1.35455068e-07f, 1.36461367e-07f,
+	1.37477329e-07f, 1.38503182e-07f, 1.39539196e-07f, 1.40585598e-07f,
+	1.41642701e-07f, 1.42710746e-07f, 1.43790061e-07f, 1.44880914e-07f,
+	1.45983634e-07f, 1.47098547e-07f, 1.48225979e-07f, 1.49366301e-07f,
+	1.50519867e-07f, 1.51687061e-07f, 1.52868282e-07f, 1.54063926e-07f,
+	1.55274449e-07f, 1.56500278e-07f, 1.57741908e-07f, 1.58999796e-07f,
+	1.60274482e-07f, 1.61566504e-07f, 1.62876404e-07f, 1.64204792e-07f,
+	1.65552265e-07f, 1.66919492e-07f, 1.68307139e-07f, 1.69715932e-07f,
+	1.71146638e-07f, 1.72600011e-07f, 1.74076931e-07f, 1.75578265e-07f,
+	1.77104937e-07f, 1.78657942e-07f, 1.80238331e-07f, 1.81847213e-07f,
+	1.83485753e-07f, 1.85155216e-07f, 1.86856923e-07f, 1.88592281e-07f,
+	1.90362812e-07f, 1.9217012e-07f, 1.94015939e-07f, 1.95902118e-07f,
+	1.97830644e-07f, 1.99803651e-07f, 2.0182344e-07f, 2.03892498e-07f,
+	2.06013496e-07f, 2.08189348e-07f, 2.10423224e-07f, 2.12718561e-07f,
+	2.15079112e-07f, 2.17508997e-07f, 2.20012723e-07f, 2.22595261e-07f,
+	2.25262099e-07f, 2.28019317e-07f, 2.30873681e-07f, 2.3383275e-07f,
+	2.36904981e-07f, 2.40099951e-07f, 2.43428417e-07f, 2.46902744e-07f,
+	2.50537028e-07f, 2.54347469e-07f, 2.58352969e-07f, 2.62575611e-07f,
+	2.67041429e-07f, 2.71781516e-07f, 2.76833276e-07f, 2.82242468e-07f,
+	2.8806565e-07f, 2.94374047e-07f, 3.01259064e-07f, 3.08840697e-07f,
+	3.17280922e-07f, 3.26805747e-07f, 3.37744353e-07f, 3.50603131e-07f,
+	3.66220746e-07f, 3.86141437e-07f, 4.13717856e-07f, 4.58783944e-07f
+};
+
+static const Float s_fe[256] = {
+	1.0f, 0.938143671f, 0.900469959f, 0.87170434f,
+	0.847785473f, 0.826993287f, 0.808421671f, 0.791527629f,
+	0.775956869f, 0.761463404f, 0.747868598f, 0.735038102f,
+	0.722867668f, 0.711274743f, 0.70019263f, 0.689566493f,
+	0.679350555f, 0.669506311f, 0.660000861f, 0.650805831f,
+	0.641896725f, 0.633251965f, 0.624852717f, 0.616682172f,
+	0.608725369f, 0.600968957f, 0.593400896f, 0.586010337f,
+	0.578787386f, 0.571723044f, 0.564809203f, 0.558038294f,
+	0.551403403f, 0.544898212f, 0.538516879f, 0.532253861f,
+	0.526104212f, 0.520063162f, 0.51412642f, 0.508289754f,
+	0.502549529f, 0.496901989f, 0.491343856f, 0.485872f,
+	0.480483353f, 0.475175202f, 0.469944835f, 0.464789748f,
+	0.459707618f, 0.454696149f, 0.449753255f, 0.444876879f,
+	0.440065116f, 0.435316116f, 0.430628151f, 0.425999552f,
+	0.42142874f, 0.416914195f, 0.412454456f, 0.408048183f,
+	0.403694004f, 0.399390697f, 0.395136982f, 0.390931726f,
+	0.386773825f, 0.382662177f, 0.378595769f, 0.374573559f,
+	0.370594651f, 0.366658092f, 0.362762988f, 0.358908474f,
+	0.355093747f, 0.351318002f, 0.347580492f, 0.343880445f,
+	0.340217143f, 0.336589903f, 0.332998067f, 0.329440951f,
+	0.325917959f, 0.322428495f, 0.318971902f, 0.315547675f,
+	0.312155247f, 0.308794081f, 0.305463612f, 0.302163392f,
+	0.298892915f, 0.295651704f, 0.292439282f, 0.289255232f,
+	0.286099076f, 0.282970428f, 0.279868841f, 0.276793927f,
+	0.273745298f, 0.270722598f, 0.267725408f, 0.264753431f,
+	0.26180625f, 0.258883536f, 0.255985022f, 0.25311029f,
+	0.250259072f, 0.24743107f, 0.244625971f, 0.241843462f,
+	0.23908329f, 0.236345157f, 0.23362878f, 0.23093392f,
+	0.228260294f, 0.225607663f, 0.222975761f, 0.220364377f,
+	0.217773244f, 0.215202153f, 0.212650865f, 0.210119158f,
+	0.207606822f, 0.205113649f, 0.202639446f, 0.200183973f,
+	0.197747067f, 0.195328519f, 0.19292815f, 0.190545768f,
+	0.188181207f, 0.185834259f, 0.18350479f, 0.181192607f,
+	0.178897545f, 0.176619455f, 0.174358174f, 0.172113538f,
+	0.169885397f, 0.167673618f, 0.165478036f, 0.163298532f,
+	0.161134943f, 0.158987135f, 0.156854987f, 0.154738367f,
+	0.152637139f, 0.150551185f, 0.148480371f, 0.146424592f,
+	0.144383729f, 0.142357647f, 0.140346244f, 0.138349429f,
+	0.136367068f, 0.134399071f, 0.13244532f, 0.130505741f,
+	0.128580198f, 0.126668632f, 0.124770917f, 0.122886978f,
+	0.121016718f, 0.119160056f, 0.117316902f, 0.115487166f,
+	0.113670766f, 0.111867629f, 0.110077679f, 0.108300827f,
+	0.106537007f, 0.104786143f, 0.103048161f, 0.101323001f,
+	0.099610582f, 0.0979108512f, 0.0962237418f, 0.0945491865f,
+	0.0928871334f, 0.0912375152f, 0.0896002799f, 0.0879753754f,
+	0.0863627419f, 0.0847623274f, 0.0831740946f, 0.0815979838f,
+	0.0800339505f, 0.0784819499f, 0.0769419447f, 0.0754138902f,
+	0.0738977492f, 0.0723934844f, 0.0709010586f, 0.0694204345f,
+	0.0679515898f, 0.0664944947f, 0.0650491193f, 0.0636154339f,
+	0.0621934161f, 0.0607830472f, 0.059384305f, 0.0579971746f,
+	0.0566216409f, 0.0552576892f, 0.053905312f, 0.0525644943f,
+	0.0512352362f, 0.049917534f, 0.0486113839f, 0.0473167934f,
+	0.0460337624f, 0.0447622985f, 0.0435024127f, 0.0422541238f,
+	0.0410174429f, 0.0397923924f, 0.0385789946f, 0.037377283f,
+	0.0361872837f, 0.0350090377f, 0.0338425823f, 0.0326879621f,
+	0.031545233f, 0.0304144435f, 0.0292956606f, 0.0281889495f,
+	0.0270943847f, 0.0260120463f, 0.0249420255f, 0.0238844212f,
+	0.0228393357f, 0.0218068883f, 0.0207872037f, 0.0197804235f,
+	0.0187867004f, 0.0178062003f, 0.0168391075f, 0.0158856213f,
+	0.0149459681f, 0.0140203917f, 0.0131091652f, 0.0122125922f,
+	0.0113310134f, 0.0104648098f, 0.0096144136f, 0.00878031459f,
+	0.00796307717f, 0.00716335326f, 0.0063819061f, 0.00561964232f,
+	0.00487765577f, 0.00415729498f, 0.00346026476f, 0.00278879888f,
+	0.00214596768f, 0.00153629982f, 0.000967269298f, 0.000454134366f
+};
+
+
+/*
+Returns a uniform Float in (0, 1), safe to take the log of*/
+static FORCEINLINE Float
+ZRng_Open(
+	_Inout_ ZRNG* _lpRng) {
+
+	return ((Float)(ZRng_NextU32(_lpRng) >> 8) + 0.5f) * ZRNG_FLOAT;
+}
+
+
+/*
+Returns a standard normal variate for the random integer _bits,
+drawing more integers from the generator when _bits is rejected*/
+static Float
+ZRng_Normal(
+	_Inout_ ZRNG*  _lpRng,
+	_In_    Uint32 _bits) {
+
+	Uint32 iz;
+	Int32 hz;
+	Float x, y;
+	for (;;) {
+		hz = (Int32)_bits >> 7; //signed 25-bit value
+		iz = _bits & 127;
+		if ((hz < 0 ? -hz : hz) < s_kn[iz])
+			return (Float)hz * s_wn[iz];
+		if (iz == 0) {
+			do {
+				x = -logf(ZRng_Open(_lpRng)) * (1.0f / ZRNG_NORMALR);
+				y = -logf(ZRng_Open(_lpRng));
+			} while (y + y < x * x);
+			return (hz > 0) ? ZRNG_NORMALR + x : -ZRNG_NORMALR - x;
+		}
+		x = (Float)hz * s_wn[iz];
+		if (s_fn[iz] + ZRng_Open(_lpRng) * (s_fn[iz - 1] - s_fn[iz]) <
+			expf(-0.5f * x * x))
+			return x;
+		_bits = ZRng_NextU32(_lpRng);
+	}
+}
+
+
+/*
+Returns an exponential variate of rate 1 for the random integer _bits,
+drawing more integers from the generator when _bits is rejected*/
+static Float
+ZRng_Exponential(
+	_Inout_ ZRNG*  _lpRng,
+	_In_    Uint32 _bits) {
+
+	Uint32 iz;
+	Int32 j;
+	Float x;
+	for (;;) {
+		iz = _bits & 255;
+		j  = (Int32)(_bits >> 8); //unsigned 24-bit value
+		if (j < s_ke[iz])
+			return (Float)j * s_we[iz];
+		if (iz == 0)
+			return ZRNG_EXPR - logf(ZRng_Open(_lpRng));
+		x = (Float)j * s_we[iz];
+		if (s_fe[iz] + ZRng_Open(_lpRng) * (s_fe[iz - 1] - s_fe[iz]) <
+			expf(-x))
+			return x;
+		_bits = ZRng_NextU32(_lpRng);
+	}
+}
+
+
+/*
+Turns random integers into variates. The AVX2 path gathers the layer 
+of eight integers at once and takes the rare rejected ones through 
+the scalar loop in index order, so it returns the same values and 
+draws the same integers from the generator as the scalar path*/
+static Void
+ZRng_Ziggurat(
+	_Inout_ ZRNG*         _lpRng,
+	_In_    const Uint32* _bits,
+	_Out_   Float*        _dst,
+	_In_    SizeT         _count,
+	_In_    Bool          _normal) {
+
+	SizeT i = 0, j;
+#if (ZSIMD_AVX2)
+	__m256i v, iz, k, ok;
+	__m256 w;
+	Uint32 miss;
+	for (; i + 8 <= _count; i += 8) {
+		v = _mm256_loadu_si256((const __m256i*)(_bits + i));
+		if (_normal) {
+			iz = _mm256_and_si256(v, _mm256_set1_epi32(127));
+			k  = _mm256_i32gather_epi32((const int*)s_kn, iz, 4);
+			w  = _mm256_i32gather_ps(s_wn, iz, 4);
+			v  = _mm256_srai_epi32(v, 7);
+			ok = _mm256_cmpgt_epi32(k, _mm256_abs_epi32(v));
+		}
+		else {
+			iz = _mm256_and_si256(v, _mm256_set1_epi32(255));
+			k  = _mm256_i32gather_epi32((const int*)s_ke, iz, 4);
+			w  = _mm256_i32gather_ps(s_we, iz, 4);
+			v  = _mm256_srli_epi32(v, 8);
+			ok = _mm256_cmpgt_epi32(k, v);
+		}
+		_mm256_storeu_ps(_dst + i, _mm256_mul_ps(_mm256_cvtepi32_ps(v), w));
+		miss = ~(Uint32)_mm256_movemask_ps(_mm256_castsi256_ps(ok)) & 0xFF;
+		for (j = 0; miss; j++, miss >>= 1) {
+			if (miss & 1) {
+				_dst[i + j] = _normal ?
+					ZRng_Normal(_lpRng, _bits[i + j]) :
+					ZRng_Exponential(_lpRng, _bits[i + j]);
+			}
+		}
+	}
+#endif
+	for (j = i; j < _count; j++) {
+		_dst[j] = _normal ?
+			ZRng_Normal(_lpRng, _bits[j]) :
+			ZRng_Exponential(_lpRng, _bits[j]);
+	}
+}
+
+
+/*
+Applies _dst * _scale + _offset*/
+static Void
+ZRng_Scale(
+	_Inout_ Float* _dst,
+	_In_    SizeT  _count,
+	_In_    Float  _scale,
+	_In_    Float  _offset) {
+
+	ZSIMDF scale, offset;
+	SizeT i;
+	scale  = ZSimd_Set1(_scale);
+	offset = ZSimd_Set1(_offset);
+	for (i = 0; i + ZSIMD_LANES <= _count; i += ZSIMD_LANES) {
+		ZSimd_Store(_dst + i, 
+			ZSimd_MulAdd(ZSimd_Load(_dst + i), scale, offset));
+	}
+	for (; i < _count; i++)
+		_dst[i] = _dst[i] * _scale + _offset;
+}
+
+
+static Void
+ZRng_FillZiggurat(
+	_Inout_ ZRNG*  _lpRng,
+	_Out_   Float* _dst,
+	_In_    SizeT  _count,
+	_In_    Bool   _normal) {
+
+	Uint64 lanes[4][ZRNG_LANES];
+	Uint32 bits[ZRNG_CHUNK];
+	SizeT i, n;
+	if (_count < ZRNG_FILLMIN) {
+		for (i = 0; i < _count; i++) {
+			_dst[i] = _normal ?
+				ZRng_Normal(_lpRng, ZRng_NextU32(_lpRng)) :
+				ZRng_Exponential(_lpRng, ZRng_NextU32(_lpRng));
+		}
+		return;
+	}
+	ZRng_SeedLanes(_lpRng, lanes);
+	for (i = 0; i < _count; i += n) {
+		n = Z_Min(_count - i, ZRNG_CHUNK);
+		ZRng_FillLanes(lanes, bits, 
+			(n + ZRNG_BLOCK - 1) / ZRNG_BLOCK, Z_FALSE);
+		ZRng_Ziggurat(_lpRng, bits, _dst + i, n, _normal);
+	}
+}
+
+
+
+
+/* Section 4:
+** public
+******************************************************************************/
+Void
+ZRng_Init(
+	_Out_ ZRNG*     _lpRng,
+	_In_  ZRNG_TYPE _type,
+	_In_  Uint64    _seed) {
+
+	Uint64 state;
+	memset(_lpRng, 0, sizeof(ZRNG));
+	_lpRng->eType = _type;
+	if (_type == ZRNG_PCG32) {
+		state = ZRng_SplitMix64(&_seed);
+		_lpRng->pcg.inc = (ZRng_SplitMix64(&_seed) << 1) | 1;
+		ZRng_Pcg(_lpRng);
+		_lpRng->pcg.state += state;
+		ZRng_Pcg(_lpRng);
+	}
+	else {
+		//SplitMix64 never returns four zeros in a row
+		_lpRng->s[0] = ZRng_SplitMix64(&_seed);
+		_lpRng->s[1] = ZRng_SplitMix64(&_seed);
+		_lpRng->s[2] = ZRng_SplitMix64(&_seed);
+		_lpRng->s[3] = ZRng_SplitMix64(&_seed);
+	}
+}
+
+
+ZRNG*
+ZRng_GetDefault(Void) {
+
+	Int32 order;
+	if (!s_rngInit) {
+		order = ZAtomic32_FetchAdd(
+			&s_rngCount, 1, memory_order_relaxed) - 1;
+		ZRng_Init(&s_rng, ZRNG_XOSHIRO256PP, (Uint64)(Uint32)order);
+		s_rngInit = Z_TRUE;
+	}
+	return &s_rng;
+}
+
+
+Void
+ZRng_Jump(
+	_Inout_ ZRNG* _lpRng) {
+
+	static const Uint64 poly[4] = {
+		0x180EC6D33CFD0ABAull, 0xD5A61266F0C9392Cull,
+		0xA9582618E03FC9AAull, 0x39ABDC4529B1661Cull
+	};
+	if (_lpRng->eType == ZRNG_PCG32)
+		ZRng_PcgAdvance(_lpRng, 1ull << 48);
+	else ZRng_XoshiroJump(_lpRng->s, poly);
+}
+
+
+Void
+ZRng_LongJump(
+	_Inout_ ZRNG* _lpRng) {
+
+	static const Uint64 poly[4] = {
+		0x76E15D3EFEFDCBBFull, 0xC5004E441C522FB3ull,
+		0x77710069854EE241ull, 0x39109BB02ACBE635ull
+	};
+	if (_lpRng->eType == ZRNG_PCG32)
+		ZRng_PcgAdvance(_lpRng, 1ull << 56);
+	else ZRng_XoshiroJump(_lpRng->s, poly);
+}
+
+
+Uint32
+ZRng_NextU32(
+	_Inout_ ZRNG* _lpRng) {
+
+	if (_lpRng->eType == ZRNG_PCG32)
+		return ZRng_Pcg(_lpRng);
+	return (Uint32)(ZRng_Xoshiro(_lpRng->s) >> 32);
+}
+
+
+Uint64
+ZRng_NextU64(
+	_Inout_ ZRNG* _lpRng) {
+
+	Uint64 hi;
+	if (_lpRng->eType == ZRNG_PCG32) {
+		hi = ZRng_Pcg(_lpRng);
+		return (hi << 32) | ZRng_Pcg(_lpRng);
+	}
+	return ZRng_Xoshiro(_lpRng->s);
+}
+
+
+Float
+ZRng_NextFloat(
+	_Inout_ ZRNG* _lpRng) {
+
+	return (Float)(ZRng_NextU32(_lpRng) >> 8) * ZRNG_FLOAT;
+}
+
+
+Real64
+ZRng_NextReal64(
+	_Inout_ ZRNG* _lpRng) {
+
+	return (Real64)(ZRng_NextU64(_lpRng) >> 11) * ZRNG_REAL64;
+}
+
+
+Uint32
+ZRng_Bounded(
+	_Inout_ ZRNG*  _lpRng,
+	_In_    Uint32 _range) {
+
+	Uint64 m;
+	Uint32 low, threshold;
+	m   = (Uint64)ZRng_NextU32(_lpRng) * _range;
+	low = (Uint32)m;
+	if (low < _range) {
+		threshold = (0 - _range) % _range;
+		while (low < threshold) {
+			m   = (Uint64)ZRng_NextU32(_lpRng) * _range;
+			low = (Uint32)m;
+		}
+	}
+	return (Uint32)(m >> 32);
+}
+
+
+Float
+ZRng_NextNormal(
+	_Inout_ ZRNG* _lpRng) {
+
+	return ZRng_Normal(_lpRng, ZRng_NextU32(_lpRng));
+}
+
+
+Float
+ZRng_NextExponential(
+	_Inout_ ZRNG* _lpRng) {
+
+	return ZRng_Exponential(_lpRng, ZRng_NextU32(_lpRng));
+}
+
+
+Void
+ZRng_FillU32(
+	_Inout_ ZRNG*   _lpRng,
+	_Out_   Uint32* _dst,
+	_In_    SizeT   _count) {
+
+	ZRng_Fill(_lpRng, _dst, _count, Z_FALSE);
+}
+
+
+Void
+ZRng_FillFloat(
+	_Inout_ ZRNG*  _lpRng,
+	_Out_   Float* _dst,
+	_In_    SizeT  _count) {
+
+	ZRng_Fill(_lpRng, _dst, _count, Z_TRUE);
+}
+
+
+Void
+ZRng_FillUniform(
+	_Inout_ ZRNG*  _lpRng,
+	_Out_   Float* _dst,
+	_In_    SizeT  _count,
+	_In_    Float  _min,
+	_In_    Float  _max) {
+
+	ZRng_Fill(_lpRng, _dst, _count, Z_TRUE);
+	ZRng_Scale(_dst, _count, _max - _min, _min);
+}
+
+
+Void
+ZRng_FillNormal(
+	_Inout_ ZRNG*  _lpRng,
+	_Out_   Float* _dst,
+	_In_    SizeT  _count,
+	_In_    Float  _mean,
+	_In_    Float  _stddev) {
+
+	ZRng_FillZiggurat(_lpRng, _dst, _count, Z_TRUE);
+	if (_mean != 0.0f || _stddev != 1.0f)
+		ZRng_Scale(_dst, _count, _stddev, _mean);
+}
+
+
+Void
+ZRng_FillExponential(
+	_Inout_ ZRNG*  _lpRng,
+	_Out_   Float* _dst,
+	_In_    SizeT  _count,
+	_In_    Float  _rate) {
+
+	ZRng_FillZiggurat(_lpRng, _dst, _count, Z_FALSE);
+	if (_rate != 1.0f)
+		ZRng_Scale(_dst, _count, 1.0f / _rate, 0.0f);
+}
+/*****************************************************************************/  
+//EOF
+/*****************************************************************************/  
@@ -0,0 +1,1271 @@
+/******************************************************************************
+* zutil - C Utility Library
+* Copyright (C) 2017-2021 Zachary T Harris. All Rights Reserved.  
+* Zlib license.
+* 
+* File: zspatial.c
+* Desc: spatial indexes over rectangles: uniform hash grid and dynamic AABB tree
+*******************************************************************************
+
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+******************************************************************************/ 
+#include <math.h>
+#include "zutil/zspatial.h"
+
+
+
+#define ZSPATIAL_LIVE       (-2)       //free list link of a proxy in use
+#define ZSPATIAL_CELLLIMIT  (1 << 30)  //cell coordinates are clamped to this
+#define ZSPATIAL_MINBUCKETS 64
+#define ZSPATIAL_STACKSIZE  256        //deeper than any balanced tree
+
+
+
+/*
+A rect held as its edges, left <= right and top <= bottom*/
+typedef struct {
+	Float l, t, r, b;
+} ZSPATIALBOX;
+
+typedef struct {
+	ZSPATIALBOX box;   //bounds of the proxy
+	Handle      hData; //user data
+	Int32       cx0;   //first and last cell column touched
+	Int32       cx1;
+	Int32       cy0;   //first and last cell row touched
+	Int32       cy1;
+	Int32       iNext; //next free proxy, or ZSPATIAL_LIVE
+} ZSPATIALGRIDPROXY;
+
+/*
+One proxy entered in one cell, linked into the bucket of the cell*/
+typedef struct {
+	Int32 iProxy;
+	Int32 cx;
+	Int32 cy;
+	Int32 iNext; //next entry in the bucket, or in the free list
+} ZSPATIALGRIDENTRY;
+
+struct _ZSpatialGrid {
+	Float              fInvCellSize;
+	ZSPATIALGRIDPROXY* lpProxies;
+	Int32              iProxyCapacity;
+	Int32              iFreeProxy;
+	SizeT              iCount;
+	ZSPATIALGRIDENTRY* lpEntries;
+	Int32              iEntryCapacity;
+	Int32              iFreeEntry;
+	SizeT              iFreeEntries;  //length of the entry free list
+	Int32*             lpBuckets;     //first entry of each bucket
+	Uint32             iBucketMask;   //bucket count - 1, a power of two
+};
+
+typedef struct {
+	ZSPATIALBOX fat;     //enlarged bounds, or the union of the children
+	ZSPATIALBOX box;     //bounds of a leaf as given
+	Handle      hData;   //user data of a leaf
+	Int32       iParent; //parent node, or next node in the free list
+	Int32       iChild1; //Z_UNDEFINED for leaves
+	Int32       iChild2;
+	Int32       iHeight; //0 for leaves, -1 for free nodes
+} ZSPATIALTREENODE;
+
+struct _ZSpatialTree {
+	ZSPATIALTREENODE* lpNodes;
+	Int32             iCapacity;
+	Int32             iRoot;
+	Int32             iFreeList;
+	SizeT             iCount;
+	Float             fMargin;
+};
+
+
+
+
+
+/* Section 1:
+** boxes
+******************************************************************************/
+static FORCEINLINE ZSPATIALBOX
+ZSpatial_MakeBox(
+	_In_ const ZRECT* _rect) {
+
+	ZSPATIALBOX box;
+	box.l = Z_Min(_rect->x, _rect->x + _rect->w);
+	box.t = Z_Min(_rect->y, _rect->y + _rect->h);
+	box.r = Z_Max(_rect->x, _rect->x + _rect->w);
+	box.b = Z_Max(_rect->y, _rect->y + _rect->h);
+	return box;
+}
+
+
+/*
+True when the intersection has a positive area, as ZRect_GetIntersection*/
+static FORCEINLINE Bool
+ZSpatial_Overlaps(
+	_In_ const ZSPATIALBOX* _a,
+	_In_ const ZSPATIALBOX* _b) {
+
+	return 
+		Z_Max(_a->l, _b->l) < Z_Min(_a->r, _b->r) &&
+		Z_Max(_a->t, _b->t) < Z_Min(_a->b, _b->b);
+}
+
+
+/*
+Half-open containment, as ZRect_ContainsPoint*/
+static FORCEINLINE Bool
+ZSpatial_ContainsPoint(
+	_In_ const ZSPATIALBOX* _a,
+	_In_ Float              _x,
+	_In_ Float              _y) {
+
+	return _x >= _a->l && _x < _a->r && _y >= _a->t && _y < _a->b;
+}
+
+
+static FORCEINLINE Bool
+ZSpatial_ContainsBox(
+	_In_ const ZSPATIALBOX* _outer,
+	_In_ const ZSPATIALBOX* _inner) {
+
+	return 
+		_outer->l <= _inner->l && _outer->t <= _inner->t &&
+		_outer->r >= _inner->r && _outer->b >= _inner->b;
+}
+
+
+static FORCEINLINE ZSPATIALBOX
+ZSpatial_Union(
+	_In_ const ZSPATIALBOX* _a,
+	_In_ const ZSPATIALBOX* _b) {
+
+	ZSPATIALBOX box;
+	box.l = Z_Min(_a->l, _b->l);
+	box.t = Z_Min(_a->t, _b->t);
+	box.r = Z_Max(_a->r, _b->r);
+	box.b = Z_Max(_a->b, _b->b);
+	return box;
+}
+
+
+/*
+Half the perimeter, the insertion cost of the tree*/
+static FORCEINLINE Float
+ZSpatial_Cost(
+	_In_ const ZSPATIALBOX* _a) {
+
+	return (_a->r - _a->l) + (_a->b - _a->t);
+}
+
+
+
+
+
+/* Section 2:
+** grid storage
+******************************************************************************/
+static FORCEINLINE Int32
+ZSpatialGrid_Cell(
+	_In_ const ZSpatialGrid* _lpGrid,
+	_In_ Float               _v) {
+
+	Float c = floorf(_v * _lpGrid->fInvCellSize);
+	if (!(c > -ZSPATIAL_CELLLIMIT))
+		return -ZSPATIAL_CELLLIMIT; //also catches NaN
+	if (c > ZSPATIAL_CELLLIMIT)
+		return ZSPATIAL_CELLLIMIT;
+	return (Int32)c;
+}
+
+
+static FORCEINLINE Uint32
+ZSpatialGrid_Hash(
+	_In_ const ZSpatialGrid* _lpGrid,
+	_In_ Int32               _cx,
+	_In_ Int32               _cy) {
+
+	Uint32 h = (Uint32)_cx * 73856093u ^ (Uint32)_cy * 19349663u;
+	return (h ^ (h >> 15)) & _lpGrid->iBucketMask;
+}
+
+
+/*
+Rehashes every entry into a table of _count buckets*/
+static ZRESULT
+ZSpatialGrid_Rehash(
+	_Inout_ ZSpatialGrid* _lpGrid,
+	_In_    Uint32        _count) {
+
+	Int32* buckets;
+	Int32* old;
+	Uint32 i, oldCount;
+	Int32  e, next;
+
+	buckets = (Int32*)malloc(_count * sizeof(Int32));
+	if (!buckets)
+		return Z_EOUTOFMEMORY;
+	for (i = 0; i < _count; ++i)
+		buckets[i] = Z_UNDEFINED;
+	old      = _lpGrid->lpBuckets;
+	oldCount = old ? _lpGrid->iBucketMask + 1 : 0;
+	_lpGrid->lpBuckets   = buckets;
+	_lpGrid->iBucketMask = _count - 1;
+	for (i = 0; i < oldCount; ++i) {
+		for (e = old[i]; e != Z_UNDEFINED; e = next) {
+			ZSPATIALGRIDENTRY* entry = &_lpGrid->lpEntries[e];
+			Uint32 h = ZSpatialGrid_Hash(_lpGrid, entry->cx, entry->cy);
+			next         = entry->iNext;
+			entry->iNext = buckets[h];
+			buckets[h]   = e;
+		}
+	}
+	free(old);
+	return Z_OK;
+}
+
+
+/*
+Makes sure _cells entries can be added without allocating*/
+static ZRESULT
+ZSpatialGrid_Reserve(
+	_Inout_ ZSpatialGrid* _lpGrid,
+	_In_    SizeT         _cells) {
+
+	ZSPATIALGRIDENTRY* entries;
+	SizeT   used, capacity, buckets, i;
+	ZRESULT result;
+
+	if (_cells <= _lpGrid->iFreeEntries)
+		return Z_OK;
+	used     = (SizeT)_lpGrid->iEntryCapacity - _lpGrid->iFreeEntries;
+	capacity = Z_Max((SizeT)_lpGrid->iEntryCapacity * 2, used + _cells);
+	if (capacity > 0x7FFFFFFF)
+		return Z_EOUTOFMEMORY;
+	entries = (ZSPATIALGRIDENTRY*)realloc(
+		_lpGrid->lpEntries, capacity * sizeof(ZSPATIALGRIDENTRY));
+	if (!entries)
+		return Z_EOUTOFMEMORY;
+	for (i = (SizeT)_lpGrid->iEntryCapacity; i < capacity; ++i) {
+		entries[i].iProxy = Z_UNDEFINED;
+		entries[i].iNext  = (i + 1 < capacity) ? (Int32)(i + 1) : _lpGrid->iFreeEntry;
+	}
+	_lpGrid->iFreeEntry     = _lpGrid->iEntryCapacity;
+	_lpGrid->iFreeEntries  += capacity - (SizeT)_lpGrid->iEntryCapacity;
+	_lpGrid->iEntryCapacity = (Int32)capacity;
+	_lpGrid->lpEntries      = entries;
+	//keep at least as many buckets as entries in use
+	buckets = _lpGrid->iBucketMask + 1;
+	while (buckets < used + _cells)
+		buckets *= 2;
+	if (buckets != (SizeT)_lpGrid->iBucketMask + 1) {
+		result = ZSpatialGrid_Rehash(_lpGrid, (Uint32)buckets);
+		if (Z_FAILURE(result))
+			return result;
+	}
+	return Z_OK;
+}
+
+
+static FORCEINLINE Void
+ZSpatialGrid_AddEntry(
+	_Inout_ ZSpatialGrid* _lpGrid,
+	_In_    Int32         _id,
+	_In_    Int32         _cx,
+	_In_    Int32         _cy) {
+
+	ZSPATIALGRIDENTRY* entry;
+	Uint32 h;
+	Int32  e;
+
+	e     = _lpGrid->iFreeEntry;
+	entry = &_lpGrid->lpEntries[e];
+	_lpGrid->iFreeEntry = entry->iNext;
+	_lpGrid->iFreeEntries--;
+	h = ZSpatialGrid_Hash(_lpGrid, _cx, _cy);
+	entry->iProxy = _id;
+	entry->cx     = _cx;
+	entry->cy     = _cy;
+	entry->iNext  = _lpGrid->lpBuckets[h];
+	_lpGrid->lpBuckets[h] = e;
+}
+
+
+static FORCEINLINE Void
+ZSpatialGrid_RemoveEntry(
+	_Inout_ ZSpatialGrid* _lpGrid,
+	_In_    Int32         _id,
+	_In_    Int32         _cx,
+	_In_    Int32         _cy) {
+
+	ZSPATIALGRIDENTRY* entry;
+	Int32* link;
+
+	link = &_lpGrid->lpBuckets[ZSpatialGrid_Hash(_lpGrid, _cx, _cy)];
+	while (*link != Z_UNDEFINED) {
+		entry = &_lpGrid->lpEntries[*link];
+		if (entry->iProxy == _id && entry->cx == _cx && entry->cy == _cy) {
+			Int32 e = *link;
+			*link         = entry->iNext;
+			entry->iProxy = Z_UNDEFINED;
+			entry->iNext  = _lpGrid->iFreeEntry;
+			_lpGrid->iFreeEntry = e;
+			_lpGrid->iFreeEntries++;
+			return;
+		}
+		link = &entry->iNext;
+	}
+}
+
+
+static FORCEINLINE SizeT
+ZSpatialGrid_CellCount(
+	_In_ Int32 _cx0,
+	_In_ Int32 _cx1,
+	_In_ Int32 _cy0,
+	_In_ Int32 _cy1) {
+
+	return (SizeT)((Int64)_cx1 - _cx0 + 1) * (SizeT)((Int64)_cy1 - _cy0 + 1);
+}
+
+
+ZSpatialGrid*
+ZSpatialGrid_Create(
+	_In_        Float    _cellSize,
+	_In_        SizeT    _capacity,
+	_Inout_opt_ ZRESULT* _lpResult) {
+
+	ZSpatialGrid* grid;
+	ZRESULT result = Z_OK;
+	Uint32  buckets = ZSPATIAL_MINBUCKETS;
+
+	if (!(_cellSize > 0) || _capacity > 0x3FFFFFFF) {
+		result = Z_EINVALIDARG;
+		goto fail;
+	}
+	grid = (ZSpatialGrid*)calloc(1, sizeof(ZSpatialGrid));
+	if (!grid) {
+		result = Z_EOUTOFMEMORY;
+		goto fail;
+	}
+	grid->fInvCellSize = 1.0f / _cellSize;
+	grid->iFreeProxy   = Z_UNDEFINED;
+	grid->iFreeEntry   = Z_UNDEFINED;
+	while (buckets < _capacity * 2)
+		buckets *= 2;
+	result = ZSpatialGrid_Rehash(grid, buckets);
+	if (Z_SUCCESS(result) && _capacity) {
+		grid->lpProxies = (ZSPATIALGRIDPROXY*)malloc(
+			_capacity * sizeof(ZSPATIALGRIDPROXY));
+		if (grid->lpProxies) {
+			SizeT i;
+			for (i = 0; i < _capacity; ++i)
+				grid->lpProxies[i].iNext = 
+					(i + 1 < _capacity) ? (Int32)(i + 1) : Z_UNDEFINED;
+			grid->iFreeProxy     = 0;
+			grid->iProxyCapacity = (Int32)_capacity;
+			result = ZSpatialGrid_Reserve(grid, _capacity * 2);
+		}
+		else
+			result = Z_EOUTOFMEMORY;
+	}
+	if (Z_FAILURE(result)) {
+		ZSpatialGrid_Release(grid);
+		goto fail;
+	}
+	if (_lpResult)
+		*_lpResult = Z_OK;
+	return grid;
+fail:
+	if (_lpResult)
+		*_lpResult = result;
+	return NULL;
+}
+
+
+Void
+ZSpatialGrid_Release(
+	_Inout_ ZSpatialGrid* _lpGrid) {
+
+	if (!_lpGrid)
+		return;
+	free(_lpGrid->lpProxies);
+	free(_lpGrid->lpEntries);
+	free(_lpGrid->lpBuckets);
+	free(_lpGrid);
+}
+
+
+Int32
+ZSpatialGrid_Insert(
+	_Inout_ ZSpatialGrid* _lpGrid,
+	_In_    const ZRECT*  _rect,
+	_In_    Handle        _hData) {
+
+	ZSPATIALGRIDPROXY* proxy;
+	ZSPATIALBOX box;
+	Int32 id, cx0, cx1, cy0, cy1, x, y;
+
+	box = ZSpatial_MakeBox(_rect);
+	cx0 = ZSpatialGrid_Cell(_lpGrid, box.l);
+	cx1 = ZSpatialGrid_Cell(_lpGrid, box.r);
+	cy0 = ZSpatialGrid_Cell(_lpGrid, box.t);
+	cy1 = ZSpatialGrid_Cell(_lpGrid, box.b);
+	if (_lpGrid->iFreeProxy == Z_UNDEFINED) {
+		ZSPATIALGRIDPROXY* proxies;
+		SizeT capacity, i;
+		capacity = Z_Max((SizeT)_lpGrid->iProxyCapacity * 2, 16);
+		if (capacity > 0x7FFFFFFF)
+			return Z_UNDEFINED;
+		proxies = (ZSPATIALGRIDPROXY*)realloc(
+			_lpGrid->lpProxies, capacity * sizeof(ZSPATIALGRIDPROXY));
+		if (!proxies)
+			return Z_UNDEFINED;
+		for (i = (SizeT)_lpGrid->iProxyCapacity; i < capacity; ++i)
+			proxies[i].iNext = (i + 1 < capacity) ? (Int32)(i + 1) : Z_UNDEFINED;
+		_lpGrid->iFreeProxy     = _lpGrid->iProxyCapacity;
+		_lpGrid->iProxyCapacity = (Int32)capacity;
+		_lpGrid->lpProxies      = proxies;
+	}
+	if (Z_FAILURE(ZSpatialGrid_Reserve(_lpGrid, 
+		ZSpatialGrid_CellCount(cx0, cx1, cy0, cy1))))
+		return Z_UNDEFINED;
+	id    = _lpGrid->iFreeProxy;
+	proxy = &_lpGrid->lpProxies[id];
+	_lpGrid->iFreeProxy = proxy->iNext;
+	proxy->box   = box;
+	proxy->hData = _hData;
+	proxy->cx0   = cx0;
+	proxy->cx1   = cx1;
+	proxy->cy0   = cy0;
+	proxy->cy1   = cy1;
+	proxy->iNext = ZSPATIAL_LIVE;
+	for (y = cy0; y <= cy1; ++y) {
+		for (x = cx0; x <= cx1; ++x)
+			ZSpatialGrid_AddEntry(_lpGrid, id, x, y);
+	}
+	_lpGrid->iCount++;
+	return id;
+}
+
+
+ZRESULT
+ZSpatialGrid_Update(
+	_Inout_ ZSpatialGrid* _lpGrid,
+	_In_    Int32         _id,
+	_In_    const ZRECT*  _rect) {
+
+	ZSPATIALGRIDPROXY* proxy;
+	ZSPATIALBOX box;
+	Int32   cx0, cx1, cy0, cy1, x, y;
+	ZRESULT result;
+
+	proxy = &_lpGrid->lpProxies[_id];
+	box   = ZSpatial_MakeBox(_rect);
+	cx0   = ZSpatialGrid_Cell(_lpGrid, box.l);
+	cx1   = ZSpatialGrid_Cell(_lpGrid, box.r);
+	cy0   = ZSpatialGrid_Cell(_lpGrid, box.t);
+	cy1   = ZSpatialGrid_Cell(_lpGrid, box.b);
+	if (cx0 == proxy->cx0 && cx1 == proxy->cx1 && 
+		cy0 == proxy->cy0 && cy1 == proxy->cy1) {
+		proxy->box = box;
+		return Z_OK;
+	}
+	result = ZSpatialGrid_Reserve(_lpGrid, 
+		ZSpatialGrid_CellCount(cx0, cx1, cy0, cy1));
+	if (Z_FAILURE(result))
+		return result;
+	proxy->box = box;
+	//leave the cells outside the new range, enter those outside the old
+	for (y = proxy->cy0; y <= proxy->cy1; ++y) {
+		for (x = proxy->cx0; x <= proxy->cx1; ++x) {
+			if (x < cx0 || x > cx1 || y < cy0 || y > cy1)
+				ZSpatialGrid_RemoveEntry(_lpGrid, _id, x, y);
+		}
+	}
+	for (y = cy0; y <= cy1; ++y) {
+		for (x = cx0; x <= cx1; ++x) {
+			if (x < proxy->cx0 || x > proxy->cx1 || 
+				y < proxy->cy0 || y > proxy->cy1)
+				ZSpatialGrid_AddEntry(_lpGrid, _id, x, y);
+		}
+	}
+	proxy->cx0 = cx0;
+	proxy->cx1 = cx1;
+	proxy->cy0 = cy0;
+	proxy->cy1 = cy1;
+	return Z_OK;
+}
+
+
+Void
+ZSpatialGrid_Remove(
+	_Inout_ ZSpatialGrid* _lpGrid,
+	_In_    Int32         _id) {
+
+	ZSPATIALGRIDPROXY* proxy;
+	Int32 x, y;
+
+	proxy = &_lpGrid->lpProxies[_id];
+	for (y = proxy->cy0; y <= proxy->cy1; ++y) {
+		for (x = proxy->cx0; x <= proxy->cx1; ++x)
+			ZSpatialGrid_RemoveEntry(_lpGrid, _id, x, y);
+	}
+	proxy->hData = NULL;
+	proxy->iNext = _lpGrid->iFreeProxy;
+	_lpGrid->iFreeProxy = _id;
+	_lpGrid->iCount--;
+}
+
+
+Handle
+ZSpatialGrid_GetData(
+	_In_ const ZSpatialGrid* _lpGrid,
+	_In_ Int32               _id) {
+
+	return _lpGrid->lpProxies[_id].hData;
+}
+
+
+SizeT
+ZSpatialGrid_GetCount(
+	_In_ const ZSpatialGrid* _lpGrid) {
+
+	return _lpGrid->iCount;
+}
+
+
+
+
+
+/* Section 3:
+** grid queries
+******************************************************************************/
+/*
+Tests every proxy, for queries covering more cells than there are proxies*/
+static SizeT
+ZSpatialGrid_QueryAll(
+	_In_ const ZSpatialGrid* _lpGrid,
+	_In_ const ZSPATIALBOX*  _box,
+	_In_ ZSpatialQueryFn     _fn,
+	_In_ Handle              _hContext) {
+
+	const ZSPATIALGRIDPROXY* proxy;
+	SizeT found = 0;
+	Int32 id;
+
+	for (id = 0; id < _lpGrid->iProxyCapacity; ++id) {
+		proxy = &_lpGrid->lpProxies[id];
+		if (proxy->iNext != ZSPATIAL_LIVE || 
+			!ZSpatial_Overlaps(&proxy->box, _box))
+			continue;
+		found++;
+		if (!_fn(id, proxy->hData, _hContext))
+			break;
+	}
+	return found;
+}
+
+
+/*
+A proxy met in several cells of a rect query is only reported in the 
+first cell that both cover, so no per-query marking is needed*/
+SizeT
+ZSpatialGrid_QueryRect(
+	_In_ const ZSpatialGrid* _lpGrid,
+	_In_ const ZRECT*        _rect,
+	_In_ ZSpatialQueryFn     _fn,
+	_In_ Handle              _hContext) {
+
+	const ZSPATIALGRIDENTRY* entry;
+	const ZSPATIALGRIDPROXY* proxy;
+	ZSPATIALBOX box;
+	SizeT found = 0;
+	Int32 cx0, cx1, cy0, cy1, x, y, e;
+
+	box = ZSpatial_MakeBox(_rect);
+	cx0 = ZSpatialGrid_Cell(_lpGrid, box.l);
+	cx1 = ZSpatialGrid_Cell(_lpGrid, box.r);
+	cy0 = ZSpatialGrid_Cell(_lpGrid, box.t);
+	cy1 = ZSpatialGrid_Cell(_lpGrid, box.b);
+	if (ZSpatialGrid_CellCount(cx0, cx1, cy0, cy1) > _lpGrid->iCount)
+		return ZSpatialGrid_QueryAll(_lpGrid, &box, _fn, _hContext);
+	for (y = cy0; y <= cy1; ++y) {
+		for (x = cx0; x <= cx1; ++x) {
+			e = _lpGrid->lpBuckets[ZSpatialGrid_Hash(_lpGrid, x, y)];
+			for (; e != Z_UNDEFINED; e = entry->iNext) {
+				entry = &_lpGrid->lpEntries[e];
+				if (entry->cx != x || entry->cy != y)
+					continue;
+				proxy = &_lpGrid->lpProxies[entry->iProxy];
+				if (Z_Max(proxy->cx0, cx0) != x || 
+					Z_Max(proxy->cy0, cy0) != y ||
+					!ZSpatial_Overlaps(&proxy->box, &box))
+					continue;
+				found++;
+				if (!_fn(entry->iProxy, proxy->hData, _hContext))
+					return found;
+			}
+		}
+	}
+	return found;
+}
+
+
+SizeT
+ZSpatialGrid_QueryPoint(
+	_In_ const ZSpatialGrid* _lpGrid,
+	_In_ Float               _x,
+	_In_ Float               _y,
+	_In_ ZSpatialQueryFn     _fn,
+	_In_ Handle              _hContext) {
+
+	const ZSPATIALGRIDENTRY* entry;
+	const ZSPATIALGRIDPROXY* proxy;
+	SizeT found = 0;
+	Int32 x, y, e;
+
+	x = ZSpatialGrid_Cell(_lpGrid, _x);
+	y = ZSpatialGrid_Cell(_lpGrid, _y);
+	e = _lpGrid->lpBuckets[ZSpatialGrid_Hash(_lpGrid, x, y)];
+	for (; e != Z_UNDEFINED; e = entry->iNext) {
+		entry = &_lpGrid->lpEntries[e];
+		if (entry->cx != x || entry->cy != y)
+			continue;
+		proxy = &_lpGrid->lpProxies[entry->iProxy];
+		if (!ZSpatial_ContainsPoint(&proxy->box, _x, _y))
+			continue;
+		found++;
+		if (!_fn(entry->iProxy, proxy->hData, _hContext))
+			break;
+	}
+	return found;
+}
+
+
+/*
+Pairs are found among the entries of each cell, 
+and reported in the first cell the pair shares*/
+SizeT
+ZSpatialGrid_QueryPairs(
+	_In_ const ZSpatialGrid* _lpGrid,
+	_In_ ZSpatialPairFn      _fn,
+	_In_ Handle              _hContext) {
+
+	const ZSPATIALGRIDENTRY* e0;
+	const ZSPATIALGRIDENTRY* e1;
+	const ZSPATIALGRIDPROXY* p0;
+	const ZSPATIALGRIDPROXY* p1;
+	SizeT  found = 0;
+	Uint32 h;
+	Int32  i, j, a, b;
+
+	for (h = 0; h <= _lpGrid->iBucketMask; ++h) {
+		for (i = _lpGrid->lpBuckets[h]; i != Z_UNDEFINED; i = e0->iNext) {
+			e0 = &_lpGrid->lpEntries[i];
+			p0 = &_lpGrid->lpProxies[e0->iProxy];
+			for (j = e0->iNext; j != Z_UNDEFINED; j = e1->iNext) {
+				e1 = &_lpGrid->lpEntries[j];
+				if (e1->cx != e0->cx || e1->cy != e0->cy)
+					continue;
+				p1 = &_lpGrid->lpProxies[e1->iProxy];
+				if (Z_Max(p0->cx0, p1->cx0) != e0->cx ||
+					Z_Max(p0->cy0, p1->cy0) != e0->cy ||
+					!ZSpatial_Overlaps(&p0->box, &p1->box))
+					continue;
+				a = Z_Min(e0->iProxy, e1->iProxy);
+				b = Z_Max(e0->iProxy, e1->iProxy);
+				found++;
+				if (!_fn(a, _lpGrid->lpProxies[a].hData, 
+					b, _lpGrid->lpProxies[b].hData, _hContext))
+					return found;
+			}
+		}
+	}
+	return found;
+}
+
+
+
+
+
+/* Section 4:
+** tree storage
+******************************************************************************/
+#define ZSPATIAL_NODE(tree, i) (&(tree)->lpNodes[i])
+#define ZSPATIAL_ISLEAF(node)  ((node)->iChild1 == Z_UNDEFINED)
+
+/*
+Makes sure _count nodes can be allocated without growing the pool*/
+static ZRESULT
+ZSpatialTree_Reserve(
+	_Inout_ ZSpatialTree* _lpTree,
+	_In_    SizeT         _count) {
+
+	ZSPATIALTREENODE* nodes;
+	SizeT capacity, i, spare = 0;
+	Int32 n;
+
+	for (n = _lpTree->iFreeList; n != Z_UNDEFINED && spare < _count; ++spare)
+		n = _lpTree->lpNodes[n].iParent;
+	if (spare >= _count)
+		return Z_OK;
+	capacity = Z_Max((SizeT)_lpTree->iCapacity * 2, 
+		(SizeT)_lpTree->iCapacity + _count);
+	capacity = Z_Max(capacity, 16);
+	if (capacity > 0x7FFFFFFF)
+		return Z_EOUTOFMEMORY;
+	nodes = (ZSPATIALTREENODE*)realloc(
+		_lpTree->lpNodes, capacity * sizeof(ZSPATIALTREENODE));
+	if (!nodes)
+		return Z_EOUTOFMEMORY;
+	for (i = (SizeT)_lpTree->iCapacity; i < capacity; ++i) {
+		nodes[i].iParent = (i + 1 < capacity) ? (Int32)(i + 1) : _lpTree->iFreeList;
+		nodes[i].iHeight = -1;
+	}
+	_lpTree->iFreeList = _lpTree->iCapacity;
+	_lpTree->iCapacity = (Int32)capacity;
+	_lpTree->lpNodes   = nodes;
+	return Z_OK;
+}
+
+
+static FORCEINLINE Int32
+ZSpatialTree_AllocNode(
+	_Inout_ ZSpatialTree* _lpTree) {
+
+	ZSPATIALTREENODE* node;
+	Int32 id;
+
+	id   = _lpTree->iFreeList;
+	node = ZSPATIAL_NODE(_lpTree, id);
+	_lpTree->iFreeList = node->iParent;
+	node->iParent = Z_UNDEFINED;
+	node->iChild1 = Z_UNDEFINED;
+	node->iChild2 = Z_UNDEFINED;
+	node->iHeight = 0;
+	node->hData   = NULL;
+	return id;
+}
+
+
+static FORCEINLINE Void
+ZSpatialTree_FreeNode(
+	_Inout_ ZSpatialTree* _lpTree,
+	_In_    Int32         _id) {
+
+	ZSPATIALTREENODE* node = ZSPATIAL_NODE(_lpTree, _id);
+	node->iParent = _lpTree->iFreeList;
+	node->iHeight = -1;
+	_lpTree->iFreeList = _id;
+}
+
+
+/*
+Performs a left or right rotation if node _iA is imbalanced.
+Returns the new root of the subtree*/
+static Int32
+ZSpatialTree_Balance(
+	_Inout_ ZSpatialTree* _lpTree,
+	_In_    Int32         _iA) {
+
+	ZSPATIALTREENODE *a, *b, *c;
+	Int32 iB, iC, balance;
+
+	a = ZSPATIAL_NODE(_lpTree, _iA);
+	if (ZSPATIAL_ISLEAF(a) || a->iHeight < 2)
+		return _iA;
+	iB = a->iChild1;
+	iC = a->iChild2;
+	b  = ZSPATIAL_NODE(_lpTree, iB);
+	c  = ZSPATIAL_NODE(_lpTree, iC);
+	balance = c->iHeight - b->iHeight;
+	if (balance > 1) {
+		//rotate C up
+		Int32 iF = c->iChild1, iG = c->iChild2;
+		ZSPATIALTREENODE* f = ZSPATIAL_NODE(_lpTree, iF);
+		ZSPATIALTREENODE* g = ZSPATIAL_NODE(_lpTree, iG);
+		c->iChild1 = _iA;
+		c->iParent = a->iParent;
+		a->iParent = iC;
+		if (c->iParent != Z_UNDEFINED) {
+			ZSPATIALTREENODE* p = ZSPATIAL_NODE(_lpTree, c->iParent);
+			if (p->iChild1 == _iA)
+				p->iChild1 = iC;
+			else
+				p->iChild2 = iC;
+		}
+		else
+			_lpTree->iRoot = iC;
+		if (f->iHeight > g->iHeight) {
+			c->iChild2 = iF;
+			a->iChild2 = iG;
+			g->iParent = _iA;
+			a->fat = ZSpatial_Union(&b->fat, &g->fat);
+			c->fat = ZSpatial_Union(&a->fat, &f->fat);
+			a->iHeight = 1 + Z_Max(b->iHeight, g->iHeight);
+			c->iHeight = 1 + Z_Max(a->iHeight, f->iHeight);
+		}
+		else {
+			c->iChild2 = iG;
+			a->iChild2 = iF;
+			f->iParent = _iA;
+			a->fat = ZSpatial_Union(&b->fat, &f->fat);
+			c->fat = ZSpatial_Union(&a->fat, &g->fat);
+			a->iHeight = 1 + Z_Max(b->iHeight, f->iHeight);
+			c->iHeight = 1 + Z_Max(a->iHeight, g->iHeight);
+		}
+		return iC;
+	}
+	if (balance < -1) {
+		//rotate B up
+		Int32 iD = b->iChild1, iE = b->iChild2;
+		ZSPATIALTREENODE* d = ZSPATIAL_NODE(_lpTree, iD);
+		ZSPATIALTREENODE* e = ZSPATIAL_NODE(_lpTree, iE);
+		b->iChild1 = _iA;
+		b->iParent = a->iParent;
+		a->iParent = iB;
+		if (b->iParent != Z_UNDEFINED) {
+			ZSPATIALTREENODE* p = ZSPATIAL_NODE(_lpTree, b->iParent);
+			if (p->iChild1 == _iA)
+				p->iChild1 = iB;
+			else
+				p->iChild2 = iB;
+		}
+		else
+			_lpTree->iRoot = iB;
+		if (d->iHeight > e->iHeight) {
+			b->iChild2 = iD;
+			a->iChild1 = iE;
+			e->iParent = _iA;
+			a->fat = ZSpatial_Union(&c->fat, &e->fat);
+			b->fat = ZSpatial_Union(&a->fat, &d->fat);
+			a->iHeight = 1 + Z_Max(c->iHeight, e->iHeight);
+			b->iHeight = 1 + Z_Max(a->iHeight, d->iHeight);
+		}
+		else {
+			b->iChild2 = iE;
+			a->iChild1 = iD;
+			d->iParent = _iA;
+			a->fat = ZSpatial_Union(&c->fat, &d->fat);
+			b->fat = ZSpatial_Union(&a->fat, &e->fat);
+			a->iHeight = 1 + Z_Max(c->iHeight, d->iHeight);
+			b->iHeight = 1 + Z_Max(a->iHeight, e->iHeight);
+		}
+		return iB;
+	}
+	return _iA;
+}
+
+
+/*
+Refits the bounds and heights from _index up to the root, 
+rebalancing on the way*/
+static Void
+ZSpatialTree_Refit(
+	_Inout_ ZSpatialTree* _lpTree,
+	_In_    Int32         _index) {
+
+	ZSPATIALTREENODE *node, *c1, *c2;
+	while (_index != Z_UNDEFINED) {
+		_index = ZSpatialTree_Balance(_lpTree, _index);
+		node = ZSPATIAL_NODE(_lpTree, _index);
+		c1   = ZSPATIAL_NODE(_lpTree, node->iChild1);
+		c2   = ZSPATIAL_NODE(_lpTree, node->iChild2);
+		node->iHeight = 1 + Z_Max(c1->iHeight, c2->iHeight);
+		node->fat     = ZSpatial_Union(&c1->fat, &c2->fat);
+		_index = node->iParent;
+	}
+}
+
+
+/*
+Links a leaf next to the sibling that enlarges the tree the least,
+descending while a child is cheaper than pairing at the current node.
+Needs one free node*/
+static Void
+ZSpatialTree_InsertLeaf(
+	_Inout_ ZSpatialTree* _lpTree,
+	_In_    Int32         _leaf) {
+
+	ZSPATIALTREENODE *leaf, *node, *sibling, *parent;
+	ZSPATIALBOX combined, box;
+	Float cost, inherit, cost1, cost2, area;
+	Int32 index, child1, child2, oldParent, newParent;
+
+	if (_lpTree->iRoot == Z_UNDEFINED) {
+		_lpTree->iRoot = _leaf;
+		ZSPATIAL_NODE(_lpTree, _leaf)->iParent = Z_UNDEFINED;
+		return;
+	}
+	leaf  = ZSPATIAL_NODE(_lpTree, _leaf);
+	box   = leaf->fat;
+	index = _lpTree->iRoot;
+	while (!ZSPATIAL_ISLEAF(ZSPATIAL_NODE(_lpTree, index))) {
+		node     = ZSPATIAL_NODE(_lpTree, index);
+		child1   = node->iChild1;
+		child2   = node->iChild2;
+		area     = ZSpatial_Cost(&node->fat);
+		combined = ZSpatial_Union(&node->fat, &box);
+		cost     = 2 * ZSpatial_Cost(&combined);
+		inherit  = 2 * (ZSpatial_Cost(&combined) - area);
+		node     = ZSPATIAL_NODE(_lpTree, child1);
+		combined = ZSpatial_Union(&node->fat, &box);
+		cost1    = ZSpatial_Cost(&combined) + inherit;
+		if (!ZSPATIAL_ISLEAF(node))
+			cost1 -= ZSpatial_Cost(&node->fat);
+		node     = ZSPATIAL_NODE(_lpTree, child2);
+		combined = ZSpatial_Union(&node->fat, &box);
+		cost2    = ZSpatial_Cost(&combined) + inherit;
+		if (!ZSPATIAL_ISLEAF(node))
+			cost2 -= ZSpatial_Cost(&node->fat);
+		if (cost < cost1 && cost < cost2)
+			break;
+		index = cost1 < cost2 ? child1 : child2;
+	}
+	newParent = ZSpatialTree_AllocNode(_lpTree);
+	leaf      = ZSPATIAL_NODE(_lpTree, _leaf);
+	sibling   = ZSPATIAL_NODE(_lpTree, index);
+	parent    = ZSPATIAL_NODE(_lpTree, newParent);
+	oldParent = sibling->iParent;
+	parent->iParent = oldParent;
+	parent->fat     = ZSpatial_Union(&box, &sibling->fat);
+	parent->iHeight = sibling->iHeight + 1;
+	parent->iChild1 = index;
+	parent->iChild2 = _leaf;
+	if (oldParent != Z_UNDEFINED) {
+		node = ZSPATIAL_NODE(_lpTree, oldParent);
+		if (node->iChild1 == index)
+			node->iChild1 = newParent;
+		else
+			node->iChild2 = newParent;
+	}
+	else
+		_lpTree->iRoot = newParent;
+	sibling->iParent = newParent;
+	leaf->iParent    = newParent;
+	ZSpatialTree_Refit(_lpTree, leaf->iParent);
+}
+
+
+static Void
+ZSpatialTree_RemoveLeaf(
+	_Inout_ ZSpatialTree* _lpTree,
+	_In_    Int32         _leaf) {
+
+	ZSPATIALTREENODE *parent, *grand;
+	Int32 iParent, iGrand, iSibling;
+
+	if (_leaf == _lpTree->iRoot) {
+		_lpTree->iRoot = Z_UNDEFINED;
+		return;
+	}
+	iParent  = ZSPATIAL_NODE(_lpTree, _leaf)->iParent;
+	parent   = ZSPATIAL_NODE(_lpTree, iParent);
+	iGrand   = parent->iParent;
+	iSibling = parent->iChild1 == _leaf ? parent->iChild2 : parent->iChild1;
+	ZSPATIAL_NODE(_lpTree, iSibling)->iParent = iGrand;
+	ZSpatialTree_FreeNode(_lpTree, iParent);
+	if (iGrand == Z_UNDEFINED) {
+		_lpTree->iRoot = iSibling;
+		return;
+	}
+	grand = ZSPATIAL_NODE(_lpTree, iGrand);
+	if (grand->iChild1 == iParent)
+		grand->iChild1 = iSibling;
+	else
+		grand->iChild2 = iSibling;
+	ZSpatialTree_Refit(_lpTree, iGrand);
+}
+
+
+static FORCEINLINE Void
+ZSpatialTree_Fatten(
+	_In_    const ZSpatialTree* _lpTree,
+	_Inout_ ZSPATIALTREENODE*   _leaf) {
+
+	_leaf->fat.l = _leaf->box.l - _lpTree->fMargin;
+	_leaf->fat.t = _leaf->box.t - _lpTree->fMargin;
+	_leaf->fat.r = _leaf->box.r + _lpTree->fMargin;
+	_leaf->fat.b = _leaf->box.b + _lpTree->fMargin;
+}
+
+
+ZSpatialTree*
+ZSpatialTree_Create(
+	_In_        Float    _margin,
+	_In_        SizeT    _capacity,
+	_Inout_opt_ ZRESULT* _lpResult) {
+
+	ZSpatialTree* tree;
+	ZRESULT result = Z_OK;
+
+	if (!(_margin >= 0) || _capacity > 0x3FFFFFFF) {
+		result = Z_EINVALIDARG;
+		goto fail;
+	}
+	tree = (ZSpatialTree*)calloc(1, sizeof(ZSpatialTree));
+	if (!tree) {
+		result = Z_EOUTOFMEMORY;
+		goto fail;
+	}
+	tree->iRoot     = Z_UNDEFINED;
+	tree->iFreeList = Z_UNDEFINED;
+	tree->fMargin   = _margin;
+	if (_capacity) {
+		//a tree of n leaves has n - 1 inner nodes
+		result = ZSpatialTree_Reserve(tree, _capacity * 2);
+		if (Z_FAILURE(result)) {
+			ZSpatialTree_Release(tree);
+			goto fail;
+		}
+	}
+	if (_lpResult)
+		*_lpResult = Z_OK;
+	return tree;
+fail:
+	if (_lpResult)
+		*_lpResult = result;
+	return NULL;
+}
+
+
+Void
+ZSpatialTree_Release(
+	_Inout_ ZSpatialTree* _lpTree) {
+
+	if (!_lpTree)
+		return;
+	free(_lpTree->lpNodes);
+	free(_lpTree);
+}
+
+
+Int32
+ZSpatialTree_Insert(
+	_Inout_ ZSpatialTree* _lpTree,
+	_In_    const ZRECT*  _rect,
+	_In_    Handle        _hData) {
+
+	ZSPATIALTREENODE* leaf;
+	Int32 id;
+
+	//the leaf and its new parent
+	if (Z_FAILURE(ZSpatialTree_Reserve(_lpTree, 2)))
+		return Z_UNDEFINED;
+	id   = ZSpatialTree_AllocNode(_lpTree);
+	leaf = ZSPATIAL_NODE(_lpTree, id);
+	leaf->box   = ZSpatial_MakeBox(_rect);
+	leaf->hData = _hData;
+	ZSpatialTree_Fatten(_lpTree, leaf);
+	ZSpatialTree_InsertLeaf(_lpTree, id);
+	_lpTree->iCount++;
+	return id;
+}
+
+
+Bool
+ZSpatialTree_Update(
+	_Inout_ ZSpatialTree* _lpTree,
+	_In_    Int32         _id,
+	_In_    const ZRECT*  _rect) {
+
+	ZSPATIALTREENODE* leaf;
+
+	leaf = ZSPATIAL_NODE(_lpTree, _id);
+	leaf->box = ZSpatial_MakeBox(_rect);
+	if (ZSpatial_ContainsBox(&leaf->fat, &leaf->box))
+		return Z_FALSE;
+	//removal frees the node that reinsertion needs
+	ZSpatialTree_RemoveLeaf(_lpTree, _id);
+	ZSpatialTree_Fatten(_lpTree, leaf);
+	ZSpatialTree_InsertLeaf(_lpTree, _id);
+	return Z_TRUE;
+}
+
+
+Void
+ZSpatialTree_Remove(
+	_Inout_ ZSpatialTree* _lpTree,
+	_In_    Int32         _id) {
+
+	ZSpatialTree_RemoveLeaf(_lpTree, _id);
+	ZSpatialTree_FreeNode(_lpTree, _id);
+	_lpTree->iCount--;
+}
+
+
+Handle
+ZSpatialTree_GetData(
+	_In_ const ZSpatialTree* _lpTree,
+	_In_ Int32               _id) {
+
+	return _lpTree->lpNodes[_id].hData;
+}
+
+
+SizeT
+ZSpatialTree_GetCount(
+	_In_ const ZSpatialTree* _lpTree) {
+
+	return _lpTree->iCount;
+}
+
+
+Int32
+ZSpatialTree_GetHeight(
+	_In_ const ZSpatialTree* _lpTree) {
+
+	if (_lpTree->iRoot == Z_UNDEFINED)
+		return 0;
+	return _lpTree->lpNodes[_lpTree->iRoot].iHeight;
+}
+
+
+
+
+
+/* Section 5:
+** tree queries
+******************************************************************************/
+/*
+Reports the leaves overlapping a box, skipping leaves up to _skip 
+when _skip is not Z_UNDEFINED. Stops early if _stop is set by _fn*/
+static SizeT
+ZSpatialTree_Walk(
+	_In_    const ZSpatialTree* _lpTree,
+	_In_    const ZSPATIALBOX*  _box,
+	_In_    Int32               _skip,
+	_In_    ZSpatialPairFn      _pairFn,
+	_In_    ZSpatialQueryFn     _fn,
+	_In_    Handle              _hContext,
+	_Inout_ Bool*               _stop) {
+
+	const ZSPATIALTREENODE* node;
+	Int32 stack[ZSPATIAL_STACKSIZE];
+	Int32 top = 0, index;
+	SizeT found = 0;
+	Bool  more;
+
+	if (_lpTree->iRoot == Z_UNDEFINED)
+		return 0;
+	stack[top++] = _lpTree->iRoot;
+	while (top) {
+		index = stack[--top];
+		node  = ZSPATIAL_NODE(_lpTree, index);
+		if (!ZSpatial_Overlaps(&node->fat, _box))
+			continue;
+		if (!ZSPATIAL_ISLEAF(node)) {
+			stack[top++] = node->iChild1;
+			stack[top++] = node->iChild2;
+			continue;
+		}
+		if (index <= _skip || !ZSpatial_Overlaps(&node->box, _box))
+			continue;
+		found++;
+		if (_pairFn)
+			more = _pairFn(_skip, ZSPATIAL_NODE(_lpTree, _skip)->hData, 
+				index, node->hData, _hContext);
+		else
+			more = _fn(index, node->hData, _hContext);
+		if (!more) {
+			*_stop = Z_TRUE;
+			break;
+		}
+	}
+	return found;
+}
+
+
+SizeT
+ZSpatialTree_QueryRect(
+	_In_ const ZSpatialTree* _lpTree,
+	_In_ const ZRECT*        _rect,
+	_In_ ZSpatialQueryFn     _fn,
+	_In_ Handle              _hContext) {
+
+	ZSPATIALBOX box;
+	Bool stop = Z_FALSE;
+	box = ZSpatial_MakeBox(_rect);
+	return ZSpatialTree_Walk(
+		_lpTree, &box, Z_UNDEFINED, NULL, _fn, _hContext, &stop);
+}
+
+
+SizeT
+ZSpatialTree_QueryPoint(
+	_In_ const ZSpatialTree* _lpTree,
+	_In_ Float               _x,
+	_In_ Float               _y,
+	_In_ ZSpatialQueryFn     _fn,
+	_In_ Handle              _hContext) {
+
+	const ZSPATIALTREENODE* node;
+	Int32 stack[ZSPATIAL_STACKSIZE];
+	Int32 top = 0, index;
+	SizeT found = 0;
+
+	if (_lpTree->iRoot == Z_UNDEFINED)
+		return 0;
+	stack[top++] = _lpTree->iRoot;
+	while (top) {
+		index = stack[--top];
+		node  = ZSPATIAL_NODE(_lpTree, index);
+		if (!ZSpatial_ContainsPoint(&node->fat, _x, _y))
+			continue;
+		if (!ZSPATIAL_ISLEAF(node)) {
+			stack[top++] = node->iChild1;
+			stack[top++] = node->iChild2;
+			continue;
+		}
+		if (!ZSpatial_ContainsPoint(&node->box, _x, _y))
+			continue;
+		found++;
+		if (!_fn(index, node->hData, _hContext))
+			break;
+	}
+	return found;
+}
+
+
+/*
+Each leaf queries the tree with its own bounds and keeps the leaves
+with larger ids, so every pair is reported once*/
+SizeT
+ZSpatialTree_QueryPairs(
+	_In_ const ZSpatialTree* _lpTree,
+	_In_ ZSpatialPairFn      _fn,
+	_In_ Handle              _hContext) {
+
+	const ZSPATIALTREENODE* node;
+	SizeT found = 0;
+	Bool  stop = Z_FALSE;
+	Int32 id;
+
+	for (id = 0; id < _lpTree->iCapacity && !stop; ++id) {
+		node = ZSPATIAL_NODE(_lpTree, id);
+		if (node->iHeight != 0)
+			continue;
+		found += ZSpatialTree_Walk(
+			_lpTree, &node->box, id, _fn, NULL, _hContext, &stop);
+	}
+	return found;
+}
+/*****************************************************************************/  
+//EOF
+/*****************************************************************************/  
@@ -0,0 +1,338 @@
+/******************************************************************************
+* zutil - C Utility Library
+* Copyright (C) 2017-2021 Zachary T Harris. All Rights Reserved.  
+* Zlib license.
+* 
+* File: zstr.c
+* Desc: length-tracked string with small-string optimization
+*******************************************************************************
+
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+******************************************************************************/ 
+#include "zutil/zstr.h"
+#include "zutil/zstring.h"
+
+
+
+#define ZSTR_TAG          (ZSTR_INLINE_CAPACITY + 1) //index of the tag byte
+#define ZSTR_MAX_CAPACITY 0xFFFFFFFE //largest capacity held by iCapacity
+
+
+
+/*
+Updates the stored length and writes the terminator*/
+static Void
+ZStr_SetLength(
+	_Inout_ ZSTR* _str,
+	_In_    SizeT _len) {
+
+	if (ZStr_IsInline(_str)) {
+		_str->sso[ZSTR_TAG] = (Char)_len;
+		_str->sso[_len] = '\0';
+	}
+	else {
+		_str->heap.iLength = _len;
+		_str->heap.lpData[_len] = '\0';
+	}
+}
+
+
+/*
+Moves the characters to a heap block of exactly _capacity bytes*/
+static ZRESULT
+ZStr_Realloc(
+	_Inout_ ZSTR* _str,
+	_In_    SizeT _capacity) {
+
+	Char* data;
+	SizeT length;
+
+	length = ZStr_Length(_str);
+	if (ZStr_IsInline(_str)) {
+		data = (Char*)malloc(_capacity + 1);
+		if (!data) {
+			return Z_EOUTOFMEMORY;
+		}
+		memcpy(data, _str->sso, length + 1);
+	}
+	else {
+		data = (Char*)realloc(_str->heap.lpData, _capacity + 1);
+		if (!data) {
+			return Z_EOUTOFMEMORY;
+		}
+	}
+	_str->heap.lpData = data;
+	_str->heap.iLength = length;
+	_str->heap.iCapacity = (Uint32)_capacity;
+	_str->sso[ZSTR_TAG] = (Char)ZSTR_TAG_HEAP;
+	return Z_OK;
+}
+
+
+/*
+Grows the capacity to at least _capacity bytes, by at least half 
+of the current capacity so that repeated appends stay amortized O(1)*/
+static ZRESULT
+ZStr_Grow(
+	_Inout_ ZSTR* _str,
+	_In_    SizeT _capacity) {
+
+	SizeT capacity;
+
+	capacity = ZStr_Capacity(_str);
+	if (_capacity <= capacity) {
+		return Z_OK;
+	}
+	if (_capacity > ZSTR_MAX_CAPACITY) {
+		return Z_EOUTOFMEMORY;
+	}
+	capacity += capacity / 2;
+	if (capacity < _capacity || capacity > ZSTR_MAX_CAPACITY) {
+		capacity = _capacity;
+	}
+	return ZStr_Realloc(_str, capacity);
+}
+
+
+/*
+@return: Z_TRUE if _src points into the characters of _str, terminator
+included, which growing may move or overwrite*/
+static FORCEINLINE Bool
+ZStr_Overlaps(
+	_In_ const ZSTR* _str,
+	_In_ Lpcstr      _src) {
+
+	Uintptr data;
+	data = (Uintptr)ZStr_CStr(_str);
+	return (Uintptr)_src >= data && 
+		(Uintptr)_src <= data + ZStr_Capacity(_str);
+}
+
+
+
+Void
+ZStr_Init(
+	_Out_ ZSTR* _str) {
+
+	memset(_str, 0, sizeof(ZSTR));
+}
+
+
+ZRESULT
+ZStr_InitN(
+	_Out_ ZSTR*  _str,
+	_In_  Lpcstr _src,
+	_In_  SizeT  _len) {
+
+	ZStr_Init(_str);
+	return ZStr_Append(_str, _src, _len);
+}
+
+
+Void
+ZStr_Free(
+	_Inout_ ZSTR* _str) {
+
+	if (!ZStr_IsInline(_str)) {
+		free(_str->heap.lpData);
+	}
+	ZStr_Init(_str);
+}
+
+
+ZRESULT
+ZStr_Reserve(
+	_Inout_ ZSTR* _str,
+	_In_    SizeT _capacity) {
+
+	if (_capacity <= ZStr_Capacity(_str)) {
+		return Z_OK;
+	}
+	if (_capacity > ZSTR_MAX_CAPACITY) {
+		return Z_EOUTOFMEMORY;
+	}
+	return ZStr_Realloc(_str, _capacity);
+}
+
+
+Void
+ZStr_Clear(
+	_Inout_ ZSTR* _str) {
+
+	ZStr_SetLength(_str, 0);
+}
+
+
+Void
+ZStr_Truncate(
+	_Inout_ ZSTR* _str,
+	_In_    SizeT _len) {
+
+	if (_len < ZStr_Length(_str)) {
+		ZStr_SetLength(_str, _len);
+	}
+}
+
+
+ZRESULT
+ZStr_Append(
+	_Inout_ ZSTR*  _str,
+	_In_    Lpcstr _src,
+	_In_    SizeT  _len) {
+
+	SizeT   length, offset;
+	Bool    self;
+	ZRESULT zresult;
+
+	length = ZStr_Length(_str);
+	if (_len > ZSTR_MAX_CAPACITY - length) {
+		return Z_EOUTOFMEMORY;
+	}
+	//a source inside _str is found again by its offset after growing
+	self = ZStr_Overlaps(_str, _src);
+	offset = self ? (SizeT)(_src - ZStr_CStr(_str)) : 0;
+	zresult = ZStr_Grow(_str, length + _len);
+	if (Z_FAILURE(zresult)) {
+		return zresult;
+	}
+	if (self) {
+		_src = ZStr_CStr(_str) + offset;
+	}
+	memmove(ZStr_Data(_str) + length, _src, _len);
+	ZStr_SetLength(_str, length + _len);
+	return Z_OK;
+}
+
+
+ZRESULT
+ZStr_AppendChar(
+	_Inout_ ZSTR* _str,
+	_In_    Char  _char) {
+
+	return ZStr_Append(_str, &_char, 1);
+}
+
+
+ZRESULT
+ZStr_Assign(
+	_Inout_ ZSTR*  _str,
+	_In_    Lpcstr _src,
+	_In_    SizeT  _len) {
+
+	if (ZStr_Overlaps(_str, _src)) { //a part of _str, moved to the front
+		memmove(ZStr_Data(_str), _src, _len);
+		ZStr_SetLength(_str, _len);
+		return Z_OK;
+	}
+	ZStr_Clear(_str);
+	return ZStr_Append(_str, _src, _len);
+}
+
+
+Void
+ZStr_ToLower(
+	_Inout_ ZSTR* _str) {
+
+	ZString_ToLowerEx(ZStr_Data(_str), ZStr_Length(_str));
+}
+
+
+Void
+ZStr_ToUpper(
+	_Inout_ ZSTR* _str) {
+
+	ZString_ToUpperEx(ZStr_Data(_str), ZStr_Length(_str));
+}
+
+
+ZSTRVIEW
+ZStr_View(
+	_In_ const ZSTR* _str) {
+
+	ZSTRVIEW view;
+	view.lpData = ZStr_CStr(_str);
+	view.iLength = ZStr_Length(_str);
+	return view;
+}
+
+
+ZSTRVIEW
+ZStr_Slice(
+	_In_ const ZSTR* _str,
+	_In_ SizeT       _begin,
+	_In_ SizeT       _end) {
+
+	ZSTRVIEW view;
+	SizeT    length;
+
+	length = ZStr_Length(_str);
+	_end = Z_Min(_end, length);
+	_begin = Z_Min(_begin, _end);
+	view.lpData = ZStr_CStr(_str) + _begin;
+	view.iLength = _end - _begin;
+	return view;
+}
+
+
+Int32
+ZStr_CaseCmp(
+	_In_ const ZSTR* _str1,
+	_In_ const ZSTR* _str2) {
+
+	return ZString_CaseCmpEx(
+		ZStr_CStr(_str1), ZStr_Length(_str1),
+		ZStr_CStr(_str2), ZStr_Length(_str2));
+}
+
+
+Int32
+ZStr_Compare(
+	_In_ const ZSTR* _str1,
+	_In_ const ZSTR* _str2) {
+
+	SizeT len1, len2;
+	Int32 result;
+
+	len1 = ZStr_Length(_str1);
+	len2 = ZStr_Length(_str2);
+	result = memcmp(ZStr_CStr(_str1), ZStr_CStr(_str2), Z_Min(len1, len2));
+	if (result != 0 || len1 == len2)
+		return result;
+	return (len1 < len2) ? -1 : 1;
+}
+
+
+Intptr
+ZStr_Find(
+	_In_ const ZSTR* _str,
+	_In_ Char        _char) {
+
+	return ZString_FindOfEx(ZStr_CStr(_str), ZStr_Length(_str), _char);
+}
+
+
+Intptr
+ZStr_FindLast(
+	_In_ const ZSTR* _str,
+	_In_ Char        _char) {
+
+	return ZString_FindLastOfEx(ZStr_CStr(_str), ZStr_Length(_str), _char);
+}
+/*****************************************************************************/  
+//EOF
+/*****************************************************************************/  
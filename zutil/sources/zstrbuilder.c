@@ -0,0 +1,219 @@
+/******************************************************************************
+* zutil - C Utility Library
+* Copyright (C) 2017-2021 Zachary T Harris. All Rights Reserved.  
+* Zlib license.
+* 
+* File: zstrbuilder.c
+* Desc: incremental string assembly without rescanning
+*******************************************************************************
+
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+******************************************************************************/ 
+#include "zutil/zformat.h"
+#include "zutil/zstrbuilder.h"
+
+
+
+#define ZSTRBUILDER_MIN_CAPACITY 64 //smallest heap buffer allocated
+
+
+
+/*
+Makes room for _len more bytes, growing a heap buffer geometrically.
+@return: True if the bytes fit, else false and the error is recorded*/
+static Bool
+ZStrBuilder_Grow(
+	_Inout_ ZSTRBUILDER* _sb,
+	_In_    SizeT        _len) {
+
+	Char* data;
+	SizeT capacity;
+
+	if (_len <= _sb->iCapacity - _sb->iLength) {
+		return Z_TRUE;
+	}
+	if (_sb->bGrowable && _len <= ((SizeT)-2) - _sb->iLength) {
+		capacity = _sb->iCapacity + _sb->iCapacity / 2;
+		if (capacity < _sb->iLength + _len) {
+			capacity = _sb->iLength + _len;
+		}
+		data = (Char*)realloc(_sb->lpData, capacity + 1);
+		if (data) {
+			_sb->lpData = data;
+			_sb->iCapacity = capacity;
+			return Z_TRUE;
+		}
+	}
+	_sb->zresult = Z_EOUTOFMEMORY;
+	return Z_FALSE;
+}
+
+
+
+ZRESULT
+ZStrBuilder_Init(
+	_Out_ ZSTRBUILDER* _sb,
+	_In_  SizeT        _capacity) {
+
+	_capacity = Z_Max(_capacity, ZSTRBUILDER_MIN_CAPACITY);
+	_sb->lpData = (Char*)malloc(_capacity + 1);
+	if (!_sb->lpData) {
+		memset(_sb, 0, sizeof(ZSTRBUILDER));
+		_sb->zresult = Z_EOUTOFMEMORY;
+		return Z_EOUTOFMEMORY;
+	}
+	_sb->lpData[0] = '\0';
+	_sb->iLength = 0;
+	_sb->iCapacity = _capacity;
+	_sb->bGrowable = Z_TRUE;
+	_sb->zresult = Z_OK;
+	return Z_OK;
+}
+
+
+Void
+ZStrBuilder_InitBuffer(
+	_Out_   ZSTRBUILDER* _sb,
+	_Inout_ Char*        _buffer,
+	_In_    SizeT        _size) {
+
+	assert(_buffer && _size > 0);
+	_buffer[0] = '\0';
+	_sb->lpData = _buffer;
+	_sb->iLength = 0;
+	_sb->iCapacity = _size - 1;
+	_sb->bGrowable = Z_FALSE;
+	_sb->zresult = Z_OK;
+}
+
+
+Void
+ZStrBuilder_Free(
+	_Inout_ ZSTRBUILDER* _sb) {
+
+	if (_sb->bGrowable) {
+		free(_sb->lpData);
+	}
+	memset(_sb, 0, sizeof(ZSTRBUILDER));
+}
+
+
+Void
+ZStrBuilder_Reset(
+	_Inout_ ZSTRBUILDER* _sb) {
+
+	if (_sb->lpData) {
+		_sb->lpData[0] = '\0';
+	}
+	_sb->iLength = 0;
+	_sb->zresult = Z_OK;
+}
+
+
+Void
+ZStrBuilder_AppendChar(
+	_Inout_ ZSTRBUILDER* _sb,
+	_In_    Char         _char) {
+
+	if (Z_FAILURE(_sb->zresult) || !ZStrBuilder_Grow(_sb, 1)) {
+		return;
+	}
+	_sb->lpData[_sb->iLength++] = _char;
+	_sb->lpData[_sb->iLength] = '\0';
+}
+
+
+Void
+ZStrBuilder_AppendN(
+	_Inout_ ZSTRBUILDER* _sb,
+	_In_    Lpcstr       _src,
+	_In_    SizeT        _len) {
+
+	if (Z_FAILURE(_sb->zresult) || !_sb->lpData) {
+		return;
+	}
+	if (!ZStrBuilder_Grow(_sb, _len)) {
+		_len = _sb->iCapacity - _sb->iLength; //keep what fits
+	}
+	memcpy(_sb->lpData + _sb->iLength, _src, _len);
+	_sb->iLength += _len;
+	_sb->lpData[_sb->iLength] = '\0';
+}
+
+
+Void
+ZStrBuilder_AppendStr(
+	_Inout_ ZSTRBUILDER* _sb,
+	_In_    Lpcstr       _src) {
+
+	ZStrBuilder_AppendN(_sb, _src, strlen(_src));
+}
+
+
+Void
+ZStrBuilder_AppendView(
+	_Inout_ ZSTRBUILDER* _sb,
+	_In_    ZSTRVIEW     _view) {
+
+	ZStrBuilder_AppendN(_sb, _view.lpData, _view.iLength);
+}
+
+
+Void
+ZStrBuilder_AppendUint(
+	_Inout_ ZSTRBUILDER* _sb,
+	_In_    Uint64       _value) {
+
+	Char digits[ZFORMAT_INT_SIZE];
+	ZStrBuilder_AppendN(_sb, digits, ZFormat_Uint(_value, digits));
+}
+
+
+Void
+ZStrBuilder_AppendInt(
+	_Inout_ ZSTRBUILDER* _sb,
+	_In_    Int64        _value) {
+
+	Char digits[ZFORMAT_INT_SIZE];
+	ZStrBuilder_AppendN(_sb, digits, ZFormat_Int(_value, digits));
+}
+
+
+Void
+ZStrBuilder_AppendFloat(
+	_Inout_ ZSTRBUILDER* _sb,
+	_In_    Real64       _value,
+	_In_    Int32        _decPlaces) {
+
+	Char digits[ZFORMAT_FIXED_SIZE];
+	ZStrBuilder_AppendN(
+		_sb, digits, ZFormat_DoubleFixed(_value, _decPlaces, digits));
+}
+
+
+Void
+ZStrBuilder_AppendDouble(
+	_Inout_ ZSTRBUILDER* _sb,
+	_In_    Real64       _value) {
+
+	Char digits[ZFORMAT_FLOAT_SIZE];
+	ZStrBuilder_AppendN(_sb, digits, ZFormat_Double(_value, digits));
+}
+/*****************************************************************************/  
+//EOF
+/*****************************************************************************/  
@@ -24,9 +24,735 @@ freely, subject to the following restrictions:
    misrepresented as being the original software.
 3. This notice may not be removed or altered from any source distribution.
 ******************************************************************************/
-#include <math.h>
+#include "zutil/zformat.h"
+#include "zutil/zparse.h"
 #include "zutil/zstring.h" 
 
+#if (Z_ARCHITECTURE_AVX2)
+#  include <immintrin.h>
+#  define ZSTRING_AVX2 1
+#endif
+#if (Z_ARCHITECTURE_SSE2)
+#  include <emmintrin.h>
+#  define ZSTRING_SSE2 1
+#elif (Z_ARCHITECTURE_NEON && Z_ARCHITECTURE_ARM_64)
+#  include <arm_neon.h>
+#  define ZSTRING_NEON 1
+#endif
+
+
+
+/*
+** ASCII case helpers:
+** The vector paths only change the ASCII letters of a block. Blocks that
+** hold bytes above 0x7F go through tolower/toupper instead, so the result
+** is the same as the per-byte locale conversion. Comparisons fold both
+** sides in the vector unit and only fall back to the locale at the first
+** differing byte.
+******************************************************************************/
+static FORCEINLINE Int32
+ZString_FoldUpper(
+	_In_ Byte _ch) {
+
+	if (_ch < 0x80) {
+		return ((Uint32)_ch - 'a' < 26u) ? (_ch ^ 0x20) : _ch;
+	}
+	return toupper(_ch);
+}
+
+
+
+
+static Void
+ZString_ToLowerScalar(
+	_Inout_ Char* _str,
+	_In_    SizeT _len) {
+
+	SizeT index;
+	for (index = 0; index < _len; ++index)
+		_str[index] = (Char)tolower((Byte)_str[index]);
+}
+
+
+static Void
+ZString_ToUpperScalar(
+	_Inout_ Char* _str,
+	_In_    SizeT _len) {
+
+	SizeT index;
+	for (index = 0; index < _len; ++index)
+		_str[index] = (Char)toupper((Byte)_str[index]);
+}
+
+
+#if (ZSTRING_AVX2)
+/*
+Flips the case of the letters in [_first, _first + 26) of 32 bytes*/
+static FORCEINLINE __m256i
+ZString_FlipCase32(
+	_In_ __m256i _v,
+	_In_ Char    _first) {
+
+	__m256i rel, mask;
+	rel = _mm256_sub_epi8(_v, _mm256_set1_epi8((Char)(_first + 128)));
+	mask = _mm256_cmpgt_epi8(_mm256_set1_epi8(-128 + 26), rel);
+	mask = _mm256_and_si256(mask, _mm256_set1_epi8(0x20));
+	return _mm256_xor_si256(_v, mask);
+}
+
+
+static FORCEINLINE Uint32
+ZString_CaseMismatch32(
+	_In_ Lpcstr _str1,
+	_In_ Lpcstr _str2) {
+
+	__m256i a, b;
+	a = _mm256_loadu_si256((const __m256i*)_str1);
+	b = _mm256_loadu_si256((const __m256i*)_str2);
+	a = ZString_FlipCase32(a, 'a');
+	b = ZString_FlipCase32(b, 'a');
+	return ~(Uint32)_mm256_movemask_epi8(_mm256_cmpeq_epi8(a, b));
+}
+#endif
+
+
+#if (ZSTRING_SSE2)
+/*
+Flips the case of the letters in [_first, _first + 26) of 16 bytes*/
+static FORCEINLINE __m128i
+ZString_FlipCase16(
+	_In_ __m128i _v,
+	_In_ Char    _first) {
+
+	__m128i rel, mask;
+	rel = _mm_sub_epi8(_v, _mm_set1_epi8((Char)(_first + 128)));
+	mask = _mm_cmplt_epi8(rel, _mm_set1_epi8(-128 + 26));
+	return _mm_xor_si128(_v, _mm_and_si128(mask, _mm_set1_epi8(0x20)));
+}
+
+
+static FORCEINLINE Bool
+ZString_HasHighBit16(
+	_In_ __m128i _v) {
+
+	return _mm_movemask_epi8(_v) != 0;
+}
+
+
+static FORCEINLINE Uint64
+ZString_CaseMismatch16(
+	_In_ Lpcstr _str1,
+	_In_ Lpcstr _str2) {
+
+	__m128i a, b;
+	a = _mm_loadu_si128((const __m128i*)_str1);
+	b = _mm_loadu_si128((const __m128i*)_str2);
+	a = ZString_FlipCase16(a, 'a');
+	b = ZString_FlipCase16(b, 'a');
+	return ~(Uint32)_mm_movemask_epi8(_mm_cmpeq_epi8(a, b)) & 0xFFFF;
+}
+#  define ZSTRING_MISMATCH_SHIFT 0 //mask bits per byte: 1
+#elif (ZSTRING_NEON)
+static FORCEINLINE uint8x16_t
+ZString_FlipCase16(
+	_In_ uint8x16_t _v,
+	_In_ Char       _first) {
+
+	uint8x16_t mask;
+	mask = vcltq_u8(vsubq_u8(_v, vdupq_n_u8((Byte)_first)), vdupq_n_u8(26));
+	return veorq_u8(_v, vandq_u8(mask, vdupq_n_u8(0x20)));
+}
+
+
+static FORCEINLINE Bool
+ZString_HasHighBit16(
+	_In_ uint8x16_t _v) {
+
+	return vmaxvq_u8(_v) >= 0x80;
+}
+
+
+static FORCEINLINE Uint64
+ZString_CaseMismatch16(
+	_In_ Lpcstr _str1,
+	_In_ Lpcstr _str2) {
+
+	uint8x16_t a, b, ne;
+	a = ZString_FlipCase16(vld1q_u8((const Byte*)_str1), 'a');
+	b = ZString_FlipCase16(vld1q_u8((const Byte*)_str2), 'a');
+	ne = vmvnq_u8(vceqq_u8(a, b));
+	return vget_lane_u64(vreinterpret_u64_u8(
+		vshrn_n_u16(vreinterpretq_u16_u8(ne), 4)), 0);
+}
+#  define ZSTRING_MISMATCH_SHIFT 2 //mask bits per byte: 4
+#endif
+
+
+#if (ZSTRING_SSE2)
+#  define ZString_Load16(p)     _mm_loadu_si128((const __m128i*)(p))
+#  define ZString_Store16(p, v) _mm_storeu_si128((__m128i*)(p), v)
+#elif (ZSTRING_NEON)
+#  define ZString_Load16(p)     vld1q_u8((const Byte*)(p))
+#  define ZString_Store16(p, v) vst1q_u8((Byte*)(p), v)
+#endif
+
+
+/*
+Flips the case of the ASCII letters in [_first, _first + 26), 
+calling _scalar for blocks that hold non-ASCII bytes*/
+static FORCEINLINE SizeT
+ZString_ConvertCaseVector(
+	_Inout_ Char* _str,
+	_In_    SizeT _len,
+	_In_    Char  _first,
+	_In_    Void (*_scalar)(Char*, SizeT)) {
+
+	SizeT index = 0;
+#if (ZSTRING_AVX2)
+	for (; index + 32 <= _len; index += 32) {
+		__m256i v = _mm256_loadu_si256((const __m256i*)(_str + index));
+		if (_mm256_movemask_epi8(v)) {
+			_scalar(_str + index, 32);
+			continue;
+		}
+		_mm256_storeu_si256(
+			(__m256i*)(_str + index), ZString_FlipCase32(v, _first));
+	}
+#endif
+#if (ZSTRING_SSE2 || ZSTRING_NEON)
+	for (; index + 16 <= _len; index += 16) {
+		if (ZString_HasHighBit16(ZString_Load16(_str + index))) {
+			_scalar(_str + index, 16);
+			continue;
+		}
+		ZString_Store16(_str + index,
+			ZString_FlipCase16(ZString_Load16(_str + index), _first));
+	}
+#endif
+	Z_Unused(_str);
+	Z_Unused(_len);
+	Z_Unused(_first);
+	Z_Unused(_scalar);
+	return index;
+}
+
+
+/*
+Compares explicit-length strings ignoring case, 
+returning the folded difference of the first differing byte*/
+static Int32
+ZString_CaseCmpVector(
+	_In_    Lpcstr _str1,
+	_In_    Lpcstr _str2,
+	_In_    SizeT  _len,
+	_Inout_ Bool*  _lpEqual) {
+
+	SizeT index = 0;
+	Int32 a, b;
+
+#if (ZSTRING_AVX2)
+	while (index + 32 <= _len) {
+		const Uint64 mask =
+			ZString_CaseMismatch32(_str1 + index, _str2 + index);
+		if (!mask) {
+			index += 32;
+			continue;
+		}
+		index += (Uint32)Z_CTZ64(mask);
+		a = ZString_FoldUpper((Byte)_str1[index]);
+		b = ZString_FoldUpper((Byte)_str2[index]);
+		if (a != b) {
+			*_lpEqual = Z_FALSE;
+			return a - b;
+		}
+		++index; //equal under the locale, resume after it
+	}
+#endif
+#if (ZSTRING_SSE2 || ZSTRING_NEON)
+	while (index + 16 <= _len) {
+		const Uint64 mask =
+			ZString_CaseMismatch16(_str1 + index, _str2 + index);
+		if (!mask) {
+			index += 16;
+			continue;
+		}
+		index += (Uint32)Z_CTZ64(mask) >> ZSTRING_MISMATCH_SHIFT;
+		a = ZString_FoldUpper((Byte)_str1[index]);
+		b = ZString_FoldUpper((Byte)_str2[index]);
+		if (a != b) {
+			*_lpEqual = Z_FALSE;
+			return a - b;
+		}
+		++index;
+	}
+#endif
+	for (; index < _len; ++index) {
+		a = ZString_FoldUpper((Byte)_str1[index]);
+		b = ZString_FoldUpper((Byte)_str2[index]);
+		if (a != b) {
+			*_lpEqual = Z_FALSE;
+			return a - b;
+		}
+	}
+	*_lpEqual = Z_TRUE;
+	return 0;
+}
+
+
+
+/*
+** Search helpers:
+** Substring search filters candidate positions a vector block at a time
+** by comparing the first and the last byte of the needle, and verifies
+** candidates with memcmp. The verification work is budgeted against the
+** distance scanned; needles that keep producing false candidates switch
+** to the Two-Way algorithm, which is linear in the worst case. Two-Way 
+** reads its sequences through a stride of +1 or -1 so that the same code
+** searches backwards for ZString_FindLast.
+******************************************************************************/
+#define ZSTRING_SEARCH_BUDGET 256 //verified bytes allowed before the budget
+
+#if (ZSTRING_AVX2)
+#  define ZSTRING_SEARCH_BLOCK 32
+#  define ZSTRING_SEARCH_SHIFT 0
+#elif (ZSTRING_SSE2 || ZSTRING_NEON)
+#  define ZSTRING_SEARCH_BLOCK 16
+#  define ZSTRING_SEARCH_SHIFT ZSTRING_MISMATCH_SHIFT
+#endif
+#if (ZSTRING_AVX2 || ZSTRING_NEON || (ZSTRING_SSE2 && Z_ARCHITECTURE_SSSE3))
+#  define ZSTRING_SHUFFLE 1
+#endif
+#if (ZSTRING_SSE2 && Z_ARCHITECTURE_SSSE3)
+#  include <tmmintrin.h>
+#endif
+
+
+#if (ZSTRING_AVX2)
+static FORCEINLINE Uint64
+ZString_ByteMask(
+	_In_ Lpcstr _str,
+	_In_ Byte   _ch) {
+
+	__m256i v;
+	v = _mm256_loadu_si256((const __m256i*)_str);
+	return (Uint32)_mm256_movemask_epi8(
+		_mm256_cmpeq_epi8(v, _mm256_set1_epi8((Char)_ch)));
+}
+
+
+static FORCEINLINE Uint64
+ZString_PairMask(
+	_In_ Lpcstr _str,
+	_In_ SizeT  _dist,
+	_In_ Byte   _first,
+	_In_ Byte   _last) {
+
+	__m256i a, b;
+	a = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)_str), 
+		_mm256_set1_epi8((Char)_first));
+	b = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)(_str + _dist)),
+		_mm256_set1_epi8((Char)_last));
+	return (Uint32)_mm256_movemask_epi8(_mm256_and_si256(a, b));
+}
+
+
+static FORCEINLINE Uint64
+ZString_SetMask(
+	_In_ Lpcstr          _str,
+	_In_ const ZCHARSET* _set) {
+
+	__m256i v, lo, hi, lower, upper, selLower, selUpper, hits;
+	lower = _mm256_broadcastsi128_si256(
+		_mm_loadu_si128((const __m128i*)_set->lower));
+	upper = _mm256_broadcastsi128_si256(
+		_mm_loadu_si128((const __m128i*)_set->upper));
+	selLower = _mm256_setr_epi8(
+		1, 2, 4, 8, 16, 32, 64, -128, 0, 0, 0, 0, 0, 0, 0, 0,
+		1, 2, 4, 8, 16, 32, 64, -128, 0, 0, 0, 0, 0, 0, 0, 0);
+	selUpper = _mm256_setr_epi8(
+		0, 0, 0, 0, 0, 0, 0, 0, 1, 2, 4, 8, 16, 32, 64, -128,
+		0, 0, 0, 0, 0, 0, 0, 0, 1, 2, 4, 8, 16, 32, 64, -128);
+	v  = _mm256_loadu_si256((const __m256i*)_str);
+	lo = _mm256_and_si256(v, _mm256_set1_epi8(0x0F));
+	hi = _mm256_and_si256(_mm256_srli_epi16(v, 4), _mm256_set1_epi8(0x0F));
+	hits = _mm256_or_si256(
+		_mm256_and_si256(_mm256_shuffle_epi8(lower, lo), 
+			_mm256_shuffle_epi8(selLower, hi)),
+		_mm256_and_si256(_mm256_shuffle_epi8(upper, lo), 
+			_mm256_shuffle_epi8(selUpper, hi)));
+	return ~(Uint32)_mm256_movemask_epi8(
+		_mm256_cmpeq_epi8(hits, _mm256_setzero_si256())) & 0xFFFFFFFFULL;
+}
+#elif (ZSTRING_SSE2)
+static FORCEINLINE Uint64
+ZString_ByteMask(
+	_In_ Lpcstr _str,
+	_In_ Byte   _ch) {
+
+	return (Uint32)_mm_movemask_epi8(
+		_mm_cmpeq_epi8(ZString_Load16(_str), _mm_set1_epi8((Char)_ch)));
+}
+
+
+static FORCEINLINE Uint64
+ZString_PairMask(
+	_In_ Lpcstr _str,
+	_In_ SizeT  _dist,
+	_In_ Byte   _first,
+	_In_ Byte   _last) {
+
+	__m128i a, b;
+	a = _mm_cmpeq_epi8(ZString_Load16(_str), _mm_set1_epi8((Char)_first));
+	b = _mm_cmpeq_epi8(ZString_Load16(_str + _dist), 
+		_mm_set1_epi8((Char)_last));
+	return (Uint32)_mm_movemask_epi8(_mm_and_si128(a, b));
+}
+
+
+#  if (ZSTRING_SHUFFLE)
+static FORCEINLINE Uint64
+ZString_SetMask(
+	_In_ Lpcstr          _str,
+	_In_ const ZCHARSET* _set) {
+
+	__m128i v, lo, hi, selLower, selUpper, hits;
+	selLower = _mm_setr_epi8(
+		1, 2, 4, 8, 16, 32, 64, -128, 0, 0, 0, 0, 0, 0, 0, 0);
+	selUpper = _mm_setr_epi8(
+		0, 0, 0, 0, 0, 0, 0, 0, 1, 2, 4, 8, 16, 32, 64, -128);
+	v  = ZString_Load16(_str);
+	lo = _mm_and_si128(v, _mm_set1_epi8(0x0F));
+	hi = _mm_and_si128(_mm_srli_epi16(v, 4), _mm_set1_epi8(0x0F));
+	hits = _mm_or_si128(
+		_mm_and_si128(_mm_shuffle_epi8(ZString_Load16(_set->lower), lo),
+			_mm_shuffle_epi8(selLower, hi)),
+		_mm_and_si128(_mm_shuffle_epi8(ZString_Load16(_set->upper), lo),
+			_mm_shuffle_epi8(selUpper, hi)));
+	return ~(Uint32)_mm_movemask_epi8(
+		_mm_cmpeq_epi8(hits, _mm_setzero_si128())) & 0xFFFF;
+}
+#  endif
+#elif (ZSTRING_NEON)
+/*
+Narrows a byte mask to 4 bits per byte and keeps one bit of each*/
+static FORCEINLINE Uint64
+ZString_NarrowMask(
+	_In_ uint8x16_t _eq) {
+
+	return vget_lane_u64(vreinterpret_u64_u8(
+		vshrn_n_u16(vreinterpretq_u16_u8(_eq), 4)), 0) &
+		0x8888888888888888ULL;
+}
+
+
+static FORCEINLINE Uint64
+ZString_ByteMask(
+	_In_ Lpcstr _str,
+	_In_ Byte   _ch) {
+
+	return ZString_NarrowMask(vceqq_u8(ZString_Load16(_str), vdupq_n_u8(_ch)));
+}
+
+
+static FORCEINLINE Uint64
+ZString_PairMask(
+	_In_ Lpcstr _str,
+	_In_ SizeT  _dist,
+	_In_ Byte   _first,
+	_In_ Byte   _last) {
+
+	return ZString_NarrowMask(vandq_u8(
+		vceqq_u8(ZString_Load16(_str), vdupq_n_u8(_first)),
+		vceqq_u8(ZString_Load16(_str + _dist), vdupq_n_u8(_last))));
+}
+
+
+static FORCEINLINE Uint64
+ZString_SetMask(
+	_In_ Lpcstr          _str,
+	_In_ const ZCHARSET* _set) {
+
+	static const Byte selLower[16] = {
+		1, 2, 4, 8, 16, 32, 64, 128, 0, 0, 0, 0, 0, 0, 0, 0 };
+	static const Byte selUpper[16] = {
+		0, 0, 0, 0, 0, 0, 0, 0, 1, 2, 4, 8, 16, 32, 64, 128 };
+	uint8x16_t v, lo, hi, hits;
+	v  = ZString_Load16(_str);
+	lo = vandq_u8(v, vdupq_n_u8(0x0F));
+	hi = vshrq_n_u8(v, 4);
+	hits = vorrq_u8(
+		vandq_u8(vqtbl1q_u8(vld1q_u8(_set->lower), lo), 
+			vqtbl1q_u8(vld1q_u8(selLower), hi)),
+		vandq_u8(vqtbl1q_u8(vld1q_u8(_set->upper), lo), 
+			vqtbl1q_u8(vld1q_u8(selUpper), hi)));
+	return ZString_NarrowMask(vtstq_u8(hits, hits));
+}
+#endif
+
+
+/*
+Reads element _i of a sequence walked with stride _step (+1 or -1)*/
+static FORCEINLINE Byte
+ZString_At(
+	_In_ Lpcstr _seq,
+	_In_ SizeT  _i,
+	_In_ Intptr _step) {
+
+	return (Byte)_seq[(Intptr)_i * _step];
+}
+
+
+/*
+Computes the critical factorization of a needle for Two-Way: the 
+shorter of the maximal suffixes under both byte orders.
+@_lpPeriod: receives the period of the chosen suffix
+@return   : start of the right half of the factorization*/
+static SizeT
+ZString_CriticalFactorization(
+	_In_    Lpcstr _sub,
+	_In_    SizeT  _sublen,
+	_In_    Intptr _step,
+	_Inout_ SizeT* _lpPeriod) {
+
+	SizeT maxSuffix, maxSuffixRev, j, k, p;
+	Byte  a, b;
+
+	maxSuffix = (SizeT)-1;
+	j = 0;
+	k = p = 1;
+	while (j + k < _sublen) {
+		a = ZString_At(_sub, j + k, _step);
+		b = ZString_At(_sub, maxSuffix + k, _step);
+		if (a < b) {
+			j += k;
+			k = 1;
+			p = j - maxSuffix;
+		}
+		else if (a == b) {
+			if (k != p) {
+				++k;
+			}
+			else {
+				j += p;
+				k = 1;
+			}
+		}
+		else {
+			maxSuffix = j++;
+			k = p = 1;
+		}
+	}
+	*_lpPeriod = p;
+
+	maxSuffixRev = (SizeT)-1;
+	j = 0;
+	k = p = 1;
+	while (j + k < _sublen) {
+		a = ZString_At(_sub, j + k, _step);
+		b = ZString_At(_sub, maxSuffixRev + k, _step);
+		if (b < a) {
+			j += k;
+			k = 1;
+			p = j - maxSuffixRev;
+		}
+		else if (a == b) {
+			if (k != p) {
+				++k;
+			}
+			else {
+				j += p;
+				k = 1;
+			}
+		}
+		else {
+			maxSuffixRev = j++;
+			k = p = 1;
+		}
+	}
+	if (maxSuffixRev + 1 < maxSuffix + 1)
+		return maxSuffix + 1;
+	*_lpPeriod = p;
+	return maxSuffixRev + 1;
+}
+
+
+/*
+Finds the first occurrence of a needle with the Two-Way algorithm in 
+O(_len + _sublen) time and constant space, for 0 < _sublen <= _len*/
+static Intptr
+ZString_TwoWay(
+	_In_ Lpcstr _str,
+	_In_ SizeT  _len,
+	_In_ Lpcstr _sub,
+	_In_ SizeT  _sublen,
+	_In_ Intptr _step) {
+
+	SizeT suffix, period, memory, i, j;
+
+	if (_len < _sublen)
+		return Z_UNDEFINED;
+	suffix = ZString_CriticalFactorization(_sub, _sublen, _step, &period);
+	for (i = 0; i < suffix; ++i) {
+		if (ZString_At(_sub, i, _step) != ZString_At(_sub, i + period, _step))
+			break;
+	}
+
+	j = 0;
+	if (i == suffix) {
+		//periodic needle: remember the matched prefix across shifts
+		memory = 0;
+		while (j <= _len - _sublen) {
+			i = Z_Max(suffix, memory);
+			while (i < _sublen && 
+				ZString_At(_sub, i, _step) == ZString_At(_str, i + j, _step)) {
+				++i;
+			}
+			if (_sublen <= i) {
+				i = suffix - 1;
+				while (memory < i + 1 &&
+					ZString_At(_sub, i, _step) == ZString_At(_str, i + j, _step)) {
+					--i;
+				}
+				if (i + 1 < memory + 1)
+					return (Intptr)j;
+				j += period;
+				memory = _sublen - period;
+			}
+			else {
+				j += i - suffix + 1;
+				memory = 0;
+			}
+		}
+	}
+	else {
+		period = Z_Max(suffix, _sublen - suffix) + 1;
+		while (j <= _len - _sublen) {
+			i = suffix;
+			while (i < _sublen && 
+				ZString_At(_sub, i, _step) == ZString_At(_str, i + j, _step)) {
+				++i;
+			}
+			if (_sublen <= i) {
+				i = suffix - 1;
+				while (i != (SizeT)-1 &&
+					ZString_At(_sub, i, _step) == ZString_At(_str, i + j, _step)) {
+					--i;
+				}
+				if (i == (SizeT)-1)
+					return (Intptr)j;
+				j += period;
+			}
+			else {
+				j += i - suffix + 1;
+			}
+		}
+	}
+	return Z_UNDEFINED;
+}
+
+
+/*
+Finds the first occurrence of a needle of at least two bytes starting at
+or after _index, filtering candidates with memchr on the first byte.
+@_work : verified bytes so far, switches to Two-Way past the budget*/
+static Intptr
+ZString_FindScalar(
+	_In_ Lpcstr _str,
+	_In_ SizeT  _len,
+	_In_ Lpcstr _sub,
+	_In_ SizeT  _sublen,
+	_In_ SizeT  _index,
+	_In_ SizeT  _work) {
+
+	Lpcstr found;
+	SizeT  limit;
+	Intptr result;
+
+	limit = _len - _sublen;
+	while (_index <= limit) {
+		found = (Lpcstr)memchr(_str + _index, _sub[0], limit - _index + 1);
+		if (!found)
+			return Z_UNDEFINED;
+		_index = (SizeT)(found - _str);
+		if (!memcmp(found + 1, _sub + 1, _sublen - 1))
+			return (Intptr)_index;
+		++_index;
+		_work += _sublen;
+		if (_work > 2 * _index + ZSTRING_SEARCH_BUDGET) {
+			result = ZString_TwoWay(
+				_str + _index, _len - _index, _sub, _sublen, 1);
+			return (result < 0) ? result : result + (Intptr)_index;
+		}
+	}
+	return Z_UNDEFINED;
+}
+
+
+/*
+Finds the last occurrence of a needle of at least two bytes that starts
+before _end, scanning backwards*/
+static Intptr
+ZString_FindLastScalar(
+	_In_ Lpcstr _str,
+	_In_ SizeT  _len,
+	_In_ Lpcstr _sub,
+	_In_ SizeT  _sublen,
+	_In_ SizeT  _end,
+	_In_ SizeT  _work) {
+
+	SizeT  scanned;
+	Intptr result;
+
+	scanned = _len - _sublen + 1 - _end;
+	while (_end--) {
+		++scanned;
+		if (_str[_end] != _sub[0])
+			continue;
+		if (!memcmp(_str + _end + 1, _sub + 1, _sublen - 1))
+			return (Intptr)_end;
+		_work += _sublen;
+		if (_work > 2 * scanned + ZSTRING_SEARCH_BUDGET) {
+			//search str[0, _end + _sublen - 1) back to front
+			result = ZString_TwoWay(_str + _end + _sublen - 2, 
+				_end + _sublen - 1, _sub + _sublen - 1, _sublen, -1);
+			return (result < 0) ? result : 
+				(Intptr)(_end - 1) - result;
+		}
+	}
+	return Z_UNDEFINED;
+}
+
+
+/*
+Copies _src[_begin, _end), clamped to the string, into a new string
+from _lpArena, or from the heap if _lpArena is NULL.
+@return: the substring, or NULL if _end < _begin or out of memory*/
+static Char*
+ZString_SubStrTo(
+	_Inout_opt_ ZArena* _lpArena,
+	_In_        Lpcstr  _src,
+	_In_        Uint32  _begin,
+	_In_        Uint32  _end) {
+
+	Char*  dst;
+	SizeT  srclen, len;
+
+	dst = NULL;
+	if (_end >= _begin) {
+		srclen = strlen(_src);
+		_begin = (Uint32)Z_Min((SizeT)_begin, srclen);
+		len = Z_Min((SizeT)(_end - _begin), srclen - _begin);
+		dst = (_lpArena != NULL) ? 
+			(Char*)ZArena_Alloc(_lpArena, sizeof(Char)* (len + 1), 1) :
+			(Char*)malloc(sizeof(Char)* (len + 1));
+		if (dst != NULL) {
+			memcpy(dst, _src + _begin, len);
+			dst[len] = '\0';
+		}
+	}
+	return dst;
+}
+
 
 
 
@@ -47,21 +773,12 @@ ZString_CaseCmp(
 	_In_ Lpcstr _str1,
 	_In_ Lpcstr _str2) {
 
-	Char a, b;
-	a = 0;
-	b = 0;
-
-	while (*_str1 && *_str2) {
-		a = toupper((Byte)*_str1);
-		b = toupper((Byte)*_str2);
-		if (a != b)
-			break;
-		++_str1;
-		++_str2;
-	}
-	a = toupper(*_str1);
-	b = toupper(*_str2);
-	return (Int32)((Byte)a - (Byte)b);
+	Int32 a, b;
+	do {
+		a = ZString_FoldUpper((Byte)*_str1++);
+		b = ZString_FoldUpper((Byte)*_str2++);
+	} while (a == b && a != 0);
+	return a - b;
 }
 
 
@@ -83,18 +800,29 @@ ZString_Copy(
 }
 
 
+Char*
+ZString_CopyArena(
+	_Inout_ ZArena* _lpArena,
+	_In_    Lpcstr  _src) {
+
+	SizeT len;
+	Char* out = NULL; 
+	if (_src != NULL) {
+		len = strlen(_src);
+		out = (Char*)ZArena_Alloc(_lpArena, (len + 1) * sizeof(Char), 1);
+		if (out != NULL)
+			memcpy(out, _src, len + 1);
+	}
+	return out;
+}
+
+
 Int32 
 ZString_FindLastOf(
 	_In_ Lpcstr _str,
 	_In_ Char   _char) {
 
-	Int32 index;
-	index = strlen(_str) - 1;
-	for (; index >= 0; index--) {
-		if (_str[index] == _char)
-			return index;
-	}
-	return Z_UNDEFINED;
+	return (Int32)ZString_FindLastOfEx(_str, strlen(_str), _char);
 }
 
 
@@ -104,63 +832,8 @@ ZString_Ftoa(
 	_Inout_ Char* _dststr,
 	_In_    Int32 _decPlaces) {
 
-	Char* tmpstr1;
-	Int32 iPart, index;
-	Int32 a, b, c, d, x, temp;
-	Float fPart;
-
-	iPart = (Int32)_fValue;
-	fPart = _fValue - (Float)iPart;
-	{
-		tmpstr1 = _dststr;
-		x = iPart;
-		d = 0;
-		a = 0;
-		b = 0;
-		while (x) {
-			tmpstr1[a++] = (x % 0xA) + '0';
-			x = x / 0xA;
-		}
-		while (a < d) { tmpstr1[a++] = '0'; }
-
-		c = a - 1;
-		while (b < c) {
-			temp = tmpstr1[b];
-			tmpstr1[b] = tmpstr1[c];
-			tmpstr1[c] = temp;
-			b++; 
-			c--;
-		}
-		tmpstr1[a] = '\0';
-		index = a;
-	}
-	if (_decPlaces != 0) {
-		_dststr[index] = '.';
-		fPart = (Float)(fPart * pow(10.f, _decPlaces));
-		{
-			tmpstr1 = _dststr + index + 1;
-			x = (Int32)fPart;
-			d = _decPlaces;
-			a = 0;
-			b = 0;
-			while (x) {
-				tmpstr1[a++] = (x % 0xA) + '0';
-				x = x / 0xA;
-			}
-			while (a < d) { tmpstr1[a++] = '0'; }
-
-			c = a - 1;
-			while (b < c) {
-				temp = tmpstr1[b];
-				tmpstr1[b] = tmpstr1[c];
-				tmpstr1[c] = temp;
-				b++; c--;
-			}
-			tmpstr1[a] = '\0';
-			index = a;
-		}
-	}
-} 
+	ZFormat_FloatFixed(_fValue, _decPlaces, _dststr);
+}
 
 
 Void
@@ -207,19 +880,18 @@ ZString_SubStr(
 	_In_ Uint32 _begin,
 	_In_ Uint32 _end) {
 
-	Char*  dst;
-	Uint32 len;
+	return ZString_SubStrTo(NULL, _src, _begin, _end);
+}
 
-	len = 0;
-	dst = NULL;
 
-	if (_end >= _begin) {
-		len = _end - _begin;
-		dst = (Char*)malloc(sizeof(Char)* (len + 1));
-		if (dst != NULL)
-			strncpy(dst, (_src + _begin), len);
-	}
-	return dst;
+Char* 
+ZString_SubStrArena(
+	_Inout_ ZArena* _lpArena,
+	_In_    Lpcstr  _src,
+	_In_    Uint32  _begin,
+	_In_    Uint32  _end) {
+
+	return ZString_SubStrTo(_lpArena, _src, _begin, _end);
 }
 
 
@@ -227,38 +899,15 @@ Bool
 ZString_ToBoolean(
 	_In_ Lpcstr _str) {
 
-	SizeT len;
-	Char* dst;
-	Bool  bResult;
-
-	bResult = Z_UNDEFINED;
+	SizeT  len;
+	Lpcstr end;
+	Bool   bResult;
 
 	len = strlen(_str);
-	if (!len)
-		return bResult;
-
-	dst = (Char*)malloc(sizeof(Char)* (strlen(_str) + 1));
-	if (!dst)
-		return bResult;
-
-	strcpy(dst, _str);
-	ZString_ToLower(dst);
-
-	if (dst == "1"      ||
-		dst == "true"   ||
-		dst == "enable" ||
-		dst == "on") {
-		bResult = Z_TRUE;
-	}
-	else if (
-		dst == "0"       ||
-		dst == "false"   ||
-		dst == "disable" ||
-		dst == "off") {
-		bResult = Z_FALSE;
+	if (Z_FAILURE(ZParse_Bool(_str, len, &bResult, &end)) || 
+		end != _str + len) {
+		return Z_UNDEFINED;
 	}
-	free(dst);
-	dst = NULL;
 	return bResult;
 }
 
@@ -267,12 +916,8 @@ Void
 ZString_ToLower(
 	_Inout_ Char* _str) {
 
-	Uint32 index, size;
-
 	if (_str != NULL) {
-		size = strlen(_str);
-		for (index = 0; index < size; ++index)
-			_str[index] = tolower(_str[index]);
+		ZString_ToLowerEx(_str, strlen(_str));
 	}
 }
 
@@ -281,12 +926,8 @@ Void
 ZString_ToUpper(
 	_Inout_ Char* _str) {
 
-	Uint32 index, size;
-
 	if (_str != NULL) {
-		size = strlen(_str);
-		for (index = 0; index < size; ++index)
-			_str[index] = toupper(_str[index]);
+		ZString_ToUpperEx(_str, strlen(_str));
 	}
 }
 
@@ -315,18 +956,7 @@ ZString_StrCaseCmp(
 	_In_ Lpcstr _str1,
 	_In_ Lpcstr _str2) {
 
-	Char a, b;
-	while (*_str1 && *_str2) {
-		a = toupper((Byte)*_str1);
-		b = toupper((Byte)*_str2);
-		if (a != b)
-			break;
-		++_str1;
-		++_str2;
-	}
-	a = toupper(*_str1);
-	b = toupper(*_str2);
-	return (Int32)((Byte)a - (Byte)b);
+	return ZString_CaseCmp(_str1, _str2);
 }
 
 
@@ -336,23 +966,262 @@ ZString_StrCaseCmpN(
 	_In_ Lpcstr _str2,
 	_In_ Int32  _iEndPoint) {
 
-	Int32 c1, c2;
-	do {
-		c1 = *_str1++;
-		c2 = *_str2++;
-		if (!_iEndPoint--)
-			return Z_TRUE; //strings are equal until end point
-
-		if (c1 != c2) {
-			if (c1 >= 'a' && c1 <= 'z')
-				c1 -= ('a' - 'A');
-			if (c2 >= 'a' && c2 <= 'z')
-				c2 -= ('a' - 'A');
-			if (c1 != c2)
-				return Z_FALSE; //strings not equal
+	Lpcstr end;
+	SizeT  len;
+
+	/*
+	bound both strings by their terminator before comparing vectors, 
+	memchr stops at the first match so it never reads past it*/
+	if (_iEndPoint < 0) {
+		len = strlen(_str1);
+	}
+	else {
+		end = (Lpcstr)memchr(_str1, '\0', (SizeT)_iEndPoint);
+		len = end ? (SizeT)(end - _str1) : (SizeT)_iEndPoint;
+	}
+	if (memchr(_str2, '\0', len) != NULL)
+		return Z_FALSE; //_str2 ends first
+	if (_iEndPoint < 0 || len < (SizeT)_iEndPoint) {
+		if (_str2[len] != '\0')
+			return Z_FALSE; //_str1 ends first
+	}
+	return ZString_CaseEqualEx(_str1, _str2, len);
+}
+
+
+Int32
+ZString_CaseCmpEx(
+	_In_ Lpcstr _str1,
+	_In_ SizeT  _len1,
+	_In_ Lpcstr _str2,
+	_In_ SizeT  _len2) {
+
+	Int32 result;
+	Bool  bEqual;
+
+	result = ZString_CaseCmpVector(
+		_str1, _str2, Z_Min(_len1, _len2), &bEqual);
+	if (!bEqual || _len1 == _len2)
+		return result;
+	return (_len1 < _len2) ? -1 : 1;
+}
+
+
+Bool
+ZString_CaseEqualEx(
+	_In_ Lpcstr _str1,
+	_In_ Lpcstr _str2,
+	_In_ SizeT  _len) {
+
+	Bool bEqual;
+	ZString_CaseCmpVector(_str1, _str2, _len, &bEqual);
+	return bEqual;
+}
+
+
+Intptr
+ZString_FindOfEx(
+	_In_ Lpcstr _str,
+	_In_ SizeT  _len,
+	_In_ Char   _char) {
+
+	Lpcstr found;
+	found = (Lpcstr)memchr(_str, _char, _len);
+	return found ? (Intptr)(found - _str) : Z_UNDEFINED;
+}
+
+
+Intptr
+ZString_FindLastOfEx(
+	_In_ Lpcstr _str,
+	_In_ SizeT  _len,
+	_In_ Char   _char) {
+
+#if (ZSTRING_SEARCH_BLOCK)
+	Uint64 mask;
+	while (_len >= ZSTRING_SEARCH_BLOCK) {
+		_len -= ZSTRING_SEARCH_BLOCK;
+		mask = ZString_ByteMask(_str + _len, (Byte)_char);
+		if (mask) {
+			return (Intptr)(_len + 
+				((63 - (Uint32)Z_CLZ64(mask)) >> ZSTRING_SEARCH_SHIFT));
+		}
+	}
+#endif
+	while (_len--) {
+		if (_str[_len] == _char)
+			return (Intptr)_len;
+	}
+	return Z_UNDEFINED;
+}
+
+
+Intptr
+ZString_Find(
+	_In_ Lpcstr _str,
+	_In_ SizeT  _len,
+	_In_ Lpcstr _sub,
+	_In_ SizeT  _sublen) {
+
+	SizeT  index, work;
+#if (ZSTRING_SEARCH_BLOCK)
+	SizeT  limit, bit;
+	Uint64 mask;
+	Intptr result;
+#endif
+
+	if (!_sublen)
+		return 0;
+	if (_sublen > _len)
+		return Z_UNDEFINED;
+	if (_sublen == 1)
+		return ZString_FindOfEx(_str, _len, _sub[0]);
+
+	index = 0;
+	work  = 0;
+#if (ZSTRING_SEARCH_BLOCK)
+	limit = _len - _sublen;
+	for (; index + ZSTRING_SEARCH_BLOCK <= limit + 1; 
+		index += ZSTRING_SEARCH_BLOCK) {
+		mask = ZString_PairMask(_str + index, _sublen - 1, 
+			(Byte)_sub[0], (Byte)_sub[_sublen - 1]);
+		while (mask) {
+			bit = (Uint32)Z_CTZ64(mask) >> ZSTRING_SEARCH_SHIFT;
+			if (!memcmp(_str + index + bit + 1, _sub + 1, _sublen - 2))
+				return (Intptr)(index + bit);
+			work += _sublen;
+			mask &= mask - 1;
+		}
+		if (work > 2 * index + ZSTRING_SEARCH_BUDGET) {
+			index += ZSTRING_SEARCH_BLOCK;
+			result = ZString_TwoWay(
+				_str + index, _len - index, _sub, _sublen, 1);
+			return (result < 0) ? result : result + (Intptr)index;
+		}
+	}
+#endif
+	return ZString_FindScalar(_str, _len, _sub, _sublen, index, work);
+}
+
+
+Intptr
+ZString_FindLast(
+	_In_ Lpcstr _str,
+	_In_ SizeT  _len,
+	_In_ Lpcstr _sub,
+	_In_ SizeT  _sublen) {
+
+	SizeT  end, work;
+#if (ZSTRING_SEARCH_BLOCK)
+	SizeT  bit, count;
+	Uint64 mask;
+	Intptr result;
+#endif
+
+	if (!_sublen)
+		return (Intptr)_len;
+	if (_sublen > _len)
+		return Z_UNDEFINED;
+	if (_sublen == 1)
+		return ZString_FindLastOfEx(_str, _len, _sub[0]);
+
+	//candidate starts are [0, end)
+	end  = _len - _sublen + 1;
+	work = 0;
+#if (ZSTRING_SEARCH_BLOCK)
+	count = end;
+	while (end >= ZSTRING_SEARCH_BLOCK) {
+		end -= ZSTRING_SEARCH_BLOCK;
+		mask = ZString_PairMask(_str + end, _sublen - 1, 
+			(Byte)_sub[0], (Byte)_sub[_sublen - 1]);
+		while (mask) {
+			bit = 63 - (Uint32)Z_CLZ64(mask);
+			mask ^= 1ULL << bit;
+			bit >>= ZSTRING_SEARCH_SHIFT;
+			if (!memcmp(_str + end + bit + 1, _sub + 1, _sublen - 2))
+				return (Intptr)(end + bit);
+			work += _sublen;
+		}
+		if (work > 2 * (count - end) + ZSTRING_SEARCH_BUDGET) {
+			//search str[0, end + _sublen - 1) back to front
+			result = ZString_TwoWay(_str + end + _sublen - 2, 
+				end + _sublen - 1, _sub + _sublen - 1, _sublen, -1);
+			return (result < 0) ? result : (Intptr)(end - 1) - result;
+		}
+	}
+#endif
+	return ZString_FindLastScalar(_str, _len, _sub, _sublen, end, work);
+}
+
+
+Intptr
+ZString_FindAny(
+	_In_ Lpcstr          _str,
+	_In_ SizeT           _len,
+	_In_ const ZCHARSET* _set) {
+
+	SizeT index = 0;
+#if (ZSTRING_SHUFFLE)
+	Uint64 mask;
+	for (; index + ZSTRING_SEARCH_BLOCK <= _len; 
+		index += ZSTRING_SEARCH_BLOCK) {
+		mask = ZString_SetMask(_str + index, _set);
+		if (mask) {
+			return (Intptr)(index + 
+				((Uint32)Z_CTZ64(mask) >> ZSTRING_SEARCH_SHIFT));
+		}
+	}
+#endif
+	for (; index < _len; ++index) {
+		if (ZString_CharSetHas(_set, _str[index]))
+			return (Intptr)index;
+	}
+	return Z_UNDEFINED;
+}
+
+
+Void
+ZString_CharSetInit(
+	_Inout_ ZCHARSET* _set,
+	_In_    Lpcstr    _chars,
+	_In_    SizeT     _len) {
+
+	SizeT index;
+	Byte  ch;
+
+	memset(_set, 0, sizeof(ZCHARSET));
+	for (index = 0; index < _len; ++index) {
+		ch = (Byte)_chars[index];
+		_set->bits[ch >> 5] |= 1U << (ch & 31);
+		if (ch < 0x80) {
+			_set->lower[ch & 0x0F] |= (Byte)(1U << (ch >> 4));
+		}
+		else {
+			_set->upper[ch & 0x0F] |= (Byte)(1U << ((ch >> 4) - 8));
 		}
-	} while (c1);
-	return Z_TRUE; //strings are equal
+	}
+}
+
+
+Void
+ZString_ToLowerEx(
+	_Inout_ Char* _str,
+	_In_    SizeT _len) {
+
+	SizeT index;
+	index = ZString_ConvertCaseVector(_str, _len, 'A', ZString_ToLowerScalar);
+	ZString_ToLowerScalar(_str + index, _len - index);
+}
+
+
+Void
+ZString_ToUpperEx(
+	_Inout_ Char* _str,
+	_In_    SizeT _len) {
+
+	SizeT index;
+	index = ZString_ConvertCaseVector(_str, _len, 'a', ZString_ToUpperScalar);
+	ZString_ToUpperScalar(_str + index, _len - index);
 }
 /*****************************************************************************/  
 //EOF
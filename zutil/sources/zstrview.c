@@ -0,0 +1,258 @@
+/******************************************************************************
+* zutil - C Utility Library
+* Copyright (C) 2017-2021 Zachary T Harris. All Rights Reserved.  
+* Zlib license.
+* 
+* File: zstrview.c
+* Desc: non-owning string views, splitting and tokenizing
+*******************************************************************************
+
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+******************************************************************************/ 
+#include "zutil/zstrview.h"
+
+
+
+static FORCEINLINE Bool
+ZStrView_IsSpace(
+	_In_ Char _ch) {
+
+	return _ch == ' ' || (Uint32)(Byte)_ch - '\t' < 5u;
+}
+
+
+
+
+Bool
+ZStrView_Equal(
+	_In_ ZSTRVIEW _view1,
+	_In_ ZSTRVIEW _view2) {
+
+	return _view1.iLength == _view2.iLength &&
+		!memcmp(_view1.lpData, _view2.lpData, _view1.iLength);
+}
+
+
+Bool
+ZStrView_CaseEqual(
+	_In_ ZSTRVIEW _view1,
+	_In_ ZSTRVIEW _view2) {
+
+	return _view1.iLength == _view2.iLength &&
+		ZString_CaseEqualEx(_view1.lpData, _view2.lpData, _view1.iLength);
+}
+
+
+Int32
+ZStrView_Compare(
+	_In_ ZSTRVIEW _view1,
+	_In_ ZSTRVIEW _view2) {
+
+	Int32 result;
+	result = memcmp(_view1.lpData, _view2.lpData,
+		Z_Min(_view1.iLength, _view2.iLength));
+	if (result)
+		return result;
+	if (_view1.iLength == _view2.iLength)
+		return 0;
+	return (_view1.iLength < _view2.iLength) ? -1 : 1;
+}
+
+
+Bool
+ZStrView_StartsWith(
+	_In_ ZSTRVIEW _view,
+	_In_ ZSTRVIEW _prefix) {
+
+	return _prefix.iLength <= _view.iLength &&
+		!memcmp(_view.lpData, _prefix.lpData, _prefix.iLength);
+}
+
+
+Bool
+ZStrView_EndsWith(
+	_In_ ZSTRVIEW _view,
+	_In_ ZSTRVIEW _suffix) {
+
+	return _suffix.iLength <= _view.iLength &&
+		!memcmp(_view.lpData + _view.iLength - _suffix.iLength, 
+			_suffix.lpData, _suffix.iLength);
+}
+
+
+Intptr
+ZStrView_Find(
+	_In_ ZSTRVIEW _view,
+	_In_ ZSTRVIEW _sub) {
+
+	return ZString_Find(
+		_view.lpData, _view.iLength, _sub.lpData, _sub.iLength);
+}
+
+
+ZSTRVIEW
+ZStrView_Trim(
+	_In_ ZSTRVIEW _view) {
+
+	return ZStrView_TrimRight(ZStrView_TrimLeft(_view));
+}
+
+
+ZSTRVIEW
+ZStrView_TrimLeft(
+	_In_ ZSTRVIEW _view) {
+
+	while (_view.iLength && ZStrView_IsSpace(*_view.lpData)) {
+		++_view.lpData;
+		--_view.iLength;
+	}
+	return _view;
+}
+
+
+ZSTRVIEW
+ZStrView_TrimRight(
+	_In_ ZSTRVIEW _view) {
+
+	while (_view.iLength && 
+		ZStrView_IsSpace(_view.lpData[_view.iLength - 1])) {
+		--_view.iLength;
+	}
+	return _view;
+}
+
+
+Bool
+ZStrView_SplitOnce(
+	_In_    ZSTRVIEW  _view,
+	_In_    Char      _sep,
+	_Inout_ ZSTRVIEW* _lpLeft,
+	_Inout_ ZSTRVIEW* _lpRight) {
+
+	Intptr index;
+	index = ZString_FindOfEx(_view.lpData, _view.iLength, _sep);
+	if (index < 0) {
+		*_lpLeft  = _view;
+		*_lpRight = ZStrView_Make(_view.lpData + _view.iLength, 0);
+		return Z_FALSE;
+	}
+	*_lpLeft  = ZStrView_Make(_view.lpData, (SizeT)index);
+	*_lpRight = ZStrView_Make(_view.lpData + index + 1, 
+		_view.iLength - (SizeT)index - 1);
+	return Z_TRUE;
+}
+
+
+Void
+ZStrView_SplitInit(
+	_Out_ ZSTRSPLIT* _iter,
+	_In_  ZSTRVIEW   _view,
+	_In_  Lpcstr     _delim,
+	_In_  SizeT      _delimlen) {
+
+	_iter->rest         = _view;
+	_iter->lpDelim      = _delim;
+	_iter->iDelimLength = _delimlen;
+	_iter->bDone        = Z_FALSE;
+}
+
+
+Bool
+ZStrView_SplitNext(
+	_Inout_ ZSTRSPLIT* _iter,
+	_Inout_ ZSTRVIEW*  _lpField) {
+
+	Intptr index;
+
+	if (_iter->bDone)
+		return Z_FALSE;
+	index = Z_UNDEFINED;
+	if (_iter->iDelimLength) {
+		index = ZString_Find(_iter->rest.lpData, _iter->rest.iLength,
+			_iter->lpDelim, _iter->iDelimLength);
+	}
+	if (index < 0) {
+		//the last field runs to the end of the view
+		*_lpField = _iter->rest;
+		_iter->rest.lpData += _iter->rest.iLength;
+		_iter->rest.iLength = 0;
+		_iter->bDone = Z_TRUE;
+		return Z_TRUE;
+	}
+	*_lpField = ZStrView_Make(_iter->rest.lpData, (SizeT)index);
+	_iter->rest.lpData  += (SizeT)index + _iter->iDelimLength;
+	_iter->rest.iLength -= (SizeT)index + _iter->iDelimLength;
+	return Z_TRUE;
+}
+
+
+Void
+ZStrView_TokenInit(
+	_Out_ ZSTRTOKEN* _iter,
+	_In_  ZSTRVIEW   _view,
+	_In_  Lpcstr     _delims,
+	_In_  SizeT      _len) {
+
+	_iter->rest = _view;
+	ZString_CharSetInit(&_iter->delims, _delims, _len);
+}
+
+
+Bool
+ZStrView_TokenNext(
+	_Inout_ ZSTRTOKEN* _iter,
+	_Inout_ ZSTRVIEW*  _lpToken) {
+
+	Lpcstr begin, end;
+	Intptr index;
+	SizeT  length;
+
+	begin = _iter->rest.lpData;
+	end   = begin + _iter->rest.iLength;
+	while (begin < end && ZString_CharSetHas(&_iter->delims, *begin)) {
+		++begin;
+	}
+	if (begin == end) {
+		_iter->rest = ZStrView_Make(end, 0);
+		return Z_FALSE;
+	}
+	index  = ZString_FindAny(begin, (SizeT)(end - begin), &_iter->delims);
+	length = (index < 0) ? (SizeT)(end - begin) : (SizeT)index;
+	*_lpToken   = ZStrView_Make(begin, length);
+	_iter->rest = ZStrView_Make(begin + length, (SizeT)(end - begin) - length);
+	return Z_TRUE;
+}
+
+
+SizeT
+ZStrView_Copy(
+	_In_    ZSTRVIEW _view,
+	_Inout_ Char*    _dst,
+	_In_    SizeT    _dstsize) {
+
+	SizeT len;
+	if (_dstsize > 0) {
+		len = Z_Min(_view.iLength, _dstsize - 1);
+		memcpy(_dst, _view.lpData, len);
+		_dst[len] = '\0';
+	}
+	return _view.iLength;
+}
+/*****************************************************************************/  
+//EOF
+/*****************************************************************************/  
@@ -0,0 +1,694 @@
+/******************************************************************************
+* zutil - C Utility Library
+* Copyright (C) 2017-2021 Zachary T Harris. All Rights Reserved.  
+* Zlib license.
+* 
+* File: zsweep.c
+* Desc: sort-and-sweep broadphase over rectangle arrays
+*******************************************************************************
+
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+******************************************************************************/ 
+#include "zutil/zsweep.h"
+
+
+
+#define ZSWEEP_EMPTY     0xFFFFFFFFFFFFFFFFull //key of an empty pair slot
+#define ZSWEEP_MINBITS   6                     //smallest pair table, 64 slots
+#define ZSWEEP_RADIXBITS 11                    //3 passes over 32-bit keys
+#define ZSWEEP_RADIXSIZE (1 << ZSWEEP_RADIXBITS)
+#define ZSWEEP_REQUERY   32                    //emptiness changes to requery
+
+
+
+/*
+An edge of an object on one axis. The low bit of iData is set for the
+start (left or top) edge and the object index is in the bits above.
+At equal positions end edges sort before start edges, so rects that 
+only touch are not overlapping on that axis*/
+typedef struct {
+	Float  fValue;
+	Uint32 iData;
+} ZSWEEPEDGE;
+
+typedef struct {
+	Float l, t, r, b;
+} ZSWEEPBOX;
+
+typedef struct {
+	ZSWEEPPAIR* lpPairs;
+	SizeT       iCount;
+	SizeT       iCapacity;
+} ZSWEEPLIST;
+
+struct _ZSweep {
+	ZSWEEPEDGE* lpEdges[2];   //sorted edges along x and y, 2 per object
+	ZSWEEPBOX*  lpBoxes;      //normalized bounds of each object
+	SizeT       iCount;       //number of objects
+	SizeT       iCapacity;    //objects that fit in the arrays
+	Bool        bSorted;      //false until the next full build
+	Uint64*     lpSet;        //open addressed set of overlapping pairs
+	Uint32      iSetBits;     //log2 of the set size
+	SizeT       iSetCount;    //pairs in the set
+	ZSWEEPLIST  added;        //pairs added by the last update
+	ZSWEEPLIST  removed;      //pairs removed by the last update
+	Bool        bFailed;      //an allocation failed during the update
+};
+
+
+
+
+
+/* Section 1:
+** pair set
+******************************************************************************/
+static FORCEINLINE Uint64
+ZSweep_Key(
+	_In_ Int32 _a,
+	_In_ Int32 _b) {
+
+	return _a < _b ? 
+		((Uint64)_a << 32) | (Uint32)_b : ((Uint64)_b << 32) | (Uint32)_a;
+}
+
+
+static FORCEINLINE SizeT
+ZSweep_Slot(
+	_In_ const ZSweep* _lpSweep,
+	_In_ Uint64        _key) {
+
+	return (SizeT)((_key * 0x9E3779B97F4A7C15ull) >> (64 - _lpSweep->iSetBits));
+}
+
+
+static FORCEINLINE Bool
+ZSweep_SetContains(
+	_In_ const ZSweep* _lpSweep,
+	_In_ Uint64        _key) {
+
+	SizeT mask = ((SizeT)1 << _lpSweep->iSetBits) - 1;
+	SizeT i    = ZSweep_Slot(_lpSweep, _key);
+	for (; _lpSweep->lpSet[i] != ZSWEEP_EMPTY; i = (i + 1) & mask) {
+		if (_lpSweep->lpSet[i] == _key)
+			return Z_TRUE;
+	}
+	return Z_FALSE;
+}
+
+
+/*
+Reallocates the set with 2^_bits slots, keeping its pairs*/
+static ZRESULT
+ZSweep_SetResize(
+	_Inout_ ZSweep* _lpSweep,
+	_In_    Uint32  _bits) {
+
+	Uint64* old;
+	SizeT   oldSize, size, i, j;
+
+	size = (SizeT)1 << _bits;
+	old  = _lpSweep->lpSet;
+	oldSize = old ? (SizeT)1 << _lpSweep->iSetBits : 0;
+	_lpSweep->lpSet = (Uint64*)malloc(size * sizeof(Uint64));
+	if (!_lpSweep->lpSet) {
+		_lpSweep->lpSet = old;
+		return Z_EOUTOFMEMORY;
+	}
+	memset(_lpSweep->lpSet, 0xFF, size * sizeof(Uint64));
+	_lpSweep->iSetBits = _bits;
+	for (i = 0; i < oldSize; ++i) {
+		if (old[i] == ZSWEEP_EMPTY)
+			continue;
+		j = ZSweep_Slot(_lpSweep, old[i]);
+		while (_lpSweep->lpSet[j] != ZSWEEP_EMPTY)
+			j = (j + 1) & (size - 1);
+		_lpSweep->lpSet[j] = old[i];
+	}
+	free(old);
+	return Z_OK;
+}
+
+
+static ZRESULT
+ZSweep_SetInsert(
+	_Inout_ ZSweep* _lpSweep,
+	_In_    Uint64  _key) {
+
+	SizeT   mask, i;
+	ZRESULT result;
+
+	//keep the load factor at or below one half
+	if ((_lpSweep->iSetCount + 1) * 2 > (SizeT)1 << _lpSweep->iSetBits) {
+		result = ZSweep_SetResize(_lpSweep, _lpSweep->iSetBits + 1);
+		if (Z_FAILURE(result))
+			return result;
+	}
+	mask = ((SizeT)1 << _lpSweep->iSetBits) - 1;
+	i    = ZSweep_Slot(_lpSweep, _key);
+	while (_lpSweep->lpSet[i] != ZSWEEP_EMPTY)
+		i = (i + 1) & mask;
+	_lpSweep->lpSet[i] = _key;
+	_lpSweep->iSetCount++;
+	return Z_OK;
+}
+
+
+/*
+Removes a key with backward shift deletion, so no tombstones are left.
+Returns false if the key was not in the set*/
+static Bool
+ZSweep_SetErase(
+	_Inout_ ZSweep* _lpSweep,
+	_In_    Uint64  _key) {
+
+	Uint64* set = _lpSweep->lpSet;
+	SizeT   mask, i, j, home;
+
+	mask = ((SizeT)1 << _lpSweep->iSetBits) - 1;
+	i    = ZSweep_Slot(_lpSweep, _key);
+	while (set[i] != _key) {
+		if (set[i] == ZSWEEP_EMPTY)
+			return Z_FALSE;
+		i = (i + 1) & mask;
+	}
+	for (j = (i + 1) & mask; set[j] != ZSWEEP_EMPTY; j = (j + 1) & mask) {
+		home = ZSweep_Slot(_lpSweep, set[j]);
+		//move set[j] into the hole unless its home lies in (i, j]
+		if (((j - home) & mask) >= ((j - i) & mask)) {
+			set[i] = set[j];
+			i = j;
+		}
+	}
+	set[i] = ZSWEEP_EMPTY;
+	_lpSweep->iSetCount--;
+	return Z_TRUE;
+}
+
+
+static Void
+ZSweep_SetClear(
+	_Inout_ ZSweep* _lpSweep) {
+
+	if (_lpSweep->lpSet)
+		memset(_lpSweep->lpSet, 0xFF, 
+			((SizeT)1 << _lpSweep->iSetBits) * sizeof(Uint64));
+	_lpSweep->iSetCount = 0;
+}
+
+
+static FORCEINLINE Void
+ZSweep_Report(
+	_Inout_ ZSweep*     _lpSweep,
+	_Inout_ ZSWEEPLIST* _lpList,
+	_In_    Uint64      _key) {
+
+	if (_lpList->iCount == _lpList->iCapacity) {
+		SizeT capacity = Z_Max(_lpList->iCapacity * 2, 64);
+		ZSWEEPPAIR* pairs = (ZSWEEPPAIR*)realloc(
+			_lpList->lpPairs, capacity * sizeof(ZSWEEPPAIR));
+		if (!pairs) {
+			_lpSweep->bFailed = Z_TRUE;
+			return;
+		}
+		_lpList->lpPairs   = pairs;
+		_lpList->iCapacity = capacity;
+	}
+	_lpList->lpPairs[_lpList->iCount].a = (Int32)(_key >> 32);
+	_lpList->lpPairs[_lpList->iCount].b = (Int32)(Uint32)_key;
+	_lpList->iCount++;
+}
+
+
+
+
+
+/* Section 2:
+** sorting
+******************************************************************************/
+static FORCEINLINE Bool
+ZSweep_Overlaps(
+	_In_ const ZSWEEPBOX* _a,
+	_In_ const ZSWEEPBOX* _b) {
+
+	return 
+		Z_Max(_a->l, _b->l) < Z_Min(_a->r, _b->r) &&
+		Z_Max(_a->t, _b->t) < Z_Min(_a->b, _b->b);
+}
+
+
+static FORCEINLINE Bool
+ZSweep_IsEmpty(
+	_In_ const ZSWEEPBOX* _box) {
+
+	return _box->l == _box->r || _box->t == _box->b;
+}
+
+
+static FORCEINLINE Bool
+ZSweep_Less(
+	_In_ const ZSWEEPEDGE* _a,
+	_In_ const ZSWEEPEDGE* _b) {
+
+	return _a->fValue < _b->fValue || 
+		(_a->fValue == _b->fValue && (_a->iData & 1) < (_b->iData & 1));
+}
+
+
+/*
+Maps a float to an unsigned key with the same order*/
+static FORCEINLINE Uint32
+ZSweep_RadixKey(
+	_In_ Float _value) {
+
+	Uint32 bits;
+	memcpy(&bits, &_value, sizeof(bits));
+	return bits ^ ((Uint32)((Int32)bits >> 31) | 0x80000000u);
+}
+
+
+/*
+Stable LSD radix sort of _count edges by position. The input holds all
+end edges before all start edges, so ties come out in edge order*/
+static Void
+ZSweep_RadixSort(
+	_Inout_ ZSWEEPEDGE* _lpEdges,
+	_Inout_ ZSWEEPEDGE* _lpScratch,
+	_In_    SizeT       _count) {
+
+	SizeT  histogram[ZSWEEP_RADIXSIZE];
+	SizeT  i, sum, next;
+	Uint32 shift, digit;
+	ZSWEEPEDGE* src = _lpEdges;
+	ZSWEEPEDGE* dst = _lpScratch;
+	ZSWEEPEDGE* tmp;
+
+	for (shift = 0; shift < 32; shift += ZSWEEP_RADIXBITS) {
+		memset(histogram, 0, sizeof(histogram));
+		for (i = 0; i < _count; ++i) {
+			digit = (ZSweep_RadixKey(src[i].fValue) >> shift) & 
+				(ZSWEEP_RADIXSIZE - 1);
+			histogram[digit]++;
+		}
+		for (i = 0, sum = 0; i < ZSWEEP_RADIXSIZE; ++i) {
+			next = sum + histogram[i];
+			histogram[i] = sum;
+			sum = next;
+		}
+		for (i = 0; i < _count; ++i) {
+			digit = (ZSweep_RadixKey(src[i].fValue) >> shift) & 
+				(ZSWEEP_RADIXSIZE - 1);
+			dst[histogram[digit]++] = src[i];
+		}
+		tmp = src;
+		src = dst;
+		dst = tmp;
+	}
+	//three passes leave the result in the scratch array
+	memcpy(_lpEdges, src, _count * sizeof(ZSWEEPEDGE));
+}
+
+
+/*
+Re-sorts one axis after the positions changed. A start edge and an end
+edge of two objects trade places exactly when the pair starts or stops
+overlapping on this axis, so only those pairs are visited: a start edge
+moving below an end edge may begin an overlap, and an end edge moving
+below a start edge ends one*/
+static Void
+ZSweep_InsertionSort(
+	_Inout_ ZSweep*     _lpSweep,
+	_Inout_ ZSWEEPEDGE* _lpEdges,
+	_In_    SizeT       _count) {
+
+	ZSWEEPEDGE edge, prev;
+	SizeT  i, j;
+	Int32  a, b;
+	Uint64 key;
+
+	for (i = 1; i < _count; ++i) {
+		edge = _lpEdges[i];
+		for (j = i; j > 0 && ZSweep_Less(&edge, &_lpEdges[j - 1]); --j) {
+			prev = _lpEdges[j - 1];
+			_lpEdges[j] = prev;
+			a = (Int32)(edge.iData >> 1);
+			b = (Int32)(prev.iData >> 1);
+			if (((edge.iData ^ prev.iData) & 1) == 0 || a == b)
+				continue;
+			key = ZSweep_Key(a, b);
+			if (edge.iData & 1) {
+				//the other axis may have added the pair already
+				if (!ZSweep_Overlaps(
+					&_lpSweep->lpBoxes[a], &_lpSweep->lpBoxes[b]) ||
+					ZSweep_SetContains(_lpSweep, key))
+					continue;
+				if (Z_FAILURE(ZSweep_SetInsert(_lpSweep, key))) {
+					_lpSweep->bFailed = Z_TRUE;
+					continue;
+				}
+				ZSweep_Report(_lpSweep, &_lpSweep->added, key);
+			}
+			else if (ZSweep_SetErase(_lpSweep, key))
+				ZSweep_Report(_lpSweep, &_lpSweep->removed, key);
+		}
+		_lpEdges[j] = edge;
+	}
+}
+
+
+
+
+
+/* Section 3:
+** broadphase
+******************************************************************************/
+static ZRESULT
+ZSweep_Reserve(
+	_Inout_ ZSweep* _lpSweep,
+	_In_    SizeT   _count) {
+
+	ZSWEEPEDGE* edges[2];
+	ZSWEEPBOX*  boxes;
+
+	if (_count <= _lpSweep->iCapacity)
+		return Z_OK;
+	edges[0] = (ZSWEEPEDGE*)malloc(2 * _count * sizeof(ZSWEEPEDGE));
+	edges[1] = (ZSWEEPEDGE*)malloc(2 * _count * sizeof(ZSWEEPEDGE));
+	boxes    = (ZSWEEPBOX*)malloc(_count * sizeof(ZSWEEPBOX));
+	if (!edges[0] || !edges[1] || !boxes) {
+		free(edges[0]);
+		free(edges[1]);
+		free(boxes);
+		return Z_EOUTOFMEMORY;
+	}
+	free(_lpSweep->lpEdges[0]);
+	free(_lpSweep->lpEdges[1]);
+	free(_lpSweep->lpBoxes);
+	_lpSweep->lpEdges[0] = edges[0];
+	_lpSweep->lpEdges[1] = edges[1];
+	_lpSweep->lpBoxes    = boxes;
+	_lpSweep->iCapacity  = _count;
+	return Z_OK;
+}
+
+
+/*
+Updates the pairs of an object that became empty or stopped being 
+empty. Its edges need not swap with those of the objects it overlaps 
+when that happens, so the insertion sort can miss the change*/
+static Void
+ZSweep_Requery(
+	_Inout_ ZSweep* _lpSweep,
+	_In_    Int32   _a) {
+
+	const ZSWEEPBOX* boxes = _lpSweep->lpBoxes;
+	Uint64 key;
+	Int32  b;
+	Bool   bEmpty;
+
+	bEmpty = ZSweep_IsEmpty(&boxes[_a]);
+	for (b = 0; b < (Int32)_lpSweep->iCount; ++b) {
+		if (b == _a)
+			continue;
+		key = ZSweep_Key(_a, b);
+		if (bEmpty) {
+			if (ZSweep_SetErase(_lpSweep, key))
+				ZSweep_Report(_lpSweep, &_lpSweep->removed, key);
+			continue;
+		}
+		if (!ZSweep_Overlaps(&boxes[_a], &boxes[b]) ||
+			ZSweep_SetContains(_lpSweep, key))
+			continue;
+		if (Z_FAILURE(ZSweep_SetInsert(_lpSweep, key))) {
+			_lpSweep->bFailed = Z_TRUE;
+			continue;
+		}
+		ZSweep_Report(_lpSweep, &_lpSweep->added, key);
+	}
+}
+
+
+/*
+Sorts both axes from scratch and sweeps along x for the new pairs,
+reporting the difference from the previous pairs*/
+static ZRESULT
+ZSweep_Build(
+	_Inout_ ZSweep* _lpSweep,
+	_In_    SizeT   _count) {
+
+	ZSWEEPEDGE* scratch;
+	ZSWEEPEDGE* edges;
+	Uint64*     oldSet;
+	Uint32      oldBits;
+	Int32*      active;
+	Int32*      slot;
+	SizeT       i, j, n, oldSize;
+	Int32       axis, a;
+	ZRESULT     result = Z_OK;
+
+	scratch = (ZSWEEPEDGE*)malloc(2 * _count * sizeof(ZSWEEPEDGE) + 1);
+	active  = (Int32*)malloc(2 * _count * sizeof(Int32) + 1);
+	if (!scratch || !active) {
+		free(scratch);
+		free(active);
+		return Z_EOUTOFMEMORY;
+	}
+	slot = active + _count;
+	for (axis = 0; axis < 2; ++axis) {
+		edges = _lpSweep->lpEdges[axis];
+		for (i = 0; i < _count; ++i) {
+			const ZSWEEPBOX* box = &_lpSweep->lpBoxes[i];
+			edges[i].fValue          = axis ? box->b : box->r;
+			edges[i].iData           = (Uint32)(i << 1);
+			edges[_count + i].fValue = axis ? box->t : box->l;
+			edges[_count + i].iData  = (Uint32)(i << 1) | 1;
+		}
+		ZSweep_RadixSort(edges, scratch, 2 * _count);
+	}
+	free(scratch);
+	//sweep into a fresh set, keeping the old one to compare against
+	oldSet  = _lpSweep->lpSet;
+	oldBits = _lpSweep->iSetBits;
+	oldSize = oldSet ? (SizeT)1 << oldBits : 0;
+	_lpSweep->lpSet     = NULL;
+	_lpSweep->iSetCount = 0;
+	result = ZSweep_SetResize(_lpSweep, ZSWEEP_MINBITS);
+	edges  = _lpSweep->lpEdges[0];
+	for (i = 0, n = 0; i < 2 * _count && Z_SUCCESS(result); ++i) {
+		a = (Int32)(edges[i].iData >> 1);
+		//empty rects overlap nothing, and their end edge comes first
+		if (_lpSweep->lpBoxes[a].l == _lpSweep->lpBoxes[a].r)
+			continue;
+		if (!(edges[i].iData & 1)) {
+			active[slot[a]] = active[--n];
+			slot[active[n]] = slot[a];
+			continue;
+		}
+		for (j = 0; j < n; ++j) {
+			if (!ZSweep_Overlaps(
+				&_lpSweep->lpBoxes[a], &_lpSweep->lpBoxes[active[j]]))
+				continue;
+			result = ZSweep_SetInsert(_lpSweep, ZSweep_Key(a, active[j]));
+			if (Z_FAILURE(result))
+				break;
+		}
+		slot[a] = (Int32)n;
+		active[n++] = a;
+	}
+	free(active);
+	if (Z_FAILURE(result)) {
+		free(_lpSweep->lpSet);
+		_lpSweep->lpSet    = oldSet;
+		_lpSweep->iSetBits = oldBits;
+		return result;
+	}
+	for (i = 0; i < oldSize; ++i) {
+		if (oldSet[i] != ZSWEEP_EMPTY && 
+			!ZSweep_SetContains(_lpSweep, oldSet[i]))
+			ZSweep_Report(_lpSweep, &_lpSweep->removed, oldSet[i]);
+	}
+	for (i = 0; i < (SizeT)1 << _lpSweep->iSetBits; ++i) {
+		Uint64 key = _lpSweep->lpSet[i];
+		if (key == ZSWEEP_EMPTY)
+			continue;
+		if (oldSet) {
+			//look the key up in the old table
+			SizeT mask = oldSize - 1;
+			SizeT k = (SizeT)((key * 0x9E3779B97F4A7C15ull) >> (64 - oldBits));
+			while (oldSet[k] != ZSWEEP_EMPTY && oldSet[k] != key)
+				k = (k + 1) & mask;
+			if (oldSet[k] == key)
+				continue;
+		}
+		ZSweep_Report(_lpSweep, &_lpSweep->added, key);
+	}
+	free(oldSet);
+	return Z_OK;
+}
+
+
+ZSweep*
+ZSweep_Create(
+	_Inout_opt_ ZRESULT* _lpResult) {
+
+	ZSweep* sweep;
+	ZRESULT result = Z_OK;
+
+	sweep = (ZSweep*)calloc(1, sizeof(ZSweep));
+	if (sweep) {
+		result = ZSweep_SetResize(sweep, ZSWEEP_MINBITS);
+		if (Z_FAILURE(result)) {
+			free(sweep);
+			sweep = NULL;
+		}
+	}
+	else
+		result = Z_EOUTOFMEMORY;
+	if (_lpResult)
+		*_lpResult = result;
+	return sweep;
+}
+
+
+Void
+ZSweep_Release(
+	_Inout_ ZSweep* _lpSweep) {
+
+	if (!_lpSweep)
+		return;
+	free(_lpSweep->lpEdges[0]);
+	free(_lpSweep->lpEdges[1]);
+	free(_lpSweep->lpBoxes);
+	free(_lpSweep->lpSet);
+	free(_lpSweep->added.lpPairs);
+	free(_lpSweep->removed.lpPairs);
+	free(_lpSweep);
+}
+
+
+ZRESULT
+ZSweep_Update(
+	_Inout_ ZSweep*      _lpSweep,
+	_In_    const ZRECT* _rects,
+	_In_    SizeT        _count) {
+
+	ZSWEEPEDGE* edges;
+	ZRESULT     result;
+	SizeT       i, nToggled;
+	Int32       axis, toggled[ZSWEEP_REQUERY];
+	Bool        bEmpty;
+
+	_lpSweep->added.iCount   = 0;
+	_lpSweep->removed.iCount = 0;
+	_lpSweep->bFailed        = Z_FALSE;
+	if (_count > 0x7FFFFFFF)
+		return Z_EINVALIDARG;
+	if (_count != _lpSweep->iCount)
+		_lpSweep->bSorted = Z_FALSE;
+	result = ZSweep_Reserve(_lpSweep, _count);
+	if (Z_FAILURE(result))
+		goto fail;
+	//note the objects that become empty or stop being empty, and 
+	//rebuild instead when there are many
+	nToggled = 0;
+	for (i = 0; i < _count; ++i) {
+		ZSWEEPBOX* box = &_lpSweep->lpBoxes[i];
+		bEmpty = _lpSweep->bSorted && ZSweep_IsEmpty(box);
+		box->l = Z_Min(_rects[i].x, _rects[i].x + _rects[i].w);
+		box->t = Z_Min(_rects[i].y, _rects[i].y + _rects[i].h);
+		box->r = Z_Max(_rects[i].x, _rects[i].x + _rects[i].w);
+		box->b = Z_Max(_rects[i].y, _rects[i].y + _rects[i].h);
+		if (!_lpSweep->bSorted || bEmpty == ZSweep_IsEmpty(box))
+			continue;
+		if (nToggled < ZSWEEP_REQUERY)
+			toggled[nToggled++] = (Int32)i;
+		else
+			_lpSweep->bSorted = Z_FALSE;
+	}
+	_lpSweep->iCount = _count;
+	if (!_lpSweep->bSorted) {
+		result = ZSweep_Build(_lpSweep, _count);
+		if (Z_FAILURE(result))
+			goto fail;
+		_lpSweep->bSorted = Z_TRUE;
+	}
+	else {
+		for (axis = 0; axis < 2; ++axis) {
+			edges = _lpSweep->lpEdges[axis];
+			for (i = 0; i < 2 * _count; ++i) {
+				const ZSWEEPBOX* box = &_lpSweep->lpBoxes[edges[i].iData >> 1];
+				if (axis)
+					edges[i].fValue = (edges[i].iData & 1) ? box->t : box->b;
+				else
+					edges[i].fValue = (edges[i].iData & 1) ? box->l : box->r;
+			}
+			ZSweep_InsertionSort(_lpSweep, edges, 2 * _count);
+		}
+		for (i = 0; i < nToggled; ++i)
+			ZSweep_Requery(_lpSweep, toggled[i]);
+	}
+	if (!_lpSweep->bFailed)
+		return Z_OK;
+	result = Z_EOUTOFMEMORY;
+fail:
+	ZSweep_SetClear(_lpSweep);
+	_lpSweep->bSorted        = Z_FALSE;
+	_lpSweep->added.iCount   = 0;
+	_lpSweep->removed.iCount = 0;
+	return result;
+}
+
+
+const ZSWEEPPAIR*
+ZSweep_GetAdded(
+	_In_    const ZSweep* _lpSweep,
+	_Inout_ SizeT*        _lpCount) {
+
+	*_lpCount = _lpSweep->added.iCount;
+	return _lpSweep->added.lpPairs;
+}
+
+
+const ZSWEEPPAIR*
+ZSweep_GetRemoved(
+	_In_    const ZSweep* _lpSweep,
+	_Inout_ SizeT*        _lpCount) {
+
+	*_lpCount = _lpSweep->removed.iCount;
+	return _lpSweep->removed.lpPairs;
+}
+
+
+SizeT
+ZSweep_GetPairCount(
+	_In_ const ZSweep* _lpSweep) {
+
+	return _lpSweep->iSetCount;
+}
+
+
+Bool
+ZSweep_IsOverlapping(
+	_In_ const ZSweep* _lpSweep,
+	_In_ Int32         _a,
+	_In_ Int32         _b) {
+
+	return ZSweep_SetContains(_lpSweep, ZSweep_Key(_a, _b));
+}
+/*****************************************************************************/  
+//EOF
+/*****************************************************************************/  
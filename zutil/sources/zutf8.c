@@ -0,0 +1,504 @@
+/******************************************************************************
+* zutil - C Utility Library
+* Copyright (C) 2017-2021 Zachary T Harris. All Rights Reserved.  
+* Zlib license.
+* 
+* File: zutf8.c
+* Desc: utf-8 validation and length measurement
+*******************************************************************************
+
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+******************************************************************************/ 
+#include "zutil/zutf8.h"
+
+#if (Z_ARCHITECTURE_SSSE3)
+#  include <tmmintrin.h>
+#  define ZUTF8_SSSE3 1
+#elif (Z_ARCHITECTURE_NEON && Z_ARCHITECTURE_ARM_64)
+#  include <arm_neon.h>
+#  define ZUTF8_NEON 1
+#endif
+#if (Z_ARCHITECTURE_SSE2)
+#  include <emmintrin.h>
+#endif
+
+
+
+
+
+/* Section 1:
+** validation lookup tables
+*******************************************************************************
+The vector validator classifies every byte pair (previous byte, current byte)
+with three 16-entry tables indexed by the high nibble of the previous byte,
+the low nibble of the previous byte, and the high nibble of the current byte.
+Each table entry is a set of the error classes below that the nibble allows,
+so a pair is invalid when an error class survives all three lookups.
+(Keiser & Lemire, "Validating UTF-8 In Less Than One Instruction Per Byte")*/
+#define ZUTF8_TOO_SHORT      0x01 //lead byte followed by a non-continuation
+#define ZUTF8_TOO_LONG       0x02 //ascii followed by a continuation
+#define ZUTF8_OVERLONG_3     0x04 //E0 followed by 80..9F
+#define ZUTF8_TOO_LARGE      0x08 //F4 followed by 90..BF, or F5..FF
+#define ZUTF8_SURROGATE      0x10 //ED followed by A0..BF
+#define ZUTF8_OVERLONG_2     0x20 //C0 or C1
+#define ZUTF8_TOO_LARGE_1000 0x40 //F5..FF followed by 80..8F
+#define ZUTF8_OVERLONG_4     0x40 //F0 followed by 80..8F
+#define ZUTF8_TWO_CONTS      0x80 //two continuations in a row
+#define ZUTF8_CARRY \
+  (ZUTF8_TOO_SHORT | ZUTF8_TOO_LONG | ZUTF8_TWO_CONTS)
+
+#if (ZUTF8_SSSE3 || ZUTF8_NEON)
+static const Byte s_byte1high[16] = {
+	/* 0_______ ascii */
+	ZUTF8_TOO_LONG, ZUTF8_TOO_LONG, ZUTF8_TOO_LONG, ZUTF8_TOO_LONG,
+	ZUTF8_TOO_LONG, ZUTF8_TOO_LONG, ZUTF8_TOO_LONG, ZUTF8_TOO_LONG,
+	/* 10______ continuation */
+	ZUTF8_TWO_CONTS, ZUTF8_TWO_CONTS, ZUTF8_TWO_CONTS, ZUTF8_TWO_CONTS,
+	/* 1100____ two byte lead */
+	ZUTF8_TOO_SHORT | ZUTF8_OVERLONG_2,
+	/* 1101____ two byte lead */
+	ZUTF8_TOO_SHORT,
+	/* 1110____ three byte lead */
+	ZUTF8_TOO_SHORT | ZUTF8_OVERLONG_3 | ZUTF8_SURROGATE,
+	/* 1111____ four byte lead */
+	ZUTF8_TOO_SHORT | ZUTF8_TOO_LARGE | 
+	ZUTF8_TOO_LARGE_1000 | ZUTF8_OVERLONG_4
+};
+
+static const Byte s_byte1low[16] = {
+	/* ____0000 */
+	ZUTF8_CARRY | ZUTF8_OVERLONG_3 | ZUTF8_OVERLONG_2 | ZUTF8_OVERLONG_4,
+	/* ____0001 */
+	ZUTF8_CARRY | ZUTF8_OVERLONG_2,
+	/* ____001_ */
+	ZUTF8_CARRY,
+	ZUTF8_CARRY,
+	/* ____0100 */
+	ZUTF8_CARRY | ZUTF8_TOO_LARGE,
+	/* ____0101 - ____1100 */
+	ZUTF8_CARRY | ZUTF8_TOO_LARGE | ZUTF8_TOO_LARGE_1000,
+	ZUTF8_CARRY | ZUTF8_TOO_LARGE | ZUTF8_TOO_LARGE_1000,
+	ZUTF8_CARRY | ZUTF8_TOO_LARGE | ZUTF8_TOO_LARGE_1000,
+	ZUTF8_CARRY | ZUTF8_TOO_LARGE | ZUTF8_TOO_LARGE_1000,
+	ZUTF8_CARRY | ZUTF8_TOO_LARGE | ZUTF8_TOO_LARGE_1000,
+	ZUTF8_CARRY | ZUTF8_TOO_LARGE | ZUTF8_TOO_LARGE_1000,
+	ZUTF8_CARRY | ZUTF8_TOO_LARGE | ZUTF8_TOO_LARGE_1000,
+	ZUTF8_CARRY | ZUTF8_TOO_LARGE | ZUTF8_TOO_LARGE_1000,
+	/* ____1101 */
+	ZUTF8_CARRY | ZUTF8_TOO_LARGE | ZUTF8_TOO_LARGE_1000 | ZUTF8_SURROGATE,
+	/* ____111_ */
+	ZUTF8_CARRY | ZUTF8_TOO_LARGE | ZUTF8_TOO_LARGE_1000,
+	ZUTF8_CARRY | ZUTF8_TOO_LARGE | ZUTF8_TOO_LARGE_1000
+};
+
+static const Byte s_byte2high[16] = {
+	/* 0_______ ascii */
+	ZUTF8_TOO_SHORT, ZUTF8_TOO_SHORT, ZUTF8_TOO_SHORT, ZUTF8_TOO_SHORT,
+	ZUTF8_TOO_SHORT, ZUTF8_TOO_SHORT, ZUTF8_TOO_SHORT, ZUTF8_TOO_SHORT,
+	/* 1000____ */
+	ZUTF8_TOO_LONG | ZUTF8_OVERLONG_2 | ZUTF8_TWO_CONTS |
+	ZUTF8_OVERLONG_3 | ZUTF8_TOO_LARGE_1000 | ZUTF8_OVERLONG_4,
+	/* 1001____ */
+	ZUTF8_TOO_LONG | ZUTF8_OVERLONG_2 | ZUTF8_TWO_CONTS |
+	ZUTF8_OVERLONG_3 | ZUTF8_TOO_LARGE,
+	/* 101_____ */
+	ZUTF8_TOO_LONG | ZUTF8_OVERLONG_2 | ZUTF8_TWO_CONTS |
+	ZUTF8_SURROGATE | ZUTF8_TOO_LARGE,
+	ZUTF8_TOO_LONG | ZUTF8_OVERLONG_2 | ZUTF8_TWO_CONTS |
+	ZUTF8_SURROGATE | ZUTF8_TOO_LARGE,
+	/* 11______ lead */
+	ZUTF8_TOO_SHORT, ZUTF8_TOO_SHORT, ZUTF8_TOO_SHORT, ZUTF8_TOO_SHORT
+};
+
+/*
+Per-lane upper bound of the final three bytes of a block that can not be
+the start of an unfinished sequence (F0.., E0.., C0.. respectively)*/
+static const Byte s_incomplete[16] = {
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xEF, 0xDF, 0xBF
+};
+#endif
+
+
+
+
+
+/* Section 2:
+** scalar routines
+******************************************************************************/
+#define ZUTF8_HIGHBITS 0x8080808080808080ULL
+#define ZUTF8_LOWBITS  0x0101010101010101ULL
+
+static Bool
+ZUtf8_ValidateScalar(
+	_In_ const Byte* _src,
+	_In_ SizeT       _len) {
+
+	SizeT  it, left;
+	Uint64 word;
+	Byte   lo, hi;
+
+	it = 0;
+	while (it < _len) {
+		/*
+		Skip ascii eight bytes at a time */
+		if (it + 8 <= _len) {
+			memcpy(&word, _src + it, 8);
+			if ((word & ZUTF8_HIGHBITS) == 0) {
+				it += 8;
+				continue;
+			}
+		}
+		if (_src[it] < 0x80) {
+			++it;
+			continue;
+		}
+		lo = 0x80;
+		hi = 0xBF;
+		if (_src[it] >= 0xC2 && _src[it] <= 0xDF) {
+			left = 1;
+		}
+		else if (_src[it] >= 0xE0 && _src[it] <= 0xEF) {
+			left = 2;
+			if (_src[it] == 0xE0) lo = 0xA0; //overlong
+			if (_src[it] == 0xED) hi = 0x9F; //surrogate
+		}
+		else if (_src[it] >= 0xF0 && _src[it] <= 0xF4) {
+			left = 3;
+			if (_src[it] == 0xF0) lo = 0x90; //overlong
+			if (_src[it] == 0xF4) hi = 0x8F; //above U+10FFFF
+		}
+		else return Z_FALSE;
+
+		if (_len - it <= left) {
+			return Z_FALSE; //truncated
+		}
+		if (_src[it + 1] < lo || _src[it + 1] > hi) {
+			return Z_FALSE;
+		}
+		for (it += 2; --left > 0; ++it) {
+			if ((_src[it] & 0xC0) != 0x80)
+				return Z_FALSE;
+		}
+	}
+	return Z_TRUE;
+}
+
+
+/*
+Counts bytes that start a code point, and optionally the lead bytes
+of four byte sequences (which need a surrogate pair in UTF-16)*/
+static SizeT
+ZUtf8_MeasureScalar(
+	_In_ const Byte* _src,
+	_In_ SizeT       _len,
+	_In_ Bool        _surrogates) {
+
+	SizeT  it, count;
+	Uint64 word, mask;
+
+	count = 0;
+	for (it = 0; it + 8 <= _len; it += 8) {
+		memcpy(&word, _src + it, 8);
+		/*
+		continuation bytes are 10______ */
+		mask = word & ~(word << 1) & ZUTF8_HIGHBITS;
+		count += 8 - (SizeT)((((mask >> 7) * ZUTF8_LOWBITS) >> 56));
+		if (_surrogates) {
+			/*
+			four byte leads are 1111____ */
+			mask = word & (word << 1) & (word << 2) & (word << 3);
+			mask &= ZUTF8_HIGHBITS;
+			count += (SizeT)((((mask >> 7) * ZUTF8_LOWBITS) >> 56));
+		}
+	}
+	for (; it < _len; ++it) {
+		if ((_src[it] & 0xC0) != 0x80)
+			++count;
+		if (_surrogates && _src[it] >= 0xF0)
+			++count;
+	}
+	return count;
+}
+
+
+
+
+
+/* Section 3:
+** vector routines
+******************************************************************************/
+#if (ZUTF8_SSSE3)
+static Void
+ZUtf8_CheckBlock(
+	_In_    __m128i  _input,
+	_Inout_ __m128i* _prev,
+	_Inout_ __m128i* _error,
+	_Inout_ __m128i* _incomplete) {
+
+	const __m128i nibble = _mm_set1_epi8(0x0F);
+	__m128i prev1, prev2, prev3, special, must;
+
+	if (_mm_movemask_epi8(_input) == 0) {
+		/*
+		ascii block, only a sequence left open by the last block can fail*/
+		*_error = _mm_or_si128(*_error, *_incomplete);
+		*_incomplete = _mm_setzero_si128();
+		*_prev = _input;
+		return;
+	}
+	prev1 = _mm_alignr_epi8(_input, *_prev, 15);
+	prev2 = _mm_alignr_epi8(_input, *_prev, 14);
+	prev3 = _mm_alignr_epi8(_input, *_prev, 13);
+
+	special = _mm_and_si128(
+		_mm_and_si128(
+			_mm_shuffle_epi8(
+				_mm_loadu_si128((const __m128i*)s_byte1high),
+				_mm_and_si128(_mm_srli_epi16(prev1, 4), nibble)),
+			_mm_shuffle_epi8(
+				_mm_loadu_si128((const __m128i*)s_byte1low),
+				_mm_and_si128(prev1, nibble))),
+		_mm_shuffle_epi8(
+			_mm_loadu_si128((const __m128i*)s_byte2high),
+			_mm_and_si128(_mm_srli_epi16(_input, 4), nibble)));
+	/*
+	The third and fourth bytes of a sequence must be continuations,
+	which is the only case where two continuations in a row are legal*/
+	must = _mm_or_si128(
+		_mm_subs_epu8(prev2, _mm_set1_epi8((Char)(0xE0 - 0x80))),
+		_mm_subs_epu8(prev3, _mm_set1_epi8((Char)(0xF0 - 0x80))));
+	must = _mm_and_si128(must, _mm_set1_epi8((Char)0x80));
+
+	*_error = _mm_or_si128(*_error, _mm_xor_si128(must, special));
+	*_incomplete = _mm_subs_epu8(
+		_input, _mm_loadu_si128((const __m128i*)s_incomplete));
+	*_prev = _input;
+}
+
+
+static Bool
+ZUtf8_ValidateVector(
+	_In_ const Byte* _src,
+	_In_ SizeT       _len) {
+
+	__m128i prev, error, incomplete;
+	Byte    tail[16];
+	SizeT   it;
+
+	prev = _mm_setzero_si128();
+	error = _mm_setzero_si128();
+	incomplete = _mm_setzero_si128();
+
+	for (it = 0; it + 16 <= _len; it += 16) {
+		ZUtf8_CheckBlock(
+			_mm_loadu_si128((const __m128i*)(_src + it)),
+			&prev, &error, &incomplete);
+	}
+	if (it < _len) {
+		memset(tail, 0, sizeof(tail));
+		memcpy(tail, _src + it, _len - it);
+		ZUtf8_CheckBlock(
+			_mm_loadu_si128((const __m128i*)tail),
+			&prev, &error, &incomplete);
+	}
+	error = _mm_or_si128(error, incomplete);
+	return _mm_movemask_epi8(
+		_mm_cmpeq_epi8(error, _mm_setzero_si128())) == 0xFFFF;
+}
+#elif (ZUTF8_NEON)
+static Void
+ZUtf8_CheckBlock(
+	_In_    uint8x16_t  _input,
+	_Inout_ uint8x16_t* _prev,
+	_Inout_ uint8x16_t* _error,
+	_Inout_ uint8x16_t* _incomplete) {
+
+	const uint8x16_t nibble = vdupq_n_u8(0x0F);
+	uint8x16_t prev1, prev2, prev3, special, must;
+
+	if (vmaxvq_u8(_input) < 0x80) {
+		/*
+		ascii block, only a sequence left open by the last block can fail*/
+		*_error = vorrq_u8(*_error, *_incomplete);
+		*_incomplete = vdupq_n_u8(0);
+		*_prev = _input;
+		return;
+	}
+	prev1 = vextq_u8(*_prev, _input, 15);
+	prev2 = vextq_u8(*_prev, _input, 14);
+	prev3 = vextq_u8(*_prev, _input, 13);
+
+	special = vandq_u8(
+		vandq_u8(
+			vqtbl1q_u8(vld1q_u8(s_byte1high), vshrq_n_u8(prev1, 4)),
+			vqtbl1q_u8(vld1q_u8(s_byte1low), vandq_u8(prev1, nibble))),
+		vqtbl1q_u8(vld1q_u8(s_byte2high), vshrq_n_u8(_input, 4)));
+	/*
+	The third and fourth bytes of a sequence must be continuations,
+	which is the only case where two continuations in a row are legal*/
+	must = vorrq_u8(
+		vqsubq_u8(prev2, vdupq_n_u8(0xE0 - 0x80)),
+		vqsubq_u8(prev3, vdupq_n_u8(0xF0 - 0x80)));
+	must = vandq_u8(must, vdupq_n_u8(0x80));
+
+	*_error = vorrq_u8(*_error, veorq_u8(must, special));
+	*_incomplete = vqsubq_u8(_input, vld1q_u8(s_incomplete));
+	*_prev = _input;
+}
+
+
+static Bool
+ZUtf8_ValidateVector(
+	_In_ const Byte* _src,
+	_In_ SizeT       _len) {
+
+	uint8x16_t prev, error, incomplete;
+	Byte       tail[16];
+	SizeT      it;
+
+	prev = vdupq_n_u8(0);
+	error = vdupq_n_u8(0);
+	incomplete = vdupq_n_u8(0);
+
+	for (it = 0; it + 16 <= _len; it += 16) {
+		ZUtf8_CheckBlock(vld1q_u8(_src + it), &prev, &error, &incomplete);
+	}
+	if (it < _len) {
+		memset(tail, 0, sizeof(tail));
+		memcpy(tail, _src + it, _len - it);
+		ZUtf8_CheckBlock(vld1q_u8(tail), &prev, &error, &incomplete);
+	}
+	error = vorrq_u8(error, incomplete);
+	return vmaxvq_u8(error) == 0;
+}
+#endif
+
+
+#if (Z_ARCHITECTURE_SSE2)
+static SizeT
+ZUtf8_MeasureVector(
+	_In_ const Byte* _src,
+	_In_ SizeT       _len,
+	_In_ Bool        _surrogates) {
+
+	const __m128i conts = _mm_set1_epi8(-65); //0xBF as signed
+	const __m128i leads = _mm_set1_epi8((Char)0xF0);
+	__m128i input, sum, total;
+	Uint64  halves[2];
+	SizeT   it, rounds;
+
+	total = _mm_setzero_si128();
+	it = 0;
+	while (it + 16 <= _len) {
+		/*
+		Each block adds at most 2 to an 8-bit lane, so fold the lane
+		counts into the 64-bit total every 127 blocks */
+		sum = _mm_setzero_si128();
+		for (rounds = 0; rounds < 127 && it + 16 <= _len; ++rounds) {
+			input = _mm_loadu_si128((const __m128i*)(_src + it));
+			/*
+			compare results are -1 per lane, subtracting counts them*/
+			sum = _mm_sub_epi8(sum, _mm_cmpgt_epi8(input, conts));
+			if (_surrogates) {
+				sum = _mm_sub_epi8(sum, _mm_cmpeq_epi8(
+					_mm_min_epu8(input, leads), leads));
+			}
+			it += 16;
+		}
+		total = _mm_add_epi64(
+			total, _mm_sad_epu8(sum, _mm_setzero_si128()));
+	}
+	//both 64-bit halves in full, past 2^32 characters
+	_mm_storeu_si128((__m128i*)halves, total);
+	return (SizeT)(halves[0] + halves[1]) + 
+		ZUtf8_MeasureScalar(_src + it, _len - it, _surrogates);
+}
+#elif (Z_ARCHITECTURE_NEON && Z_ARCHITECTURE_ARM_64)
+static SizeT
+ZUtf8_MeasureVector(
+	_In_ const Byte* _src,
+	_In_ SizeT       _len,
+	_In_ Bool        _surrogates) {
+
+	const int8x16_t  conts = vdupq_n_s8(-65); //0xBF as signed
+	const uint8x16_t leads = vdupq_n_u8(0xF0);
+	uint8x16_t input, sum;
+	SizeT      it, count, rounds;
+
+	count = 0;
+	it = 0;
+	while (it + 16 <= _len) {
+		/*
+		Each block adds at most 2 to an 8-bit lane, so fold the lane
+		counts into the total every 127 blocks */
+		sum = vdupq_n_u8(0);
+		for (rounds = 0; rounds < 127 && it + 16 <= _len; ++rounds) {
+			input = vld1q_u8(_src + it);
+			sum = vsubq_u8(
+				sum, vcgtq_s8(vreinterpretq_s8_u8(input), conts));
+			if (_surrogates) {
+				sum = vsubq_u8(sum, vcgeq_u8(input, leads));
+			}
+			it += 16;
+		}
+		count += vaddlvq_u8(sum);
+	}
+	return count + ZUtf8_MeasureScalar(_src + it, _len - it, _surrogates);
+}
+#else
+#  define ZUtf8_MeasureVector ZUtf8_MeasureScalar
+#endif
+
+
+
+
+
+/* Section 4:
+** public interface functions
+******************************************************************************/
+Bool
+ZUtf8_Validate(
+	_In_ Lpcstr _src,
+	_In_ SizeT  _len) {
+
+#if (ZUTF8_SSSE3 || ZUTF8_NEON)
+	if (_len >= 16)
+		return ZUtf8_ValidateVector((const Byte*)_src, _len);
+#endif
+	return ZUtf8_ValidateScalar((const Byte*)_src, _len);
+}
+
+
+SizeT
+ZUtf8_CountCodePoints(
+	_In_ Lpcstr _src,
+	_In_ SizeT  _len) {
+	return ZUtf8_MeasureVector((const Byte*)_src, _len, Z_FALSE);
+}
+
+
+SizeT
+ZUtf8_Utf16Length(
+	_In_ Lpcstr _src,
+	_In_ SizeT  _len) {
+	return ZUtf8_MeasureVector((const Byte*)_src, _len, Z_TRUE);
+}
+/*****************************************************************************/  
+//EOF
+/*****************************************************************************/  
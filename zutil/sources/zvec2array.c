@@ -0,0 +1,459 @@
+/******************************************************************************
+* zutil - C Utility Library
+* Copyright (C) 2017-2021 Zachary T Harris. All Rights Reserved.  
+* Zlib license.
+* 
+* File: zvec2array.c
+* Desc: structure-of-arrays 2D vectors with batch kernels
+*******************************************************************************
+
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+******************************************************************************/ 
+#include <math.h>
+#include "zutil/zmath.h"
+#include "zutil/zsimd.h"
+#include "zutil/zvec2array.h"
+
+
+
+
+
+/* Section 1:
+** storage
+******************************************************************************/
+/*
+Moves an array into a new block with room for _capacity vectors*/
+static ZRESULT
+ZVec2Array_Realloc(
+	_Inout_ ZVEC2ARRAY* _array,
+	_In_    SizeT       _capacity) {
+
+	Void*  block;
+	Float* x;
+
+	_capacity = (SizeT)ZMath_AlignU64(_capacity, ZVEC2ARRAY_PAD);
+	block = malloc(2 * _capacity * sizeof(Float) + ZVEC2ARRAY_ALIGN);
+	if (!block)
+		return Z_EOUTOFMEMORY;
+	x = (Float*)(SizeT)ZMath_AlignU64((SizeT)block, ZVEC2ARRAY_ALIGN);
+	if (_array->iCount) {
+		memcpy(x, _array->x, _array->iCount * sizeof(Float));
+		memcpy(x + _capacity, _array->y, _array->iCount * sizeof(Float));
+	}
+	free(_array->lpBlock);
+	_array->lpBlock   = block;
+	_array->x         = x;
+	_array->y         = x + _capacity;
+	_array->iCapacity = _capacity;
+	return Z_OK;
+}
+
+
+/*
+Resizes the destination of a kernel to the source count*/
+static FORCEINLINE ZRESULT
+ZVec2Array_Prepare(
+	_Inout_ ZVEC2ARRAY* _dst,
+	_In_    SizeT       _count) {
+
+	if (_dst->iCount == _count)
+		return Z_OK;
+	return ZVec2Array_Resize(_dst, _count);
+}
+
+
+
+
+ZRESULT
+ZVec2Array_Init(
+	_Out_ ZVEC2ARRAY* _array,
+	_In_  SizeT       _capacity) {
+
+	memset(_array, 0, sizeof(ZVEC2ARRAY));
+	if (!_capacity)
+		return Z_OK;
+	return ZVec2Array_Realloc(_array, _capacity);
+}
+
+
+Void
+ZVec2Array_Free(
+	_Inout_ ZVEC2ARRAY* _array) {
+
+	free(_array->lpBlock);
+	memset(_array, 0, sizeof(ZVEC2ARRAY));
+}
+
+
+ZRESULT
+ZVec2Array_Resize(
+	_Inout_ ZVEC2ARRAY* _array,
+	_In_    SizeT       _count) {
+
+	ZRESULT result;
+	if (_count > _array->iCapacity) {
+		result = ZVec2Array_Realloc(
+			_array, Z_Max(_count, _array->iCapacity + _array->iCapacity / 2));
+		if (Z_FAILURE(result))
+			return result;
+	}
+	_array->iCount = _count;
+	return Z_OK;
+}
+
+
+ZRESULT
+ZVec2Array_FromAoS(
+	_Inout_ ZVEC2ARRAY*  _array,
+	_In_    const ZVEC2* _src,
+	_In_    SizeT        _count) {
+
+	const Float* src;
+	ZRESULT result;
+	SizeT   i = 0;
+
+	result = ZVec2Array_Prepare(_array, _count);
+	if (Z_FAILURE(result))
+		return result;
+	src = (const Float*)_src;
+#if (ZSIMD_SSE2 || ZSIMD_AVX2)
+	for (; i + 4 <= _count; i += 4) {
+		__m128 a = _mm_loadu_ps(src + 2 * i);
+		__m128 b = _mm_loadu_ps(src + 2 * i + 4);
+		_mm_store_ps(_array->x + i, _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0)));
+		_mm_store_ps(_array->y + i, _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1)));
+	}
+#elif (ZSIMD_NEON)
+	for (; i + 4 <= _count; i += 4) {
+		float32x4x2_t v = vld2q_f32(src + 2 * i);
+		vst1q_f32(_array->x + i, v.val[0]);
+		vst1q_f32(_array->y + i, v.val[1]);
+	}
+#endif
+	for (; i < _count; ++i) {
+		_array->x[i] = src[2 * i];
+		_array->y[i] = src[2 * i + 1];
+	}
+	return Z_OK;
+}
+
+
+Void
+ZVec2Array_ToAoS(
+	_In_    const ZVEC2ARRAY* _array,
+	_Inout_ ZVEC2*            _dst) {
+
+	Float* dst;
+	SizeT  i = 0;
+
+	dst = (Float*)_dst;
+#if (ZSIMD_SSE2 || ZSIMD_AVX2)
+	for (; i + 4 <= _array->iCount; i += 4) {
+		__m128 x = _mm_load_ps(_array->x + i);
+		__m128 y = _mm_load_ps(_array->y + i);
+		_mm_storeu_ps(dst + 2 * i, _mm_unpacklo_ps(x, y));
+		_mm_storeu_ps(dst + 2 * i + 4, _mm_unpackhi_ps(x, y));
+	}
+#elif (ZSIMD_NEON)
+	for (; i + 4 <= _array->iCount; i += 4) {
+		float32x4x2_t v;
+		v.val[0] = vld1q_f32(_array->x + i);
+		v.val[1] = vld1q_f32(_array->y + i);
+		vst2q_f32(dst + 2 * i, v);
+	}
+#endif
+	for (; i < _array->iCount; ++i) {
+		dst[2 * i]     = _array->x[i];
+		dst[2 * i + 1] = _array->y[i];
+	}
+}
+
+
+
+
+
+/* Section 2:
+** batch kernels
+******************************************************************************/
+ZRESULT
+ZVec2Array_Add(
+	_Inout_ ZVEC2ARRAY*       _dst,
+	_In_    const ZVEC2ARRAY* _a,
+	_In_    const ZVEC2ARRAY* _b) {
+
+	ZRESULT result;
+	SizeT   i = 0, n;
+
+	n = _a->iCount;
+	if (_b->iCount != n)
+		return Z_EINVALIDARG;
+	result = ZVec2Array_Prepare(_dst, n);
+	if (Z_FAILURE(result))
+		return result;
+	for (; i + ZSIMD_LANES <= n; i += ZSIMD_LANES) {
+		ZSimd_Store(_dst->x + i, 
+			ZSimd_Add(ZSimd_Load(_a->x + i), ZSimd_Load(_b->x + i)));
+		ZSimd_Store(_dst->y + i, 
+			ZSimd_Add(ZSimd_Load(_a->y + i), ZSimd_Load(_b->y + i)));
+	}
+	for (; i < n; ++i) {
+		_dst->x[i] = _a->x[i] + _b->x[i];
+		_dst->y[i] = _a->y[i] + _b->y[i];
+	}
+	return Z_OK;
+}
+
+
+ZRESULT
+ZVec2Array_Sub(
+	_Inout_ ZVEC2ARRAY*       _dst,
+	_In_    const ZVEC2ARRAY* _a,
+	_In_    const ZVEC2ARRAY* _b) {
+
+	ZRESULT result;
+	SizeT   i = 0, n;
+
+	n = _a->iCount;
+	if (_b->iCount != n)
+		return Z_EINVALIDARG;
+	result = ZVec2Array_Prepare(_dst, n);
+	if (Z_FAILURE(result))
+		return result;
+	for (; i + ZSIMD_LANES <= n; i += ZSIMD_LANES) {
+		ZSimd_Store(_dst->x + i, 
+			ZSimd_Sub(ZSimd_Load(_a->x + i), ZSimd_Load(_b->x + i)));
+		ZSimd_Store(_dst->y + i, 
+			ZSimd_Sub(ZSimd_Load(_a->y + i), ZSimd_Load(_b->y + i)));
+	}
+	for (; i < n; ++i) {
+		_dst->x[i] = _a->x[i] - _b->x[i];
+		_dst->y[i] = _a->y[i] - _b->y[i];
+	}
+	return Z_OK;
+}
+
+
+ZRESULT
+ZVec2Array_Scale(
+	_Inout_ ZVEC2ARRAY*       _dst,
+	_In_    const ZVEC2ARRAY* _src,
+	_In_    Float             _sx,
+	_In_    Float             _sy) {
+
+	ZRESULT result;
+	ZSIMDF  sx, sy;
+	SizeT   i = 0, n;
+
+	n = _src->iCount;
+	result = ZVec2Array_Prepare(_dst, n);
+	if (Z_FAILURE(result))
+		return result;
+	sx = ZSimd_Set1(_sx);
+	sy = ZSimd_Set1(_sy);
+	for (; i + ZSIMD_LANES <= n; i += ZSIMD_LANES) {
+		ZSimd_Store(_dst->x + i, ZSimd_Mul(ZSimd_Load(_src->x + i), sx));
+		ZSimd_Store(_dst->y + i, ZSimd_Mul(ZSimd_Load(_src->y + i), sy));
+	}
+	for (; i < n; ++i) {
+		_dst->x[i] = _src->x[i] * _sx;
+		_dst->y[i] = _src->y[i] * _sy;
+	}
+	return Z_OK;
+}
+
+
+ZRESULT
+ZVec2Array_Lerp(
+	_Inout_ ZVEC2ARRAY*       _dst,
+	_In_    const ZVEC2ARRAY* _a,
+	_In_    const ZVEC2ARRAY* _b,
+	_In_    Float             _t) {
+
+	ZRESULT result;
+	ZSIMDF  t, a;
+	SizeT   i = 0, n;
+
+	n = _a->iCount;
+	if (_b->iCount != n)
+		return Z_EINVALIDARG;
+	result = ZVec2Array_Prepare(_dst, n);
+	if (Z_FAILURE(result))
+		return result;
+	t = ZSimd_Set1(_t);
+	for (; i + ZSIMD_LANES <= n; i += ZSIMD_LANES) {
+		a = ZSimd_Load(_a->x + i);
+		ZSimd_Store(_dst->x + i, 
+			ZSimd_MulAdd(ZSimd_Sub(ZSimd_Load(_b->x + i), a), t, a));
+		a = ZSimd_Load(_a->y + i);
+		ZSimd_Store(_dst->y + i, 
+			ZSimd_MulAdd(ZSimd_Sub(ZSimd_Load(_b->y + i), a), t, a));
+	}
+	for (; i < n; ++i) {
+		_dst->x[i] = _a->x[i] + (_b->x[i] - _a->x[i]) * _t;
+		_dst->y[i] = _a->y[i] + (_b->y[i] - _a->y[i]) * _t;
+	}
+	return Z_OK;
+}
+
+
+ZRESULT
+ZVec2Array_Normalize(
+	_Inout_ ZVEC2ARRAY*       _dst,
+	_In_    const ZVEC2ARRAY* _src) {
+
+	ZRESULT result;
+	ZSIMDF  x, y, len2, scale, zero, one;
+	Float   length;
+	SizeT   i = 0, n;
+
+	n = _src->iCount;
+	result = ZVec2Array_Prepare(_dst, n);
+	if (Z_FAILURE(result))
+		return result;
+	zero = ZSimd_Set1(0.0f);
+	one  = ZSimd_Set1(1.0f);
+	for (; i + ZSIMD_LANES <= n; i += ZSIMD_LANES) {
+		x = ZSimd_Load(_src->x + i);
+		y = ZSimd_Load(_src->y + i);
+		len2  = ZSimd_MulAdd(x, x, ZSimd_Mul(y, y));
+		scale = ZSimd_Div(one, ZSimd_Sqrt(len2));
+		scale = ZSimd_And(ZSimd_CmpGt(len2, zero), scale);
+		ZSimd_Store(_dst->x + i, ZSimd_Mul(x, scale));
+		ZSimd_Store(_dst->y + i, ZSimd_Mul(y, scale));
+	}
+	for (; i < n; ++i) {
+		length = sqrtf(_src->x[i] * _src->x[i] + _src->y[i] * _src->y[i]);
+		if (length > 0.0f) {
+			_dst->x[i] = _src->x[i] * (1.0f / length);
+			_dst->y[i] = _src->y[i] * (1.0f / length);
+		}
+		else {
+			_dst->x[i] = 0.0f;
+			_dst->y[i] = 0.0f;
+		}
+	}
+	return Z_OK;
+}
+
+
+ZRESULT
+ZVec2Array_Rotate(
+	_Inout_ ZVEC2ARRAY*       _dst,
+	_In_    const ZVEC2ARRAY* _src,
+	_In_    Float             _radians) {
+
+	ZRESULT result;
+	ZSIMDF  x, y, cs, sn;
+	Float   fcs, fsn, fx;
+	SizeT   i = 0, n;
+
+	n = _src->iCount;
+	result = ZVec2Array_Prepare(_dst, n);
+	if (Z_FAILURE(result))
+		return result;
+	fcs = cosf(_radians);
+	fsn = sinf(_radians);
+	cs  = ZSimd_Set1(fcs);
+	sn  = ZSimd_Set1(fsn);
+	for (; i + ZSIMD_LANES <= n; i += ZSIMD_LANES) {
+		x = ZSimd_Load(_src->x + i);
+		y = ZSimd_Load(_src->y + i);
+		ZSimd_Store(_dst->x + i, ZSimd_Sub(ZSimd_Mul(x, cs), ZSimd_Mul(y, sn)));
+		ZSimd_Store(_dst->y + i, ZSimd_MulAdd(x, sn, ZSimd_Mul(y, cs)));
+	}
+	for (; i < n; ++i) {
+		fx = _src->x[i];
+		_dst->x[i] = fx * fcs - _src->y[i] * fsn;
+		_dst->y[i] = fx * fsn + _src->y[i] * fcs;
+	}
+	return Z_OK;
+}
+
+
+ZRESULT
+ZVec2Array_Dot(
+	_In_    const ZVEC2ARRAY* _a,
+	_In_    const ZVEC2ARRAY* _b,
+	_Inout_ Float*            _out) {
+
+	SizeT i = 0, n;
+
+	n = _a->iCount;
+	if (_b->iCount != n)
+		return Z_EINVALIDARG;
+	for (; i + ZSIMD_LANES <= n; i += ZSIMD_LANES) {
+		ZSimd_Store(_out + i, ZSimd_MulAdd(
+			ZSimd_Load(_a->x + i), ZSimd_Load(_b->x + i),
+			ZSimd_Mul(ZSimd_Load(_a->y + i), ZSimd_Load(_b->y + i))));
+	}
+	for (; i < n; ++i) {
+		_out[i] = _a->x[i] * _b->x[i] + _a->y[i] * _b->y[i];
+	}
+	return Z_OK;
+}
+
+
+Void
+ZVec2Array_Length(
+	_In_    const ZVEC2ARRAY* _src,
+	_Inout_ Float*            _out) {
+
+	ZSIMDF x, y;
+	SizeT  i = 0, n;
+
+	n = _src->iCount;
+	for (; i + ZSIMD_LANES <= n; i += ZSIMD_LANES) {
+		x = ZSimd_Load(_src->x + i);
+		y = ZSimd_Load(_src->y + i);
+		ZSimd_Store(_out + i, ZSimd_Sqrt(ZSimd_MulAdd(x, x, ZSimd_Mul(y, y))));
+	}
+	for (; i < n; ++i) {
+		_out[i] = sqrtf(_src->x[i] * _src->x[i] + _src->y[i] * _src->y[i]);
+	}
+}
+
+
+ZRESULT
+ZVec2Array_Distance(
+	_In_    const ZVEC2ARRAY* _a,
+	_In_    const ZVEC2ARRAY* _b,
+	_Inout_ Float*            _out) {
+
+	ZSIMDF dx, dy;
+	Float  fx, fy;
+	SizeT  i = 0, n;
+
+	n = _a->iCount;
+	if (_b->iCount != n)
+		return Z_EINVALIDARG;
+	for (; i + ZSIMD_LANES <= n; i += ZSIMD_LANES) {
+		dx = ZSimd_Sub(ZSimd_Load(_a->x + i), ZSimd_Load(_b->x + i));
+		dy = ZSimd_Sub(ZSimd_Load(_a->y + i), ZSimd_Load(_b->y + i));
+		ZSimd_Store(_out + i, 
+			ZSimd_Sqrt(ZSimd_MulAdd(dx, dx, ZSimd_Mul(dy, dy))));
+	}
+	for (; i < n; ++i) {
+		fx = _a->x[i] - _b->x[i];
+		fy = _a->y[i] - _b->y[i];
+		_out[i] = sqrtf(fx * fx + fy * fy);
+	}
+	return Z_OK;
+}
+/*****************************************************************************/  
+//EOF
+/*****************************************************************************/  